@@ -1,4 +1,5 @@
 #include "../common/data_bucket.h"
+#include "../common/data_bucket_index.h"
 #include "database.h"
 #include <ctime>
 #include <cctype>
@@ -6,8 +7,8 @@
 
 using json = nlohmann::json;
 
-const std::string                               NESTED_KEY_DELIMITER = ".";
-std::vector<DataBucketsRepository::DataBuckets> g_data_bucket_cache  = {};
+const std::string NESTED_KEY_DELIMITER = ".";
+DataBucketIndex   g_data_bucket_cache;
 
 #if defined(ZONE)
 #include "../zone/zonedb.h"
@@ -19,6 +20,20 @@ extern WorldDatabase database;
 #error "You must define either ZONE or WORLD"
 #endif
 
+// the cache scope a key reads and writes, the same columns CheckBucketMatch compares
+static DataBucketIndex::ScopeRef CacheScope(const DataBucketKey &k)
+{
+	return DataBucketIndex::ScopeRef{
+		k.key,
+		k.account_id,
+		k.character_id,
+		k.npc_id,
+		k.bot_id,
+		k.zone_id,
+		k.instance_id
+	};
+}
+
 void DataBucket::SetData(const std::string &bucket_key, const std::string &bucket_value, std::string expires_time)
 {
 	auto k = DataBucketKey{
@@ -140,13 +155,8 @@ void DataBucket::SetData(const DataBucketKey &k_)
 
 	if (bucket_id) {
 		// update the cache if it exists
-		if (CanCache(k)) {
-			for (auto &e: g_data_bucket_cache) {
-				if (CheckBucketMatch(e, k)) {
-					e = b;
-					break;
-				}
-			}
+		if (CanCache(k) && g_data_bucket_cache.Find(CacheScope(k))) {
+			g_data_bucket_cache.Put(b);
 		}
 
 		DataBucketsRepository::UpdateOne(database, b);
@@ -157,7 +167,7 @@ void DataBucket::SetData(const DataBucketKey &k_)
 		// add to cache if it doesn't exist
 		if (CanCache(k) && !ExistsInCache(b)) {
 			DeleteFromMissesCache(b);
-			g_data_bucket_cache.emplace_back(b);
+			g_data_bucket_cache.Put(b);
 		}
 	}
 }
@@ -240,22 +250,24 @@ DataBucketsRepository::DataBuckets DataBucket::GetData(const DataBucketKey &k_,
 
 	// Attempt to retrieve the value from the cache
 	if (can_cache) {
-		for (const auto &e : g_data_bucket_cache) {
-			if (CheckBucketMatch(e, k)) {
-				if (e.expires > 0 && e.expires < std::time(nullptr)) {
-					LogDataBuckets("Attempted to read expired key [{}] removing from cache", e.key_);
-					DeleteData(k);
-					return DataBucketsRepository::NewEntity();
-				}
-
-				LogDataBuckets("Returning key [{}] value [{}] from cache", e.key_, e.value);
+		// expired rows leave the cache here, the database copy is removed the next time it is read
+		g_data_bucket_cache.EraseExpired(std::time(nullptr));
+
+		auto e = g_data_bucket_cache.Find(CacheScope(k));
+		if (e) {
+			if (e->expires > 0 && e->expires < std::time(nullptr)) {
+				LogDataBuckets("Attempted to read expired key [{}] removing from cache", e->key_);
+				DeleteData(k);
+				return DataBucketsRepository::NewEntity();
+			}
 
-				if (is_nested_key && !k_.key.empty()) {
-					return ExtractNestedValue(e, k_.key);
-				}
+			LogDataBuckets("Returning key [{}] value [{}] from cache", e->key_, e->value);
 
-				return e;
+			if (is_nested_key && !k_.key.empty()) {
+				return ExtractNestedValue(*e, k_.key);
 			}
+
+			return *e;
 		}
 	}
 
@@ -272,9 +284,9 @@ DataBucketsRepository::DataBuckets DataBucket::GetData(const DataBucketKey &k_,
 	if (r.empty()) {
 		// Handle cache misses
 		if (!ignore_misses_cache && can_cache) {
-			size_t size_before = g_data_bucket_cache.size();
+			size_t size_before = g_data_bucket_cache.Size();
 
-			g_data_bucket_cache.emplace_back(
+			g_data_bucket_cache.Put(
 				DataBucketsRepository::DataBuckets{
 					.id = 0,
 					.key_ = k.key,
@@ -299,7 +311,7 @@ DataBucketsRepository::DataBuckets DataBucket::GetData(const DataBucketKey &k_,
 				k.zone_id,
 				k.instance_id,
 				size_before,
-				g_data_bucket_cache.size()
+				g_data_bucket_cache.Size()
 			);
 		}
 
@@ -315,18 +327,8 @@ DataBucketsRepository::DataBuckets DataBucket::GetData(const DataBucketKey &k_,
 	}
 
 	// Add the value to the cache if it doesn't exist
-	if (can_cache) {
-		bool has_cache = false;
-		for (const auto &e : g_data_bucket_cache) {
-			if (e.id == bucket.id) {
-				has_cache = true;
-				break;
-			}
-		}
-
-		if (!has_cache) {
-			g_data_bucket_cache.emplace_back(bucket);
-		}
+	if (can_cache && !g_data_bucket_cache.ContainsId(bucket.id)) {
+		g_data_bucket_cache.Put(bucket);
 	}
 
 	// Handle nested key extraction
@@ -359,17 +361,7 @@ bool DataBucket::DeleteData(const DataBucketKey &k)
 	if (!is_nested_key) {
 		// Update cache
 		if (CanCache(k)) {
-			// delete from cache where contents match
-			g_data_bucket_cache.erase(
-				std::remove_if(
-					g_data_bucket_cache.begin(),
-					g_data_bucket_cache.end(),
-					[&](DataBucketsRepository::DataBuckets &e) {
-						return CheckBucketMatch(e, k);
-					}
-				),
-				g_data_bucket_cache.end()
-			);
+			g_data_bucket_cache.Erase(CacheScope(k));
 		}
 
 		// Regular key deletion, no nesting involved
@@ -431,16 +423,7 @@ bool DataBucket::DeleteData(const DataBucketKey &k)
 
 		// delete cache
 		if (CanCache(k)) {
-			g_data_bucket_cache.erase(
-				std::remove_if(
-					g_data_bucket_cache.begin(),
-					g_data_bucket_cache.end(),
-					[&](DataBucketsRepository::DataBuckets &e) {
-						return CheckBucketMatch(e, top_level_k);
-					}
-				),
-				g_data_bucket_cache.end()
-			);
+			g_data_bucket_cache.Erase(CacheScope(top_level_k));
 		}
 
 		return DataBucketsRepository::DeleteWhere(
@@ -455,11 +438,9 @@ bool DataBucket::DeleteData(const DataBucketKey &k)
 
 	// Update cache
 	if (CanCache(k)) {
-		for (auto &e : g_data_bucket_cache) {
-			if (CheckBucketMatch(e, top_level_k)) {
-				e.value = r.value;
-				break;
-			}
+		auto e = g_data_bucket_cache.Find(CacheScope(top_level_k));
+		if (e) {
+			e->value = r.value;
 		}
 	}
 
@@ -581,7 +562,7 @@ void DataBucket::LoadZoneCache(uint16 zone_id, uint16 instance_id)
 		return;
 	}
 
-	LogDataBucketsDetail("cache size before [{}] l size [{}]", g_data_bucket_cache.size(), l.size());
+	LogDataBucketsDetail("cache size before [{}] l size [{}]", g_data_bucket_cache.Size(), l.size());
 
 	uint32 added_count = 0;
 
@@ -595,16 +576,16 @@ void DataBucket::LoadZoneCache(uint16 zone_id, uint16 instance_id)
 		if (!ExistsInCache(e)) {
 			LogDataBucketsDetail("bucket id [{}] bucket key [{}] bucket value [{}]", e.id, e.key_, e.value);
 
-			g_data_bucket_cache.emplace_back(e);
+			g_data_bucket_cache.Put(e);
 		}
 	}
 
-	LogDataBucketsDetail("cache size after [{}]", g_data_bucket_cache.size());
+	LogDataBucketsDetail("cache size after [{}]", g_data_bucket_cache.Size());
 
 	LogDataBuckets(
 		"Loaded [{}] zone keys new cache size is [{}]",
 		l.size(),
-		g_data_bucket_cache.size()
+		g_data_bucket_cache.Size()
 	);
 }
 
@@ -615,19 +596,15 @@ void DataBucket::BulkLoadEntitiesToCache(DataBucketLoadType::Type t, std::vector
 	}
 
 	if (ids.size() == 1) {
-		bool has_cache = false;
-
-		for (const auto &e: g_data_bucket_cache) {
-			if (t == DataBucketLoadType::Bot) {
-				has_cache = e.bot_id == ids[0];
-			}
-			else if (t == DataBucketLoadType::Account) {
-				has_cache = e.account_id == ids[0];
-			}
-			else if (t == DataBucketLoadType::Client) {
-				has_cache = e.character_id == ids[0];
+		bool has_cache = g_data_bucket_cache.AnyOf(
+			[&](const DataBucketsRepository::DataBuckets &e) {
+				return e.id != 0 && (
+					(t == DataBucketLoadType::Bot && e.bot_id == ids[0]) ||
+					(t == DataBucketLoadType::Account && e.account_id == ids[0]) ||
+					(t == DataBucketLoadType::Client && e.character_id == ids[0])
+				);
 			}
-		}
+		);
 
 		if (has_cache) {
 			LogDataBucketsDetail("LoadType [{}] ID [{}] has cache", DataBucketLoadType::Name[t], ids[0]);
@@ -666,7 +643,7 @@ void DataBucket::BulkLoadEntitiesToCache(DataBucketLoadType::Type t, std::vector
 		return;
 	}
 
-	LogDataBucketsDetail("cache size before [{}] l size [{}]", g_data_bucket_cache.size(), l.size());
+	LogDataBucketsDetail("cache size before [{}] l size [{}]", g_data_bucket_cache.Size(), l.size());
 
 	uint32 added_count = 0;
 
@@ -680,38 +657,33 @@ void DataBucket::BulkLoadEntitiesToCache(DataBucketLoadType::Type t, std::vector
 		if (!ExistsInCache(e)) {
 			LogDataBucketsDetail("bucket id [{}] bucket key [{}] bucket value [{}]", e.id, e.key_, e.value);
 
-			g_data_bucket_cache.emplace_back(e);
+			g_data_bucket_cache.Put(e);
 		}
 	}
 
-	LogDataBucketsDetail("cache size after [{}]", g_data_bucket_cache.size());
+	LogDataBucketsDetail("cache size after [{}]", g_data_bucket_cache.Size());
 
 	LogDataBuckets(
 		"Bulk Loaded ids [{}] column [{}] new cache size is [{}]",
 		ids.size(),
 		column,
-		g_data_bucket_cache.size()
+		g_data_bucket_cache.Size()
 	);
 }
 
 void DataBucket::DeleteCachedBuckets(DataBucketLoadType::Type type, uint32 id, uint32 secondary_id)
 {
-	size_t size_before = g_data_bucket_cache.size();
-
-	g_data_bucket_cache.erase(
-		std::remove_if(
-			g_data_bucket_cache.begin(),
-			g_data_bucket_cache.end(),
-			[&](DataBucketsRepository::DataBuckets &e) {
-				return (
-					(type == DataBucketLoadType::Bot && e.bot_id == id) ||
-					(type == DataBucketLoadType::Account && e.account_id == id) ||
-					(type == DataBucketLoadType::Client && e.character_id == id) ||
-					(type == DataBucketLoadType::Zone && e.zone_id == id && e.instance_id == secondary_id)
-				);
-			}
-		),
-		g_data_bucket_cache.end()
+	size_t size_before = g_data_bucket_cache.Size();
+
+	g_data_bucket_cache.EraseIf(
+		[&](const DataBucketsRepository::DataBuckets &e) {
+			return (
+				(type == DataBucketLoadType::Bot && e.bot_id == id) ||
+				(type == DataBucketLoadType::Account && e.account_id == id) ||
+				(type == DataBucketLoadType::Client && e.character_id == id) ||
+				(type == DataBucketLoadType::Zone && e.zone_id == id && e.instance_id == secondary_id)
+			);
+		}
 	);
 
 	LogDataBuckets(
@@ -719,79 +691,54 @@ void DataBucket::DeleteCachedBuckets(DataBucketLoadType::Type type, uint32 id, u
 		DataBucketLoadType::Name[type],
 		id,
 		size_before,
-		g_data_bucket_cache.size()
+		g_data_bucket_cache.Size()
 	);
 }
 
 bool DataBucket::ExistsInCache(const DataBucketsRepository::DataBuckets &entry)
 {
-	for (const auto &e: g_data_bucket_cache) {
-		if (e.id == entry.id) {
-			return true;
-		}
-	}
-
-	return false;
+	return g_data_bucket_cache.ContainsId(entry.id);
 }
 
 void DataBucket::DeleteFromMissesCache(DataBucketsRepository::DataBuckets e)
 {
 	// delete from cache where there might have been a written bucket miss to the cache
 	// this is to prevent the cache from growing too large
-	size_t size_before = g_data_bucket_cache.size();
-
-	g_data_bucket_cache.erase(
-		std::remove_if(
-			g_data_bucket_cache.begin(),
-			g_data_bucket_cache.end(),
-			[&](DataBucketsRepository::DataBuckets &ce) {
-				return ce.id == 0 && ce.key_ == e.key_ &&
-					   ce.account_id == e.account_id &&
-					   ce.character_id == e.character_id &&
-					   ce.npc_id == e.npc_id &&
-					   ce.bot_id == e.bot_id &&
-					   ce.zone_id == e.zone_id &&
-					   ce.instance_id == e.instance_id;
-			}
-		),
-		g_data_bucket_cache.end()
-	);
+	size_t size_before = g_data_bucket_cache.Size();
+
+	g_data_bucket_cache.EraseMiss(DataBucketIndex::ScopeOf(e));
+
 	LogDataBucketsDetail(
 		"Deleted bucket misses from cache where key [{}] size before [{}] after [{}]",
 		e.key_,
 		size_before,
-		g_data_bucket_cache.size()
+		g_data_bucket_cache.Size()
 	);
 }
 
 void DataBucket::ClearCache()
 {
-	g_data_bucket_cache.clear();
+	g_data_bucket_cache.Clear();
 	LogInfo("Cleared data buckets cache");
 }
 
 void DataBucket::DeleteFromCache(uint64 id, DataBucketLoadType::Type type)
 {
-	size_t size_before = g_data_bucket_cache.size();
-
-	g_data_bucket_cache.erase(
-		std::remove_if(
-			g_data_bucket_cache.begin(),
-			g_data_bucket_cache.end(),
-			[&](DataBucketsRepository::DataBuckets &e) {
-				switch (type) {
-					case DataBucketLoadType::Bot:
-						return e.bot_id == id;
-					case DataBucketLoadType::Client:
-						return e.character_id == id;
-					case DataBucketLoadType::Account:
-						return e.account_id == id;
-					default:
-						return false;
-				}
+	size_t size_before = g_data_bucket_cache.Size();
+
+	g_data_bucket_cache.EraseIf(
+		[&](const DataBucketsRepository::DataBuckets &e) {
+			switch (type) {
+				case DataBucketLoadType::Bot:
+					return e.bot_id == id;
+				case DataBucketLoadType::Client:
+					return e.character_id == id;
+				case DataBucketLoadType::Account:
+					return e.account_id == id;
+				default:
+					return false;
 			}
-		),
-		g_data_bucket_cache.end()
+		}
 	);
 
 	LogDataBuckets(
@@ -799,28 +746,23 @@ void DataBucket::DeleteFromCache(uint64 id, DataBucketLoadType::Type type)
 		DataBucketLoadType::Name[type],
 		id,
 		size_before,
-		g_data_bucket_cache.size()
+		g_data_bucket_cache.Size()
 	);
 }
 
 void DataBucket::DeleteZoneFromCache(uint16 zone_id, uint16 instance_id, DataBucketLoadType::Type type)
 {
-	size_t size_before = g_data_bucket_cache.size();
-
-	g_data_bucket_cache.erase(
-		std::remove_if(
-			g_data_bucket_cache.begin(),
-			g_data_bucket_cache.end(),
-			[&](DataBucketsRepository::DataBuckets &e) {
-				switch (type) {
-					case DataBucketLoadType::Zone:
-						return e.zone_id == zone_id && e.instance_id == instance_id;
-					default:
-						return false;
-				}
+	size_t size_before = g_data_bucket_cache.Size();
+
+	g_data_bucket_cache.EraseIf(
+		[&](const DataBucketsRepository::DataBuckets &e) {
+			switch (type) {
+				case DataBucketLoadType::Zone:
+					return e.zone_id == zone_id && e.instance_id == instance_id;
+				default:
+					return false;
 			}
-		),
-		g_data_bucket_cache.end()
+		}
 	);
 
 	LogDataBuckets(
@@ -828,7 +770,7 @@ void DataBucket::DeleteZoneFromCache(uint16 zone_id, uint16 instance_id, DataBuc
 		zone_id,
 		instance_id,
 		size_before,
-		g_data_bucket_cache.size()
+		g_data_bucket_cache.Size()
 	);
 }
 
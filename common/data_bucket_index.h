@@ -0,0 +1,251 @@
+#ifndef EQEMU_DATA_BUCKET_INDEX_H
+#define EQEMU_DATA_BUCKET_INDEX_H
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "types.h"
+#include "repositories/data_buckets_repository.h"
+
+/*
+	The data bucket rows a process keeps in memory, found by scope instead of by scanning.
+
+	Rows are keyed by their key and scoping columns, the same columns DataBucket::CheckBucketMatch
+	compares, so there is at most one row per scope. A row with id 0 is a remembered miss, the key
+	was looked up and is not in the database. Rows with an expiry are also kept in a min-heap on
+	the expiry time so expired rows can be dropped without walking the cache.
+*/
+class DataBucketIndex {
+public:
+	typedef DataBucketsRepository::DataBuckets Bucket;
+
+	// a row's scope without owning the key, what lookups are made with
+	struct ScopeRef {
+		std::string_view key;
+		uint64           account_id;
+		uint64           character_id;
+		uint32           npc_id;
+		uint32           bot_id;
+		uint16           zone_id;
+		uint16           instance_id;
+
+		bool operator==(const ScopeRef &o) const
+		{
+			return key == o.key && account_id == o.account_id && character_id == o.character_id &&
+				npc_id == o.npc_id && bot_id == o.bot_id && zone_id == o.zone_id && instance_id == o.instance_id;
+		}
+	};
+
+	static ScopeRef ScopeOf(const Bucket &b)
+	{
+		return ScopeRef{ b.key_, b.account_id, b.character_id, b.npc_id, b.bot_id, b.zone_id, b.instance_id };
+	}
+
+	Bucket *Find(const ScopeRef &scope)
+	{
+		auto iter = m_rows.find(scope);
+		return iter != m_rows.end() ? &iter->second : nullptr;
+	}
+
+	bool ContainsId(uint64 id) const { return id != 0 && m_ids.find(id) != m_ids.end(); }
+
+	// adds the row, replacing whatever was cached for its scope (a miss or an older copy)
+	void Put(const Bucket &b)
+	{
+		auto scope = ScopeOf(b);
+		auto iter  = m_rows.find(scope);
+		if (iter != m_rows.end()) {
+			if (iter->second.id != 0 && iter->second.id != b.id) {
+				m_ids.erase(iter->second.id);
+			}
+
+			iter->second = b;
+		}
+		else {
+			iter = m_rows.emplace(Scope(b), b).first;
+		}
+
+		if (b.id != 0) {
+			m_ids[b.id] = &iter->first;
+		}
+
+		if (b.expires > 0) {
+			m_expiry.push_back(Expiry{ b.expires, b.id });
+			std::push_heap(m_expiry.begin(), m_expiry.end(), std::greater<Expiry>());
+
+			// rows that were rewritten or erased leave their old entries behind, don't let those pile up
+			if (m_expiry.size() > 64 && m_expiry.size() > m_rows.size() * 2) {
+				RebuildExpiry();
+			}
+		}
+	}
+
+	bool Erase(const ScopeRef &scope)
+	{
+		auto iter = m_rows.find(scope);
+		if (iter == m_rows.end()) {
+			return false;
+		}
+
+		EraseRow(iter);
+		return true;
+	}
+
+	// only drops the row for this scope if it is a remembered miss
+	bool EraseMiss(const ScopeRef &scope)
+	{
+		auto iter = m_rows.find(scope);
+		if (iter == m_rows.end() || iter->second.id != 0) {
+			return false;
+		}
+
+		EraseRow(iter);
+		return true;
+	}
+
+	template<typename Fn>
+	size_t EraseIf(Fn &&fn)
+	{
+		size_t erased = 0;
+		for (auto iter = m_rows.begin(); iter != m_rows.end();) {
+			if (fn(static_cast<const Bucket &>(iter->second))) {
+				iter = EraseRow(iter);
+				erased++;
+			}
+			else {
+				++iter;
+			}
+		}
+
+		return erased;
+	}
+
+	template<typename Fn>
+	bool AnyOf(Fn &&fn) const
+	{
+		for (auto &e : m_rows) {
+			if (fn(e.second)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// drops every row whose expiry is before now, returns how many went
+	size_t EraseExpired(int64 now)
+	{
+		size_t erased = 0;
+		while (!m_expiry.empty() && static_cast<int64>(m_expiry.front().expires) < now) {
+			Expiry e = m_expiry.front();
+			std::pop_heap(m_expiry.begin(), m_expiry.end(), std::greater<Expiry>());
+			m_expiry.pop_back();
+
+			auto id = m_ids.find(e.id);
+			if (id == m_ids.end()) {
+				continue;
+			}
+
+			auto iter = m_rows.find(ScopeRef(*id->second));
+			if (iter != m_rows.end() && iter->second.expires == e.expires) {
+				EraseRow(iter);
+				erased++;
+			}
+		}
+
+		return erased;
+	}
+
+	void Clear()
+	{
+		m_rows.clear();
+		m_ids.clear();
+		m_expiry.clear();
+	}
+
+	size_t Size() const { return m_rows.size(); }
+
+private:
+	struct Scope {
+		std::string key;
+		uint64      account_id;
+		uint64      character_id;
+		uint32      npc_id;
+		uint32      bot_id;
+		uint16      zone_id;
+		uint16      instance_id;
+
+		explicit Scope(const Bucket &b)
+			: key(b.key_), account_id(b.account_id), character_id(b.character_id), npc_id(b.npc_id), bot_id(b.bot_id),
+			  zone_id(b.zone_id), instance_id(b.instance_id) { }
+
+		operator ScopeRef() const
+		{
+			return ScopeRef{ key, account_id, character_id, npc_id, bot_id, zone_id, instance_id };
+		}
+	};
+
+	struct ScopeHash {
+		using is_transparent = void;
+
+		size_t operator()(const ScopeRef &s) const
+		{
+			size_t h = std::hash<std::string_view>()(s.key);
+			Combine(h, s.account_id);
+			Combine(h, s.character_id);
+			Combine(h, (static_cast<uint64>(s.npc_id) << 32) | s.bot_id);
+			Combine(h, (static_cast<uint64>(s.zone_id) << 16) | s.instance_id);
+			return h;
+		}
+
+		static void Combine(size_t &h, uint64 v)
+		{
+			h ^= std::hash<uint64>()(v) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+		}
+	};
+
+	struct ScopeEqual {
+		using is_transparent = void;
+
+		bool operator()(const ScopeRef &a, const ScopeRef &b) const { return a == b; }
+	};
+
+	struct Expiry {
+		uint32 expires;
+		uint64 id;
+
+		bool operator>(const Expiry &o) const { return expires > o.expires; }
+	};
+
+	typedef std::unordered_map<Scope, Bucket, ScopeHash, ScopeEqual> RowMap;
+
+	RowMap::iterator EraseRow(RowMap::iterator iter)
+	{
+		if (iter->second.id != 0) {
+			m_ids.erase(iter->second.id);
+		}
+
+		return m_rows.erase(iter);
+	}
+
+	void RebuildExpiry()
+	{
+		m_expiry.clear();
+		for (auto &e : m_rows) {
+			if (e.second.expires > 0 && e.second.id != 0) {
+				m_expiry.push_back(Expiry{ e.second.expires, e.second.id });
+			}
+		}
+
+		std::make_heap(m_expiry.begin(), m_expiry.end(), std::greater<Expiry>());
+	}
+
+	RowMap                                       m_rows;
+	std::unordered_map<uint64, const Scope *>    m_ids;    // database id to the scope it is cached under
+	std::vector<Expiry>                          m_expiry; // min-heap on expiry, may hold stale entries
+};
+
+#endif //EQEMU_DATA_BUCKET_INDEX_H
@@ -3,7 +3,9 @@
 
 //this is the only part of an EQStream that is seen by the application.
 
+#include <memory>
 #include <string>
+#include <vector>
 #include "emu_versions.h"
 #include "eq_packet.h"
 #include "net/daybreak_connection.h"
@@ -19,6 +21,15 @@ typedef enum {
 class EQApplicationPacket;
 class OpcodeManager;
 
+//a packet as it leaves a stream's struct strategy, ready for the wire
+struct EncodedPacket
+{
+	std::unique_ptr<EQApplicationPacket> packet;
+	bool ack_req;
+};
+
+typedef std::vector<EncodedPacket> EncodedPacketList;
+
 struct EQStreamManagerInterfaceOptions
 {
 	EQStreamManagerInterfaceOptions() {
@@ -105,6 +116,20 @@ public:
 	virtual Stats GetStats() const = 0;
 	virtual void ResetStats() = 0;
 	virtual EQStreamManagerInterface* GetManager() const = 0;
+
+	//multicast support, see MulticastPacket. Streams with the same encode key translate packets
+	//identically, so one Encode() result can be handed to QueueEncoded() on each of them.
+	virtual const void *GetEncodeKey() const { return this; }
+	virtual std::shared_ptr<const EncodedPacketList> Encode(const EQApplicationPacket *p, bool ack_req) const {
+		auto packets = std::make_shared<EncodedPacketList>();
+		packets->push_back(EncodedPacket{ std::unique_ptr<EQApplicationPacket>(p->Copy()), ack_req });
+		return packets;
+	}
+	virtual void QueueEncoded(const EncodedPacketList &packets) {
+		for (auto &e : packets) {
+			QueuePacket(e.packet.get(), e.ack_req);
+		}
+	}
 };
 
 #endif /*EQSTREAMINTF_H_*/
@@ -5,6 +5,46 @@
 #include "eqemu_logsys.h"
 #include "opcodemgr.h"
 
+namespace {
+	//stands in for the real stream while a struct strategy encodes, keeping what it queues
+	class EncodeCaptureStream : public EQStreamInterface {
+	public:
+		EncodeCaptureStream() : m_packets(std::make_shared<EncodedPacketList>()) { }
+
+		std::shared_ptr<EncodedPacketList> Packets() { return m_packets; }
+
+		virtual void QueuePacket(const EQApplicationPacket *p, bool ack_req = true) {
+			if (p) {
+				m_packets->push_back(EncodedPacket{ std::unique_ptr<EQApplicationPacket>(p->Copy()), ack_req });
+			}
+		}
+		virtual void FastQueuePacket(EQApplicationPacket **p, bool ack_req = true) {
+			if (p && *p) {
+				m_packets->push_back(EncodedPacket{ std::unique_ptr<EQApplicationPacket>(*p), ack_req });
+				*p = nullptr;
+			}
+		}
+		virtual EQApplicationPacket *PopPacket() { return nullptr; }
+		virtual void Close() { }
+		virtual void ReleaseFromUse() { }
+		virtual void RemoveData() { }
+		virtual std::string GetRemoteAddr() const { return std::string(); }
+		virtual uint32 GetRemoteIP() const { return 0; }
+		virtual uint16 GetRemotePort() const { return 0; }
+		virtual bool CheckState(EQStreamState state) { return state == ESTABLISHED; }
+		virtual std::string Describe() const { return "Encode Capture"; }
+		virtual EQStreamState GetState() { return ESTABLISHED; }
+		virtual void SetOpcodeManager(OpcodeManager **opm) { }
+		virtual OpcodeManager *GetOpcodeManager() const { return nullptr; }
+		virtual Stats GetStats() const { return Stats{}; }
+		virtual void ResetStats() { }
+		virtual EQStreamManagerInterface *GetManager() const { return nullptr; }
+
+	private:
+		std::shared_ptr<EncodedPacketList> m_packets;
+	};
+}
+
 
 EQStreamProxy::EQStreamProxy(std::shared_ptr<EQStreamInterface> &stream, const StructStrategy *structs, OpcodeManager **opcodes)
 :	m_stream(stream),
@@ -113,3 +153,28 @@ OpcodeManager *EQStreamProxy::GetOpcodeManager() const
 	return (*m_opcodes);
 }
 
+//every proxy sharing a struct strategy encodes the same way
+const void *EQStreamProxy::GetEncodeKey() const
+{
+	return m_structs;
+}
+
+std::shared_ptr<const EncodedPacketList> EQStreamProxy::Encode(const EQApplicationPacket *p, bool ack_req) const
+{
+	auto capture = std::make_shared<EncodeCaptureStream>();
+	if (p == nullptr) {
+		return capture->Packets();
+	}
+
+	EQApplicationPacket *newp = p->Copy();
+	m_structs->Encode(&newp, capture, ack_req);
+	return capture->Packets();
+}
+
+//packets from Encode() skip the struct strategy, the stream below only maps opcodes
+void EQStreamProxy::QueueEncoded(const EncodedPacketList &packets)
+{
+	for (auto &e : packets) {
+		m_stream->QueuePacket(e.packet.get(), e.ack_req);
+	}
+}
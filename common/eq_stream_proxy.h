@@ -35,6 +35,9 @@ public:
 	virtual void ResetStats();
 	virtual EQStreamManagerInterface* GetManager() const;
 	virtual OpcodeManager* GetOpcodeManager() const;
+	virtual const void *GetEncodeKey() const;
+	virtual std::shared_ptr<const EncodedPacketList> Encode(const EQApplicationPacket *p, bool ack_req) const;
+	virtual void QueueEncoded(const EncodedPacketList &packets);
 
 protected:
 	std::shared_ptr<EQStreamInterface> const m_stream;	//we own this stream object.
@@ -0,0 +1,29 @@
+#include "multicast_packet.h"
+#include "eq_packet.h"
+
+MulticastPacket::MulticastPacket(const EQApplicationPacket *app, bool ack_req)
+	: m_app(app), m_ack_req(ack_req), m_encode_count(0), m_queue_count(0)
+{
+}
+
+void MulticastPacket::QueueTo(EQStreamInterface *stream)
+{
+	if (stream == nullptr || m_app == nullptr) {
+		return;
+	}
+
+	const void *key = stream->GetEncodeKey();
+	for (auto &e : m_encoded) {
+		if (e.first == key) {
+			stream->QueueEncoded(*e.second);
+			m_queue_count++;
+			return;
+		}
+	}
+
+	m_encoded.emplace_back(key, stream->Encode(m_app, m_ack_req));
+	m_encode_count++;
+
+	stream->QueueEncoded(*m_encoded.back().second);
+	m_queue_count++;
+}
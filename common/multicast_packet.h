@@ -0,0 +1,43 @@
+#ifndef EQEMU_MULTICAST_PACKET_H
+#define EQEMU_MULTICAST_PACKET_H
+
+#include "types.h"
+#include "eq_stream_intf.h"
+#include <memory>
+#include <utility>
+#include <vector>
+
+class EQApplicationPacket;
+
+/*
+	One application packet on its way to many streams.
+
+	The first stream of each client version runs the packet through its struct strategy; every
+	later stream with the same encode key is handed the same reference counted result, so a
+	packet seen by hundreds of clients is translated once per client version instead of once
+	per client. The application packet must stay unchanged while the multicast is in use.
+*/
+class MulticastPacket {
+public:
+	MulticastPacket(const EQApplicationPacket *app, bool ack_req = true);
+
+	const EQApplicationPacket *GetPacket() const { return m_app; }
+	bool IsAckRequired() const { return m_ack_req; }
+
+	void QueueTo(EQStreamInterface *stream);
+
+	// struct strategy runs and streams queued to so far
+	uint32 GetEncodeCount() const { return m_encode_count; }
+	uint32 GetQueueCount() const { return m_queue_count; }
+
+private:
+	const EQApplicationPacket *m_app;
+	bool                       m_ack_req;
+	uint32                     m_encode_count;
+	uint32                     m_queue_count;
+
+	// one entry per client version seen, a handful at most
+	std::vector<std::pair<const void *, std::shared_ptr<const EncodedPacketList>>> m_encoded;
+};
+
+#endif //EQEMU_MULTICAST_PACKET_H
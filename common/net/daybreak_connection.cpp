@@ -5,6 +5,11 @@
 #include <zlib.h>
 #include <fmt/format.h>
 
+#ifdef EQEMU_DAYBREAK_BATCHED_IO
+#include <sys/socket.h>
+#include <cerrno>
+#endif
+
 // observed client receive window is 300 packets, 140KB
 constexpr size_t MAX_CLIENT_RECV_PACKETS_PER_WINDOW = 300;
 constexpr size_t MAX_CLIENT_RECV_BYTES_PER_WINDOW   = 140 * 1024;
@@ -12,11 +17,35 @@ constexpr size_t MAX_CLIENT_RECV_BYTES_PER_WINDOW   = 140 * 1024;
 // buffer pools
 SendBufferPool send_buffer_pool;
 
+// max datagrams handed to a single sendmmsg call
+constexpr size_t MAX_SEND_BATCH = 64;
+
+// recvmmsg splits the receive buffer into 64KB datagram slots, libuv caps a single read at 20 of them
+constexpr size_t RECV_BATCH_DATAGRAM_SIZE = 64 * 1024;
+constexpr size_t RECV_BATCH_DATAGRAMS     = 20;
+
+static void OnPooledSendComplete(uv_udp_send_t *req, int status)
+{
+	auto *ctx = reinterpret_cast<EmbeddedContext *>(req->data);
+	if (!ctx) {
+		std::cerr << "Error: send_req->data is null in callback!" << std::endl;
+		return;
+	}
+
+	if (status < 0) {
+		std::cerr << "uv_udp_send failed: " << uv_strerror(status) << std::endl;
+	}
+
+	ctx->pool->release(ctx);
+}
+
 EQ::Net::DaybreakConnectionManager::DaybreakConnectionManager()
 {
 	m_attached = nullptr;
+	m_batched_io = false;
 	memset(&m_timer, 0, sizeof(uv_timer_t));
 	memset(&m_socket, 0, sizeof(uv_udp_t));
+	memset(&m_flush_check, 0, sizeof(uv_check_t));
 
 	Attach(EQ::EventLoop::Get().Handle());
 }
@@ -24,9 +53,11 @@ EQ::Net::DaybreakConnectionManager::DaybreakConnectionManager()
 EQ::Net::DaybreakConnectionManager::DaybreakConnectionManager(const DaybreakConnectionManagerOptions &opts)
 {
 	m_attached = nullptr;
+	m_batched_io = false;
 	m_options = opts;
 	memset(&m_timer, 0, sizeof(uv_timer_t));
 	memset(&m_socket, 0, sizeof(uv_udp_t));
+	memset(&m_flush_check, 0, sizeof(uv_check_t));
 
 	Attach(EQ::EventLoop::Get().Handle());
 }
@@ -49,9 +80,33 @@ void EQ::Net::DaybreakConnectionManager::Attach(uv_loop_t *loop)
 			c->UpdateDataBudget();
 			c->Process();
 			c->ProcessResend();
+			c->FlushSendBatch();
 		}, update_rate, update_rate);
 
-		uv_udp_init(loop, &m_socket);
+#ifdef EQEMU_DAYBREAK_BATCHED_IO
+		m_batched_io = m_options.batched_io;
+#endif
+
+		if (m_batched_io) {
+#if UV_VERSION_HEX >= 0x012800
+			uv_udp_init_ex(loop, &m_socket, AF_INET | UV_UDP_RECVMMSG);
+			m_recv_batch_buffer.reset(new char[RECV_BATCH_DATAGRAM_SIZE * RECV_BATCH_DATAGRAMS]);
+#else
+			uv_udp_init(loop, &m_socket);
+#endif
+
+			// sends queued from anywhere during a loop iteration go out together once polling is done
+			uv_check_init(loop, &m_flush_check);
+			m_flush_check.data = this;
+			uv_check_start(&m_flush_check, [](uv_check_t *handle) {
+				DaybreakConnectionManager *c = (DaybreakConnectionManager*)handle->data;
+				c->FlushSendBatch();
+			});
+		}
+		else {
+			uv_udp_init(loop, &m_socket);
+		}
+
 		m_socket.data = this;
 		struct sockaddr_in recv_addr;
 		uv_ip4_addr("0.0.0.0", m_options.port, &recv_addr);
@@ -60,6 +115,13 @@ void EQ::Net::DaybreakConnectionManager::Attach(uv_loop_t *loop)
 		rc = uv_udp_recv_start(
 			&m_socket,
 			[](uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf) {
+				DaybreakConnectionManager *c = (DaybreakConnectionManager*)handle->data;
+				if (c->m_recv_batch_buffer) {
+					buf->base = c->m_recv_batch_buffer.get();
+					buf->len  = RECV_BATCH_DATAGRAM_SIZE * RECV_BATCH_DATAGRAMS;
+					return;
+				}
+
 				if (suggested_size > 65536) {
 					buf->base = new char[suggested_size];
 					buf->len  = suggested_size;
@@ -76,12 +138,10 @@ void EQ::Net::DaybreakConnectionManager::Attach(uv_loop_t *loop)
 				return;
 			}
 
-			char endpoint[16];
-			uv_ip4_name((const sockaddr_in*)addr, endpoint, 16);
-			auto port = ntohs(((const sockaddr_in*)addr)->sin_port);
-			c->ProcessPacket(endpoint, port, buf->base, nread);
+			c->ProcessPacket(*(const sockaddr_in*)addr, buf->base, nread);
 
-			if (buf->len > 65536) {
+			// the recvmmsg buffer is owned by the manager and reused for every read
+			if (buf->len > 65536 && !c->m_recv_batch_buffer) {
 				delete[] buf->base;
 			}
 		});
@@ -95,10 +155,104 @@ void EQ::Net::DaybreakConnectionManager::Detach()
 	if (m_attached) {
 		uv_udp_recv_stop(&m_socket);
 		uv_timer_stop(&m_timer);
+
+		if (m_batched_io) {
+			uv_check_stop(&m_flush_check);
+			FlushSendBatch();
+		}
+
 		m_attached = nullptr;
 	}
 }
 
+void EQ::Net::DaybreakConnectionManager::QueueSend(
+	uv_udp_send_t *req,
+	const uv_buf_t &buffer,
+	const sockaddr_in &addr,
+	EmbeddedContext *ctx
+)
+{
+	if (!m_batched_io) {
+		uv_buf_t send_buffers[1] = { buffer };
+		int send_result = uv_udp_send(req, &m_socket, send_buffers, 1, (const sockaddr *)&addr, OnPooledSendComplete);
+		if (send_result < 0) {
+			std::cerr << "uv_udp_send() failed: " << uv_strerror(send_result) << std::endl;
+			ctx->pool->release(ctx);
+		}
+		return;
+	}
+
+	m_send_batch.push_back(BatchedSend{ req, buffer, addr, ctx });
+	if (m_send_batch.size() >= MAX_SEND_BATCH) {
+		FlushSendBatch();
+	}
+}
+
+void EQ::Net::DaybreakConnectionManager::FlushSendBatch()
+{
+	if (m_send_batch.empty()) {
+		return;
+	}
+
+	size_t sent_total = 0;
+
+#ifdef EQEMU_DAYBREAK_BATCHED_IO
+	uv_os_fd_t fd;
+	if (uv_fileno((const uv_handle_t *)&m_socket, &fd) == 0) {
+		mmsghdr messages[MAX_SEND_BATCH];
+		iovec   iovecs[MAX_SEND_BATCH];
+
+		while (sent_total < m_send_batch.size()) {
+			size_t count = std::min(m_send_batch.size() - sent_total, MAX_SEND_BATCH);
+			for (size_t i = 0; i < count; ++i) {
+				auto &e = m_send_batch[sent_total + i];
+				iovecs[i].iov_base = e.buffer.base;
+				iovecs[i].iov_len  = e.buffer.len;
+
+				memset(&messages[i], 0, sizeof(mmsghdr));
+				messages[i].msg_hdr.msg_name    = &e.addr;
+				messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+				messages[i].msg_hdr.msg_iov     = &iovecs[i];
+				messages[i].msg_hdr.msg_iovlen  = 1;
+			}
+
+			int sent = sendmmsg(fd, messages, (unsigned int)count, 0);
+			if (sent < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+
+				// EAGAIN and friends, let libuv queue the rest until the socket is writable
+				break;
+			}
+
+			// the kernel has its own copy now
+			for (int i = 0; i < sent; ++i) {
+				auto *ctx = m_send_batch[sent_total + i].ctx;
+				ctx->pool->release(ctx);
+			}
+
+			sent_total += sent;
+			if ((size_t)sent < count) {
+				break;
+			}
+		}
+	}
+#endif
+
+	for (size_t i = sent_total; i < m_send_batch.size(); ++i) {
+		auto &e = m_send_batch[i];
+		uv_buf_t send_buffers[1] = { e.buffer };
+		int send_result = uv_udp_send(e.req, &m_socket, send_buffers, 1, (const sockaddr *)&e.addr, OnPooledSendComplete);
+		if (send_result < 0) {
+			std::cerr << "uv_udp_send() failed: " << uv_strerror(send_result) << std::endl;
+			e.ctx->pool->release(e.ctx);
+		}
+	}
+
+	m_send_batch.clear();
+}
+
 void EQ::Net::DaybreakConnectionManager::Connect(const std::string &addr, int port)
 {
 	//todo dns resolution
@@ -110,22 +264,18 @@ void EQ::Net::DaybreakConnectionManager::Connect(const std::string &addr, int po
 		m_on_new_connection(connection);
 	}
 
-	m_connections.emplace(std::make_pair(std::make_pair(addr, port), connection));
+	m_connections.Insert(
+		DaybreakEndpointKey(connection->m_send_addr.sin_addr.s_addr, connection->m_send_addr.sin_port),
+		connection
+	);
 }
 
 void EQ::Net::DaybreakConnectionManager::Process()
 {
 	auto now = Clock::now();
-	auto iter = m_connections.begin();
-	
-	// Debug: Log connection processing
-	static int mgr_process_count = 0;
-	if (++mgr_process_count % 300 == 0 && !m_connections.empty()) {
-		//printf("[DaybreakConnectionManager::Process] Processing %zu connections\n", m_connections.size());
-	}
-	
-	while (iter != m_connections.end()) {
-		auto connection = iter->second;
+
+	m_connections.ForEach([&](uint64_t key, std::shared_ptr<DaybreakConnection> &c) {
+		auto connection = c;
 		auto status = connection->m_status;
 
 		if (status == StatusDisconnecting) {
@@ -134,25 +284,22 @@ void EQ::Net::DaybreakConnectionManager::Process()
 				connection->FlushBuffer();
 				connection->SendDisconnect();
 				connection->ChangeStatus(StatusDisconnected);
-				iter = m_connections.erase(iter);
-				continue;
+				return false;
 			}
 		}
 
 		if (status == StatusConnecting) {
 			auto time_since_last_recv = std::chrono::duration_cast<std::chrono::milliseconds>(now - connection->m_last_recv);
 			if ((size_t)time_since_last_recv.count() > m_options.connect_stale_ms) {
-				iter = m_connections.erase(iter);
 				connection->ChangeStatus(StatusDisconnecting);
-				continue;
+				return false;
 			}
 		}
 		else if (status == StatusConnected) {
 			auto time_since_last_recv = std::chrono::duration_cast<std::chrono::milliseconds>(now - connection->m_last_recv);
 			if ((size_t)time_since_last_recv.count() > m_options.stale_connection_ms) {
-				iter = m_connections.erase(iter);
 				connection->ChangeStatus(StatusDisconnecting);
-				continue;
+				return false;
 			}
 		}
 
@@ -180,8 +327,8 @@ void EQ::Net::DaybreakConnectionManager::Process()
 				break;
 		}
 
-		iter++;
-	}
+		return true;
+	});
 }
 
 void EQ::Net::DaybreakConnectionManager::UpdateDataBudget()
@@ -194,20 +341,15 @@ void EQ::Net::DaybreakConnectionManager::UpdateDataBudget()
 	auto update_rate = (uint64_t)(1000.0 / m_options.tic_rate_hertz);
 	auto budget_add = update_rate * outgoing_data_rate / 1000.0;
 
-	auto iter = m_connections.begin();
-	while (iter != m_connections.end()) {
-		auto &connection = iter->second;
+	m_connections.ForEach([&](uint64_t key, std::shared_ptr<DaybreakConnection> &connection) {
 		connection->UpdateDataBudget(budget_add);
-
-		iter++;
-	}
+		return true;
+	});
 }
 
 void EQ::Net::DaybreakConnectionManager::ProcessResend()
 {
-	auto iter = m_connections.begin();
-	while (iter != m_connections.end()) {
-		auto &connection = iter->second;
+	m_connections.ForEach([&](uint64_t key, std::shared_ptr<DaybreakConnection> &connection) {
 		auto status = connection->m_status;
 
 		switch (status)
@@ -220,14 +362,12 @@ void EQ::Net::DaybreakConnectionManager::ProcessResend()
 				break;
 		}
 
-		iter++;
-	}
+		return true;
+	});
 }
 
-void EQ::Net::DaybreakConnectionManager::ProcessPacket(const std::string &endpoint, int port, const char *data, size_t size)
+void EQ::Net::DaybreakConnectionManager::ProcessPacket(const sockaddr_in &addr, const char *data, size_t size)
 {
-	//printf("[DaybreakConnectionManager::ProcessPacket] Received packet from %s:%d, size=%zu\n", endpoint.c_str(), port, size);
-
 	if (m_options.simulated_in_packet_loss && m_options.simulated_in_packet_loss >= m_rand.Int(0, 100)) {
 		return;
 	}
@@ -240,7 +380,8 @@ void EQ::Net::DaybreakConnectionManager::ProcessPacket(const std::string &endpoi
 	}
 
 	try {
-		auto connection = FindConnectionByEndpoint(endpoint, port);
+		auto key = DaybreakEndpointKey(addr.sin_addr.s_addr, addr.sin_port);
+		auto connection = FindConnectionByEndpoint(key);
 		if (connection) {
 			StaticPacket p((void*)data, size);
 			connection->ProcessPacket(p);
@@ -250,17 +391,21 @@ void EQ::Net::DaybreakConnectionManager::ProcessPacket(const std::string &endpoi
 				StaticPacket p((void*)data, size);
 				auto request = p.GetSerialize<DaybreakConnect>(0);
 
-				connection = std::shared_ptr<DaybreakConnection>(new DaybreakConnection(this, request, endpoint, port));
+				// the endpoint string is only built once, when the session is created
+				char endpoint[16];
+				uv_ip4_name(&addr, endpoint, 16);
+
+				connection = std::shared_ptr<DaybreakConnection>(new DaybreakConnection(this, request, endpoint, ntohs(addr.sin_port)));
 				connection->m_self = connection;
 
 				if (m_on_new_connection) {
 					m_on_new_connection(connection);
 				}
-				m_connections.emplace(std::make_pair(std::make_pair(endpoint, port), connection));
+				m_connections.Insert(key, connection);
 				connection->ProcessPacket(p);
 			}
 			else if (data[1] != OP_OutOfSession) {
-				SendDisconnect(endpoint, port);
+				SendDisconnect(addr);
 			}
 		}
 	}
@@ -271,18 +416,17 @@ void EQ::Net::DaybreakConnectionManager::ProcessPacket(const std::string &endpoi
 	}
 }
 
-std::shared_ptr<EQ::Net::DaybreakConnection> EQ::Net::DaybreakConnectionManager::FindConnectionByEndpoint(std::string addr, int port)
+std::shared_ptr<EQ::Net::DaybreakConnection> EQ::Net::DaybreakConnectionManager::FindConnectionByEndpoint(uint64_t key)
 {
-	auto p = std::make_pair(addr, port);
-	auto iter = m_connections.find(p);
-	if (iter != m_connections.end()) {
-		return iter->second;
+	auto connection = m_connections.Find(key);
+	if (connection) {
+		return *connection;
 	}
 
 	return nullptr;
 }
 
-void EQ::Net::DaybreakConnectionManager::SendDisconnect(const std::string &addr, int port)
+void EQ::Net::DaybreakConnectionManager::SendDisconnect(const sockaddr_in &addr)
 {
 	DaybreakDisconnect header;
 	header.zero = 0;
@@ -293,15 +437,13 @@ void EQ::Net::DaybreakConnectionManager::SendDisconnect(const std::string &addr,
 	out.PutSerialize(0, header);
 
 	uv_udp_send_t *send_req = new uv_udp_send_t;
-	sockaddr_in send_addr;
-	uv_ip4_addr(addr.c_str(), port, &send_addr);
 	uv_buf_t send_buffers[1];
 
 	char *data = new char[out.Length()];
 	memcpy(data, out.Data(), out.Length());
 	send_buffers[0] = uv_buf_init(data, out.Length());
 	send_req->data = send_buffers[0].base;
-	int ret = uv_udp_send(send_req, &m_socket, send_buffers, 1, (sockaddr*)&send_addr,
+	int ret = uv_udp_send(send_req, &m_socket, send_buffers, 1, (const sockaddr*)&addr,
 		[](uv_udp_send_t* req, int status) {
 		delete[](char*)req->data;
 		delete req;
@@ -317,6 +459,7 @@ EQ::Net::DaybreakConnection::DaybreakConnection(DaybreakConnectionManager *owner
 	m_status = StatusConnected;
 	m_endpoint = endpoint;
 	m_port = port;
+	uv_ip4_addr(m_endpoint.c_str(), m_port, &m_send_addr);
 	m_connect_code = NetworkToHost(connect.connect_code);
 	m_encode_key = m_owner->m_rand.Int(std::numeric_limits<uint32_t>::min(), std::numeric_limits<uint32_t>::max());
 	m_max_packet_size = (uint32_t)std::min(owner->m_options.max_packet_size, (size_t)NetworkToHost(connect.max_packet_size));
@@ -344,6 +487,7 @@ EQ::Net::DaybreakConnection::DaybreakConnection(DaybreakConnectionManager *owner
 	m_status = StatusConnecting;
 	m_endpoint = endpoint;
 	m_port = port;
+	uv_ip4_addr(m_endpoint.c_str(), m_port, &m_send_addr);
 	m_connect_code = m_owner->m_rand.Int(std::numeric_limits<uint32_t>::min(), std::numeric_limits<uint32_t>::max());
 	m_encode_key = 0;
 	m_max_packet_size = (uint32_t)owner->m_options.max_packet_size;
@@ -529,61 +673,37 @@ void EQ::Net::DaybreakConnection::ProcessQueue()
 {
 	for (int i = 0; i < 4; ++i) {
 		auto stream = &m_streams[i];
-		if (!stream->packet_queue.empty()) {
-			//printf("[DaybreakConnection::ProcessQueue] Stream %d: checking queue (size=%zu), looking for seq=%u\n", 
-			//	i, stream->packet_queue.size(), stream->sequence_in);
-			// Print first few queued sequences for debugging
-			int count = 0;
-			for (auto& kv : stream->packet_queue) {
-				if (count++ < 5) {
-					//printf("  - Queued seq: %u\n", kv.first);
-				}
-			}
-		}
-		for (;;) {
-
-			auto iter = stream->packet_queue.find(stream->sequence_in);
-			if (iter == stream->packet_queue.end()) {
+		while (!stream->packet_queue.Empty()) {
+			auto packet = stream->packet_queue.Find(stream->sequence_in);
+			if (!packet) {
 				break;
 			}
 
-			//printf("[DaybreakConnection::ProcessQueue] Found queued packet seq=%u, processing\n", stream->sequence_in);
-			auto packet = iter->second;
-			stream->packet_queue.erase(iter);
-			ProcessDecodedPacket(*packet);
-			delete packet;
+			// processing can queue more packets and grow the window, so work on a copy that owns its own buffer
+			stream->queue_scratch.Clear();
+			stream->queue_scratch.PutPacket(0, *packet);
+			stream->packet_queue.Erase(stream->sequence_in);
+			ProcessDecodedPacket(stream->queue_scratch);
 		}
 	}
 }
 
 void EQ::Net::DaybreakConnection::RemoveFromQueue(int stream, uint16_t seq)
 {
-	auto s = &m_streams[stream];
-	auto iter = s->packet_queue.find(seq);
-	if (iter != s->packet_queue.end()) {
-		//printf("[DaybreakConnection::RemoveFromQueue] Removing packet seq=%u from stream %d queue\n", seq, stream);
-		auto packet = iter->second;
-		s->packet_queue.erase(iter);
-		delete packet;
-	} else {
-		//printf("[DaybreakConnection::RemoveFromQueue] Packet seq=%u NOT found in stream %d queue\n", seq, stream);
-	}
+	m_streams[stream].packet_queue.Erase(seq);
 }
 
 void EQ::Net::DaybreakConnection::AddToQueue(int stream, uint16_t seq, const Packet &p)
 {
 	auto s = &m_streams[stream];
-	auto iter = s->packet_queue.find(seq);
-	if (iter == s->packet_queue.end()) {
-		DynamicPacket *out = new DynamicPacket();
-		out->PutPacket(0, p);
-
-		s->packet_queue.emplace(std::make_pair(seq, out));
-		//printf("[DaybreakConnection::AddToQueue] Added packet seq=%u to stream %d queue (queue_size=%zu)\n", 
-		//	seq, stream, s->packet_queue.size());
-	} else {
-		//printf("[DaybreakConnection::AddToQueue] Packet seq=%u already in stream %d queue, ignoring\n", seq, stream);
+	if (s->packet_queue.Find(seq)) {
+		return;
 	}
+
+	// slot storage is reused, this only allocates when the payload outgrows the previous occupant
+	auto &out = s->packet_queue.Emplace(seq);
+	out.Clear();
+	out.PutPacket(0, p);
 }
 
 void EQ::Net::DaybreakConnection::ProcessDecodedPacket(const Packet &p)
@@ -1229,7 +1349,7 @@ void EQ::Net::DaybreakConnection::ProcessResend(int stream)
 		return;
 	}
 
-	if (m_streams[stream].sent_packets.empty()) {
+	if (m_streams[stream].sent_packets.Empty()) {
 		return;
 	}
 
@@ -1240,9 +1360,9 @@ void EQ::Net::DaybreakConnection::ProcessResend(int stream)
 	auto s = &m_streams[stream];
 
 	// Get a reference resend delay (assume first packet represents the typical case)
-	if (!s->sent_packets.empty()) {
+	if (!s->sent_packets.Empty()) {
 		// Check if the first packet has timed out
-		auto &first_packet = s->sent_packets.begin()->second;
+		auto &first_packet = *s->sent_packets.Find(s->sent_packets.Head());
 		auto time_since_first_sent = std::chrono::duration_cast<std::chrono::milliseconds>(now - first_packet.first_sent).count();
 
 		if (time_since_first_sent >= m_owner->m_options.resend_timeout) {
@@ -1277,7 +1397,7 @@ void EQ::Net::DaybreakConnection::ProcessResend(int stream)
 				"Not resending packets for m_endpoint [{}] m_port [{}] packets [{}] time_first_sent [{}] resend_delay [{}] m_acked_since_last_resend [{}]",
 				m_endpoint,
 				m_port,
-				s->sent_packets.size(),
+				s->sent_packets.Size(),
 				time_since_first_sent,
 				first_packet.resend_delay,
 				m_acked_since_last_resend
@@ -1288,21 +1408,29 @@ void EQ::Net::DaybreakConnection::ProcessResend(int stream)
 
 	if (LogSys.IsLogEnabled(Logs::General, Logs::NetClient)) {
 		size_t    total_size = 0;
-		for (auto &e: s->sent_packets) {
-			total_size += e.second.packet.Length();
-		}
+		s->sent_packets.ForEach(
+			[&](uint16_t seq, DaybreakSentPacket &sp) {
+				total_size += sp.packet.Length();
+			}
+		);
 
 		LogNetClientDetail(
 			"Resending packets for m_endpoint [{}] m_port [{}] packet count [{}] total packet size [{}] m_acked_since_last_resend [{}]",
 			m_endpoint,
 			m_port,
-			s->sent_packets.size(),
+			s->sent_packets.Size(),
 			total_size,
 			m_acked_since_last_resend
 		);
 	}
 
-	for (auto &e: s->sent_packets) {
+	// walk the window oldest first, Head() and Tail() bound every unacked sequence
+	for (uint16_t seq = s->sent_packets.Head(); seq != s->sent_packets.Tail(); ++seq) {
+		auto sent = s->sent_packets.Find(seq);
+		if (!sent) {
+			continue;
+		}
+
 		if (m_resend_packets_sent >= MAX_CLIENT_RECV_PACKETS_PER_WINDOW ||
 			m_resend_bytes_sent >= MAX_CLIENT_RECV_BYTES_PER_WINDOW) {
 			LogNetClient(
@@ -1311,14 +1439,14 @@ void EQ::Net::DaybreakConnection::ProcessResend(int stream)
 				m_port,
 				m_resend_packets_sent,
 				MAX_CLIENT_RECV_PACKETS_PER_WINDOW,
-				s->sent_packets.size(),
+				s->sent_packets.Size(),
 				m_resend_bytes_sent,
 				MAX_CLIENT_RECV_BYTES_PER_WINDOW
 			);
 			break;
 		}
 
-		auto &sp = e.second;
+		auto &sp = *sent;
 		auto &p  = sp.packet;
 		if (p.Length() >= DaybreakHeader::size()) {
 			if (p.GetInt8(0) == 0 && p.GetInt8(1) >= OP_Fragment && p.GetInt8(1) <= OP_Fragment4) {
@@ -1355,23 +1483,16 @@ void EQ::Net::DaybreakConnection::Ack(int stream, uint16_t seq)
 {
 	auto now = Clock::now();
 	auto s = &m_streams[stream];
-	auto iter = s->sent_packets.begin();
-	while (iter != s->sent_packets.end()) {
-		auto order = CompareSequence(seq, iter->first);
-
-		if (order != SequenceFuture) {
-			uint64_t round_time = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - iter->second.last_sent).count();
 
-			m_stats.max_ping = std::max(m_stats.max_ping, round_time);
-			m_stats.min_ping = std::min(m_stats.min_ping, round_time);
-			m_stats.last_ping = round_time;
-			m_rolling_ping = (m_rolling_ping * 2 + round_time) / 3;
-
-			iter = s->sent_packets.erase(iter);
-		}
-		else {
-			++iter;
+	// sent packets are held in sequence order so everything acked is at the front of the window
+	while (!s->sent_packets.Empty()) {
+		auto head = s->sent_packets.Head();
+		if (CompareSequence(seq, head) == SequenceFuture) {
+			break;
 		}
+
+		RecordRoundTrip(*s->sent_packets.Find(head), now);
+		s->sent_packets.Erase(head);
 	}
 
 	m_acked_since_last_resend = true;
@@ -1382,22 +1503,26 @@ void EQ::Net::DaybreakConnection::OutOfOrderAck(int stream, uint16_t seq)
 {
 	auto now = Clock::now();
 	auto s = &m_streams[stream];
-	auto iter = s->sent_packets.find(seq);
-	if (iter != s->sent_packets.end()) {
-		uint64_t round_time = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - iter->second.last_sent).count();
-
-		m_stats.max_ping = std::max(m_stats.max_ping, round_time);
-		m_stats.min_ping = std::min(m_stats.min_ping, round_time);
-		m_stats.last_ping = round_time;
-		m_rolling_ping = (m_rolling_ping * 2 + round_time) / 3;
-
-		s->sent_packets.erase(iter);
+	auto sent = s->sent_packets.Find(seq);
+	if (sent) {
+		RecordRoundTrip(*sent, now);
+		s->sent_packets.Erase(seq);
 	}
 
 	m_acked_since_last_resend = true;
 	m_last_ack = now;
 }
 
+void EQ::Net::DaybreakConnection::RecordRoundTrip(const DaybreakSentPacket &sent, Timestamp now)
+{
+	uint64_t round_time = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - sent.last_sent).count();
+
+	m_stats.max_ping = std::max(m_stats.max_ping, round_time);
+	m_stats.min_ping = std::min(m_stats.min_ping, round_time);
+	m_stats.last_ping = round_time;
+	m_rolling_ping = (m_rolling_ping * 2 + round_time) / 3;
+}
+
 void EQ::Net::DaybreakConnection::UpdateDataBudget(double budget_add)
 {
 	auto outgoing_data_rate = m_owner->m_options.outgoing_data_rate;
@@ -1528,8 +1653,6 @@ void EQ::Net::DaybreakConnection::InternalSend(Packet &p) {
 	auto [send_req, data, ctx] = *pooled_opt;
 	ctx->pool = &send_buffer_pool; // set pool pointer
 
-	sockaddr_in send_addr{};
-	uv_ip4_addr(m_endpoint.c_str(), m_port, &send_addr);
 	uv_buf_t send_buffers[1];
 
 	if (PacketCanBeEncoded(p)) {
@@ -1595,27 +1718,7 @@ void EQ::Net::DaybreakConnection::InternalSend(Packet &p) {
 		return;
 	}
 
-	int send_result = uv_udp_send(
-		send_req, &m_owner->m_socket, send_buffers, 1, (sockaddr *)&send_addr,
-		[](uv_udp_send_t *req, int status) {
-			auto *ctx = reinterpret_cast<EmbeddedContext *>(req->data);
-			if (!ctx) {
-				std::cerr << "Error: send_req->data is null in callback!" << std::endl;
-				return;
-			}
-
-			if (status < 0) {
-				std::cerr << "uv_udp_send failed: " << uv_strerror(status) << std::endl;
-			}
-
-			ctx->pool->release(ctx);
-		}
-	);
-
-	if (send_result < 0) {
-		std::cerr << "uv_udp_send() failed: " << uv_strerror(send_result) << std::endl;
-		send_buffer_pool.release(ctx);
-	}
+	m_owner->QueueSend(send_req, send_buffers[0], m_send_addr, ctx);
 }
 
 void EQ::Net::DaybreakConnection::InternalQueuePacket(Packet &p, int stream_id, bool reliable)
@@ -1648,16 +1751,7 @@ void EQ::Net::DaybreakConnection::InternalQueuePacket(Packet &p, int stream_id,
 		first_packet.PutData(DaybreakReliableFragmentHeader::size(), (char*)p.Data() + used, sublen);
 		used += sublen;
 
-		DaybreakSentPacket sent;
-		sent.packet.PutPacket(0, first_packet);
-		sent.last_sent = Clock::now();
-		sent.first_sent = Clock::now();
-		sent.times_resent = 0;
-		sent.resend_delay = EQ::Clamp(
-			static_cast<size_t>((m_rolling_ping * m_owner->m_options.resend_delay_factor) + m_owner->m_options.resend_delay_ms),
-			m_owner->m_options.resend_delay_min,
-			m_owner->m_options.resend_delay_max);
-		stream->sent_packets.emplace(std::make_pair(stream->sequence_out, sent));
+		TrackSentPacket(stream, first_packet);
 		stream->sequence_out++;
 
 		InternalBufferedSend(first_packet);
@@ -1680,16 +1774,7 @@ void EQ::Net::DaybreakConnection::InternalQueuePacket(Packet &p, int stream_id,
 				used += left;
 			}
 
-			DaybreakSentPacket sent;
-			sent.packet.PutPacket(0, packet);
-			sent.last_sent = Clock::now();
-			sent.first_sent = Clock::now();
-			sent.times_resent = 0;
-			sent.resend_delay = EQ::Clamp(
-				static_cast<size_t>((m_rolling_ping * m_owner->m_options.resend_delay_factor) + m_owner->m_options.resend_delay_ms),
-				m_owner->m_options.resend_delay_min,
-				m_owner->m_options.resend_delay_max);
-			stream->sent_packets.emplace(std::make_pair(stream->sequence_out, sent));
+			TrackSentPacket(stream, packet);
 			stream->sequence_out++;
 
 			InternalBufferedSend(packet);
@@ -1704,22 +1789,27 @@ void EQ::Net::DaybreakConnection::InternalQueuePacket(Packet &p, int stream_id,
 		packet.PutSerialize(0, header);
 		packet.PutPacket(DaybreakReliableHeader::size(), p);
 
-		DaybreakSentPacket sent;
-		sent.packet.PutPacket(0, packet);
-		sent.last_sent = Clock::now();
-		sent.first_sent = Clock::now();
-		sent.times_resent = 0;
-		sent.resend_delay = EQ::Clamp(
-			static_cast<size_t>((m_rolling_ping * m_owner->m_options.resend_delay_factor) + m_owner->m_options.resend_delay_ms),
-			m_owner->m_options.resend_delay_min,
-			m_owner->m_options.resend_delay_max);
-		stream->sent_packets.emplace(std::make_pair(stream->sequence_out, sent));
+		TrackSentPacket(stream, packet);
 		stream->sequence_out++;
 
 		InternalBufferedSend(packet);
 	}
 }
 
+void EQ::Net::DaybreakConnection::TrackSentPacket(DaybreakStream *stream, const Packet &p)
+{
+	auto &sent = stream->sent_packets.Emplace(stream->sequence_out);
+	sent.packet.Clear();
+	sent.packet.PutPacket(0, p);
+	sent.last_sent = Clock::now();
+	sent.first_sent = sent.last_sent;
+	sent.times_resent = 0;
+	sent.resend_delay = EQ::Clamp(
+		static_cast<size_t>((m_rolling_ping * m_owner->m_options.resend_delay_factor) + m_owner->m_options.resend_delay_ms),
+		m_owner->m_options.resend_delay_min,
+		m_owner->m_options.resend_delay_max);
+}
+
 void EQ::Net::DaybreakConnection::FlushBuffer()
 {
 	// //printf("[DaybreakConnection::FlushBuffer] Called, buffer has %zu packets\n", m_buffered_packets.size());
@@ -4,6 +4,8 @@
 #include "packet.h"
 #include "daybreak_structs.h"
 #include "daybreak_pooling.h"
+#include "daybreak_endpoint_map.h"
+#include "daybreak_sequence_window.h"
 #include <uv.h>
 #include <chrono>
 #include <functional>
@@ -11,6 +13,12 @@
 #include <map>
 #include <queue>
 #include <list>
+#include <vector>
+
+// batched send/receive relies on sendmmsg/recvmmsg which are linux only
+#if defined(__linux__)
+#define EQEMU_DAYBREAK_BATCHED_IO
+#endif
 
 namespace EQ
 {
@@ -163,6 +171,7 @@ namespace EQ
 			DaybreakConnectionManager *m_owner;
 			std::string m_endpoint;
 			int m_port;
+			sockaddr_in m_send_addr;
 			uint32_t m_connect_code;
 			uint32_t m_encode_key;
 			uint32_t m_max_packet_size;
@@ -208,13 +217,17 @@ namespace EQ
 
 				uint16_t sequence_in;
 				uint16_t sequence_out;
-				std::map<uint16_t, Packet*> packet_queue;
+
+				// future packets waiting on sequence_in, queue_scratch holds the one being processed
+				DaybreakSequenceWindow<DynamicPacket> packet_queue{ 16 };
+				DynamicPacket queue_scratch;
 
 				DynamicPacket fragment_packet;
 				uint32_t fragment_current_bytes;
 				uint32_t fragment_total_bytes;
 
-				std::map<uint16_t, DaybreakSentPacket> sent_packets;
+				// unacked packets, oldest first
+				DaybreakSequenceWindow<DaybreakSentPacket> sent_packets{ 32 };
 			};
 
 			DaybreakStream m_streams[4];
@@ -225,6 +238,8 @@ namespace EQ
 			void ProcessQueue();
 			void RemoveFromQueue(int stream, uint16_t seq);
 			void AddToQueue(int stream, uint16_t seq, const Packet &p);
+			void TrackSentPacket(DaybreakStream *stream, const Packet &p);
+			void RecordRoundTrip(const DaybreakSentPacket &sent, Timestamp now);
 			void ProcessDecodedPacket(const Packet &p);
 			void ChangeStatus(DbProtocolStatus new_status);
 			bool ValidateCRC(Packet &p);
@@ -279,6 +294,7 @@ namespace EQ
 				resend_timeout = 30000;
 				connection_close_time = 2000;
 				outgoing_data_rate = 0.0;
+				batched_io = false;
 			}
 
 			size_t max_packet_size;
@@ -302,6 +318,7 @@ namespace EQ
 			DaybreakEncodeType encode_passes[2];
 			int port;
 			double outgoing_data_rate;
+			bool batched_io; // collect outgoing datagrams and flush them with sendmmsg, drain the socket with recvmmsg (linux only)
 		};
 
 		class DaybreakConnectionManager
@@ -321,24 +338,40 @@ namespace EQ
 			void OnErrorMessage(std::function<void(const std::string&)> func) { m_on_error_message = func; }
 
 			DaybreakConnectionManagerOptions& GetOptions() { return m_options; }
+			bool IsBatchedIO() const { return m_batched_io; }
 		private:
 			void Attach(uv_loop_t *loop);
 			void Detach();
 
+			struct BatchedSend
+			{
+				uv_udp_send_t *req;
+				uv_buf_t buffer;
+				sockaddr_in addr;
+				EmbeddedContext *ctx;
+			};
+
+			void QueueSend(uv_udp_send_t *req, const uv_buf_t &buffer, const sockaddr_in &addr, EmbeddedContext *ctx);
+			void FlushSendBatch();
+
 			EQ::Random m_rand;
 			uv_timer_t m_timer;
 			uv_udp_t m_socket;
+			uv_check_t m_flush_check;
 			uv_loop_t *m_attached;
+			bool m_batched_io;
+			std::vector<BatchedSend> m_send_batch;
+			std::unique_ptr<char[]> m_recv_batch_buffer;
 			DaybreakConnectionManagerOptions m_options;
 			std::function<void(std::shared_ptr<DaybreakConnection>)> m_on_new_connection;
 			std::function<void(std::shared_ptr<DaybreakConnection>, DbProtocolStatus, DbProtocolStatus)> m_on_connection_state_change;
 			std::function<void(std::shared_ptr<DaybreakConnection>, const Packet&)> m_on_packet_recv;
 			std::function<void(const std::string&)> m_on_error_message;
-			std::map<std::pair<std::string, int>, std::shared_ptr<DaybreakConnection>> m_connections;
+			DaybreakEndpointMap<std::shared_ptr<DaybreakConnection>> m_connections;
 
-			void ProcessPacket(const std::string &endpoint, int port, const char *data, size_t size);
-			std::shared_ptr<DaybreakConnection> FindConnectionByEndpoint(std::string addr, int port);
-			void SendDisconnect(const std::string &addr, int port);
+			void ProcessPacket(const sockaddr_in &addr, const char *data, size_t size);
+			std::shared_ptr<DaybreakConnection> FindConnectionByEndpoint(uint64_t key);
+			void SendDisconnect(const sockaddr_in &addr);
 
 			friend class DaybreakConnection;
 		};
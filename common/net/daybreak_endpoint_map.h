@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace EQ
+{
+	namespace Net
+	{
+		// IPv4 address (network byte order) and port packed into a single key
+		inline uint64_t DaybreakEndpointKey(uint32_t addr, uint16_t port)
+		{
+			return (static_cast<uint64_t>(addr) << 16) | static_cast<uint64_t>(port);
+		}
+
+		/*
+			Open addressing (linear probing) hash table keyed by DaybreakEndpointKey.
+
+			Erase leaves a tombstone rather than shifting entries so it is safe to erase while
+			walking the table with ForEach, tombstones are dropped the next time the table grows
+			or is rebuilt.
+		*/
+		template<typename T>
+		class DaybreakEndpointMap
+		{
+		public:
+			DaybreakEndpointMap() { Rebuild(16); }
+
+			T* Find(uint64_t key)
+			{
+				size_t mask = m_slots.size() - 1;
+				for (size_t i = Hash(key) & mask;; i = (i + 1) & mask) {
+					auto &s = m_slots[i];
+					if (s.state == SlotEmpty) {
+						return nullptr;
+					}
+
+					if (s.state == SlotUsed && s.key == key) {
+						return &s.value;
+					}
+				}
+			}
+
+			// inserts or replaces
+			void Insert(uint64_t key, const T &value)
+			{
+				if ((m_used + m_tombstones + 1) * 2 > m_slots.size()) {
+					Rebuild(m_used * 4 > m_slots.size() ? m_slots.size() * 2 : m_slots.size());
+				}
+
+				size_t mask      = m_slots.size() - 1;
+				Slot   *reusable = nullptr;
+				for (size_t i = Hash(key) & mask;; i = (i + 1) & mask) {
+					auto &s = m_slots[i];
+					if (s.state == SlotUsed && s.key == key) {
+						s.value = value;
+						return;
+					}
+
+					if (s.state == SlotTombstone && !reusable) {
+						reusable = &s;
+					}
+
+					if (s.state == SlotEmpty) {
+						if (reusable) {
+							m_tombstones--;
+						}
+						else {
+							reusable = &s;
+						}
+
+						reusable->key   = key;
+						reusable->value = value;
+						reusable->state = SlotUsed;
+						m_used++;
+						return;
+					}
+				}
+			}
+
+			bool Erase(uint64_t key)
+			{
+				size_t mask = m_slots.size() - 1;
+				for (size_t i = Hash(key) & mask;; i = (i + 1) & mask) {
+					auto &s = m_slots[i];
+					if (s.state == SlotEmpty) {
+						return false;
+					}
+
+					if (s.state == SlotUsed && s.key == key) {
+						EraseSlot(s);
+						return true;
+					}
+				}
+			}
+
+			// fn(key, value) returns false to erase the entry, value must not be used after an insert from within fn
+			template<typename Fn>
+			void ForEach(Fn fn)
+			{
+				for (size_t i = 0; i < m_slots.size(); ++i) {
+					auto &s = m_slots[i];
+					if (s.state != SlotUsed) {
+						continue;
+					}
+
+					uint64_t key        = s.key;
+					size_t   generation = m_generation;
+					if (fn(key, s.value)) {
+						continue;
+					}
+
+					// an insert during fn may have rebuilt the table underneath us
+					if (generation == m_generation) {
+						EraseSlot(m_slots[i]);
+					}
+					else {
+						Erase(key);
+					}
+				}
+			}
+
+			size_t Size() const { return m_used; }
+			bool Empty() const { return m_used == 0; }
+
+		private:
+			enum SlotState : uint8_t
+			{
+				SlotEmpty,
+				SlotUsed,
+				SlotTombstone
+			};
+
+			struct Slot
+			{
+				uint64_t key = 0;
+				T value{};
+				SlotState state = SlotEmpty;
+			};
+
+			static size_t Hash(uint64_t key)
+			{
+				// splitmix64 finalizer, the low bits of address/port pairs are far from uniform
+				key ^= key >> 30;
+				key *= 0xbf58476d1ce4e5b9ULL;
+				key ^= key >> 27;
+				key *= 0x94d049bb133111ebULL;
+				key ^= key >> 31;
+				return static_cast<size_t>(key);
+			}
+
+			void EraseSlot(Slot &s)
+			{
+				s.value = T{};
+				s.state = SlotTombstone;
+				m_used--;
+				m_tombstones++;
+			}
+
+			void Rebuild(size_t capacity)
+			{
+				std::vector<Slot> old;
+				old.swap(m_slots);
+				m_slots.resize(capacity);
+				m_generation++;
+				m_used       = 0;
+				m_tombstones = 0;
+
+				size_t mask = capacity - 1;
+				for (auto &o : old) {
+					if (o.state != SlotUsed) {
+						continue;
+					}
+
+					size_t i = Hash(o.key) & mask;
+					while (m_slots[i].state != SlotEmpty) {
+						i = (i + 1) & mask;
+					}
+
+					m_slots[i].key   = o.key;
+					m_slots[i].value = std::move(o.value);
+					m_slots[i].state = SlotUsed;
+					m_used++;
+				}
+			}
+
+			std::vector<Slot> m_slots;
+			size_t m_used = 0;
+			size_t m_tombstones = 0;
+			size_t m_generation = 0;
+		};
+	}
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace EQ
+{
+	namespace Net
+	{
+		/*
+			Ring buffer of T indexed by a 16 bit reliable sequence modulo the buffer size.
+
+			Used for the per stream send (unacked) and receive (out of order) queues. Slots are
+			reused in place, so once the ring has warmed up storing a packet does not allocate
+			unless the payload is larger than anything previously stored in that slot.
+
+			Live entries are tracked as the range [Head(), Tail()) in sequence order, the ring
+			doubles when an entry falls outside of what the current size can address.
+		*/
+		template<typename T>
+		class DaybreakSequenceWindow
+		{
+		public:
+			static constexpr size_t MaxCapacity = 32768;
+
+			explicit DaybreakSequenceWindow(size_t initial_capacity = 256)
+			{
+				size_t capacity = 1;
+				while (capacity < initial_capacity) {
+					capacity <<= 1;
+				}
+
+				m_slots.resize(capacity);
+			}
+
+			bool Empty() const { return m_count == 0; }
+			size_t Size() const { return m_count; }
+			size_t Capacity() const { return m_slots.size(); }
+
+			// oldest live sequence and one past the newest, only meaningful when not empty
+			uint16_t Head() const { return m_head; }
+			uint16_t Tail() const { return m_tail; }
+
+			T* Find(uint16_t seq)
+			{
+				auto &s = m_slots[seq & (m_slots.size() - 1)];
+				if (s.used && s.seq == seq) {
+					return &s.value;
+				}
+
+				return nullptr;
+			}
+
+			// returns the slot for seq, the previous contents are left in place for the caller to overwrite
+			T& Emplace(uint16_t seq)
+			{
+				if (m_count == 0) {
+					m_head = seq;
+					m_tail = static_cast<uint16_t>(seq + 1);
+				}
+				else {
+					if (Before(seq, m_head)) {
+						m_head = seq;
+					}
+
+					if (!Before(seq, m_tail)) {
+						m_tail = static_cast<uint16_t>(seq + 1);
+					}
+
+					while (Span() > m_slots.size() && m_slots.size() < MaxCapacity) {
+						Grow();
+					}
+				}
+
+				auto &s = m_slots[seq & (m_slots.size() - 1)];
+				if (s.used && s.seq != seq) {
+					// only reachable with MaxCapacity sequences in flight, the oldest one gives way
+					Erase(s.seq);
+					return Emplace(seq);
+				}
+
+				if (!s.used) {
+					s.used = true;
+					s.seq  = seq;
+					m_count++;
+				}
+
+				return s.value;
+			}
+
+			void Erase(uint16_t seq)
+			{
+				auto &s = m_slots[seq & (m_slots.size() - 1)];
+				if (!s.used || s.seq != seq) {
+					return;
+				}
+
+				s.used = false;
+				m_count--;
+
+				if (m_count == 0) {
+					m_head = m_tail;
+					return;
+				}
+
+				// skip past anything already acked out of order
+				if (seq == m_head) {
+					while (!IsLive(m_head)) {
+						m_head++;
+					}
+				}
+
+				if (static_cast<uint16_t>(seq + 1) == m_tail) {
+					while (!IsLive(static_cast<uint16_t>(m_tail - 1))) {
+						m_tail--;
+					}
+				}
+			}
+
+			// fn(seq, value) for every live entry, oldest first
+			template<typename Fn>
+			void ForEach(Fn fn)
+			{
+				if (m_count == 0) {
+					return;
+				}
+
+				for (uint16_t seq = m_head; seq != m_tail; ++seq) {
+					auto &s = m_slots[seq & (m_slots.size() - 1)];
+					if (s.used && s.seq == seq) {
+						fn(seq, s.value);
+					}
+				}
+			}
+
+			void Clear()
+			{
+				for (auto &s : m_slots) {
+					s.used = false;
+				}
+
+				m_count = 0;
+				m_head  = m_tail;
+			}
+
+		private:
+			struct Slot
+			{
+				T value{};
+				uint16_t seq = 0;
+				bool used = false;
+			};
+
+			// a is earlier than b in sequence order
+			static bool Before(uint16_t a, uint16_t b) { return static_cast<int16_t>(a - b) < 0; }
+
+			size_t Span() const { return static_cast<uint16_t>(m_tail - m_head) == 0 ? 65536 : static_cast<uint16_t>(m_tail - m_head); }
+
+			bool IsLive(uint16_t seq) const
+			{
+				auto &s = m_slots[seq & (m_slots.size() - 1)];
+				return s.used && s.seq == seq;
+			}
+
+			void Grow()
+			{
+				std::vector<Slot> old;
+				old.swap(m_slots);
+				m_slots.resize(old.size() * 2);
+
+				for (auto &o : old) {
+					if (!o.used) {
+						continue;
+					}
+
+					auto &s = m_slots[o.seq & (m_slots.size() - 1)];
+					s.value = std::move(o.value);
+					s.seq   = o.seq;
+					s.used  = true;
+				}
+			}
+
+			std::vector<Slot> m_slots;
+			size_t m_count = 0;
+			uint16_t m_head = 0;
+			uint16_t m_tail = 0;
+		};
+	}
+}
@@ -27,8 +27,15 @@
 	#include <sys/time.h>
 #endif
 
-#ifdef i386
+#if defined(i386) || defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
 	#define USE_RDTSC
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+#else
+	#include <chrono>
 #endif
 
 bool RDTSC_Timer::_inited = false;
@@ -57,34 +64,12 @@ RDTSC_Timer::RDTSC_Timer(bool start_it) {
 }
 
 int64 RDTSC_Timer::rdtsc() {
-	int64 res = 0;
 #ifdef USE_RDTSC
-#ifndef WIN64
-#ifdef WIN32
-	//untested!
-	unsigned long highw, loww;
-	__asm {
-		push eax
-		push edx
-		rdtsc
-		mov highw, eax
-		mov loww, edx
-		pop edx
-		pop eax
-	}
-	res = ((int64)highw)<<32 | loww;
+	return(static_cast<int64>(__rdtsc()));
 #else
-	//gnu version
-	__asm__ __volatile__ ("rdtsc" : "=A" (res));
-#endif
-#else
-	//fall back to get time of day
-	timeval t;
-	gettimeofday(&t, nullptr);
-	res = ((int64)t.tv_sec) * 1000 + t.tv_usec;
-#endif
+	//fall back to a monotonic clock in microseconds
+	return(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
 #endif
-	return(res);
 }
 
 void RDTSC_Timer::init() {
@@ -46,11 +46,13 @@ public:
 
 	//access functions
 	int64 getTicks() { return(_end - _start); }
-	static int64 ticksPerMS() { return(_ticsperms); }
+	static int64 ticksPerMS() { if(!_inited) init(); return(_ticsperms); }
 
-protected:
+	//raw counter, convert differences with ticksPerMS()
 	static int64 rdtsc();
 
+protected:
+
 	int64 _start;
 	int64 _end;
 
@@ -74,6 +74,7 @@ RULE_INT(Character, WhiteModifier, 100, "The experience obtained for white con m
 RULE_INT(Character, YellowModifier, 125, "The experience obtained for yellow con mobs is multiplied by value/100")
 RULE_INT(Character, RedModifier, 150, "The experience obtained for red con mobs is multiplied by value/100")
 RULE_INT(Character, AutosaveIntervalS, 300, "Number of seconds after which a timer is triggered which stores the character data. The value 0 means no periodic automatic saving.")
+RULE_BOOL(Character, WriteBehindSaves, true, "Write character data, currency, binds and buffs on a separate database connection and thread instead of stalling the zone. Read when the zone process starts")
 RULE_INT(Character, HPRegenMultiplier, 100, "The hitpoint regeneration is multiplied by value/100 (up to the caps)")
 RULE_INT(Character, ManaRegenMultiplier, 100, "The mana regeneration is multiplied by value/100 (up to the caps)")
 RULE_INT(Character, EnduranceRegenMultiplier, 100, "The endurance regeneration is multiplied by value/100 (up to the caps)")
@@ -239,6 +240,7 @@ RULE_INT(Character, SecondsBeforeIdleCombatZone, 600, "Seconds before a player i
 RULE_INT(Character, SecondsBeforeIdleNonCombatZone, 60, "Seconds before a player is considered idle in non-combat zones (60 = 1 minute)")
 RULE_INT(Character, SecondsBeforeAFKCombatZone, 1800, "Seconds before a player is considered AFK in combat zones (1800 = 30 minutes)")
 RULE_INT(Character, SecondsBeforeAFKNonCombatZone, 600, "Seconds before a player is considered AFK in non-combat zones (600 = 10 minutes)")
+RULE_BOOL(Character, VerifyBuffBonusCache, false, "Recompute item and AA bonuses on buff only recalculations and log any difference from the cached results, for testing the cache")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Mercs)
@@ -362,6 +364,7 @@ RULE_INT(Zone, ClientLinkdeadMS, 90000, "The time a client remains link dead on
 RULE_INT(Zone, GraveyardTimeMS, 1200000, "Time until a player corpse is moved to a zone's graveyard, if one is specified for the zone (milliseconds)")
 RULE_BOOL(Zone, EnableShadowrest, 1, "Enables or disables the Shadowrest zone feature for player corpses. Default is turned on")
 RULE_INT(Zone, AutoShutdownDelay, 60000, "How long a dynamic zone stays loaded while empty (milliseconds)")
+RULE_INT(Zone, BootThreads, 4, "Threads that load map files and content tables while a zone boots, each with its own content database connection. 0 loads everything on the zone thread")
 RULE_INT(Zone, PEQZoneReuseTime, 900, "Seconds between two uses of the #peqzone command (Set to 0 to disable)")
 RULE_INT(Zone, PEQZoneDebuff1, 4454, "First debuff casted by #peqzone Default is Cursed Keeper's Blight")
 RULE_INT(Zone, PEQZoneDebuff2, 2209, "Second debuff casted by #peqzone Default is Tendrils of Apathy")
@@ -402,6 +405,8 @@ RULE_INT(Map, FindBestZHeightAdjust, 1, "Adds this to the current Z before seeki
 RULE_BOOL(Map, CheckForDoorLoSCheat, true, "Runs LoS checks to prevent cheating through doors.")
 RULE_BOOL(Map, EnableLoSCheatExemptions, false, "Enables exemptions for the LoS Cheat check. Must modify source to create these.")
 RULE_REAL(Map, RangeCheckForDoorLoSCheat, 250.0, "Default 250.0. Range to check if a door is blocking LoS from the target.")
+RULE_BOOL(Map, UseBVHRaycast, false, "Use the SIMD BVH raycast backend for LoS, best Z and collision checks instead of the AABB tree. The .mmf cache is rebuilt when this changes")
+RULE_INT(Map, RecordRaycastQueries, 0, "Appends this many LoS and best Z queries per zone boot to maps/base/<zone>.raycast for replay with benchmark:raycast, 0 disables")
 RULE_STRING(Map, ZonesToCheckDoorCheat, "89,103", "Zones that will check for the door LoS cheat. You can leave it blank to disable, 'all' to check all zones or use a comma-delimited list of zones. Default Sebilis & Chardok")
 RULE_CATEGORY_END()
 
@@ -410,7 +415,10 @@ RULE_BOOL(Pathing, Find, true, "Enable pathing for FindPerson requests from the
 RULE_BOOL(Pathing, Fear, true, "Enable pathing for fear")
 RULE_REAL(Pathing, NavmeshStepSize, 100.0f, "Step size for the movement manager")
 RULE_REAL(Pathing, ShortMovementUpdateRange, 130.0f, "Range for short movement updates")
+RULE_INT(Pathing, MediumRangeResendInterval, 3, "Periodic position resends of a moving mob reach clients past ShortMovementUpdateRange only every Nth time, 1 sends them every resend")
 RULE_INT(Pathing, MaxNavmeshNodes, 4092, "Maximum navmesh nodes in a traversable path")
+RULE_INT(Pathing, RouteCacheSize, 1024, "Navmesh corridors kept per zone so mobs pathing between the same places share one search, 0 disables the cache")
+RULE_INT(Pathing, AsyncThreads, 2, "Worker threads for ground path searches, results are applied on the next movement tick. 0 searches on the zone thread. Read when the first path is requested")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Watermap)
@@ -706,6 +714,7 @@ RULE_BOOL(NPC, NPCIgnoreLevelBasedHasteCaps, false, "Ignores hard coded level ba
 RULE_INT(NPC, NPCHasteCap, 150, "Haste cap for non-v3(over haste) haste")
 RULE_INT(NPC, NPCHastev3Cap, 25, "Haste cap for v3(over haste) haste")
 RULE_STRING(NPC, ExcludedFaceTargetRaces, "52,72,73,141,233,328,329,372,376,377,378,379,380,381,382,383,404,422,423,424,425,426,428,429,445,449,460,462,463,500,501,502,503,504,505,506,507,508,509,510,511,513,514,515,516,533,534,535,536,537,538,539,540,541,542,543,544,545,546,550,551,552,553,554,555,556,557,567,573,577,586,589,590,591,592,593,595,596,599,601,616,619,621,628,629,630,633,634,635,636,665,683,684,685,691,692,693,694,702,703,705,706,707,710,711,714,720,2250,2254", "Race IDs excluded from facing target when hailed")
+RULE_BOOL(NPC, SleepWhenIdle, true, "Idle NPCs are skipped by the mob process until one of their timers is due or something wakes them")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Aggro)
@@ -1015,6 +1024,7 @@ RULE_INT(Network, ResendDelayMinMS, 300, "Minimum timespan between two send retr
 RULE_INT(Network, ResendDelayMaxMS, 5000, "Maximum timespan between two send retries (milliseconds)")
 RULE_REAL(Network, ClientDataRate, 0.0, "KB / sec, 0.0 disabled")
 RULE_BOOL(Network, CompressZoneStream, true, "Setting whether the zone stream should be compressed for transmission")
+RULE_BOOL(Network, BatchedUDPIO, false, "Batch outgoing client datagrams per event loop iteration with sendmmsg and drain the socket with recvmmsg (Linux only, requires restart)")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(QueryServ)
@@ -185,6 +185,8 @@ EverQuest::EverQuest(const std::string &host, int port, const std::string &user,
 	m_character = character;
 	m_dbid = 0;
 
+	PhaseBegin(HCPhaseLogin);
+
 	EQ::Net::DNSLookup(m_host, port, false, [&](const std::string &addr) {
 		if (addr.empty()) {
 			std::cout << fmt::format("Could not resolve address: {}",  m_host) << std::endl;
@@ -207,6 +209,77 @@ EverQuest::~EverQuest()
 {
 }
 
+void EverQuest::PhaseBegin(HCPhase phase)
+{
+	m_phase_start[phase] = std::chrono::steady_clock::now();
+	m_phase_active[phase] = true;
+}
+
+void EverQuest::PhaseEnd(HCPhase phase)
+{
+	if (!m_phase_active[phase]) {
+		return;
+	}
+
+	m_phase_active[phase] = false;
+	if (m_on_phase_complete) {
+		m_on_phase_complete(phase, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_phase_start[phase]));
+	}
+}
+
+void EverQuest::AccumulateStats(std::shared_ptr<EQ::Net::DaybreakConnection> conn)
+{
+	if (!conn) {
+		return;
+	}
+
+	auto stats = conn->GetStats();
+	m_closed_sent_packets += stats.sent_packets;
+	m_closed_recv_packets += stats.recv_packets;
+}
+
+void EverQuest::GetPacketCounts(uint64_t &sent, uint64_t &recv)
+{
+	sent = m_closed_sent_packets;
+	recv = m_closed_recv_packets;
+
+	for (auto &conn : { m_login_connection, m_world_connection, m_zone_connection }) {
+		if (conn) {
+			auto stats = conn->GetStats();
+			sent += stats.sent_packets;
+			recv += stats.recv_packets;
+		}
+	}
+}
+
+void EverQuest::Disconnect()
+{
+	// Close everything without triggering the reconnect handlers
+	if (m_login_connection_manager) {
+		m_login_connection_manager->OnConnectionStateChange(std::bind(&EverQuest::LoginOnStatusChangeReconnectDisabled, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+	}
+
+	if (m_world_connection_manager) {
+		m_world_connection_manager->OnConnectionStateChange(std::bind(&EverQuest::WorldOnStatusChangeReconnectDisabled, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+	}
+
+	if (m_zone_connection_manager) {
+		m_zone_connection_manager->OnConnectionStateChange(std::bind(&EverQuest::ZoneOnStatusChangeReconnectDisabled, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+	}
+
+	for (auto &conn : { m_login_connection, m_world_connection, m_zone_connection }) {
+		if (conn) {
+			conn->Close();
+		}
+	}
+
+	m_zone_connected = false;
+	m_client_ready_sent = false;
+	for (auto &active : m_phase_active) {
+		active = false;
+	}
+}
+
 void EverQuest::LoginOnNewConnection(std::shared_ptr<EQ::Net::DaybreakConnection> connection)
 {
 	m_login_connection = connection;
@@ -221,6 +294,7 @@ void EverQuest::LoginOnStatusChangeReconnectEnabled(std::shared_ptr<EQ::Net::Day
 	}
 
 	if (to == EQ::Net::StatusDisconnected) {
+		AccumulateStats(conn);
 		std::cout << "Login connection lost before we got to world, reconnecting." << std::endl;
 		m_key.clear();
 		m_dbid = 0;
@@ -232,6 +306,7 @@ void EverQuest::LoginOnStatusChangeReconnectEnabled(std::shared_ptr<EQ::Net::Day
 void EverQuest::LoginOnStatusChangeReconnectDisabled(std::shared_ptr<EQ::Net::DaybreakConnection> conn, EQ::Net::DbProtocolStatus from, EQ::Net::DbProtocolStatus to)
 {
 	if (to == EQ::Net::StatusDisconnected) {
+		AccumulateStats(conn);
 		m_login_connection.reset();
 	}
 }
@@ -348,6 +423,13 @@ void EverQuest::LoginProcessLoginResponse(const EQ::Net::Packet & p)
 	EQ::Net::StaticPacket sp(&decrypted[0], encrypt_size);
 	auto response_error = sp.GetUInt16(1);
 
+	if (m_on_login_response) {
+		m_on_login_response(
+			response_error <= 101,
+			std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_phase_start[HCPhaseLogin])
+		);
+	}
+
 	if (response_error > 101) {
 		std::cout << fmt::format("Error logging in response code: {}",  response_error) << std::endl;
 		LoginDisableReconnect();
@@ -447,6 +529,9 @@ void EverQuest::ConnectToWorld(const std::string& world_address)
 	if (s_debug_level >= 1) {
 		std::cout << fmt::format("[EverQuest::ConnectToWorld] Creating new world connection manager for {}:9000",  world_address) << std::endl;
 	}
+	PhaseEnd(HCPhaseLogin);
+	PhaseBegin(HCPhaseWorld);
+
 	m_world_connection_manager.reset(new EQ::Net::DaybreakConnectionManager());
 	m_world_connection_manager->OnNewConnection(std::bind(&EverQuest::WorldOnNewConnection, this, std::placeholders::_1));
 	m_world_connection_manager->OnConnectionStateChange(std::bind(&EverQuest::WorldOnStatusChangeReconnectEnabled, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
@@ -472,6 +557,7 @@ void EverQuest::WorldOnStatusChangeReconnectEnabled(std::shared_ptr<EQ::Net::Day
 	}
 
 	if (to == EQ::Net::StatusDisconnected) {
+		AccumulateStats(conn);
 		std::cout << "World connection lost, reconnecting." << std::endl;
 		m_world_connection.reset();
 		// We need to store the world address for reconnects
@@ -482,6 +568,7 @@ void EverQuest::WorldOnStatusChangeReconnectEnabled(std::shared_ptr<EQ::Net::Day
 void EverQuest::WorldOnStatusChangeReconnectDisabled(std::shared_ptr<EQ::Net::DaybreakConnection> conn, EQ::Net::DbProtocolStatus from, EQ::Net::DbProtocolStatus to)
 {
 	if (to == EQ::Net::StatusDisconnected) {
+		AccumulateStats(conn);
 		m_world_connection.reset();
 	}
 }
@@ -856,7 +943,10 @@ void EverQuest::ConnectToZone()
 {
 	std::cout << fmt::format("Connecting to zone server at {}:{}",  
 		m_zone_server_host, m_zone_server_port) << std::endl;
-		
+
+	PhaseEnd(HCPhaseWorld);
+	PhaseBegin(HCPhaseZone);
+
 	m_zone_connection_manager.reset(new EQ::Net::DaybreakConnectionManager());
 	m_zone_connection_manager->OnNewConnection(std::bind(&EverQuest::ZoneOnNewConnection, this, std::placeholders::_1));
 	m_zone_connection_manager->OnConnectionStateChange(std::bind(&EverQuest::ZoneOnStatusChangeReconnectEnabled, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
@@ -885,6 +975,7 @@ void EverQuest::ZoneOnStatusChangeReconnectEnabled(std::shared_ptr<EQ::Net::Dayb
 	}
 
 	if (to == EQ::Net::StatusDisconnected) {
+		AccumulateStats(conn);
 		std::cout << "Zone connection lost, reconnecting." << std::endl;
 		m_zone_connected = false;
 		m_zone_session_established = false;
@@ -898,6 +989,7 @@ void EverQuest::ZoneOnStatusChangeReconnectEnabled(std::shared_ptr<EQ::Net::Dayb
 void EverQuest::ZoneOnStatusChangeReconnectDisabled(std::shared_ptr<EQ::Net::DaybreakConnection> conn, EQ::Net::DbProtocolStatus from, EQ::Net::DbProtocolStatus to)
 {
 	if (to == EQ::Net::StatusDisconnected) {
+		AccumulateStats(conn);
 		m_zone_connection.reset();
 	}
 }
@@ -1133,6 +1225,7 @@ void EverQuest::ZoneSendClientReady()
 	DumpPacket("C->S", HC_OP_ClientReady, p);
 	m_zone_connection->QueuePacket(p);
 	m_client_ready_sent = true;
+	PhaseEnd(HCPhaseZone);
 }
 
 void EverQuest::ZoneSendSetServerFilter()
@@ -11,6 +11,7 @@
 #include <memory>
 #include <glm/glm.hpp>
 #include <chrono>
+#include <functional>
 
 // Forward declarations
 class IPathfinder;
@@ -190,6 +191,14 @@ enum AnimationType {
 	ANIM_FLY = 9
 };
 
+// Connection phases timed for swarm reporting
+enum HCPhase {
+	HCPhaseLogin = 0,  // login server connect through play response
+	HCPhaseWorld,      // world connect through zone server info
+	HCPhaseZone,       // zone connect through client ready
+	HCPhaseCount
+};
+
 // Client position update packet uses bit-packed format
 // Format: spawn_id (2 bytes) + 20 bytes of bit-packed data:
 // field1: delta_heading:10, x_pos:19, padding:3
@@ -232,6 +241,16 @@ public:
 	void SetNavmeshPath(const std::string& path) { m_navmesh_path = path; }
 	void SetMapsPath(const std::string& path) { m_maps_path = path; }
 
+	// Non-blocking movement for driving many clients from one loop
+	void BeginMove(float x, float y, float z) { MoveToWithPath(x, y, z); }
+
+	// Swarm support
+	void OnPhaseComplete(std::function<void(HCPhase, std::chrono::milliseconds)> fn) { m_on_phase_complete = fn; }
+	// login server answered the credentials, accepted or not, timed from the start of the login phase
+	void OnLoginResponse(std::function<void(bool, std::chrono::milliseconds)> fn) { m_on_login_response = fn; }
+	void Disconnect();
+	void GetPacketCounts(uint64_t &sent, uint64_t &recv);
+
 private:
 	// Utility functions
 	static void DumpPacket(const std::string &prefix, uint16_t opcode, const EQ::Net::Packet &p);
@@ -490,6 +509,18 @@ private:
 	uint16_t m_ucs_port = 0;
 	std::string m_mail_key;
 	
+	// Phase timing and packet totals from connections that have gone away
+	void PhaseBegin(HCPhase phase);
+	void PhaseEnd(HCPhase phase);
+	void AccumulateStats(std::shared_ptr<EQ::Net::DaybreakConnection> conn);
+
+	std::function<void(HCPhase, std::chrono::milliseconds)> m_on_phase_complete;
+	std::function<void(bool, std::chrono::milliseconds)> m_on_login_response;
+	std::chrono::steady_clock::time_point m_phase_start[HCPhaseCount];
+	bool m_phase_active[HCPhaseCount] = { false, false, false };
+	uint64_t m_closed_sent_packets = 0;
+	uint64_t m_closed_recv_packets = 0;
+
 	// World server channel message routing
 	void WorldSendChannelMessage(const std::string &channel, const std::string &message, const std::string &target = "");
 	void WorldProcessChannelMessage(const EQ::Net::Packet &p);
@@ -13,6 +13,7 @@
 #include <unistd.h>
 
 #include "eq.h"
+#include "swarm.h"
 
 EQEmuLogSys Log;
 EQEmuLogSys LogSys;
@@ -240,6 +241,7 @@ int main(int argc, char *argv[]) {
 	int debug_level = 0;
 	std::string config_file = "hc_test1.json";
 	bool pathfinding_enabled = true;
+	std::string swarm_file;
 	
 	for (int i = 1; i < argc; i++) {
 		std::string arg = argv[i];
@@ -251,6 +253,10 @@ int main(int argc, char *argv[]) {
 			if (i + 1 < argc) {
 				config_file = argv[++i];
 			}
+		} else if (arg == "--swarm" || arg == "-s") {
+			if (i + 1 < argc) {
+				swarm_file = argv[++i];
+			}
 		} else if (arg == "--no-pathfinding" || arg == "-np") {
 			pathfinding_enabled = false;
 		} else if (arg == "--help" || arg == "-h") {
@@ -259,12 +265,35 @@ int main(int argc, char *argv[]) {
 			std::cout << "  -d, --debug <level>      Set debug level (0-3)\n";
 			std::cout << "  -c, --config <file>      Set config file (default: hc_test1.json)\n";
 			std::cout << "  -np, --no-pathfinding    Disable navmesh pathfinding\n";
+			std::cout << "  -s, --swarm <file>       Run a load test scenario instead of the interactive client\n";
 			std::cout << "  -h, --help               Show this help message\n";
 			return 0;
 		}
 	}
 
 	EverQuest::SetDebugLevel(debug_level);
+
+	if (!swarm_file.empty()) {
+		SwarmScenario scenario;
+		if (!Swarm::LoadScenario(swarm_file, scenario)) {
+			return 1;
+		}
+
+		// Per client chatter would drown the report with hundreds of clients, keep it only when debugging
+		std::ostream report(std::cout.rdbuf());
+		struct NullBuffer : std::streambuf {
+			int overflow(int c) override { return c; }
+		} discard;
+		if (debug_level == 0) {
+			std::cout.rdbuf(&discard);
+		}
+
+		Swarm swarm(scenario, report);
+		int result = swarm.Run();
+		std::cout.rdbuf(report.rdbuf());
+		return result;
+	}
+
 	std::cout << fmt::format("Starting EQEmu Headless Client with debug level {}, config file: {}, pathfinding: {}\n", 
 		debug_level, config_file, pathfinding_enabled ? "enabled" : "disabled");
 
@@ -0,0 +1,464 @@
+#include "swarm.h"
+#include "../common/event/event_loop.h"
+#include "../common/json_config.h"
+#include "../common/strings.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+namespace {
+	const char *PhaseName(int phase)
+	{
+		switch (phase) {
+		case HCPhaseLogin: return "login";
+		case HCPhaseWorld: return "world";
+		case HCPhaseZone: return "zone-in";
+		default: return "unknown";
+		}
+	}
+
+	// Upper bounds in milliseconds for the histogram rows, the last row is open ended
+	const uint32_t histogram_buckets[] = { 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 30000 };
+}
+
+void SwarmHistogram::Add(uint32_t ms)
+{
+	m_samples.push_back(ms);
+}
+
+uint32_t SwarmHistogram::Percentile(double p) const
+{
+	if (m_samples.empty()) {
+		return 0;
+	}
+
+	auto sorted = m_samples;
+	std::sort(sorted.begin(), sorted.end());
+	auto index = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+	return sorted[std::clamp<size_t>(index, 1, sorted.size()) - 1];
+}
+
+void SwarmHistogram::Print(std::ostream &out, const std::string &name, size_t timeouts) const
+{
+	out << fmt::format(
+		"  {:<8} n={:<6} timeouts={:<4} p50={:>6}ms p90={:>6}ms p99={:>6}ms max={:>6}ms\n",
+		name,
+		m_samples.size(),
+		timeouts,
+		Percentile(50),
+		Percentile(90),
+		Percentile(99),
+		Percentile(100)
+	);
+
+	if (m_samples.empty()) {
+		return;
+	}
+
+	size_t counts[std::size(histogram_buckets) + 1] = { };
+	for (auto s : m_samples) {
+		size_t i = 0;
+		while (i < std::size(histogram_buckets) && s > histogram_buckets[i]) {
+			++i;
+		}
+
+		counts[i]++;
+	}
+
+	for (size_t i = 0; i <= std::size(histogram_buckets); ++i) {
+		if (counts[i] == 0) {
+			continue;
+		}
+
+		auto label = i < std::size(histogram_buckets) ?
+			fmt::format("<= {}ms", histogram_buckets[i]) :
+			fmt::format("> {}ms", histogram_buckets[i - 1]);
+
+		auto width = static_cast<size_t>(std::ceil(40.0 * counts[i] / m_samples.size()));
+		out << fmt::format("    {:>10} {:>6} {}\n", label, counts[i], std::string(width, '#'));
+	}
+}
+
+/*
+	{
+		"host": "127.0.0.1", "port": 5999, "server": "My Test Server",
+		"accounts": [ { "user": "a", "pass": "b", "character": "Abc" } ],
+		"account_template": { "user": "swarm{}", "pass": "password", "character": "Swarm{}", "first": 1, "count": 200 },
+		"spawn_rate": 5, "duration": 300, "phase_timeout": 60, "report_interval": 10, "seed": 1,
+		"movement": { "pattern": "wander", "radius": 50, "interval_ms": 3000 },
+		"chat": { "rate": 0.05, "channel": "say", "message": "swarm test" },
+		"zone_hop": { "interval": 120 },
+		"login_only": false
+	}
+*/
+bool Swarm::LoadScenario(const std::string &file_name, SwarmScenario &scenario)
+{
+	try {
+		auto config = EQ::JsonConfigFile::Load(file_name);
+		auto &root  = config.RawHandle();
+
+		scenario.host            = root.get("host", scenario.host).asString();
+		scenario.port            = root.get("port", scenario.port).asInt();
+		scenario.server          = root.get("server", scenario.server).asString();
+		scenario.spawn_rate      = root.get("spawn_rate", scenario.spawn_rate).asDouble();
+		scenario.duration        = root.get("duration", scenario.duration).asInt();
+		scenario.phase_timeout   = root.get("phase_timeout", scenario.phase_timeout).asInt();
+		scenario.report_interval = root.get("report_interval", scenario.report_interval).asInt();
+		scenario.seed            = root.get("seed", scenario.seed).asUInt();
+
+		if (root.isMember("accounts")) {
+			for (auto &a : root["accounts"]) {
+				scenario.accounts.push_back({ a["user"].asString(), a["pass"].asString(), a["character"].asString() });
+			}
+		}
+
+		if (root.isMember("account_template")) {
+			auto &t    = root["account_template"];
+			int  first = t.get("first", 1).asInt();
+			int  count = t.get("count", 0).asInt();
+			for (int i = first; i < first + count; ++i) {
+				auto n = std::to_string(i);
+				scenario.accounts.push_back(
+					{
+						Strings::Replace(t["user"].asString(), "{}", n),
+						Strings::Replace(t["pass"].asString(), "{}", n),
+						Strings::Replace(t["character"].asString(), "{}", n)
+					}
+				);
+			}
+		}
+
+		if (root.isMember("movement")) {
+			auto &m = root["movement"];
+			scenario.movement          = m.get("pattern", scenario.movement).asString();
+			scenario.movement_radius   = m.get("radius", scenario.movement_radius).asFloat();
+			scenario.movement_interval = m.get("interval_ms", scenario.movement_interval).asInt();
+		}
+
+		if (root.isMember("chat")) {
+			auto &c = root["chat"];
+			scenario.chat_rate    = c.get("rate", scenario.chat_rate).asDouble();
+			scenario.chat_channel = c.get("channel", scenario.chat_channel).asString();
+			scenario.chat_message = c.get("message", scenario.chat_message).asString();
+		}
+
+		if (root.isMember("zone_hop")) {
+			scenario.zone_hop_interval = root["zone_hop"].get("interval", scenario.zone_hop_interval).asInt();
+		}
+
+		scenario.login_only = root.get("login_only", scenario.login_only).asBool();
+	}
+	catch (std::exception &ex) {
+		std::cerr << fmt::format("Error parsing scenario file {}: {}\n", file_name, ex.what());
+		return false;
+	}
+
+	if (scenario.accounts.empty() || scenario.server.empty()) {
+		std::cerr << fmt::format("Scenario file {} needs a server and at least one account\n", file_name);
+		return false;
+	}
+
+	return true;
+}
+
+Swarm::Swarm(const SwarmScenario &scenario, std::ostream &report)
+	: m_scenario(scenario), m_report(report), m_rng(scenario.seed)
+{
+}
+
+std::chrono::milliseconds Swarm::NextInterval(double per_second)
+{
+	// exponential gaps so events from many clients do not line up
+	std::exponential_distribution<double> gap(per_second);
+	return std::chrono::milliseconds(static_cast<int64_t>(gap(m_rng) * 1000.0) + 1);
+}
+
+void Swarm::StartClient(size_t account)
+{
+	auto &a   = m_scenario.accounts[account];
+	auto now  = std::chrono::steady_clock::now();
+	auto c    = std::make_unique<SwarmClient>();
+	auto *raw = c.get();
+
+	c->account       = account;
+	c->phase_started = now;
+	c->eq            = std::make_unique<EverQuest>(m_scenario.host, m_scenario.port, a.user, a.pass, m_scenario.server, a.character);
+	c->eq->SetPathfinding(false);
+	c->eq->OnPhaseComplete(
+		[this, raw](HCPhase phase, std::chrono::milliseconds elapsed) {
+			auto now = std::chrono::steady_clock::now();
+			m_phases[phase].Add(static_cast<uint32_t>(elapsed.count()));
+			raw->phase         = phase + 1;
+			raw->phase_started = now;
+
+			if (phase == HCPhaseZone) {
+				raw->zoned_in   = now;
+				raw->has_origin = false;
+				raw->next_move  = now + std::chrono::milliseconds(m_scenario.movement_interval);
+				raw->next_chat  = now + NextInterval(m_scenario.chat_rate > 0.0 ? m_scenario.chat_rate : 1.0);
+			}
+		}
+	);
+
+	c->eq->OnLoginResponse(
+		[this, raw](bool accepted, std::chrono::milliseconds elapsed) {
+			m_credentials.Add(static_cast<uint32_t>(elapsed.count()));
+			if (accepted) {
+				m_logins_accepted++;
+			}
+			else {
+				m_logins_refused++;
+			}
+
+			raw->login_answered = true;
+		}
+	);
+
+	m_clients.push_back(std::move(c));
+}
+
+void Swarm::Retire(SwarmClient &c, std::chrono::steady_clock::time_point now)
+{
+	uint64_t sent = 0, recv = 0;
+	c.eq->GetPacketCounts(sent, recv);
+	m_retired_sent_packets += sent;
+	m_retired_recv_packets += recv;
+
+	// give the disconnects a moment to go out before the connection managers are torn down
+	c.eq->OnPhaseComplete(nullptr);
+	c.eq->OnLoginResponse(nullptr);
+	c.eq->Disconnect();
+	m_retired.push_back({ std::move(c.eq), now + std::chrono::seconds(2) });
+}
+
+void Swarm::ProcessClient(SwarmClient &c, std::chrono::steady_clock::time_point now)
+{
+	// the same accounts go around again at the spawn rate, the login server only ever sees passwords
+	if (m_scenario.login_only && c.login_answered) {
+		m_rejoin.push_back(c.account);
+		Retire(c, now);
+		return;
+	}
+
+	if (c.phase < HCPhaseCount) {
+		if (now - c.phase_started > std::chrono::seconds(m_scenario.phase_timeout)) {
+			m_timeouts[c.phase]++;
+			Retire(c, now);
+		}
+
+		return;
+	}
+
+	if (!c.eq->IsFullyZonedIn()) {
+		return;
+	}
+
+	if (m_scenario.zone_hop_interval > 0 && now - c.zoned_in > std::chrono::seconds(m_scenario.zone_hop_interval)) {
+		// hc has no in zone zone change, so a hop is a full log out and back in through login and world
+		m_hops++;
+		m_rejoin.push_back(c.account);
+		Retire(c, now);
+		return;
+	}
+
+	if (m_scenario.movement != "none" && now >= c.next_move) {
+		if (!c.has_origin) {
+			c.origin     = c.eq->GetPosition();
+			c.has_origin = true;
+		}
+
+		auto  radius = m_scenario.movement_radius;
+		float x      = c.origin.x;
+		float y      = c.origin.y;
+		if (m_scenario.movement == "wander") {
+			std::uniform_real_distribution<float> d(-radius, radius);
+			x += d(m_rng);
+			y += d(m_rng);
+		}
+		else if (m_scenario.movement == "circle") {
+			float angle = static_cast<float>(c.move_step % 8) * 3.14159265f / 4.0f;
+			x += std::cos(angle) * radius;
+			y += std::sin(angle) * radius;
+		}
+		else if (m_scenario.movement == "line") {
+			x += (c.move_step % 2 == 0) ? radius : -radius;
+		}
+
+		c.move_step++;
+		c.eq->BeginMove(x, y, c.origin.z);
+		c.next_move = now + std::chrono::milliseconds(m_scenario.movement_interval);
+		m_moves_sent++;
+	}
+
+	if (m_scenario.chat_rate > 0.0 && now >= c.next_chat) {
+		c.eq->SendChatMessage(m_scenario.chat_message, m_scenario.chat_channel);
+		c.next_chat = now + NextInterval(m_scenario.chat_rate);
+		m_chat_sent++;
+	}
+}
+
+void Swarm::Report(bool final_report, std::chrono::steady_clock::time_point now)
+{
+	uint64_t sent = m_retired_sent_packets;
+	uint64_t recv = m_retired_recv_packets;
+	size_t   zoned_in = 0;
+	for (auto &c : m_clients) {
+		if (!c->eq) {
+			continue;
+		}
+
+		uint64_t s = 0, r = 0;
+		c->eq->GetPacketCounts(s, r);
+		sent += s;
+		recv += r;
+
+		if (c->phase == HCPhaseCount && c->eq->IsFullyZonedIn()) {
+			zoned_in++;
+		}
+	}
+
+	double interval = std::chrono::duration<double>(now - (final_report ? m_started : m_last_report)).count();
+	if (interval <= 0.0) {
+		interval = 1.0;
+	}
+
+	uint64_t interval_sent = final_report ? sent : sent - m_last_sent_packets;
+	uint64_t interval_recv = final_report ? recv : recv - m_last_recv_packets;
+
+	m_report << fmt::format(
+		"[swarm] {:>6.0f}s {} | clients [{}] zoned in [{}] | packets out [{:.0f}/s] in [{:.0f}/s] | moves [{}] chat [{}] hops [{}]\n",
+		std::chrono::duration<double>(now - m_started).count(),
+		final_report ? "final" : "progress",
+		m_clients.size(),
+		zoned_in,
+		interval_sent / interval,
+		interval_recv / interval,
+		m_moves_sent,
+		m_chat_sent,
+		m_hops
+	);
+
+	size_t logins = m_logins_accepted + m_logins_refused;
+	m_report << fmt::format(
+		"  logins accepted [{}] refused [{}] [{:.1f}/s]\n",
+		m_logins_accepted,
+		m_logins_refused,
+		(final_report ? logins : logins - m_last_logins) / interval
+	);
+	m_credentials.Print(m_report, "password", 0);
+
+	for (int i = 0; i < HCPhaseCount; ++i) {
+		if (m_scenario.login_only && i != HCPhaseLogin) {
+			continue;
+		}
+
+		m_phases[i].Print(m_report, PhaseName(i), m_timeouts[i]);
+	}
+
+	m_report << std::flush;
+
+	m_last_sent_packets = sent;
+	m_last_recv_packets = recv;
+	m_last_logins       = logins;
+	m_last_report       = now;
+}
+
+int Swarm::Run()
+{
+	m_started     = std::chrono::steady_clock::now();
+	m_last_report = m_started;
+
+	m_report << fmt::format(
+		"[swarm] {} clients against {}:{} [{}] spawn rate [{}/s] movement [{}] chat rate [{}/s] zone hop [{}s] login only [{}] seed [{}]\n",
+		m_scenario.accounts.size(),
+		m_scenario.host,
+		m_scenario.port,
+		m_scenario.server,
+		m_scenario.spawn_rate,
+		m_scenario.movement,
+		m_scenario.chat_rate,
+		m_scenario.zone_hop_interval,
+		m_scenario.login_only,
+		m_scenario.seed
+	) << std::flush;
+
+	size_t next_account = 0;
+	auto   next_spawn   = m_started;
+	auto   last_update  = m_started;
+	auto   spawn_gap    = std::chrono::microseconds(static_cast<int64_t>(1000000.0 / std::max(m_scenario.spawn_rate, 0.001)));
+	std::chrono::steady_clock::time_point all_started;
+	bool   spawning     = true;
+
+	for (;;) {
+		EQ::EventLoop::Get().Process();
+
+		auto now = std::chrono::steady_clock::now();
+
+		// new accounts first, then anyone returning from a zone hop, both at the scenario spawn rate
+		if (now >= next_spawn) {
+			if (next_account < m_scenario.accounts.size()) {
+				StartClient(next_account++);
+				next_spawn += spawn_gap;
+			}
+			else if (!m_rejoin.empty()) {
+				StartClient(m_rejoin.front());
+				m_rejoin.erase(m_rejoin.begin());
+				next_spawn += spawn_gap;
+			}
+			else {
+				next_spawn = now;
+			}
+
+			if (spawning && next_account == m_scenario.accounts.size()) {
+				spawning    = false;
+				all_started = now;
+			}
+		}
+
+		if (now - last_update >= std::chrono::milliseconds(16)) {
+			for (auto &c : m_clients) {
+				if (c->eq) {
+					ProcessClient(*c, now);
+				}
+
+				if (c->eq) {
+					c->eq->UpdateMovement();
+				}
+			}
+
+			last_update = now;
+		}
+
+		m_clients.erase(
+			std::remove_if(m_clients.begin(), m_clients.end(), [](const std::unique_ptr<SwarmClient> &c) { return !c->eq; }),
+			m_clients.end()
+		);
+
+		m_retired.erase(
+			std::remove_if(m_retired.begin(), m_retired.end(), [&](const RetiredClient &r) { return now >= r.destroy_at; }),
+			m_retired.end()
+		);
+
+		if (m_scenario.report_interval > 0 && now - m_last_report >= std::chrono::seconds(m_scenario.report_interval)) {
+			Report(false, now);
+		}
+
+		if (!spawning && now - all_started >= std::chrono::seconds(m_scenario.duration)) {
+			break;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	auto now = std::chrono::steady_clock::now();
+	for (auto &c : m_clients) {
+		if (c->eq) {
+			Retire(*c, now);
+		}
+	}
+
+	Report(true, now);
+	return 0;
+}
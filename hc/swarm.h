@@ -0,0 +1,120 @@
+#pragma once
+
+#include "eq.h"
+#include <cstdint>
+#include <chrono>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <memory>
+
+// Account used by a single swarm client
+struct SwarmAccount
+{
+	std::string user;
+	std::string pass;
+	std::string character;
+};
+
+// Scenario file contents, see Swarm::LoadScenario for the format
+struct SwarmScenario
+{
+	std::string host = "127.0.0.1";
+	int port = 5999;
+	std::string server;
+	std::vector<SwarmAccount> accounts;
+
+	double spawn_rate = 5.0;        // clients started per second
+	int duration = 300;             // seconds to keep running once every client has been started
+	int phase_timeout = 60;         // seconds before a phase that has not finished counts as timed out
+	int report_interval = 10;       // seconds between progress reports, 0 for final report only
+	uint32_t seed = 1;
+
+	std::string movement = "none";  // none, wander, circle, line
+	float movement_radius = 50.0f;
+	int movement_interval = 3000;   // milliseconds between new movement targets
+
+	double chat_rate = 0.0;         // messages per second per zoned in client
+	std::string chat_channel = "say";
+	std::string chat_message = "swarm test";
+
+	int zone_hop_interval = 0;      // seconds in zone before logging out and back in, 0 to disable
+
+	bool login_only = false;        // disconnect at the login server's answer and log in again, a credential storm
+};
+
+// Latency samples bucketed on a fixed millisecond scale
+class SwarmHistogram
+{
+public:
+	void Add(uint32_t ms);
+	size_t Count() const { return m_samples.size(); }
+	uint32_t Percentile(double p) const;
+	void Print(std::ostream &out, const std::string &name, size_t timeouts) const;
+
+private:
+	std::vector<uint32_t> m_samples;
+};
+
+class Swarm
+{
+public:
+	static bool LoadScenario(const std::string &file_name, SwarmScenario &scenario);
+
+	Swarm(const SwarmScenario &scenario, std::ostream &report);
+	int Run();
+
+private:
+	struct SwarmClient
+	{
+		size_t account = 0;
+		std::unique_ptr<EverQuest> eq;
+		std::chrono::steady_clock::time_point phase_started;
+		std::chrono::steady_clock::time_point zoned_in;
+		std::chrono::steady_clock::time_point next_move;
+		std::chrono::steady_clock::time_point next_chat;
+		glm::vec3 origin;
+		bool has_origin = false;
+		int phase = HCPhaseLogin;   // phase currently in progress, HCPhaseCount once zoned in
+		int move_step = 0;
+		bool login_answered = false;
+	};
+
+	struct RetiredClient
+	{
+		std::unique_ptr<EverQuest> eq;
+		std::chrono::steady_clock::time_point destroy_at;
+	};
+
+	void StartClient(size_t account);
+	void ProcessClient(SwarmClient &c, std::chrono::steady_clock::time_point now);
+	void Retire(SwarmClient &c, std::chrono::steady_clock::time_point now);
+	void Report(bool final_report, std::chrono::steady_clock::time_point now);
+	std::chrono::milliseconds NextInterval(double per_second);
+
+	SwarmScenario m_scenario;
+	std::ostream &m_report;
+	std::mt19937 m_rng;
+
+	std::vector<std::unique_ptr<SwarmClient>> m_clients;
+	std::vector<RetiredClient> m_retired;
+	std::vector<size_t> m_rejoin;   // accounts waiting to log back in after a zone hop
+
+	SwarmHistogram m_phases[HCPhaseCount];
+	SwarmHistogram m_credentials;   // connect through the login server's answer to the password
+	size_t m_logins_accepted = 0;
+	size_t m_logins_refused = 0;
+	size_t m_last_logins = 0;
+	size_t m_timeouts[HCPhaseCount] = { 0, 0, 0 };
+	size_t m_chat_sent = 0;
+	size_t m_moves_sent = 0;
+	size_t m_hops = 0;
+
+	uint64_t m_retired_sent_packets = 0;
+	uint64_t m_retired_recv_packets = 0;
+	uint64_t m_last_sent_packets = 0;
+	uint64_t m_last_recv_packets = 0;
+	std::chrono::steady_clock::time_point m_started;
+	std::chrono::steady_clock::time_point m_last_report;
+};
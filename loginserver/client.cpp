@@ -13,6 +13,7 @@ Client::Client(std::shared_ptr<EQStreamInterface> c, LSClientVersion v)
 	m_account_id              = 0;
 	m_selected_play_server_id = 0;
 	m_play_sequence_id        = 0;
+	m_alive                   = std::make_shared<bool>(true);
 }
 
 bool Client::Process()
@@ -166,8 +167,7 @@ void Client::HandleLogin(const char *data, unsigned int size)
 //	std::cout << "encrypt_type: " << m_login_base_message.encrypt_type << std::endl;
 //	std::cout << "unk3: " << m_login_base_message.unk3 << std::endl;
 
-	bool login_success = false;
-	bool token_login   = outbuffer[0] == 0 && outbuffer[1] == 0;
+	bool token_login = outbuffer[0] == 0 && outbuffer[1] == 0;
 	if (token_login) {
 		if (server.options.IsTokenLoginAllowed()) {
 			cred          = (&outbuffer[2 + user.length()]);
@@ -209,29 +209,7 @@ void Client::HandleLogin(const char *data, unsigned int size)
 
 	auto a = LoginAccountsRepository::GetAccountFromContext(database, c);
 	if (a.id > 0) {
-		login_success = VerifyAndUpdateLoginHash(c, a);
-
-		// if user updated their password on the login server, update it here by validating their credentials with the login server
-		if (std::getenv("LSPX") && !login_success && db_loginserver == "eqemu") {
-			LogInfo("LSPX | Attempting login account via [{}]", db_loginserver);
-			uint32 account_id = AccountManagement::CheckExternalLoginserverUserCredentials(c);
-			LogInfo("LSPX | External login account id [{}]", account_id);
-			if (account_id > 0) {
-				auto updated_account = LoginAccountsRepository::UpdateAccountPassword(database, a, cred);
-				if (!updated_account.id) {
-					LogError("Failed to update eqemu account [{}] password hash", account_id);
-					SendFailedLogin();
-					return;
-				}
-
-				LogInfo("Updating eqemu account [{}] password hash", account_id);
-				DoSuccessfulLogin(updated_account);
-				return;
-			}
-		}
-
-		LogInfo("Successful login [{}]", (login_success ? "true" : "false"));
-		login_success ? DoSuccessfulLogin(a) : SendFailedLogin();
+		VerifyAndUpdateLoginHash(c, a);
 		return;
 	}
 
@@ -364,60 +342,91 @@ void Client::SendFailedLogin()
 	m_client_status = cs_failed_to_login;
 }
 
-bool Client::VerifyAndUpdateLoginHash(LoginAccountContext c, const LoginAccountsRepository::LoginAccounts &a)
+void Client::VerifyAndUpdateLoginHash(LoginAccountContext c, const LoginAccountsRepository::LoginAccounts &a)
 {
-	auto encryption_mode = server.options.GetEncryptionMode();
-	if (eqcrypt_verify_hash(a.account_name, c.password, a.account_password, encryption_mode)) {
-		return true;
-	}
+	CredentialCheck check;
+	check.username      = a.account_name;
+	check.password      = c.password;
+	check.password_hash = a.account_password;
+	check.mode          = server.options.GetEncryptionMode();
+	check.upgrade_mode  = EncryptionModeSCrypt;
 
-	if (encryption_mode < EncryptionModeArgon2) {
-		encryption_mode = EncryptionModeArgon2;
-	}
+	in_addr in{};
+	in.s_addr = m_connection->GetRemoteIP();
+	std::string address = inet_ntoa(in);
 
-	uint32 insecure_source_encryption_mode = 0;
+	m_client_status = cs_verifying_credentials;
 
-	auto verify_encryption_mode = [&](int start, int end) {
-		for (int i = start; i <= end; ++i) {
-			if (i != encryption_mode && eqcrypt_verify_hash(a.account_name, c.password, a.account_password, i)) {
-				insecure_source_encryption_mode = i;
+	// the hash is checked on a worker, the client may be gone by the time it is done
+	std::weak_ptr<bool> alive = m_alive;
+
+	bool queued = server.credential_verifier.Verify(
+		address,
+		check,
+		[this, alive, c, a](const CredentialResult &r) {
+			if (alive.expired()) {
+				return;
 			}
+
+			FinishPasswordLogin(c, a, r);
 		}
-	};
+	);
 
-	switch (a.account_password.length()) {
-		case CryptoHash::md5_hash_length:
-			verify_encryption_mode(EncryptionModeMD5, EncryptionModeMD5Triple);
-			break;
-		case CryptoHash::sha1_hash_length:
-			if (insecure_source_encryption_mode == 0) {
-				verify_encryption_mode(EncryptionModeSHA, EncryptionModeSHATriple);
-			}
-			break;
-		case CryptoHash::sha512_hash_length:
-			if (insecure_source_encryption_mode == 0) {
-				verify_encryption_mode(EncryptionModeSHA512, EncryptionModeSHA512Triple);
-			}
-			break;
+	if (!queued) {
+		LogWarning(
+			"Refusing login for [{}] from [{}], too many logins are being verified [{}]",
+			c.username,
+			address,
+			server.credential_verifier.GetInFlight()
+		);
+		SendFailedLogin();
 	}
+}
+
+void Client::FinishPasswordLogin(
+	LoginAccountContext c,
+	LoginAccountsRepository::LoginAccounts a,
+	const CredentialResult &r
+)
+{
+	bool login_success = r.valid;
 
-	if (insecure_source_encryption_mode > 0) {
+	// DoSuccessfulLogin writes the account row, the upgraded hash goes out with it
+	if (r.insecure_mode > 0 && !r.upgraded_hash.empty()) {
 		LogInfo(
 			"Updated insecure password user [{}] loginserver [{}] from mode [{}] ({}) to mode [{}] ({})",
 			c.username,
 			c.source_loginserver,
-			GetEncryptionByModeId(insecure_source_encryption_mode),
-			insecure_source_encryption_mode,
-			GetEncryptionByModeId(encryption_mode),
-			encryption_mode
+			GetEncryptionByModeId(r.insecure_mode),
+			r.insecure_mode,
+			GetEncryptionByModeId(EncryptionModeSCrypt),
+			EncryptionModeSCrypt
 		);
 
-		LoginAccountsRepository::UpdateAccountPassword(database, a, c.password);
+		a.account_password = r.upgraded_hash;
+	}
 
-		return true;
+	// if user updated their password on the login server, update it here by validating their credentials with the login server
+	if (std::getenv("LSPX") && !login_success && c.source_loginserver == "eqemu") {
+		LogInfo("LSPX | Attempting login account via [{}]", c.source_loginserver);
+		uint32 account_id = AccountManagement::CheckExternalLoginserverUserCredentials(c);
+		LogInfo("LSPX | External login account id [{}]", account_id);
+		if (account_id > 0) {
+			auto updated_account = LoginAccountsRepository::UpdateAccountPassword(database, a, c.password);
+			if (!updated_account.id) {
+				LogError("Failed to update eqemu account [{}] password hash", account_id);
+				SendFailedLogin();
+				return;
+			}
+
+			LogInfo("Updating eqemu account [{}] password hash", account_id);
+			DoSuccessfulLogin(updated_account);
+			return;
+		}
 	}
 
-	return false;
+	LogInfo("Successful login [{}]", (login_success ? "true" : "false"));
+	login_success ? DoSuccessfulLogin(a) : SendFailedLogin();
 }
 
 void Client::DoSuccessfulLogin(LoginAccountsRepository::LoginAccounts &a)
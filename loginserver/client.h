@@ -8,6 +8,7 @@
 #include "../common/net/dns.h"
 #include "../common/net/daybreak_connection.h"
 #include "login_types.h"
+#include "credential_verifier.h"
 #include "../common/repositories/login_accounts_repository.h"
 #include <memory>
 
@@ -40,7 +41,12 @@ public:
 
 	void AttemptLoginAccountCreation(LoginAccountContext c);
 	void SendFailedLogin();
-	bool VerifyAndUpdateLoginHash(LoginAccountContext c, const LoginAccountsRepository::LoginAccounts& a);
+	void VerifyAndUpdateLoginHash(LoginAccountContext c, const LoginAccountsRepository::LoginAccounts& a);
+	void FinishPasswordLogin(
+		LoginAccountContext c,
+		LoginAccountsRepository::LoginAccounts a,
+		const CredentialResult &r
+	);
 	void DoSuccessfulLogin(LoginAccountsRepository::LoginAccounts& a);
 
 private:
@@ -59,6 +65,7 @@ private:
 	LoginBaseMessage                                    m_login_base_message;
 	std::string                                         m_stored_username;
 	std::string                                         m_stored_password;
+	std::shared_ptr<bool>                               m_alive; // hash checks finishing after a disconnect hold a weak copy
 	static bool ProcessHealthCheck(std::string username) {
 		return username == "healthcheckuser";
 	}
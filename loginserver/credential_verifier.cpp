@@ -0,0 +1,195 @@
+#include "credential_verifier.h"
+#include "encryption.h"
+#include "../common/event/event_loop.h"
+#include "../common/event/task_scheduler.h"
+#include <algorithm>
+
+CredentialResult VerifyCredentials(const CredentialCheck &c)
+{
+	CredentialResult r;
+	if (eqcrypt_verify_hash(c.username, c.password, c.password_hash, c.mode)) {
+		r.valid = true;
+		return r;
+	}
+
+	auto encryption_mode = c.mode;
+	if (encryption_mode < EncryptionModeArgon2) {
+		encryption_mode = EncryptionModeArgon2;
+	}
+
+	auto verify_encryption_mode = [&](int start, int end) {
+		for (int i = start; i <= end; ++i) {
+			if (i != encryption_mode && eqcrypt_verify_hash(c.username, c.password, c.password_hash, i)) {
+				r.insecure_mode = i;
+			}
+		}
+	};
+
+	switch (c.password_hash.length()) {
+		case CryptoHash::md5_hash_length:
+			verify_encryption_mode(EncryptionModeMD5, EncryptionModeMD5Triple);
+			break;
+		case CryptoHash::sha1_hash_length:
+			verify_encryption_mode(EncryptionModeSHA, EncryptionModeSHATriple);
+			break;
+		case CryptoHash::sha512_hash_length:
+			verify_encryption_mode(EncryptionModeSHA512, EncryptionModeSHA512Triple);
+			break;
+	}
+
+	if (r.insecure_mode > 0) {
+		r.valid = true;
+		if (c.upgrade_mode > 0) {
+			r.upgraded_hash = eqcrypt_hash(c.username, c.password, c.upgrade_mode);
+		}
+	}
+
+	return r;
+}
+
+CredentialVerifier::CredentialVerifier()
+{
+	m_async                     = nullptr;
+	m_max_in_flight             = 0;
+	m_max_in_flight_per_address = 0;
+	m_in_flight                 = 0;
+	m_verified                  = 0;
+	m_refused                   = 0;
+	m_max_seen_in_flight        = 0;
+}
+
+CredentialVerifier::~CredentialVerifier()
+{
+	Stop();
+}
+
+void CredentialVerifier::Start(size_t threads, size_t max_in_flight, size_t max_in_flight_per_address)
+{
+	Stop();
+
+	m_max_in_flight             = std::max<size_t>(max_in_flight, 1);
+	m_max_in_flight_per_address = std::max<size_t>(max_in_flight_per_address, 1);
+
+	if (threads == 0) {
+		return;
+	}
+
+	m_async = new uv_async_t;
+	memset(m_async, 0, sizeof(uv_async_t));
+	uv_async_init(
+		EQ::EventLoop::Get().Handle(), m_async, [](uv_async_t *handle) {
+			auto v = (CredentialVerifier *) handle->data;
+			v->Deliver();
+		}
+	);
+	m_async->data = this;
+
+	m_workers = std::make_unique<EQ::Event::TaskScheduler>(threads);
+}
+
+void CredentialVerifier::Stop()
+{
+	// checks that haven't started are dropped, the ones running finish before the workers are gone
+	m_workers.reset();
+
+	if (m_async) {
+		uv_close(
+			(uv_handle_t *) m_async, [](uv_handle_t *handle) {
+				delete (uv_async_t *) handle;
+			}
+		);
+		m_async = nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_finished.clear();
+	m_in_flight_by_address.clear();
+	m_in_flight = 0;
+}
+
+bool CredentialVerifier::Verify(const std::string &address, CredentialCheck check, DoneFn done)
+{
+	if (!m_workers) {
+		auto r = VerifyCredentials(check);
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_verified++;
+		}
+
+		done(r);
+		return true;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		auto &address_in_flight = m_in_flight_by_address[address];
+		if (m_in_flight >= m_max_in_flight || address_in_flight >= m_max_in_flight_per_address) {
+			if (address_in_flight == 0) {
+				m_in_flight_by_address.erase(address);
+			}
+
+			m_refused++;
+			return false;
+		}
+
+		address_in_flight++;
+		m_in_flight++;
+		m_max_seen_in_flight = std::max(m_max_seen_in_flight, m_in_flight);
+	}
+
+	m_workers->Enqueue(
+		[this, address, check, done]() {
+			auto r = VerifyCredentials(check);
+			{
+				std::lock_guard<std::mutex> lock(m_lock);
+				m_finished.push_back({address, std::move(r), done});
+			}
+
+			uv_async_send(m_async);
+		}
+	);
+
+	return true;
+}
+
+void CredentialVerifier::Deliver()
+{
+	std::vector<Finished> finished;
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		finished.swap(m_finished);
+
+		for (auto &f: finished) {
+			auto iter = m_in_flight_by_address.find(f.address);
+			if (iter != m_in_flight_by_address.end() && --iter->second == 0) {
+				m_in_flight_by_address.erase(iter);
+			}
+
+			m_in_flight--;
+			m_verified++;
+		}
+	}
+
+	// the slots are free before the callbacks run, a callback may start the next check
+	for (auto &f: finished) {
+		f.done(f.result);
+	}
+}
+
+size_t CredentialVerifier::GetInFlight()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return m_in_flight;
+}
+
+std::string CredentialVerifier::GetStats()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return fmt::format(
+		"verified [{}] refused [{}] in flight [{}] max in flight [{}]",
+		m_verified,
+		m_refused,
+		m_in_flight,
+		m_max_seen_in_flight
+	);
+}
@@ -0,0 +1,87 @@
+#ifndef EQEMU_CREDENTIAL_VERIFIER_H
+#define EQEMU_CREDENTIAL_VERIFIER_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../common/types.h"
+
+typedef struct uv_async_s uv_async_t;
+
+namespace EQ
+{
+	namespace Event
+	{
+		class TaskScheduler;
+	}
+}
+
+struct CredentialCheck {
+	std::string username; // the name the stored hash was made with
+	std::string password;
+	std::string password_hash;
+	int         mode         = 0; // the configured encryption mode
+	int         upgrade_mode = 0; // mode a hash found in an older mode is rewritten in
+};
+
+struct CredentialResult {
+	bool        valid         = false;
+	int         insecure_mode = 0; // the older mode the password matched in, 0 when it matched the configured one
+	std::string upgraded_hash;     // the password hashed in upgrade_mode when insecure_mode is set
+};
+
+// tries the configured mode, then the older modes a hash of this length could be in
+CredentialResult VerifyCredentials(const CredentialCheck &c);
+
+/**
+ * Runs password hash checks on a small pool of worker threads so scrypt and argon2 never
+ * stall the event loop, a restart storm of logins otherwise freezes every connection.
+ *
+ * Results are handed back to the event loop through a uv_async handle, done always runs on
+ * the loop thread. The number of checks in flight is bounded in total and per address, a
+ * check over either limit is refused and done never runs for it.
+ */
+class CredentialVerifier {
+public:
+	typedef std::function<void(const CredentialResult &r)> DoneFn;
+
+	CredentialVerifier();
+	~CredentialVerifier();
+
+	// threads 0 verifies inline on the caller
+	void Start(size_t threads, size_t max_in_flight, size_t max_in_flight_per_address);
+	void Stop();
+
+	bool Verify(const std::string &address, CredentialCheck check, DoneFn done);
+
+	size_t GetInFlight();
+	std::string GetStats();
+
+private:
+	struct Finished {
+		std::string      address;
+		CredentialResult result;
+		DoneFn           done;
+	};
+
+	void Deliver();
+
+	std::unique_ptr<EQ::Event::TaskScheduler> m_workers;
+	uv_async_t                                *m_async;
+	size_t                                    m_max_in_flight;
+	size_t                                    m_max_in_flight_per_address;
+
+	std::mutex                              m_lock;
+	std::vector<Finished>                   m_finished;
+	std::unordered_map<std::string, size_t> m_in_flight_by_address;
+	size_t                                  m_in_flight;
+
+	uint64 m_verified;
+	uint64 m_refused;
+	size_t m_max_seen_in_flight;
+};
+
+#endif
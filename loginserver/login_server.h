@@ -3,6 +3,7 @@
 
 #include <utility>
 #include "../common/json_config.h"
+#include "credential_verifier.h"
 #include "encryption.h"
 #include "options.h"
 #include "world_server_manager.h"
@@ -22,6 +23,7 @@ public:
 	Options                            options;
 	WorldServerManager                 *server_manager;
 	ClientManager                      *client_manager{};
+	CredentialVerifier                 credential_verifier;
 };
 
 #endif
@@ -15,6 +15,7 @@
 #include "../common/database.h"
 #include "../common/events/player_event_logs.h"
 #include "../common/zone_store.h"
+#include <algorithm>
 #include <time.h>
 #include <stdlib.h>
 #include <string>
@@ -128,6 +129,11 @@ void LoadServerConfig()
 #endif
 
 	server.options.AllowTokenLogin(server.config.GetVariableBool("security", "allow_token_login", false));
+	server.options.HashThreads(server.config.GetVariableInt("security", "hash_threads", 2));
+	server.options.MaxPendingLogins(server.config.GetVariableInt("security", "max_pending_logins", 64));
+	server.options.MaxPendingLoginsPerAddress(
+		server.config.GetVariableInt("security", "max_pending_logins_per_address", 4)
+	);
 }
 
 void start_web_server()
@@ -196,6 +202,12 @@ int main(int argc, char **argv)
 		return 1;
 	}
 
+	server.credential_verifier.Start(
+		std::max(server.options.GetHashThreads(), 0),
+		std::max(server.options.GetMaxPendingLogins(), 1),
+		std::max(server.options.GetMaxPendingLoginsPerAddress(), 1)
+	);
+
 	LogInfo("Client Manager Init");
 	server.client_manager = new ClientManager();
 	if (!server.client_manager) {
@@ -244,6 +256,9 @@ int main(int argc, char **argv)
 	);
 	LogInfo("[Config] [Security] GetEncryptionMode [{}]", server.options.GetEncryptionMode());
 	LogInfo("[Config] [Security] IsTokenLoginAllowed [{}]", server.options.IsTokenLoginAllowed());
+	LogInfo("[Config] [Security] HashThreads [{}]", server.options.GetHashThreads());
+	LogInfo("[Config] [Security] MaxPendingLogins [{}]", server.options.GetMaxPendingLogins());
+	LogInfo("[Config] [Security] MaxPendingLoginsPerAddress [{}]", server.options.GetMaxPendingLoginsPerAddress());
 
 	Timer keepalive(INTERSERVER_TIMER); // does auto-reconnect
 
@@ -270,6 +285,9 @@ int main(int argc, char **argv)
 
 	LogInfo("Server Shutdown");
 
+	LogInfo("Credential Verifier Shutdown [{}]", server.credential_verifier.GetStats());
+	server.credential_verifier.Stop();
+
 	LogInfo("Client Manager Shutdown");
 	delete server.client_manager;
 
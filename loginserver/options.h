@@ -10,7 +10,10 @@ public:
 		m_encryption_mode(14),
 		m_reject_duplicate_servers(false),
 		m_allow_token_login(false),
-		m_auto_create_accounts(false) {}
+		m_auto_create_accounts(false),
+		m_hash_threads(2),
+		m_max_pending_logins(64),
+		m_max_pending_logins_per_address(4) {}
 
 	inline void AllowUnregistered(bool b) { m_allow_unregistered = b; }
 	inline void DisplayExpansions(bool b) { m_display_expansions = b; }
@@ -36,6 +39,12 @@ public:
 	inline void SetWorldDevTestServersListBottom(bool list_bottom) { m_world_dev_list_bottom = list_bottom; }
 	inline bool IsWorldSpecialCharacterStartListBottom() const { return m_special_char_list_bottom; }
 	inline void SetWorldSpecialCharacterStartListBottom(bool list_bottom) { m_special_char_list_bottom = list_bottom; }
+	inline void HashThreads(int i) { m_hash_threads = i; }
+	inline int GetHashThreads() const { return m_hash_threads; }
+	inline void MaxPendingLogins(int i) { m_max_pending_logins = i; }
+	inline int GetMaxPendingLogins() const { return m_max_pending_logins; }
+	inline void MaxPendingLoginsPerAddress(int i) { m_max_pending_logins_per_address = i; }
+	inline int GetMaxPendingLoginsPerAddress() const { return m_max_pending_logins_per_address; }
 
 private:
 	bool        m_allow_unregistered;
@@ -48,6 +57,9 @@ private:
 	bool        m_auto_create_accounts;
 	int         m_encryption_mode;
 	int         m_max_expansions_mask;
+	int         m_hash_threads;
+	int         m_max_pending_logins;
+	int         m_max_pending_logins_per_address;
 	std::string m_eqemu_loginserver_address;
 	std::string m_default_loginserver_name;
 };
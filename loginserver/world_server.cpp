@@ -21,6 +21,7 @@ WorldServer::WorldServer(std::shared_ptr<EQ::Net::ServertalkServerConnection> wo
 	m_is_server_authorized_to_list = false;
 	m_is_server_trusted            = false;
 	m_is_server_logged_in          = false;
+	m_alive                        = std::make_shared<bool>(true);
 
 	worldserver_connection->OnMessage(
 		ServerOP_NewLSInfo,
@@ -394,30 +395,88 @@ void WorldServer::HandleNewWorldserver(LoginserverNewWorldRequest *req)
 	c.long_name  = m_server_long_name;
 	c.short_name = m_server_short_name;
 
-	LoginServerAdminsRepository::LoginServerAdmins admin;
-
 	// Handle Admin Authentication
 	if (!m_account_name.empty() && !m_account_password.empty()) {
-		admin = LoginServerAdminsRepository::GetByName(database, m_account_name);
-
-		LoginWorldAdminAccountContext ac;
-		ac.id            = admin.id;
-		ac.username      = m_account_name;
-		ac.password      = m_account_password;
-		ac.password_hash = admin.account_password;
-
-		if (admin.id && WorldServer::ValidateWorldServerAdminLogin(ac, admin)) {
-			LogDebug(
-				"Authenticated world admin [{}] ({}) for world [{}]",
-				m_account_name,
-				admin.id,
-				m_server_short_name
+		auto admin = LoginServerAdminsRepository::GetByName(database, m_account_name);
+		if (admin.id) {
+			auto encryption_mode = server.options.GetEncryptionMode();
+
+			CredentialCheck check;
+			check.username      = m_account_name;
+			check.password      = m_account_password;
+			check.password_hash = admin.account_password;
+			check.mode          = encryption_mode;
+			check.upgrade_mode  = std::max<int>(encryption_mode, EncryptionModeArgon2);
+
+			// registration finishes once the hash is checked on a worker, the world may disconnect before then
+			std::weak_ptr<bool> alive   = m_alive;
+			auto                request = *req;
+
+			bool queued = server.credential_verifier.Verify(
+				m_connection->Handle()->RemoteIP(),
+				check,
+				[this, alive, request, c, admin, check](const CredentialResult &r) {
+					if (alive.expired()) {
+						return;
+					}
+
+					auto context = c;
+					AuthenticateWorldAdmin(admin, check.upgrade_mode, r, context);
+					FinishNewWorldserver(request, context);
+				}
 			);
-			c.admin_id = admin.id;
-			m_is_server_authorized_to_list = true;
+
+			// a world registering is rare enough to check inline rather than leave it unauthenticated
+			if (!queued) {
+				LogWarning("Verifying world admin [{}] inline, too many logins are being verified", m_account_name);
+				AuthenticateWorldAdmin(admin, check.upgrade_mode, VerifyCredentials(check), c);
+				FinishNewWorldserver(*req, c);
+			}
+
+			return;
 		}
 	}
 
+	FinishNewWorldserver(*req, c);
+}
+
+void WorldServer::AuthenticateWorldAdmin(
+	LoginServerAdminsRepository::LoginServerAdmins admin,
+	int upgrade_mode,
+	const CredentialResult &r,
+	LoginWorldContext &c
+)
+{
+	if (!r.valid) {
+		return;
+	}
+
+	if (r.insecure_mode > 0 && !r.upgraded_hash.empty()) {
+		LogInfo(
+			"Updated insecure world_admin_username [{}] from mode [{}] ({}) to mode [{}] ({})",
+			m_account_name,
+			GetEncryptionByModeId(r.insecure_mode),
+			r.insecure_mode,
+			GetEncryptionByModeId(upgrade_mode),
+			upgrade_mode
+		);
+
+		admin.account_password = r.upgraded_hash;
+		LoginServerAdminsRepository::UpdateOne(database, admin);
+	}
+
+	LogDebug(
+		"Authenticated world admin [{}] ({}) for world [{}]",
+		m_account_name,
+		admin.id,
+		m_server_short_name
+	);
+	c.admin_id = admin.id;
+	m_is_server_authorized_to_list = true;
+}
+
+void WorldServer::FinishNewWorldserver(LoginserverNewWorldRequest req, LoginWorldContext c)
+{
 	auto world = LoginWorldServersRepository::GetFromWorldContext(database, c);
 	if (!world.id) {
 		if (!server.options.IsUnregisteredAllowed()) {
@@ -475,11 +534,11 @@ void WorldServer::HandleNewWorldserver(LoginserverNewWorldRequest *req)
 	LoginWorldServersRepository::UpdateOne(database, world);
 
 	WorldServer::FormatWorldServerName(
-		req->server_long_name,
+		req.server_long_name,
 		m_server_list_type_id
 	);
 
-	m_server_long_name = req->server_long_name;
+	m_server_long_name = req.server_long_name;
 }
 
 void WorldServer::HandleWorldserverStatusUpdate(LoginserverWorldStatusUpdate *u)
@@ -627,61 +686,6 @@ bool WorldServer::HandleNewWorldserverValidation(LoginserverNewWorldRequest *r)
 	return true;
 }
 
-bool WorldServer::ValidateWorldServerAdminLogin(
-	LoginWorldAdminAccountContext &c,
-	LoginServerAdminsRepository::LoginServerAdmins &admin
-)
-{
-	auto encryption_mode = server.options.GetEncryptionMode();
-	if (eqcrypt_verify_hash(c.username, c.password, c.password_hash, encryption_mode)) {
-		return true;
-	}
-
-	if (encryption_mode < EncryptionModeArgon2) {
-		encryption_mode = EncryptionModeArgon2;
-	}
-
-	uint32 insecure_source_encryption_mode = 0;
-	auto   verify_encryption               = [&](int start, int end) {
-		for (int i = start; i <= end; ++i) {
-			if (i != encryption_mode && eqcrypt_verify_hash(c.username, c.password, c.password_hash, i)) {
-				LogDebug("Checking for [{}] world admin", GetEncryptionByModeId(i));
-				insecure_source_encryption_mode = i;
-			}
-		}
-	};
-
-	switch (c.password_hash.length()) {
-		case CryptoHash::md5_hash_length:
-			verify_encryption(EncryptionModeMD5, EncryptionModeMD5Triple);
-			break;
-		case CryptoHash::sha1_hash_length:
-			verify_encryption(EncryptionModeSHA, EncryptionModeSHATriple);
-			break;
-		case CryptoHash::sha512_hash_length:
-			verify_encryption(EncryptionModeSHA512, EncryptionModeSHA512Triple);
-			break;
-	}
-
-	if (insecure_source_encryption_mode > 0) {
-		LogInfo(
-			"Updated insecure world_admin_username [{}] from mode [{}] ({}) to mode [{}] ({})",
-			c.username,
-			GetEncryptionByModeId(insecure_source_encryption_mode),
-			insecure_source_encryption_mode,
-			GetEncryptionByModeId(encryption_mode),
-			encryption_mode
-		);
-
-		admin.account_password = eqcrypt_hash(c.username, c.password, encryption_mode);
-		LoginServerAdminsRepository::UpdateOne(database, admin);
-
-		return true;
-	}
-
-	return false;
-}
-
 void WorldServer::SerializeForClientServerList(SerializeBuffer &out, bool use_local_ip, LSClientVersion version) const
 {
 	// see LoginClientServerData_Struct
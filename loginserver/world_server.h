@@ -8,6 +8,7 @@
 #include "../common/event/timer.h"
 #include "login_types.h"
 #include "client.h"
+#include "credential_verifier.h"
 #include "../common/repositories/login_server_admins_repository.h"
 #include <string>
 #include <memory>
@@ -47,10 +48,6 @@ public:
 	void HandleWorldserverStatusUpdate(LoginserverWorldStatusUpdate *u);
 	bool HandleNewWorldserverValidation(LoginserverNewWorldRequest *r);
 	void SendClientAuthToWorld(Client *c);
-	static bool ValidateWorldServerAdminLogin(
-		LoginWorldAdminAccountContext &c,
-		LoginServerAdminsRepository::LoginServerAdmins &admin
-	);
 	void SerializeForClientServerList(class SerializeBuffer &out, bool use_local_ip, LSClientVersion version) const;
 
 private:
@@ -61,6 +58,14 @@ private:
 	void ProcessUserToWorldResponse(uint16_t opcode, const EQ::Net::Packet &packet);
 	void ProcessLSAccountUpdate(uint16_t opcode, const EQ::Net::Packet &packet);
 
+	void AuthenticateWorldAdmin(
+		LoginServerAdminsRepository::LoginServerAdmins admin,
+		int upgrade_mode,
+		const CredentialResult &r,
+		LoginWorldContext &c
+	);
+	void FinishNewWorldserver(LoginserverNewWorldRequest req, LoginWorldContext c);
+
 	std::shared_ptr<EQ::Net::ServertalkServerConnection> m_connection;
 
 	unsigned int m_zones_booted;
@@ -82,6 +87,8 @@ private:
 	bool         m_is_server_logged_in;
 	bool         m_is_server_trusted; // this is primarily for worldserver being able to push updates to the loginserver
 
+	std::shared_ptr<bool> m_alive; // admin checks finishing after a disconnect hold a weak copy
+
 	static void FormatWorldServerName(char *name, int8 server_list_type);
 };
 
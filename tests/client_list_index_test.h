@@ -0,0 +1,387 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_CLIENT_LIST_INDEX_H
+#define __EQEMU_TESTS_CLIENT_LIST_INDEX_H
+
+#include "cppunit/cpptest.h"
+#include "../common/strings.h"
+#include "../world/client_list_index.h"
+#include <list>
+#include <memory>
+#include <random>
+#include <strings.h>
+#include <vector>
+
+class ClientListIndexTest : public Test::Suite {
+	typedef void(ClientListIndexTest::*TestFunction)(void);
+public:
+	ClientListIndexTest() {
+		TEST_ADD(ClientListIndexTest::ListOrderTest);
+		TEST_ADD(ClientListIndexTest::NameTest);
+		TEST_ADD(ClientListIndexTest::UpdateTest);
+		TEST_ADD(ClientListIndexTest::GuildZoneTest);
+		TEST_ADD(ClientListIndexTest::LookupTest);
+		TEST_ADD(ClientListIndexTest::WhoTest);
+		TEST_ADD(ClientListIndexTest::WhoLoadTest);
+	}
+
+	~ClientListIndexTest() {
+	}
+
+	private:
+
+	// stands in for ClientListEntry, the index only ever reads the keys it is handed
+	struct Entry {
+		uint32      id;
+		std::string name;
+		uint32      account_id;
+		uint32      character_id;
+		uint32      ls_id;
+		uint32      guild_id;
+		uint32      zone_id;
+		bool        online   = true;
+		uint8       level    = 1;
+		uint8       class_id = 1;
+		uint16      race     = 1;
+		bool        gm       = false;
+		bool        lfg      = false;
+	};
+
+	// an owning list and its index the way ClientList keeps them
+	struct List {
+		std::list<std::unique_ptr<Entry>> entries;
+		ClientListIndex<Entry>            index;
+		int64                             front_order = 0;
+		int64                             back_order  = 0;
+
+		Entry *Add(Entry e, bool front) {
+			auto p = new Entry(e);
+			if (front) {
+				entries.emplace_front(p);
+				index.Add(p, --front_order, Keys(p));
+			}
+			else {
+				entries.emplace_back(p);
+				index.Add(p, back_order++, Keys(p));
+			}
+
+			return p;
+		}
+
+		void Remove(Entry *e) {
+			index.Remove(e);
+			entries.remove_if([e](const std::unique_ptr<Entry> &p) { return p.get() == e; });
+		}
+
+		void Changed(Entry *e) {
+			index.Update(e, Keys(e));
+		}
+	};
+
+	static ClientListKeys Keys(Entry *e) {
+		ClientListKeys k;
+		k.id           = e->id;
+		k.name         = Strings::ToLower(e->name);
+		k.account_id   = e->account_id;
+		k.character_id = e->character_id;
+		k.ls_id        = e->ls_id;
+		k.guild_id     = e->guild_id;
+		k.zone_id      = e->zone_id;
+		k.online       = e->online;
+		k.level        = e->level;
+		k.class_id     = e->class_id;
+		k.race         = e->race;
+		k.gm           = e->gm;
+		k.lfg          = e->lfg;
+		return k;
+	}
+
+	// the walks ClientList did before the index
+	static Entry *ScanName(const List &l, const char *name) {
+		for (auto &e : l.entries) {
+			if (strcasecmp(e->name.c_str(), name) == 0) {
+				return e.get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	static Entry *ScanAccount(const List &l, uint32 account_id) {
+		for (auto &e : l.entries) {
+			if (e->account_id == account_id) {
+				return e.get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	static std::vector<Entry *> ScanGuild(const List &l, uint32 guild_id) {
+		std::vector<Entry *> out;
+		for (auto &e : l.entries) {
+			if (e->guild_id == guild_id) {
+				out.push_back(e.get());
+			}
+		}
+
+		return out;
+	}
+
+	// the entry by entry check a who query did before the index
+	static std::vector<Entry *> ScanWho(const List &l, const ClientListWhoFilter &f) {
+		std::vector<Entry *> out;
+		for (auto &e : l.entries) {
+			bool text = !f.text ||
+				std::find(f.zones.begin(), f.zones.end(), e->zone_id) != f.zones.end() ||
+				std::find(f.guilds.begin(), f.guilds.end(), e->guild_id) != f.guilds.end() ||
+				strncasecmp(e->name.c_str(), f.name_prefix.c_str(), f.name_prefix.size()) == 0;
+
+			if (
+				e->online && text &&
+				(f.class_id < 0 || e->class_id == f.class_id) &&
+				(f.race < 0 || e->race == f.race) &&
+				(f.level_low < 0 || (e->level >= f.level_low && e->level <= f.level_high)) &&
+				(!f.gm || e->gm) &&
+				(!f.lfg || e->lfg)
+			) {
+				out.push_back(e.get());
+			}
+		}
+
+		return out;
+	}
+
+	// a server's worth of characters spread over levels, classes, races, zones and guilds
+	static void Populate(List &l, uint32 count, std::mt19937 &rng) {
+		for (uint32 i = 1; i <= count; ++i) {
+			Entry e{i, fmt::format("Char{}", i), i, i, i, static_cast<uint32>(rng() % 200), static_cast<uint32>(rng() % 300)};
+			e.online   = rng() % 10 != 0;
+			e.level    = static_cast<uint8>(rng() % 65 + 1);
+			e.class_id = static_cast<uint8>(rng() % 16 + 1);
+			e.race     = static_cast<uint16>(rng() % 14 + 1);
+			e.gm       = rng() % 100 == 0;
+			e.lfg      = rng() % 8 == 0;
+			l.Add(e, rng() % 2 == 0);
+		}
+	}
+
+	// the kinds of /who all people type, one of them picked at random
+	static ClientListWhoFilter RandomWho(std::mt19937 &rng) {
+		ClientListWhoFilter f;
+		switch (rng() % 7) {
+			case 0:
+				break;
+			case 1:
+				f.level_low  = static_cast<int>(rng() % 60 + 1);
+				f.level_high = f.level_low + static_cast<int>(rng() % 6);
+				break;
+			case 2:
+				f.class_id = static_cast<int>(rng() % 16 + 1);
+				break;
+			case 3:
+				f.race       = static_cast<int>(rng() % 14 + 1);
+				f.level_low  = 60;
+				f.level_high = 65;
+				break;
+			case 4:
+				f.gm = true;
+				break;
+			case 5:
+				f.lfg        = true;
+				f.level_low  = static_cast<int>(rng() % 50 + 1);
+				f.level_high = f.level_low + 10;
+				break;
+			default:
+				f.text        = true;
+				f.zones       = {static_cast<uint32>(rng() % 300)};
+				f.guilds      = {static_cast<uint32>(rng() % 200)};
+				f.name_prefix = fmt::format("char{}", rng() % 500 + 1);
+				break;
+		}
+
+		return f;
+	}
+
+	void ListOrderTest() {
+		List l;
+		auto back  = l.Add({1, "", 10, 0, 100, 0, 0}, false);
+		auto front = l.Add({2, "", 10, 0, 100, 0, 0}, true);
+		auto last  = l.Add({3, "", 10, 0, 100, 0, 0}, false);
+
+		TEST_ASSERT(l.index.FindByAccountID(10) == front);
+		TEST_ASSERT(l.index.FindByAccountID(10) == ScanAccount(l, 10));
+
+		auto with_ls = l.index.WithLSID(100);
+		TEST_ASSERT_EQUALS(with_ls.size(), 3u);
+		TEST_ASSERT(with_ls[0] == front && with_ls[1] == back && with_ls[2] == last);
+
+		l.Remove(front);
+		TEST_ASSERT(l.index.FindByAccountID(10) == back);
+
+		l.Remove(back);
+		l.Remove(last);
+		TEST_ASSERT(l.index.FindByAccountID(10) == nullptr);
+		TEST_ASSERT_EQUALS(l.index.Size(), 0u);
+	}
+
+	void NameTest() {
+		List l;
+		auto e = l.Add({1, "Soandso", 10, 20, 30, 0, 0}, false);
+
+		TEST_ASSERT(l.index.FindByName("soandso") == e);
+		TEST_ASSERT(l.index.FindByName(Strings::ToLower("SOANDSO")) == e);
+		TEST_ASSERT(l.index.FindByName("soand") == nullptr);
+		TEST_ASSERT(l.index.FindByID(1) == e);
+		TEST_ASSERT(l.index.FindByCharacterID(20) == e);
+		TEST_ASSERT(l.index.FindByID(2) == nullptr);
+	}
+
+	void UpdateTest() {
+		List l;
+		auto e = l.Add({1, "Soandso", 10, 20, 30, 5, 202}, false);
+
+		// camping clears the character
+		e->name         = "";
+		e->character_id = 0;
+		e->zone_id      = 0;
+		l.Changed(e);
+
+		TEST_ASSERT(l.index.FindByName("soandso") == nullptr);
+		TEST_ASSERT(l.index.FindByCharacterID(20) == nullptr);
+		TEST_ASSERT(l.index.FindByCharacterID(0) == e);
+		TEST_ASSERT(l.index.InZone(202).empty());
+
+		e->name         = "Other";
+		e->character_id = 21;
+		l.Changed(e);
+		TEST_ASSERT(l.index.FindByName("other") == e);
+		TEST_ASSERT(l.index.FindByCharacterID(0) == nullptr);
+
+		Entry stranger{9, "Stranger", 1, 1, 1, 1, 1};
+		TEST_ASSERT(!l.index.Update(&stranger, Keys(&stranger)));
+		TEST_ASSERT(l.index.FindByName("stranger") == nullptr);
+	}
+
+	void GuildZoneTest() {
+		List l;
+		std::mt19937 rng(3);
+		for (uint32 i = 1; i <= 200; ++i) {
+			l.Add({i, fmt::format("char{}", i), i, i, i, static_cast<uint32>(rng() % 8), static_cast<uint32>(rng() % 4)}, rng() % 2 == 0);
+		}
+
+		for (uint32 g = 0; g < 8; ++g) {
+			TEST_ASSERT(l.index.InGuild(g) == ScanGuild(l, g));
+		}
+
+		for (auto &e : l.entries) {
+			e->guild_id = rng() % 8;
+			l.Changed(e.get());
+		}
+
+		for (uint32 g = 0; g < 8; ++g) {
+			TEST_ASSERT(l.index.InGuild(g) == ScanGuild(l, g));
+		}
+
+		size_t in_zones = 0;
+		for (uint32 z = 0; z < 4; ++z) {
+			for (auto e : l.index.InZone(z)) {
+				TEST_ASSERT_EQUALS(e->zone_id, z);
+				in_zones++;
+			}
+		}
+
+		TEST_ASSERT_EQUALS(in_zones, l.entries.size());
+	}
+
+	// the routing lookups world does for tells and invites: a name and an account lookup per
+	// message, some for names that aren't online, benchmark:client-list times the same lookups
+	void LookupTest() {
+		const uint32 online  = 3000;
+		const int    lookups = 5000;
+
+		List         l;
+		std::mt19937 rng(11);
+		for (uint32 i = 1; i <= online; ++i) {
+			l.Add({i, fmt::format("Char{}", i), i, i, i, static_cast<uint32>(rng() % 50), static_cast<uint32>(rng() % 100)}, rng() % 2 == 0);
+		}
+
+		std::vector<Entry *> scanned;
+		std::vector<Entry *> indexed;
+		for (int i = 0; i < lookups; ++i) {
+			auto name = fmt::format("char{}", rng() % (online + 100) + 1);
+			scanned.push_back(ScanName(l, name.c_str()));
+			scanned.push_back(ScanAccount(l, i % online));
+			indexed.push_back(l.index.FindByName(Strings::ToLower(name)));
+			indexed.push_back(l.index.FindByAccountID(i % online));
+		}
+
+		TEST_ASSERT(scanned == indexed);
+	}
+
+	void WhoTest() {
+		List         l;
+		std::mt19937 rng(5);
+		Populate(l, 500, rng);
+
+		for (int i = 0; i < 500; ++i) {
+			auto f = RandomWho(rng);
+			TEST_ASSERT(l.index.Who(f) == ScanWho(l, f));
+		}
+
+		// characters level, zone and go looking for a group between queries
+		for (auto &e : l.entries) {
+			if (rng() % 3 == 0) {
+				e->level   = static_cast<uint8>(std::min(e->level + 1, 65));
+				e->zone_id = rng() % 300;
+				e->lfg     = !e->lfg;
+				e->online  = rng() % 10 != 0;
+				l.Changed(e.get());
+			}
+		}
+
+		for (int i = 0; i < 500; ++i) {
+			auto f = RandomWho(rng);
+			TEST_ASSERT(l.index.Who(f) == ScanWho(l, f));
+		}
+
+		ClientListWhoFilter none;
+		none.level_low  = 66;
+		none.level_high = 255;
+		TEST_ASSERT(l.index.Who(none).empty());
+	}
+
+	// 5000 characters online and a stream of /who all queries of every kind, both paths have to
+	// return the same entries in the same order, benchmark:client-list times the same queries
+	void WhoLoadTest() {
+		List         l;
+		std::mt19937 rng(13);
+		Populate(l, 5000, rng);
+
+		bool same = true;
+		for (int i = 0; i < 200 && same; ++i) {
+			auto f = RandomWho(rng);
+			same = l.index.Who(f) == ScanWho(l, f);
+		}
+
+		TEST_ASSERT(same);
+	}
+};
+
+#endif
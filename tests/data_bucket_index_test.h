@@ -0,0 +1,160 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_DATA_BUCKET_INDEX_H
+#define __EQEMU_TESTS_DATA_BUCKET_INDEX_H
+
+#include "cppunit/cpptest.h"
+#include "../common/data_bucket_index.h"
+
+class DataBucketIndexTest : public Test::Suite {
+	typedef void(DataBucketIndexTest::*TestFunction)(void);
+public:
+	DataBucketIndexTest() {
+		TEST_ADD(DataBucketIndexTest::ScopeTest);
+		TEST_ADD(DataBucketIndexTest::MissTest);
+		TEST_ADD(DataBucketIndexTest::ReplaceTest);
+		TEST_ADD(DataBucketIndexTest::ExpiryTest);
+		TEST_ADD(DataBucketIndexTest::EraseIfTest);
+	}
+
+	~DataBucketIndexTest() {
+	}
+
+	private:
+
+	static DataBucketIndex::Bucket MakeBucket(uint64 id, const std::string &key, uint64 character_id, uint32 expires = 0) {
+		DataBucketIndex::Bucket b{};
+		b.id           = id;
+		b.key_         = key;
+		b.value        = key + "_value";
+		b.expires      = expires;
+		b.character_id = character_id;
+		return b;
+	}
+
+	static DataBucketIndex::ScopeRef Scope(const std::string &key, uint64 character_id, uint16 zone_id = 0) {
+		return DataBucketIndex::ScopeRef{ key, 0, character_id, 0, 0, zone_id, 0 };
+	}
+
+	// every scoping column takes part in the lookup
+	void ScopeTest() {
+		DataBucketIndex index;
+		index.Put(MakeBucket(1, "flag", 10));
+		index.Put(MakeBucket(2, "flag", 11));
+
+		auto b = index.Find(Scope("flag", 10));
+		TEST_ASSERT(b != nullptr);
+		TEST_ASSERT_EQUALS(b->id, 1u);
+		TEST_ASSERT_EQUALS(index.Find(Scope("flag", 11))->id, 2u);
+		TEST_ASSERT(index.Find(Scope("flag", 12)) == nullptr);
+		TEST_ASSERT(index.Find(Scope("flag", 10, 5)) == nullptr);
+		TEST_ASSERT(index.Find(Scope("flags", 10)) == nullptr);
+		TEST_ASSERT(index.ContainsId(1));
+		TEST_ASSERT(!index.ContainsId(3));
+	}
+
+	void MissTest() {
+		DataBucketIndex index;
+		index.Put(MakeBucket(0, "missing", 10));
+
+		auto b = index.Find(Scope("missing", 10));
+		TEST_ASSERT(b != nullptr);
+		TEST_ASSERT_EQUALS(b->id, 0u);
+		TEST_ASSERT(!index.ContainsId(0));
+
+		// a written row takes over the scope of its miss
+		index.Put(MakeBucket(7, "missing", 10));
+		TEST_ASSERT_EQUALS(index.Size(), 1u);
+		TEST_ASSERT_EQUALS(index.Find(Scope("missing", 10))->id, 7u);
+		TEST_ASSERT(!index.EraseMiss(Scope("missing", 10)));
+
+		index.Put(MakeBucket(0, "other", 10));
+		TEST_ASSERT(index.EraseMiss(Scope("other", 10)));
+		TEST_ASSERT_EQUALS(index.Size(), 1u);
+	}
+
+	void ReplaceTest() {
+		DataBucketIndex index;
+		index.Put(MakeBucket(1, "flag", 10));
+
+		auto b  = MakeBucket(1, "flag", 10);
+		b.value = "updated";
+		index.Put(b);
+
+		TEST_ASSERT_EQUALS(index.Size(), 1u);
+		TEST_ASSERT_EQUALS(index.Find(Scope("flag", 10))->value, std::string("updated"));
+
+		TEST_ASSERT(index.Erase(Scope("flag", 10)));
+		TEST_ASSERT(!index.ContainsId(1));
+		TEST_ASSERT_EQUALS(index.Size(), 0u);
+	}
+
+	void ExpiryTest() {
+		DataBucketIndex index;
+		index.Put(MakeBucket(1, "soon", 10, 100));
+		index.Put(MakeBucket(2, "later", 10, 200));
+		index.Put(MakeBucket(3, "never", 10));
+
+		// pushed out by a rewrite, the old expiry no longer applies
+		index.Put(MakeBucket(4, "moved", 10, 100));
+		index.Put(MakeBucket(4, "moved", 10, 300));
+
+		TEST_ASSERT_EQUALS(index.EraseExpired(100), 0u);
+		TEST_ASSERT_EQUALS(index.EraseExpired(150), 1u);
+		TEST_ASSERT(index.Find(Scope("soon", 10)) == nullptr);
+		TEST_ASSERT(index.Find(Scope("moved", 10)) != nullptr);
+
+		TEST_ASSERT_EQUALS(index.EraseExpired(1000), 2u);
+		TEST_ASSERT_EQUALS(index.Size(), 1u);
+		TEST_ASSERT(index.Find(Scope("never", 10)) != nullptr);
+
+		// the heap is rebuilt once stale entries outnumber live rows
+		for (uint32 i = 0; i < 1000; ++i) {
+			index.Put(MakeBucket(9, "churn", 10, 500 + i));
+		}
+
+		TEST_ASSERT_EQUALS(index.EraseExpired(1000), 0u);
+		TEST_ASSERT_EQUALS(index.EraseExpired(1500), 1u);
+		TEST_ASSERT_EQUALS(index.Size(), 1u);
+	}
+
+	void EraseIfTest() {
+		DataBucketIndex index;
+		for (uint64 i = 1; i <= 10; ++i) {
+			index.Put(MakeBucket(i, "flag", i % 2));
+		}
+
+		// every row shares a key, only the character sets them apart
+		TEST_ASSERT_EQUALS(index.Size(), 2u);
+
+		for (uint64 i = 1; i <= 10; ++i) {
+			index.Put(MakeBucket(100 + i, "key" + std::to_string(i), i % 2));
+		}
+
+		size_t erased = index.EraseIf([](const DataBucketIndex::Bucket &e) { return e.character_id == 1; });
+		TEST_ASSERT_EQUALS(erased, 6u);
+		TEST_ASSERT_EQUALS(index.Size(), 6u);
+		TEST_ASSERT(index.AnyOf([](const DataBucketIndex::Bucket &e) { return e.character_id == 0; }));
+		TEST_ASSERT(!index.AnyOf([](const DataBucketIndex::Bucket &e) { return e.character_id == 1; }));
+		TEST_ASSERT(!index.ContainsId(9));
+		TEST_ASSERT(index.ContainsId(10));
+	}
+};
+
+#endif
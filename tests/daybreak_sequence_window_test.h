@@ -0,0 +1,160 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_DAYBREAK_SEQUENCE_WINDOW_H
+#define __EQEMU_TESTS_DAYBREAK_SEQUENCE_WINDOW_H
+
+#include "cppunit/cpptest.h"
+#include "../common/net/daybreak_sequence_window.h"
+#include <vector>
+
+class DaybreakSequenceWindowTest : public Test::Suite {
+	typedef void(DaybreakSequenceWindowTest::*TestFunction)(void);
+public:
+	DaybreakSequenceWindowTest() {
+		TEST_ADD(DaybreakSequenceWindowTest::ReplayInOrderTest);
+		TEST_ADD(DaybreakSequenceWindowTest::ReplayReorderTest);
+		TEST_ADD(DaybreakSequenceWindowTest::ReplayLossAndResendTest);
+		TEST_ADD(DaybreakSequenceWindowTest::ReplayWrapTest);
+		TEST_ADD(DaybreakSequenceWindowTest::ReplayWideGapTest);
+		TEST_ADD(DaybreakSequenceWindowTest::AckTest);
+		TEST_ADD(DaybreakSequenceWindowTest::OutOfOrderAckTest);
+	}
+
+	~DaybreakSequenceWindowTest() {
+	}
+
+	private:
+
+	// arrival offsets relative to the first sequence, repeats are duplicates or resends
+	bool Replay(uint16_t start, const std::vector<int> &arrivals, int expected_count) {
+		EQ::Net::DaybreakSequenceWindow<int> queue(4);
+		std::vector<int> delivered;
+		uint16_t sequence_in = start;
+
+		// mirrors DaybreakConnection::ProcessDecodedPacket / ProcessQueue for reliable packets
+		for (auto offset : arrivals) {
+			uint16_t seq  = static_cast<uint16_t>(start + offset);
+			int16_t  diff = static_cast<int16_t>(seq - sequence_in);
+
+			if (diff > 0) {
+				if (!queue.Find(seq)) {
+					queue.Emplace(seq) = offset;
+				}
+			}
+			else if (diff == 0) {
+				queue.Erase(seq);
+				delivered.push_back(offset);
+				sequence_in++;
+
+				while (!queue.Empty()) {
+					auto p = queue.Find(sequence_in);
+					if (!p) {
+						break;
+					}
+
+					delivered.push_back(*p);
+					queue.Erase(sequence_in);
+					sequence_in++;
+				}
+			}
+		}
+
+		if (!queue.Empty() || static_cast<int>(delivered.size()) != expected_count) {
+			return false;
+		}
+
+		for (int i = 0; i < expected_count; ++i) {
+			if (delivered[i] != i) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void ReplayInOrderTest() {
+		TEST_ASSERT(Replay(0, { 0, 1, 2, 3, 4, 5, 6, 7 }, 8));
+	}
+
+	void ReplayReorderTest() {
+		TEST_ASSERT(Replay(100, { 1, 0, 3, 2, 6, 5, 4, 7, 9, 8 }, 10));
+		TEST_ASSERT(Replay(100, { 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 }, 10));
+	}
+
+	void ReplayLossAndResendTest() {
+		// 2 and 5 are dropped and arrive again on resend, 3 is duplicated
+		TEST_ASSERT(Replay(500, { 0, 1, 3, 4, 3, 6, 7, 2, 1, 5, 8, 6, 9 }, 10));
+	}
+
+	void ReplayWrapTest() {
+		TEST_ASSERT(Replay(65530, { 0, 2, 1, 7, 5, 6, 3, 9, 4, 8, 10, 11 }, 12));
+	}
+
+	void ReplayWideGapTest() {
+		// the queue starts at 4 slots and has to grow to hold the whole window
+		std::vector<int> arrivals;
+		for (int i = 999; i >= 0; --i) {
+			arrivals.push_back(i);
+		}
+
+		TEST_ASSERT(Replay(65000, arrivals, 1000));
+	}
+
+	void AckTest() {
+		EQ::Net::DaybreakSequenceWindow<int> sent(4);
+		for (int i = 0; i < 20; ++i) {
+			sent.Emplace(static_cast<uint16_t>(65530 + i)) = i;
+		}
+
+		TEST_ASSERT_EQUALS(sent.Size(), 20);
+		TEST_ASSERT_EQUALS(sent.Head(), 65530);
+
+		// cumulative ack past the wrap drops everything up to and including 3
+		while (!sent.Empty() && static_cast<int16_t>(sent.Head() - 3) <= 0) {
+			sent.Erase(sent.Head());
+		}
+
+		TEST_ASSERT_EQUALS(sent.Size(), 10);
+		TEST_ASSERT_EQUALS(sent.Head(), 4);
+		TEST_ASSERT_EQUALS(*sent.Find(4), 10);
+		TEST_ASSERT(sent.Find(65535) == nullptr);
+	}
+
+	void OutOfOrderAckTest() {
+		EQ::Net::DaybreakSequenceWindow<int> sent(8);
+		for (int i = 0; i < 8; ++i) {
+			sent.Emplace(static_cast<uint16_t>(i)) = i;
+		}
+
+		sent.Erase(2);
+		sent.Erase(1);
+		sent.Erase(7);
+		TEST_ASSERT_EQUALS(sent.Head(), 0);
+		TEST_ASSERT_EQUALS(sent.Tail(), 7);
+
+		sent.Erase(0);
+		TEST_ASSERT_EQUALS(sent.Head(), 3);
+
+		std::vector<int> order;
+		sent.ForEach([&](uint16_t seq, int &v) { order.push_back(v); });
+		TEST_ASSERT(order == std::vector<int>({ 3, 4, 5, 6 }));
+	}
+};
+
+#endif
@@ -0,0 +1,229 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_HATE_LIST_INDEX_H
+#define __EQEMU_TESTS_HATE_LIST_INDEX_H
+
+#include "cppunit/cpptest.h"
+#include "../zone/hate_list.h"
+#include "../zone/hate_list_index_reference.h"
+#include <cstdint>
+#include <list>
+#include <random>
+#include <vector>
+
+class HateListIndexTest : public Test::Suite {
+	typedef void(HateListIndexTest::*TestFunction)(void);
+public:
+	HateListIndexTest() {
+		TEST_ADD(HateListIndexTest::TopTieTest);
+		TEST_ADD(HateListIndexTest::FindTest);
+		TEST_ADD(HateListIndexTest::AliasedEntityTest);
+		TEST_ADD(HateListIndexTest::VisitOrderTest);
+		TEST_ADD(HateListIndexTest::DamageChurnTest);
+	}
+
+	~HateListIndexTest() {
+	}
+
+	private:
+
+	// the hate list never dereferences its mobs in the index, any distinct address will do
+	Mob *FakeMob(int i) {
+		return reinterpret_cast<Mob *>(&m_mobs[i]);
+	}
+
+	struct_HateList *NewEntry(int mob, int64 hate) {
+		auto e = new struct_HateList{};
+		e->entity_on_hatelist = mob >= 0 ? FakeMob(mob) : nullptr;
+		e->stored_hate_amount = hate;
+		return e;
+	}
+
+	static void Free(std::list<struct_HateList *> &l) {
+		for (auto e : l) {
+			delete e;
+		}
+
+		l.clear();
+	}
+
+	void TopTieTest() {
+		HateListIndex<struct_HateList> index;
+		std::list<struct_HateList *>   l;
+		for (int i = 0; i < 5; ++i) {
+			l.push_back(NewEntry(i, i == 0 ? 10 : 50));
+			index.Insert(l.back());
+		}
+
+		TEST_ASSERT(index.Top() == *std::next(l.begin()));
+		TEST_ASSERT(HateListIndexTop(index) == HateListScanTop(l));
+
+		auto last = l.back();
+		last->stored_hate_amount = 51;
+		index.Update(last);
+		TEST_ASSERT(index.Top() == last);
+
+		last->stored_hate_amount = 50;
+		index.Update(last);
+		TEST_ASSERT(index.Top() == *std::next(l.begin()));
+
+		Free(l);
+	}
+
+	void FindTest() {
+		HateListIndex<struct_HateList> index;
+		std::list<struct_HateList *>   l;
+		for (int i = 0; i < 8; ++i) {
+			l.push_back(NewEntry(i, i * 3));
+			index.Insert(l.back());
+		}
+
+		for (int i = 0; i < 8; ++i) {
+			auto e = index.Find(FakeMob(i));
+			TEST_ASSERT(e && e->entity_on_hatelist == FakeMob(i));
+		}
+
+		TEST_ASSERT(index.Find(FakeMob(9)) == nullptr);
+		TEST_ASSERT(index.Find(nullptr) == nullptr);
+
+		auto e = index.Find(FakeMob(3));
+		index.Remove(e);
+		l.remove(e);
+		delete e;
+
+		TEST_ASSERT(index.Find(FakeMob(3)) == nullptr);
+		TEST_ASSERT_EQUALS(index.Size(), 7u);
+
+		Free(l);
+	}
+
+	// scripts can point an entry at a mob that already has one
+	void AliasedEntityTest() {
+		HateListIndex<struct_HateList> index;
+		std::list<struct_HateList *>   l;
+		for (int i = 0; i < 4; ++i) {
+			l.push_back(NewEntry(i, 100));
+			index.Insert(l.back());
+		}
+
+		auto first = l.front();
+		auto last  = l.back();
+		index.SetKey(last, FakeMob(0));
+		TEST_ASSERT(index.Find(FakeMob(0)) == first);
+		TEST_ASSERT(index.Find(FakeMob(3)) == nullptr);
+
+		index.Remove(first);
+		l.remove(first);
+		delete first;
+		TEST_ASSERT(index.Find(FakeMob(0)) == last);
+
+		index.SetKey(last, nullptr);
+		TEST_ASSERT(index.Find(FakeMob(0)) == nullptr);
+
+		Free(l);
+	}
+
+	void VisitOrderTest() {
+		HateListIndex<struct_HateList> index;
+		std::list<struct_HateList *>   l;
+		std::mt19937                   rng(7);
+		for (int i = 0; i < 64; ++i) {
+			l.push_back(NewEntry(i, rng() % 16));
+			index.Insert(l.back());
+		}
+
+		std::vector<struct_HateList *> visited;
+		index.VisitByHate(
+			[&](struct_HateList *e) {
+				visited.push_back(e);
+				return true;
+			}
+		);
+
+		bool ordered = visited.size() == l.size();
+		for (size_t i = 1; ordered && i < visited.size(); ++i) {
+			auto a = visited[i - 1];
+			auto b = visited[i];
+			ordered = a->stored_hate_amount > b->stored_hate_amount ||
+				(a->stored_hate_amount == b->stored_hate_amount && a->sequence < b->sequence);
+		}
+
+		TEST_ASSERT(ordered);
+
+		Free(l);
+	}
+
+	/*
+		100 entry hate list taking damage from random attackers, with attackers dropping off
+		and joining along the way, doing a top hate lookup every tick. Records which entry was on
+		top each tick, benchmark:hate-list times the same churn.
+	*/
+	void DamageChurn(bool indexed, std::vector<uint32> &tops) {
+		const int entries = 100;
+		const int ticks   = 20000;
+
+		HateListIndex<struct_HateList> index;
+		std::list<struct_HateList *>   l;
+		std::mt19937                   rng(42);
+		for (int i = 0; i < entries; ++i) {
+			l.push_back(NewEntry(i, rng() % 1000));
+			index.Insert(l.back());
+		}
+
+		tops.clear();
+		tops.reserve(ticks);
+
+		for (int t = 0; t < ticks; ++t) {
+			int  mob = static_cast<int>(rng() % entries);
+			auto e   = index.Find(FakeMob(mob));
+			if (rng() % 50 == 0) {
+				index.Remove(e);
+				l.remove(e);
+				delete e;
+
+				e = NewEntry(mob, 0);
+				l.push_back(e);
+				index.Insert(e);
+			}
+
+			e->stored_hate_amount += rng() % 500;
+			index.Update(e);
+
+			auto top = indexed ? HateListIndexTop(index) : HateListScanTop(l);
+			tops.push_back(top ? top->sequence : UINT32_MAX);
+		}
+
+		Free(l);
+	}
+
+	void DamageChurnTest() {
+		std::vector<uint32> scan_tops;
+		std::vector<uint32> index_tops;
+
+		DamageChurn(false, scan_tops);
+		DamageChurn(true, index_tops);
+
+		TEST_ASSERT(!scan_tops.empty());
+		TEST_ASSERT(scan_tops == index_tops);
+	}
+
+	char m_mobs[128];
+};
+
+#endif
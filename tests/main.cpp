@@ -32,6 +32,14 @@
 #include "data_verification_test.h"
 #include "skills_util_test.h"
 #include "task_state_test.h"
+#include "daybreak_sequence_window_test.h"
+#include "hate_list_index_test.h"
+#include "water_region_grid_test.h"
+#include "multicast_packet_test.h"
+#include "path_route_cache_test.h"
+#include "data_bucket_index_test.h"
+#include "client_list_index_test.h"
+#include "sleep_wheel_test.h"
 
 const EQEmuConfig *Config;
 EQEmuLogSys       LogSys;
@@ -58,6 +66,14 @@ int main()
 		tests.add(new DataVerificationTest());
 		tests.add(new SkillsUtilsTest());
 		tests.add(new TaskStateTest());
+		tests.add(new DaybreakSequenceWindowTest());
+		tests.add(new HateListIndexTest());
+		tests.add(new WaterRegionGridTest());
+		tests.add(new MulticastPacketTest());
+		tests.add(new PathRouteCacheTest());
+		tests.add(new DataBucketIndexTest());
+		tests.add(new ClientListIndexTest());
+		tests.add(new SleepWheelTest());
 		tests.run(*output, true);
 	}
 	catch (std::exception &ex) {
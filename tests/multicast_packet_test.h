@@ -0,0 +1,271 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_MULTICAST_PACKET_H
+#define __EQEMU_TESTS_MULTICAST_PACKET_H
+
+#include "cppunit/cpptest.h"
+#include "../common/eq_packet.h"
+#include "../common/eq_stream_proxy.h"
+#include "../common/multicast_packet.h"
+#include "../common/struct_strategy.h"
+#include <cstring>
+#include <memory>
+#include <vector>
+
+class MulticastPacketTest : public Test::Suite {
+	typedef void(MulticastPacketTest::*TestFunction)(void);
+public:
+	MulticastPacketTest() {
+		TEST_ADD(MulticastPacketTest::SharedEncodeTest);
+		TEST_ADD(MulticastPacketTest::PlainStreamTest);
+		TEST_ADD(MulticastPacketTest::AckRequiredTest);
+		TEST_ADD(MulticastPacketTest::StreamProxyEncodeTest);
+	}
+
+	~MulticastPacketTest() {
+	}
+
+	private:
+
+	// stands in for a client version's struct strategy: counts its runs and splits each packet in two
+	struct FakeVersion {
+		int encodes = 0;
+	};
+
+	class FakeStream : public EQStreamInterface {
+	public:
+		FakeStream(FakeVersion *version) : m_version(version) { }
+
+		struct Sent {
+			std::vector<unsigned char> data;
+			bool                       ack_req;
+			const EQApplicationPacket  *packet;
+		};
+
+		std::vector<Sent> sent;
+
+		virtual void QueuePacket(const EQApplicationPacket *p, bool ack_req = true) {
+			sent.push_back(Sent{ std::vector<unsigned char>(p->pBuffer, p->pBuffer + p->size), ack_req, p });
+		}
+		virtual void FastQueuePacket(EQApplicationPacket **p, bool ack_req = true) {
+			QueuePacket(*p, ack_req);
+			delete *p;
+			*p = nullptr;
+		}
+		virtual EQApplicationPacket *PopPacket() { return nullptr; }
+		virtual void Close() { }
+		virtual void ReleaseFromUse() { }
+		virtual void RemoveData() { }
+		virtual std::string GetRemoteAddr() const { return std::string(); }
+		virtual uint32 GetRemoteIP() const { return 0; }
+		virtual uint16 GetRemotePort() const { return 0; }
+		virtual bool CheckState(EQStreamState state) { return state == ESTABLISHED; }
+		virtual std::string Describe() const { return "Fake Stream"; }
+		virtual EQStreamState GetState() { return ESTABLISHED; }
+		virtual void SetOpcodeManager(OpcodeManager **opm) { }
+		virtual OpcodeManager *GetOpcodeManager() const { return nullptr; }
+		virtual Stats GetStats() const { return Stats{}; }
+		virtual void ResetStats() { }
+		virtual EQStreamManagerInterface *GetManager() const { return nullptr; }
+
+		virtual const void *GetEncodeKey() const {
+			return m_version ? static_cast<const void *>(m_version) : EQStreamInterface::GetEncodeKey();
+		}
+
+		virtual std::shared_ptr<const EncodedPacketList> Encode(const EQApplicationPacket *p, bool ack_req) const {
+			if (!m_version) {
+				return EQStreamInterface::Encode(p, ack_req);
+			}
+
+			m_version->encodes++;
+			auto packets = std::make_shared<EncodedPacketList>();
+			for (int i = 0; i < 2; ++i) {
+				auto out = std::make_unique<EQApplicationPacket>(p->GetOpcode(), p->size + 1);
+				out->pBuffer[0] = static_cast<unsigned char>(i);
+				memcpy(out->pBuffer + 1, p->pBuffer, p->size);
+				packets->push_back(EncodedPacket{ std::move(out), ack_req });
+			}
+
+			return packets;
+		}
+
+	private:
+		FakeVersion *m_version;
+	};
+
+	/*
+		A patch's struct strategy: its OP_ClientUpdate encoder queues a one byte header through
+		QueuePacket, then hands the packet itself on through FastQueuePacket, the two ways real
+		encoders put packets on the stream.
+	*/
+	template<int Version>
+	class SplitStrategy : public StructStrategy {
+	public:
+		SplitStrategy() {
+			encoders[OP_ClientUpdate] = Split;
+		}
+
+		inline static int encodes = 0;
+
+		virtual std::string Describe() const { return "Split Strategy"; }
+		virtual const EQ::versions::ClientVersion ClientVersion() const { return EQ::versions::ClientVersion::Unknown; }
+
+	private:
+		static void Split(EQApplicationPacket **p, std::shared_ptr<EQStreamInterface> dest, bool ack_req) {
+			encodes++;
+
+			EQApplicationPacket header((*p)->GetOpcode(), 1);
+			header.pBuffer[0] = static_cast<unsigned char>(Version);
+			dest->QueuePacket(&header, ack_req);
+			dest->FastQueuePacket(p, ack_req);
+		}
+	};
+
+	static std::unique_ptr<EQApplicationPacket> MakePacket() {
+		auto app = std::make_unique<EQApplicationPacket>(OP_ClientUpdate, 4);
+		for (int i = 0; i < 4; ++i) {
+			app->pBuffer[i] = static_cast<unsigned char>(10 + i);
+		}
+
+		return app;
+	}
+
+	void SharedEncodeTest() {
+		FakeVersion rof2;
+		FakeVersion titanium;
+
+		std::vector<std::unique_ptr<FakeStream>> streams;
+		for (int i = 0; i < 5; ++i) {
+			streams.push_back(std::make_unique<FakeStream>(i < 3 ? &rof2 : &titanium));
+		}
+
+		auto            app = MakePacket();
+		MulticastPacket packet(app.get(), false);
+		for (auto &s : streams) {
+			packet.QueueTo(s.get());
+		}
+
+		TEST_ASSERT_EQUALS(packet.GetEncodeCount(), 2u);
+		TEST_ASSERT_EQUALS(packet.GetQueueCount(), 5u);
+		TEST_ASSERT_EQUALS(rof2.encodes, 1);
+		TEST_ASSERT_EQUALS(titanium.encodes, 1);
+
+		std::vector<unsigned char> expected = { 1, 10, 11, 12, 13 };
+		for (auto &s : streams) {
+			TEST_ASSERT_EQUALS(s->sent.size(), 2u);
+			TEST_ASSERT(s->sent[1].data == expected);
+		}
+	}
+
+	// streams that don't share a translation still get the packet, one copy each
+	void PlainStreamTest() {
+		FakeStream a(nullptr);
+		FakeStream b(nullptr);
+
+		auto            app = MakePacket();
+		MulticastPacket packet(app.get());
+		packet.QueueTo(&a);
+		packet.QueueTo(&b);
+		packet.QueueTo(nullptr);
+
+		TEST_ASSERT_EQUALS(packet.GetEncodeCount(), 2u);
+		TEST_ASSERT_EQUALS(packet.GetQueueCount(), 2u);
+
+		std::vector<unsigned char> expected = { 10, 11, 12, 13 };
+		TEST_ASSERT_EQUALS(a.sent.size(), 1u);
+		TEST_ASSERT_EQUALS(b.sent.size(), 1u);
+		TEST_ASSERT(a.sent[0].data == expected);
+		TEST_ASSERT(b.sent[0].data == expected);
+	}
+
+	void AckRequiredTest() {
+		FakeVersion version;
+		FakeStream  a(&version);
+		FakeStream  b(nullptr);
+
+		auto            app = MakePacket();
+		MulticastPacket acked(app.get(), true);
+		MulticastPacket unacked(app.get(), false);
+		acked.QueueTo(&a);
+		acked.QueueTo(&b);
+		unacked.QueueTo(&a);
+		unacked.QueueTo(&b);
+
+		TEST_ASSERT_EQUALS(a.sent.size(), 4u);
+		TEST_ASSERT(a.sent[0].ack_req && a.sent[1].ack_req);
+		TEST_ASSERT(!a.sent[2].ack_req && !a.sent[3].ack_req);
+		TEST_ASSERT_EQUALS(b.sent.size(), 2u);
+		TEST_ASSERT(b.sent[0].ack_req);
+		TEST_ASSERT(!b.sent[1].ack_req);
+	}
+
+	// the proxies a zone really queues to, encoding through their struct strategy once per version
+	void StreamProxyEncodeTest() {
+		SplitStrategy<1> rof2;
+		SplitStrategy<2> titanium;
+		SplitStrategy<1>::encodes = 0;
+		SplitStrategy<2>::encodes = 0;
+
+		OpcodeManager *opcodes = nullptr;
+
+		std::vector<std::shared_ptr<FakeStream>>    streams;
+		std::vector<std::unique_ptr<EQStreamProxy>> proxies;
+		for (int i = 0; i < 5; ++i) {
+			auto stream = std::make_shared<FakeStream>(nullptr);
+			streams.push_back(stream);
+
+			std::shared_ptr<EQStreamInterface> owned = stream;
+			const StructStrategy              *structs = i < 3 ? static_cast<const StructStrategy *>(&rof2) : &titanium;
+			proxies.push_back(std::make_unique<EQStreamProxy>(owned, structs, &opcodes));
+		}
+
+		auto            app = MakePacket();
+		MulticastPacket packet(app.get(), false);
+		for (auto &p : proxies) {
+			packet.QueueTo(p.get());
+		}
+
+		TEST_ASSERT_EQUALS(packet.GetEncodeCount(), 2u);
+		TEST_ASSERT_EQUALS(packet.GetQueueCount(), 5u);
+		TEST_ASSERT_EQUALS(SplitStrategy<1>::encodes, 1);
+		TEST_ASSERT_EQUALS(SplitStrategy<2>::encodes, 1);
+
+		std::vector<unsigned char> body = { 10, 11, 12, 13 };
+		for (size_t i = 0; i < streams.size(); ++i) {
+			auto &sent = streams[i]->sent;
+			TEST_ASSERT_EQUALS(sent.size(), 2u);
+			TEST_ASSERT(sent[0].data == std::vector<unsigned char>{ static_cast<unsigned char>(i < 3 ? 1 : 2) });
+			TEST_ASSERT(sent[1].data == body);
+			TEST_ASSERT(!sent[0].ack_req && !sent[1].ack_req);
+		}
+
+		// same version streams are handed the very same encoded packets
+		for (size_t k = 0; k < 2; ++k) {
+			TEST_ASSERT(streams[1]->sent[k].packet == streams[0]->sent[k].packet);
+			TEST_ASSERT(streams[2]->sent[k].packet == streams[0]->sent[k].packet);
+			TEST_ASSERT(streams[4]->sent[k].packet == streams[3]->sent[k].packet);
+			TEST_ASSERT(streams[3]->sent[k].packet != streams[0]->sent[k].packet);
+		}
+
+		// the encoder took a copy, the multicast's packet is untouched
+		TEST_ASSERT(std::vector<unsigned char>(app->pBuffer, app->pBuffer + app->size) == body);
+	}
+};
+
+#endif
@@ -0,0 +1,178 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_PATH_ROUTE_CACHE_H
+#define __EQEMU_TESTS_PATH_ROUTE_CACHE_H
+
+#include "cppunit/cpptest.h"
+#include "../zone/path_request_slot.h"
+#include "../zone/path_route_cache.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class PathRouteCacheTest : public Test::Suite {
+	typedef void(PathRouteCacheTest::*TestFunction)(void);
+public:
+	PathRouteCacheTest() {
+		TEST_ADD(PathRouteCacheTest::HitMissTest);
+		TEST_ADD(PathRouteCacheTest::KeyTest);
+		TEST_ADD(PathRouteCacheTest::EvictionTest);
+		TEST_ADD(PathRouteCacheTest::ThreadedTest);
+		TEST_ADD(PathRouteCacheTest::StaleRequestTest);
+	}
+
+	~PathRouteCacheTest() {
+	}
+
+	private:
+
+	static PathRouteCache::Key MakeKey(uint64_t start, uint64_t end, int flags = 0xF7FF) {
+		PathRouteCache::Key key;
+		key.start_ref = start;
+		key.end_ref   = end;
+		key.flags     = flags;
+		key.max_polys = 256;
+		for (int i = 0; i < PathRouteCache::CostCount; ++i) {
+			key.costs[i] = 1.0f;
+		}
+
+		return key;
+	}
+
+	void HitMissTest() {
+		PathRouteCache        cache(8);
+		std::vector<uint64_t> corridor;
+
+		TEST_ASSERT(!cache.Find(MakeKey(1, 2), corridor));
+		cache.Insert(MakeKey(1, 2), { 1, 5, 9, 2 });
+		TEST_ASSERT(cache.Find(MakeKey(1, 2), corridor));
+		TEST_ASSERT(corridor == std::vector<uint64_t>({ 1, 5, 9, 2 }));
+
+		TEST_ASSERT_EQUALS(cache.GetHits(), 1u);
+		TEST_ASSERT_EQUALS(cache.GetMisses(), 1u);
+	}
+
+	// direction, flags and area costs all change the search, none of them may share a corridor
+	void KeyTest() {
+		PathRouteCache        cache(8);
+		std::vector<uint64_t> corridor;
+
+		cache.Insert(MakeKey(1, 2), { 1, 2 });
+
+		auto costly = MakeKey(1, 2);
+		costly.costs[1] = 3.0f;
+
+		auto longer = MakeKey(1, 2);
+		longer.max_polys = 1024;
+
+		TEST_ASSERT(!cache.Find(MakeKey(2, 1), corridor));
+		TEST_ASSERT(!cache.Find(MakeKey(1, 2, 0xFFFF), corridor));
+		TEST_ASSERT(!cache.Find(costly, corridor));
+		TEST_ASSERT(!cache.Find(longer, corridor));
+		TEST_ASSERT(cache.Find(MakeKey(1, 2), corridor));
+	}
+
+	void EvictionTest() {
+		PathRouteCache        cache(3);
+		std::vector<uint64_t> corridor;
+
+		cache.Insert(MakeKey(1, 0), { 1 });
+		cache.Insert(MakeKey(2, 0), { 2 });
+		cache.Insert(MakeKey(3, 0), { 3 });
+
+		// touching 1 leaves 2 as the oldest
+		TEST_ASSERT(cache.Find(MakeKey(1, 0), corridor));
+		cache.Insert(MakeKey(4, 0), { 4 });
+
+		TEST_ASSERT_EQUALS(cache.Size(), 3u);
+		TEST_ASSERT(!cache.Find(MakeKey(2, 0), corridor));
+		TEST_ASSERT(cache.Find(MakeKey(1, 0), corridor));
+		TEST_ASSERT(cache.Find(MakeKey(3, 0), corridor));
+		TEST_ASSERT(cache.Find(MakeKey(4, 0), corridor));
+
+		cache.SetCapacity(1);
+		TEST_ASSERT_EQUALS(cache.Size(), 1u);
+		TEST_ASSERT(cache.Find(MakeKey(4, 0), corridor));
+
+		cache.SetCapacity(0);
+		cache.Insert(MakeKey(5, 0), { 5 });
+		TEST_ASSERT_EQUALS(cache.Size(), 0u);
+	}
+
+	void ThreadedTest() {
+		PathRouteCache           cache(64);
+		std::atomic<int>         wrong(0);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 4; ++t) {
+			threads.emplace_back(
+				[&cache, &wrong, t]() {
+					std::vector<uint64_t> corridor;
+					for (uint64_t i = 0; i < 5000; ++i) {
+						auto key = MakeKey(i % 100, t);
+						if (!cache.Find(key, corridor)) {
+							cache.Insert(key, { i % 100, static_cast<uint64_t>(t) });
+						}
+						else if (corridor.size() != 2 || corridor[0] != i % 100) {
+							wrong++;
+						}
+					}
+				}
+			);
+		}
+
+		for (auto &t : threads) {
+			t.join();
+		}
+
+		TEST_ASSERT_EQUALS(cache.GetHits() + cache.GetMisses(), 20000u);
+		TEST_ASSERT(cache.Size() <= 64u);
+		TEST_ASSERT_EQUALS(wrong.load(), 0);
+	}
+
+	// the order MobMovementManager sees when a mob is sent somewhere else while its ground search runs
+	void StaleRequestTest() {
+		uint32_t        next_id = 0;
+		PathRequestSlot slot;
+
+		// ground search submitted, then the mob re-navigates by flying, swimming or a straight move
+		uint32_t ground = PathRequestSlot::NextId(next_id);
+		slot.Submit(ground);
+		TEST_ASSERT(slot.Pending());
+		slot.Cancel();
+		TEST_ASSERT(!slot.Pending());
+		TEST_ASSERT(!slot.Accept(ground));
+
+		// a newer ground search replaces the older one, only the newer one lands and only once
+		uint32_t older = PathRequestSlot::NextId(next_id);
+		slot.Submit(older);
+		uint32_t newer = PathRequestSlot::NextId(next_id);
+		slot.Submit(newer);
+		TEST_ASSERT(!slot.Accept(older));
+		TEST_ASSERT(slot.Accept(newer));
+		TEST_ASSERT(!slot.Accept(newer));
+		TEST_ASSERT(!slot.Pending());
+
+		// the counter skips 0 when it wraps, 0 is the empty slot
+		next_id = UINT32_MAX;
+		TEST_ASSERT_EQUALS(PathRequestSlot::NextId(next_id), 1u);
+		TEST_ASSERT(!slot.Accept(0));
+	}
+};
+
+#endif
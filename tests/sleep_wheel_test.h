@@ -0,0 +1,306 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_SLEEP_WHEEL_H
+#define __EQEMU_TESTS_SLEEP_WHEEL_H
+
+#include "cppunit/cpptest.h"
+#include "../zone/sleep_wheel.h"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+class SleepWheelTest : public Test::Suite {
+	typedef void(SleepWheelTest::*TestFunction)(void);
+public:
+	SleepWheelTest() {
+		TEST_ADD(SleepWheelTest::WakeTimeTest);
+		TEST_ADD(SleepWheelTest::CancelTest);
+		TEST_ADD(SleepWheelTest::FarFutureTest);
+		TEST_ADD(SleepWheelTest::ModelTest);
+		TEST_ADD(SleepWheelTest::IdleZoneTest);
+	}
+
+	~SleepWheelTest() {
+	}
+
+	private:
+
+	// every entity is woken no earlier than its wake time and less than one slot after it
+	void WakeTimeTest() {
+		SleepWheel          wheel(1000);
+		std::vector<uint64> wake(600);
+		std::vector<uint64> woken_at(600, 0);
+
+		std::mt19937 rng(7);
+		for (uint16 id = 0; id < wake.size(); ++id) {
+			wake[id] = 1000 + 1 + rng() % 40000;
+			wheel.Schedule(id, wake[id]);
+		}
+
+		TEST_ASSERT(wheel.Size() == wake.size());
+
+		std::vector<uint16> woken;
+		for (uint64 now = 1001; now <= 42000; ++now) {
+			woken.clear();
+			wheel.Advance(now, woken);
+			for (auto id: woken) {
+				TEST_ASSERT(woken_at[id] == 0);
+				woken_at[id] = now;
+			}
+		}
+
+		bool in_window = true;
+		for (size_t id = 0; id < wake.size(); ++id) {
+			in_window = in_window && woken_at[id] >= wake[id] && woken_at[id] < wake[id] + SleepWheel::Resolution;
+		}
+
+		TEST_ASSERT(in_window);
+		TEST_ASSERT(wheel.Size() == 0);
+	}
+
+	void CancelTest() {
+		SleepWheel wheel(0);
+		wheel.Schedule(1, 100);
+		wheel.Schedule(2, 100);
+		wheel.Schedule(3, 5000);
+
+		TEST_ASSERT(wheel.IsScheduled(2));
+		TEST_ASSERT(wheel.Cancel(2));
+		TEST_ASSERT(!wheel.Cancel(2));
+		TEST_ASSERT(!wheel.IsScheduled(2));
+		TEST_ASSERT(!wheel.IsScheduled(40));
+
+		// moving an entity keeps one entry for it
+		wheel.Schedule(3, 200);
+		TEST_ASSERT(wheel.Size() == 2);
+		TEST_ASSERT(wheel.GetWakeTime(3) == 200);
+
+		std::vector<uint16> woken;
+		wheel.Advance(150, woken);
+		TEST_ASSERT((woken == std::vector<uint16>{1}));
+
+		woken.clear();
+		wheel.Advance(10000, woken);
+		TEST_ASSERT((woken == std::vector<uint16>{3}));
+		TEST_ASSERT(wheel.Size() == 0);
+
+		// a wake time already passed is handed back on the next advance
+		wheel.Schedule(4, 50);
+		woken.clear();
+		wheel.Advance(10000, woken);
+		TEST_ASSERT(woken.empty());
+		wheel.Advance(10000 + SleepWheel::Resolution, woken);
+		TEST_ASSERT((woken == std::vector<uint16>{4}));
+	}
+
+	// wake times past what the levels cover are re-filed until they come due
+	void FarFutureTest() {
+		const uint64 start = 123456;
+		const uint64 wake  = start + 5ull * 3600 * 1000;
+
+		SleepWheel wheel(start);
+		wheel.Schedule(9, wake);
+		wheel.Schedule(10, start + 90000);
+
+		std::vector<uint16> woken;
+		uint64              now = start;
+		while (now + 1000 < wake) {
+			now += 1000;
+			wheel.Advance(now, woken);
+		}
+
+		TEST_ASSERT((woken == std::vector<uint16>{10}));
+		TEST_ASSERT(wheel.IsScheduled(9));
+
+		wheel.Advance(wake + SleepWheel::Resolution, woken);
+		TEST_ASSERT((woken == std::vector<uint16>{10, 9}));
+	}
+
+	// random schedules, cancels and uneven advances against a plain map of wake times
+	void ModelTest() {
+		std::mt19937 rng(11);
+		const uint64 r = SleepWheel::Resolution;
+
+		uint64                   now = 5000;
+		SleepWheel               wheel(now);
+		std::map<uint16, uint64> model; // id to the tick it is due on
+
+		bool matched = true;
+		for (int step = 0; step < 20000; ++step) {
+			int ops = rng() % 8;
+			for (int i = 0; i < ops; ++i) {
+				uint16 id = rng() % 512;
+				if (rng() % 5 == 0) {
+					TEST_ASSERT(wheel.Cancel(id) == (model.erase(id) > 0));
+					continue;
+				}
+
+				// due once the wheel reaches the slot of the rounded up wake time, never on the tick it is at
+				uint64 span = rng() % 4 == 0 ? 4000000 : 70000;
+				uint64 wake = now + rng() % span;
+				wheel.Schedule(id, wake);
+				model[id] = std::max((wake + r - 1) / r, now / r + 1);
+			}
+
+			now += rng() % 50 == 0 ? 1000000 : rng() % 400;
+
+			std::vector<uint16> woken;
+			wheel.Advance(now, woken);
+			std::sort(woken.begin(), woken.end());
+
+			std::vector<uint16> due;
+			for (auto iter = model.begin(); iter != model.end();) {
+				if (iter->second <= now / r) {
+					due.push_back(iter->first);
+					iter = model.erase(iter);
+				}
+				else {
+					++iter;
+				}
+			}
+
+			matched = matched && woken == due && wheel.Size() == model.size();
+		}
+
+		TEST_ASSERT(matched);
+	}
+
+	// the zone side of a sleeping NPC, each timer fires the first frame after its duration passed
+	struct IdleTimer {
+		uint64 start;
+		uint32 duration;
+		bool   enabled;
+
+		bool Check(uint64 now) {
+			if (enabled && now - start > duration) {
+				start = now;
+				return true;
+			}
+
+			return false;
+		}
+
+		uint64 Remaining(uint64 now) const {
+			return now - start > duration ? 0 : start + duration - now;
+		}
+	};
+
+	struct IdleNPC {
+		std::vector<IdleTimer> timers;
+	};
+
+	static std::vector<IdleNPC> IdleNPCs(size_t count) {
+		// tic, close scan, qglobal purge, idle casts and the rest an idle NPC keeps running or disabled
+		std::mt19937         rng(static_cast<uint32>(count));
+		std::vector<IdleNPC> npcs(count);
+		for (auto &n: npcs) {
+			n.timers.push_back({0, 6000, true});
+			n.timers.push_back({0, 60000, true});
+			n.timers.push_back({0, 30000, rng() % 4 == 0});
+			n.timers.push_back({0, static_cast<uint32>(8 * (750 + rng() % 6750)), rng() % 3 == 0});
+			while (n.timers.size() < 16) {
+				n.timers.push_back({0, 1000, false});
+			}
+
+			// spawns don't all tick in step
+			uint64 phase = 8 * (rng() % 750);
+			for (auto &t: n.timers) {
+				t.start = phase;
+			}
+		}
+
+		return npcs;
+	}
+
+	static uint64 Poll(IdleNPC &n, uint64 now) {
+		uint64 fired = 0;
+		for (auto &t: n.timers) {
+			fired += t.Check(now) ? 1 : 0;
+		}
+
+		return fired;
+	}
+
+	static uint64 NextWake(const IdleNPC &n, uint64 now) {
+		uint64 sleep = UINT64_MAX;
+		for (auto &t: n.timers) {
+			if (t.enabled) {
+				sleep = std::min(sleep, t.Remaining(now));
+			}
+		}
+
+		return now + sleep + 1;
+	}
+
+	void RunIdleZone(bool wheel_on, uint64 &fired, uint64 &processed) {
+		const size_t npc_count   = 2000;
+		const uint64 frame_ms    = 32;
+		const uint64 frame_count = 60000 / frame_ms;
+		const uint64 start       = 8000; // after every spawn's phase
+
+		auto       npcs = IdleNPCs(npc_count);
+		SleepWheel wheel(start);
+
+		std::vector<uint16> woken;
+		for (uint64 frame = 1; frame <= frame_count; ++frame) {
+			const uint64 now = start + frame * frame_ms;
+			if (!wheel_on) {
+				for (auto &n: npcs) {
+					fired += Poll(n, now);
+					processed++;
+				}
+
+				continue;
+			}
+
+			woken.clear();
+			wheel.Advance(now, woken);
+
+			for (uint16 id = 0; id < npc_count; ++id) {
+				if (wheel.IsScheduled(id)) {
+					continue;
+				}
+
+				fired += Poll(npcs[id], now);
+				processed++;
+				wheel.Schedule(id, NextWake(npcs[id], now));
+			}
+		}
+	}
+
+	// an idle zone polled every frame fires the same timers as the same zone sleeping each NPC until
+	// its next timer, with far fewer processes, timing is left to benchmark:mob-process
+	void IdleZoneTest() {
+		uint64 poll_fired      = 0;
+		uint64 poll_processed  = 0;
+		uint64 wheel_fired     = 0;
+		uint64 wheel_processed = 0;
+
+		RunIdleZone(false, poll_fired, poll_processed);
+		RunIdleZone(true, wheel_fired, wheel_processed);
+
+		TEST_ASSERT(poll_fired > 0);
+		TEST_ASSERT(poll_fired == wheel_fired);
+		TEST_ASSERT(poll_processed == 2000 * (60000 / 32));
+		TEST_ASSERT(wheel_processed * 10 < poll_processed);
+	}
+};
+
+#endif
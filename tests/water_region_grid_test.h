@@ -0,0 +1,172 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_WATER_REGION_GRID_H
+#define __EQEMU_TESTS_WATER_REGION_GRID_H
+
+#include "cppunit/cpptest.h"
+#include "../zone/oriented_bounding_box.h"
+#include "../zone/water_region_grid.h"
+#include <random>
+#include <vector>
+
+class WaterRegionGridTest : public Test::Suite {
+	typedef void(WaterRegionGridTest::*TestFunction)(void);
+public:
+	WaterRegionGridTest() {
+		TEST_ADD(WaterRegionGridTest::EmptyTest);
+		TEST_ADD(WaterRegionGridTest::OverlapOrderTest);
+		TEST_ADD(WaterRegionGridTest::RandomRegionsTest);
+	}
+
+	~WaterRegionGridTest() {
+	}
+
+	private:
+
+	// the scan WaterMapV2::ReturnRegionType did before the grid
+	static int LinearFind(const std::vector<OrientedBoundingBox> &boxes, const glm::vec3 &p) {
+		for (size_t i = 0; i < boxes.size(); ++i) {
+			if (boxes[i].ContainsPoint(p)) {
+				return static_cast<int>(i);
+			}
+		}
+
+		return -1;
+	}
+
+	static void Build(WaterRegionGrid &grid, const std::vector<OrientedBoundingBox> &boxes) {
+		std::vector<glm::vec3> mins(boxes.size());
+		std::vector<glm::vec3> maxs(boxes.size());
+		for (size_t i = 0; i < boxes.size(); ++i) {
+			boxes[i].GetAxisAlignedBounds(mins[i], maxs[i]);
+		}
+
+		grid.Build(mins, maxs);
+	}
+
+	static int GridFind(const WaterRegionGrid &grid, const std::vector<OrientedBoundingBox> &boxes, const glm::vec3 &p) {
+		return grid.FindFirst(p, [&](uint32_t i) { return boxes[i].ContainsPoint(p); });
+	}
+
+	// points spread over the regions, plus points on and just around each region center
+	static std::vector<glm::vec3> SamplePoints(const std::vector<OrientedBoundingBox> &boxes, const std::vector<glm::vec3> &centers, size_t count) {
+		std::vector<glm::vec3> points;
+		if (boxes.empty()) {
+			return points;
+		}
+
+		glm::vec3 min(FLT_MAX);
+		glm::vec3 max(-FLT_MAX);
+		for (auto &b : boxes) {
+			glm::vec3 bmin, bmax;
+			b.GetAxisAlignedBounds(bmin, bmax);
+			min = glm::min(min, bmin);
+			max = glm::max(max, bmax);
+		}
+
+		std::mt19937                          rng(1234);
+		std::uniform_real_distribution<float> unit(-0.1f, 1.1f);
+		std::uniform_real_distribution<float> jitter(-25.0f, 25.0f);
+		for (size_t i = 0; i < count; ++i) {
+			points.emplace_back(
+				min.x + (max.x - min.x) * unit(rng),
+				min.y + (max.y - min.y) * unit(rng),
+				min.z + (max.z - min.z) * unit(rng)
+			);
+		}
+
+		for (auto &c : centers) {
+			points.push_back(c);
+			for (int i = 0; i < 8; ++i) {
+				points.push_back(c + glm::vec3(jitter(rng), jitter(rng), jitter(rng)));
+			}
+		}
+
+		return points;
+	}
+
+	static size_t Mismatches(const std::vector<OrientedBoundingBox> &boxes, const std::vector<glm::vec3> &points) {
+		WaterRegionGrid grid;
+		Build(grid, boxes);
+
+		size_t mismatches = 0;
+		for (auto &p : points) {
+			if (GridFind(grid, boxes, p) != LinearFind(boxes, p)) {
+				mismatches++;
+			}
+		}
+
+		return mismatches;
+	}
+
+	void EmptyTest() {
+		std::vector<OrientedBoundingBox> boxes;
+		WaterRegionGrid                  grid;
+		Build(grid, boxes);
+
+		TEST_ASSERT(GridFind(grid, boxes, glm::vec3(0.0f)) == -1);
+		TEST_ASSERT(GridFind(grid, boxes, glm::vec3(100.0f, -50.0f, 3.0f)) == -1);
+	}
+
+	// nested regions, the earlier one has to win where they overlap
+	void OverlapOrderTest() {
+		std::vector<OrientedBoundingBox> boxes;
+		boxes.emplace_back(glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(1.0f), glm::vec3(10.0f));
+		boxes.emplace_back(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 45.0f), glm::vec3(1.0f), glm::vec3(100.0f));
+		boxes.emplace_back(glm::vec3(500.0f, 0.0f, 0.0f), glm::vec3(30.0f, 0.0f, 0.0f), glm::vec3(2.0f), glm::vec3(20.0f));
+
+		WaterRegionGrid grid;
+		Build(grid, boxes);
+
+		TEST_ASSERT(GridFind(grid, boxes, glm::vec3(0.0f)) == 0);
+		TEST_ASSERT(GridFind(grid, boxes, glm::vec3(50.0f, 0.0f, 0.0f)) == 1);
+		TEST_ASSERT(GridFind(grid, boxes, glm::vec3(500.0f, 0.0f, 0.0f)) == 2);
+		TEST_ASSERT(GridFind(grid, boxes, glm::vec3(300.0f, 300.0f, 0.0f)) == -1);
+	}
+
+	void RandomRegionsTest() {
+		std::mt19937                          rng(99);
+		std::uniform_real_distribution<float> position(-2000.0f, 2000.0f);
+		std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+		std::uniform_real_distribution<float> scale(0.5f, 3.0f);
+		std::uniform_real_distribution<float> extent(5.0f, 200.0f);
+
+		std::vector<OrientedBoundingBox> boxes;
+		std::vector<glm::vec3>           centers;
+		for (int i = 0; i < 400; ++i) {
+			glm::vec3 center(position(rng), position(rng), position(rng) / 10.0f);
+			glm::vec3 extents(extent(rng), extent(rng), extent(rng));
+			if (i % 50 == 0) {
+				extents *= 20.0f; // a few zone sized oceans
+			}
+
+			boxes.emplace_back(center, glm::vec3(angle(rng), angle(rng), angle(rng)), glm::vec3(scale(rng), scale(rng), scale(rng)), extents);
+			centers.push_back(center);
+		}
+
+		// flat and mirrored boxes turn up in real files
+		boxes.emplace_back(glm::vec3(10.0f), glm::vec3(0.0f), glm::vec3(1.0f, 1.0f, 0.0f), glm::vec3(50.0f));
+		boxes.emplace_back(glm::vec3(-10.0f), glm::vec3(0.0f), glm::vec3(-1.0f, 2.0f, 1.0f), glm::vec3(-50.0f, 50.0f, 50.0f));
+
+		// timing and the sweep over installed water maps are in benchmark:water-regions
+		TEST_ASSERT_EQUALS(Mismatches(boxes, SamplePoints(boxes, centers, 20000)), 0u);
+	}
+};
+
+#endif
@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <random>
+#include <strings.h>
+#include "../client_list_index.h"
+#include "../../common/strings.h"
+#include "../../common/timer.h"
+
+// stand-in for ClientListEntry, the index only ever reads the keys it is handed
+struct ClientListBenchEntry {
+	uint32      account_id;
+	std::string name;
+	uint32      guild_id = 0;
+	uint32      zone_id  = 0;
+	bool        online   = true;
+	uint8       level    = 1;
+	uint8       class_id = 1;
+	uint16      race     = 1;
+	bool        gm       = false;
+	bool        lfg      = false;
+};
+
+// the owning list and its index the way ClientList keeps them, with the walks it did before the index
+struct ClientListBench {
+	std::list<std::unique_ptr<ClientListBenchEntry>> entries;
+	ClientListIndex<ClientListBenchEntry>            index;
+	int64                                            front_order = 0;
+	int64                                            back_order  = 0;
+
+	void Add(const ClientListBenchEntry &e, bool front)
+	{
+		auto p = new ClientListBenchEntry(e);
+
+		ClientListKeys k;
+		k.id           = p->account_id;
+		k.name         = Strings::ToLower(p->name);
+		k.account_id   = p->account_id;
+		k.character_id = p->account_id;
+		k.ls_id        = p->account_id;
+		k.guild_id     = p->guild_id;
+		k.zone_id      = p->zone_id;
+		k.online       = p->online;
+		k.level        = p->level;
+		k.class_id     = p->class_id;
+		k.race         = p->race;
+		k.gm           = p->gm;
+		k.lfg          = p->lfg;
+
+		if (front) {
+			entries.emplace_front(p);
+			index.Add(p, --front_order, k);
+		}
+		else {
+			entries.emplace_back(p);
+			index.Add(p, back_order++, k);
+		}
+	}
+
+	ClientListBenchEntry *ScanName(const char *name) const
+	{
+		for (auto &e: entries) {
+			if (strcasecmp(e->name.c_str(), name) == 0) {
+				return e.get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	ClientListBenchEntry *ScanAccount(uint32 account_id) const
+	{
+		for (auto &e: entries) {
+			if (e->account_id == account_id) {
+				return e.get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	std::vector<ClientListBenchEntry *> ScanWho(const ClientListWhoFilter &f) const
+	{
+		std::vector<ClientListBenchEntry *> out;
+		for (auto &e: entries) {
+			bool text = !f.text ||
+				std::find(f.zones.begin(), f.zones.end(), e->zone_id) != f.zones.end() ||
+				std::find(f.guilds.begin(), f.guilds.end(), e->guild_id) != f.guilds.end() ||
+				strncasecmp(e->name.c_str(), f.name_prefix.c_str(), f.name_prefix.size()) == 0;
+
+			if (
+				e->online && text &&
+				(f.class_id < 0 || e->class_id == f.class_id) &&
+				(f.race < 0 || e->race == f.race) &&
+				(f.level_low < 0 || (e->level >= f.level_low && e->level <= f.level_high)) &&
+				(!f.gm || e->gm) &&
+				(!f.lfg || e->lfg)
+			) {
+				out.push_back(e.get());
+			}
+		}
+
+		return out;
+	}
+};
+
+// the routing lookups world does for tells and invites, a name and an account lookup per message
+void RunClientListLookupBenchmark(uint32 online, int lookups)
+{
+	ClientListBench l;
+	std::mt19937    rng(online);
+	for (uint32 i = 1; i <= online; ++i) {
+		l.Add({i, fmt::format("Char{}", i)}, rng() % 2 == 0);
+	}
+
+	// some of the names aren't online
+	std::vector<std::string> names;
+	for (int i = 0; i < lookups; ++i) {
+		names.push_back(fmt::format("char{}", rng() % (online + online / 30) + 1));
+	}
+
+	size_t     scan_found = 0;
+	BenchTimer timer;
+	for (int i = 0; i < lookups; ++i) {
+		scan_found += l.ScanName(names[i].c_str()) ? 1 : 0;
+		scan_found += l.ScanAccount(i % online + 1) ? 1 : 0;
+	}
+	double scan_us = static_cast<double>(timer.elapsedMicroseconds()) / lookups;
+
+	size_t index_found = 0;
+	timer.reset();
+	for (int i = 0; i < lookups; ++i) {
+		index_found += l.index.FindByName(Strings::ToLower(names[i])) ? 1 : 0;
+		index_found += l.index.FindByAccountID(i % online + 1) ? 1 : 0;
+	}
+	double index_us = static_cast<double>(timer.elapsedMicroseconds()) / lookups;
+
+	std::cout << fmt::format(
+		"| lookups {:>6} online | scan {:>8.3f} us/message | indexed {:>8.3f} us/message | found scan [{}] indexed [{}]\n",
+		Strings::Commify(online),
+		scan_us,
+		index_us,
+		scan_found,
+		index_found
+	);
+}
+
+// the kinds of /who all people type, one of them picked at random
+ClientListWhoFilter RandomClientListWho(std::mt19937 &rng, uint32 online)
+{
+	ClientListWhoFilter f;
+	switch (rng() % 7) {
+		case 0:
+			break;
+		case 1:
+			f.level_low  = static_cast<int>(rng() % 60 + 1);
+			f.level_high = f.level_low + static_cast<int>(rng() % 6);
+			break;
+		case 2:
+			f.class_id = static_cast<int>(rng() % 16 + 1);
+			break;
+		case 3:
+			f.race       = static_cast<int>(rng() % 14 + 1);
+			f.level_low  = 60;
+			f.level_high = 65;
+			break;
+		case 4:
+			f.gm = true;
+			break;
+		case 5:
+			f.lfg        = true;
+			f.level_low  = static_cast<int>(rng() % 50 + 1);
+			f.level_high = f.level_low + 10;
+			break;
+		default:
+			f.text        = true;
+			f.zones       = {static_cast<uint32>(rng() % 300)};
+			f.guilds      = {static_cast<uint32>(rng() % 200)};
+			f.name_prefix = fmt::format("char{}", rng() % (online / 10) + 1);
+			break;
+	}
+
+	return f;
+}
+
+// a server's worth of characters and a stream of /who all queries of every kind, the way they come in during an event
+void RunClientListWhoBenchmark(uint32 online, int queries)
+{
+	ClientListBench l;
+	std::mt19937    rng(online);
+	for (uint32 i = 1; i <= online; ++i) {
+		ClientListBenchEntry e{i, fmt::format("Char{}", i), static_cast<uint32>(rng() % 200), static_cast<uint32>(rng() % 300)};
+		e.online   = rng() % 10 != 0;
+		e.level    = static_cast<uint8>(rng() % 65 + 1);
+		e.class_id = static_cast<uint8>(rng() % 16 + 1);
+		e.race     = static_cast<uint16>(rng() % 14 + 1);
+		e.gm       = rng() % 100 == 0;
+		e.lfg      = rng() % 8 == 0;
+		l.Add(e, rng() % 2 == 0);
+	}
+
+	std::vector<ClientListWhoFilter> filters;
+	for (int i = 0; i < queries; ++i) {
+		filters.push_back(RandomClientListWho(rng, online));
+	}
+
+	size_t     scan_found = 0;
+	BenchTimer timer;
+	for (auto &f: filters) {
+		scan_found += l.ScanWho(f).size();
+	}
+	double scan_us = static_cast<double>(timer.elapsedMicroseconds()) / queries;
+
+	size_t index_found = 0;
+	timer.reset();
+	for (auto &f: filters) {
+		index_found += l.index.Who(f).size();
+	}
+	double index_us = static_cast<double>(timer.elapsedMicroseconds()) / queries;
+
+	std::cout << fmt::format(
+		"| who     {:>6} online | scan {:>8.3f} us/query   | indexed {:>8.3f} us/query   | found scan [{}] indexed [{}]\n",
+		Strings::Commify(online),
+		scan_us,
+		index_us,
+		scan_found,
+		index_found
+	);
+}
+
+void WorldserverCLI::BenchmarkClientList(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark client list lookups and /who all queries, list walks versus the client list index.";
+
+	if (cmd[{"-h", "--help"}]) {
+		return;
+	}
+
+	std::cout << Strings::Repeat("-", 70) << "\n";
+	std::cout << "Client list benchmark\n";
+	std::cout << Strings::Repeat("-", 70) << "\n";
+
+	for (uint32 online: {500, 3000, 10000}) {
+		RunClientListLookupBenchmark(online, 20000);
+	}
+
+	for (uint32 online: {500, 5000, 10000}) {
+		RunClientListWhoBenchmark(online, 2000);
+	}
+}
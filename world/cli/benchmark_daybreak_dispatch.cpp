@@ -0,0 +1,83 @@
+#include <map>
+#include <random>
+#include <uv.h>
+#include "../../common/net/daybreak_endpoint_map.h"
+#include "../../common/strings.h"
+#include "../../common/timer.h"
+
+void WorldserverCLI::BenchmarkDaybreakDispatch(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark per-packet connection lookup in DaybreakConnectionManager (endpoint string map vs packed key hash)";
+
+	if (cmd[{"-h", "--help"}]) {
+		return;
+	}
+
+	const size_t packets = 2000000;
+
+	for (size_t connections : {1000, 5000, 10000}) {
+		std::mt19937                         rng(static_cast<uint32_t>(connections));
+		std::vector<sockaddr_in>             endpoints;
+		std::map<std::pair<std::string, int>, std::shared_ptr<int>> by_string;
+		EQ::Net::DaybreakEndpointMap<std::shared_ptr<int>>           by_key;
+
+		for (size_t i = 0; i < connections; ++i) {
+			auto ip   = fmt::format("10.{}.{}.{}", (i >> 16) & 0xFF, (i >> 8) & 0xFF, i & 0xFF);
+			int  port = 1024 + static_cast<int>(rng() % 60000);
+
+			sockaddr_in addr{};
+			uv_ip4_addr(ip.c_str(), port, &addr);
+			endpoints.push_back(addr);
+
+			auto value = std::make_shared<int>(static_cast<int>(i));
+			by_string.emplace(std::make_pair(ip, port), value);
+			by_key.Insert(EQ::Net::DaybreakEndpointKey(addr.sin_addr.s_addr, addr.sin_port), value);
+		}
+
+		// packets arrive from random live connections
+		std::vector<uint32_t> order(packets);
+		for (auto &o : order) {
+			o = static_cast<uint32_t>(rng() % connections);
+		}
+
+		size_t     found = 0;
+		BenchTimer timer;
+
+		// previous dispatch, format the endpoint then look it up in the string keyed tree
+		for (auto o : order) {
+			auto &addr = endpoints[o];
+			char endpoint[16];
+			uv_ip4_name(&addr, endpoint, 16);
+			auto port = ntohs(addr.sin_port);
+
+			auto iter = by_string.find(std::make_pair(std::string(endpoint), (int) port));
+			if (iter != by_string.end()) {
+				std::shared_ptr<int> c = iter->second;
+				found += c ? 1 : 0;
+			}
+		}
+
+		double string_ns = static_cast<double>(timer.elapsedNanoseconds()) / packets;
+
+		timer.reset();
+		for (auto o : order) {
+			auto &addr = endpoints[o];
+			auto c = by_key.Find(EQ::Net::DaybreakEndpointKey(addr.sin_addr.s_addr, addr.sin_port));
+			if (c) {
+				std::shared_ptr<int> connection = *c;
+				found += connection ? 1 : 0;
+			}
+		}
+
+		double key_ns = static_cast<double>(timer.elapsedNanoseconds()) / packets;
+
+		std::cout << fmt::format(
+			"{:>6} connections | string map {:>8.1f} ns/packet | packed key hash {:>8.1f} ns/packet | {:>5.1f}x | found [{}]\n",
+			Strings::Commify(connections),
+			string_ns,
+			key_ns,
+			key_ns > 0 ? string_ns / key_ns : 0.0,
+			Strings::Commify(found)
+		);
+	}
+}
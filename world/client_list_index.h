@@ -0,0 +1,435 @@
+#ifndef CLIENT_LIST_INDEX_H_
+#define CLIENT_LIST_INDEX_H_
+
+#include "../common/types.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// the keys an entry is filed under, taken by the owner whenever one of them may have changed
+struct ClientListKeys {
+	uint32      id           = 0;
+	std::string name; // lower case, lookups are case insensitive
+	uint32      account_id   = 0;
+	uint32      character_id = 0;
+	uint32      ls_id        = 0;
+	uint32      guild_id     = 0;
+	uint32      zone_id      = 0;
+
+	// what /who and the LFG search filter on
+	bool   online   = false; // in a zone or zoning
+	uint8  level    = 0;
+	uint8  class_id = 0;
+	uint16 race     = 0;
+	bool   gm       = false;
+	bool   lfg      = false;
+};
+
+// a who query, every filter that is set has to match
+struct ClientListWhoFilter {
+	int  level_low  = -1; // -1 when the query has no level range
+	int  level_high = -1;
+	int  class_id   = -1;
+	int  race       = -1;
+	bool gm         = false;
+	bool lfg        = false;
+
+	// /who all <text>, matches entries in one of the zones or guilds or with a name starting with the prefix
+	bool                text = false;
+	std::vector<uint32> zones;
+	std::vector<uint32> guilds;
+	std::string         name_prefix; // lower case
+};
+
+/*
+	Hash indexes over the world client list, the list keeps owning the entries.
+
+	Several entries can share a key: an account has one entry per login until the stale ones
+	age out, and every entry at character select has character 0 and no name. Each entry is
+	ranked by its position in the owning list, the finders return the one closest to the
+	front and the lists come back in list order, exactly what a front to back walk of the
+	list would have produced.
+*/
+template<typename Entry>
+class ClientListIndex {
+public:
+	// order is the entry's position in the owning list, lower is closer to the front
+	void Add(Entry *e, int64 order, const ClientListKeys &k)
+	{
+		Remove(e);
+
+		auto &r = m_records[e];
+		r.order = order;
+		r.keys  = k;
+
+		Ranked ranked{order, e, &r};
+		Insert(m_by_id, k.id, ranked);
+		Insert(m_by_name, k.name, ranked);
+		Insert(m_by_name_sorted, k.name, ranked);
+		Insert(m_by_account, k.account_id, ranked);
+		Insert(m_by_character, k.character_id, ranked);
+		Insert(m_by_ls_id, k.ls_id, ranked);
+		Insert(m_by_guild, k.guild_id, ranked);
+		Insert(m_by_zone, k.zone_id, ranked);
+		Insert(m_online, k.online, ranked);
+		Insert(m_by_level, k.level, ranked);
+		Insert(m_by_class, k.class_id, ranked);
+		Insert(m_by_race, k.race, ranked);
+		Insert(m_gm, k.gm, ranked);
+		Insert(m_lfg, k.lfg, ranked);
+	}
+
+	// moves e to the buckets of its new keys, false when e isn't indexed
+	bool Update(Entry *e, const ClientListKeys &k)
+	{
+		auto iter = m_records.find(e);
+		if (iter == m_records.end()) {
+			return false;
+		}
+
+		auto   &old = iter->second.keys;
+		Ranked ranked{iter->second.order, e, &iter->second};
+		Move(m_by_id, old.id, k.id, ranked);
+		Move(m_by_name, old.name, k.name, ranked);
+		Move(m_by_name_sorted, old.name, k.name, ranked);
+		Move(m_by_account, old.account_id, k.account_id, ranked);
+		Move(m_by_character, old.character_id, k.character_id, ranked);
+		Move(m_by_ls_id, old.ls_id, k.ls_id, ranked);
+		Move(m_by_guild, old.guild_id, k.guild_id, ranked);
+		Move(m_by_zone, old.zone_id, k.zone_id, ranked);
+		Move(m_online, old.online, k.online, ranked);
+		Move(m_by_level, old.level, k.level, ranked);
+		Move(m_by_class, old.class_id, k.class_id, ranked);
+		Move(m_by_race, old.race, k.race, ranked);
+		Move(m_gm, old.gm, k.gm, ranked);
+		Move(m_lfg, old.lfg, k.lfg, ranked);
+		old = k;
+
+		return true;
+	}
+
+	void Remove(Entry *e)
+	{
+		auto iter = m_records.find(e);
+		if (iter == m_records.end()) {
+			return;
+		}
+
+		auto   &k = iter->second.keys;
+		Ranked ranked{iter->second.order, e, &iter->second};
+		Erase(m_by_id, k.id, ranked);
+		Erase(m_by_name, k.name, ranked);
+		Erase(m_by_name_sorted, k.name, ranked);
+		Erase(m_by_account, k.account_id, ranked);
+		Erase(m_by_character, k.character_id, ranked);
+		Erase(m_by_ls_id, k.ls_id, ranked);
+		Erase(m_by_guild, k.guild_id, ranked);
+		Erase(m_by_zone, k.zone_id, ranked);
+		Erase(m_online, k.online, ranked);
+		Erase(m_by_level, k.level, ranked);
+		Erase(m_by_class, k.class_id, ranked);
+		Erase(m_by_race, k.race, ranked);
+		Erase(m_gm, k.gm, ranked);
+		Erase(m_lfg, k.lfg, ranked);
+
+		m_records.erase(iter);
+	}
+
+	void Clear()
+	{
+		m_records.clear();
+		m_by_id.clear();
+		m_by_name.clear();
+		m_by_name_sorted.clear();
+		m_by_account.clear();
+		m_by_character.clear();
+		m_by_ls_id.clear();
+		m_by_guild.clear();
+		m_by_zone.clear();
+		m_online.clear();
+		m_by_level.clear();
+		m_by_class.clear();
+		m_by_race.clear();
+		m_gm.clear();
+		m_lfg.clear();
+	}
+
+	size_t Size() const { return m_records.size(); }
+	bool Contains(Entry *e) const { return m_records.find(e) != m_records.end(); }
+
+	Entry *FindByID(uint32 id) const { return First(m_by_id, id); }
+	Entry *FindByName(const std::string &lower_name) const { return First(m_by_name, lower_name); }
+	Entry *FindByAccountID(uint32 account_id) const { return First(m_by_account, account_id); }
+	Entry *FindByCharacterID(uint32 character_id) const { return First(m_by_character, character_id); }
+
+	std::vector<Entry *> WithCharacterID(uint32 character_id) const { return All(m_by_character, character_id); }
+	std::vector<Entry *> WithLSID(uint32 ls_id) const { return All(m_by_ls_id, ls_id); }
+	std::vector<Entry *> InGuild(uint32 guild_id) const { return All(m_by_guild, guild_id); }
+	std::vector<Entry *> InZone(uint32 zone_id) const { return All(m_by_zone, zone_id); }
+
+	// the guilds and zones at least one entry is in, for matching their names against who text
+	std::vector<uint32> Guilds() const { return Keys(m_by_guild); }
+	std::vector<uint32> Zones() const { return Keys(m_by_zone); }
+
+	/*
+		Online entries whose keys pass the filter, in list order. Only the buckets of the most
+		selective filter are walked, the other filters are checked against the keys on file.
+	*/
+	std::vector<Entry *> Who(const ClientListWhoFilter &f) const
+	{
+		std::vector<const Bucket *> source;
+		size_t                      source_size = Collect(m_online, true, source);
+		bool                        overlapping = false;
+
+		auto consider = [&](std::vector<const Bucket *> &buckets, size_t size, bool overlaps) {
+			if (size < source_size) {
+				source.swap(buckets);
+				source_size = size;
+				overlapping = overlaps;
+			}
+		};
+
+		if (f.class_id >= 0) {
+			std::vector<const Bucket *> b;
+			consider(b, Collect(m_by_class, static_cast<uint8>(f.class_id), b), false);
+		}
+
+		if (f.race >= 0) {
+			std::vector<const Bucket *> b;
+			consider(b, Collect(m_by_race, static_cast<uint16>(f.race), b), false);
+		}
+
+		if (f.level_low >= 0) {
+			std::vector<const Bucket *> b;
+			size_t                      size = 0;
+			for (int level = f.level_low; level <= std::min(f.level_high, 255); ++level) {
+				size += Collect(m_by_level, static_cast<uint8>(level), b);
+			}
+
+			consider(b, size, false);
+		}
+
+		if (f.gm) {
+			std::vector<const Bucket *> b;
+			consider(b, Collect(m_gm, true, b), false);
+		}
+
+		if (f.lfg) {
+			std::vector<const Bucket *> b;
+			consider(b, Collect(m_lfg, true, b), false);
+		}
+
+		if (f.text) {
+			std::vector<const Bucket *> b;
+			size_t                      size = 0;
+			for (auto zone_id: f.zones) {
+				size += Collect(m_by_zone, zone_id, b);
+			}
+
+			for (auto guild_id: f.guilds) {
+				size += Collect(m_by_guild, guild_id, b);
+			}
+
+			for (auto iter = m_by_name_sorted.lower_bound(f.name_prefix); iter != m_by_name_sorted.end(); ++iter) {
+				if (iter->first.compare(0, f.name_prefix.size(), f.name_prefix) != 0) {
+					break;
+				}
+
+				b.push_back(&iter->second);
+				size += iter->second.size();
+			}
+
+			consider(b, size, true);
+		}
+
+		Bucket candidates;
+		candidates.reserve(source_size);
+		for (auto b: source) {
+			candidates.insert(candidates.end(), b->begin(), b->end());
+		}
+
+		// buckets are each in list order already
+		if (source.size() > 1) {
+			std::sort(candidates.begin(), candidates.end(), ByOrder);
+		}
+
+		// a text match can reach an entry through its zone, its guild and its name
+		if (overlapping) {
+			candidates.erase(
+				std::unique(
+					candidates.begin(),
+					candidates.end(),
+					[](const Ranked &l, const Ranked &r) { return l.e == r.e; }
+				),
+				candidates.end()
+			);
+		}
+
+		std::vector<Entry *> out;
+		for (auto &c: candidates) {
+			if (Matches(c.record->keys, f)) {
+				out.push_back(c.e);
+			}
+		}
+
+		return out;
+	}
+
+private:
+	struct Record {
+		int64          order;
+		ClientListKeys keys;
+	};
+
+	// buckets hold their entries in list order, with the keys on file for checking filters in place
+	struct Ranked {
+		int64        order;
+		Entry        *e;
+		const Record *record;
+	};
+
+	typedef std::vector<Ranked> Bucket;
+
+	static bool ByOrder(const Ranked &l, const Ranked &r) { return l.order < r.order; }
+
+	static bool Matches(const ClientListKeys &k, const ClientListWhoFilter &f)
+	{
+		if (!k.online) {
+			return false;
+		}
+
+		if (f.class_id >= 0 && k.class_id != f.class_id) {
+			return false;
+		}
+
+		if (f.race >= 0 && k.race != f.race) {
+			return false;
+		}
+
+		if (f.level_low >= 0 && (k.level < f.level_low || k.level > f.level_high)) {
+			return false;
+		}
+
+		if ((f.gm && !k.gm) || (f.lfg && !k.lfg)) {
+			return false;
+		}
+
+		if (f.text) {
+			return std::find(f.zones.begin(), f.zones.end(), k.zone_id) != f.zones.end() ||
+				std::find(f.guilds.begin(), f.guilds.end(), k.guild_id) != f.guilds.end() ||
+				k.name.compare(0, f.name_prefix.size(), f.name_prefix) == 0;
+		}
+
+		return true;
+	}
+
+	template<typename M, typename K>
+	static void Insert(M &m, const K &key, const Ranked &ranked)
+	{
+		auto &b = m[key];
+		b.insert(std::upper_bound(b.begin(), b.end(), ranked, ByOrder), ranked);
+	}
+
+	template<typename M, typename K>
+	static void Erase(M &m, const K &key, const Ranked &ranked)
+	{
+		auto iter = m.find(key);
+		if (iter == m.end()) {
+			return;
+		}
+
+		// orders are unique, the entry is wherever its order sorts
+		auto &b  = iter->second;
+		auto pos = std::lower_bound(b.begin(), b.end(), ranked, ByOrder);
+		if (pos != b.end() && pos->e == ranked.e) {
+			b.erase(pos);
+		}
+
+		if (b.empty()) {
+			m.erase(iter);
+		}
+	}
+
+	template<typename M, typename K>
+	static void Move(M &m, const K &from, const K &to, const Ranked &ranked)
+	{
+		if (from == to) {
+			return;
+		}
+
+		Erase(m, from, ranked);
+		Insert(m, to, ranked);
+	}
+
+	template<typename M, typename K>
+	static size_t Collect(const M &m, const K &key, std::vector<const Bucket *> &into)
+	{
+		auto iter = m.find(key);
+		if (iter == m.end()) {
+			return 0;
+		}
+
+		into.push_back(&iter->second);
+		return iter->second.size();
+	}
+
+	template<typename M, typename K>
+	static Entry *First(const M &m, const K &key)
+	{
+		auto iter = m.find(key);
+		if (iter == m.end()) {
+			return nullptr;
+		}
+
+		return iter->second.front().e;
+	}
+
+	template<typename M, typename K>
+	static std::vector<Entry *> All(const M &m, const K &key)
+	{
+		auto iter = m.find(key);
+		if (iter == m.end()) {
+			return {};
+		}
+
+		std::vector<Entry *> out;
+		out.reserve(iter->second.size());
+		for (auto &r: iter->second) {
+			out.push_back(r.e);
+		}
+
+		return out;
+	}
+
+	template<typename M>
+	static std::vector<uint32> Keys(const M &m)
+	{
+		std::vector<uint32> out;
+		out.reserve(m.size());
+		for (auto &e: m) {
+			out.push_back(e.first);
+		}
+
+		return out;
+	}
+
+	std::unordered_map<Entry *, Record>     m_records;
+	std::unordered_map<uint32, Bucket>      m_by_id;
+	std::unordered_map<std::string, Bucket> m_by_name;
+	std::map<std::string, Bucket>           m_by_name_sorted; // for /who name prefixes
+	std::unordered_map<uint32, Bucket>      m_by_account;
+	std::unordered_map<uint32, Bucket>      m_by_character;
+	std::unordered_map<uint32, Bucket>      m_by_ls_id;
+	std::unordered_map<uint32, Bucket>      m_by_guild;
+	std::unordered_map<uint32, Bucket>      m_by_zone;
+	std::unordered_map<bool, Bucket>        m_online;
+	std::unordered_map<uint8, Bucket>       m_by_level;
+	std::unordered_map<uint8, Bucket>       m_by_class;
+	std::unordered_map<uint16, Bucket>      m_by_race;
+	std::unordered_map<bool, Bucket>        m_gm;
+	std::unordered_map<bool, Bucket>        m_lfg;
+};
+
+#endif /*CLIENT_LIST_INDEX_H_*/
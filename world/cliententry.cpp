@@ -106,6 +106,25 @@ void ClientListEntry::SetChar(uint32 iCharID, const char *iCharName)
 {
 	m_char_id = iCharID;
 	strn0cpy(m_char_name, iCharName, sizeof(m_char_name));
+	client_list.CLEChanged(this);
+}
+
+void ClientListEntry::SetGuild(uint32 guild_id)
+{
+	m_guild_id = guild_id;
+	client_list.CLEChanged(this);
+}
+
+void ClientListEntry::SetZone(uint32 zone)
+{
+	m_zone = zone;
+	client_list.CLEChanged(this);
+}
+
+void ClientListEntry::SetGM(uint8 igm)
+{
+	m_gm = igm;
+	client_list.CLEChanged(this);
 }
 
 void ClientListEntry::SetOnline(CLE_Status iOnline)
@@ -133,6 +152,8 @@ void ClientListEntry::SetOnline(CLE_Status iOnline)
 	if (m_online >= CLE_Status::Online) {
 		m_stale = 0;
 	}
+
+	client_list.CLEChanged(this);
 }
 
 void ClientListEntry::LSUpdate(ZoneServer *iZS)
@@ -214,7 +235,7 @@ void ClientListEntry::Update(ZoneServer *iZS, ServerClientList_Struct *scl, CLE_
 		memcpy(m_lfg_comments, scl->LFGComments, sizeof(m_lfg_comments));
 	}
 
-	SetOnline(iOnline);
+	SetOnline(iOnline); // refiles the entry
 }
 
 void ClientListEntry::LeavingZone(ZoneServer *iZS, CLE_Status iOnline)
@@ -232,6 +253,7 @@ void ClientListEntry::LeavingZone(ZoneServer *iZS, CLE_Status iOnline)
 	}
 	m_zone_server = 0;
 	m_zone        = 0;
+	client_list.CLEChanged(this);
 }
 
 void ClientListEntry::ClearVars(bool iAll)
@@ -267,6 +289,8 @@ void ClientListEntry::ClearVars(bool iAll)
 		safe_delete_array(elem);
 	}
 	m_tell_queue.clear();
+
+	client_list.CLEChanged(this);
 }
 
 void ClientListEntry::Camp(ZoneServer *iZS)
@@ -338,6 +362,7 @@ bool ClientListEntry::CheckAuth(uint32 loginserver_account_id, const char *key_p
 			}
 			strn0cpy(m_account_name, m_login_account_name, sizeof(m_account_name));
 			m_admin = default_account_status;
+			client_list.CLEChanged(this);
 		}
 		std::string lsworldadmin;
 		if (database.GetVariable("honorlsworldadmin", lsworldadmin)) {
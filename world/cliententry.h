@@ -91,12 +91,12 @@ public:
 	inline uint32 GuildID() const { return m_guild_id; }
 	inline uint32 GuildRank() const { return m_guild_rank; }
 	inline bool GuildTributeOptIn() const { return m_guild_tribute_opt_in; }
-	inline void SetGuild(uint32 guild_id) { m_guild_id = guild_id; }
+	void SetGuild(uint32 guild_id);
 	inline void SetGuildTributeOptIn(bool opt) { m_guild_tribute_opt_in = opt; }
 	inline bool LFG() const { return m_lfg; }
 	inline uint8 GetGM() const { return m_gm; }
-	inline void SetGM(uint8 igm) { m_gm = igm; }
-	inline void SetZone(uint32 zone) { m_zone = zone; }
+	void SetGM(uint8 igm);
+	void SetZone(uint32 zone);
 	inline bool IsLocalClient() const { return m_is_local; }
 	inline uint8 GetLFGFromLevel() const { return m_lfg_from_level; }
 	inline uint8 GetLFGToLevel() const { return m_lfg_to_level; }
@@ -45,7 +45,9 @@ ClientList::ClientList()
 	: CLStale_timer(10000),
 	  m_poll_cache_timer(6000)
 {
-	NextCLEID = 1;
+	NextCLEID     = 1;
+	m_front_order = 0;
+	m_back_order  = 0;
 
 	m_tick = std::make_unique<EQ::Timer>(5000, true, std::bind(&ClientList::OnTick, this, std::placeholders::_1));
 
@@ -82,15 +84,11 @@ void ClientList::Process() {
 }
 
 void ClientList::CLERemoveZSRef(ZoneServer* iZS) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->Server() == iZS) {
-			iterator.GetData()->ClearServer(); // calling this before LeavingZone() makes CLE not update the number of players in a zone
-			iterator.GetData()->LeavingZone();
+	for (auto &cle : clientlist) {
+		if (cle->Server() == iZS) {
+			cle->ClearServer(); // calling this before LeavingZone() makes CLE not update the number of players in a zone
+			cle->LeavingZone();
 		}
-		iterator.Advance();
 	}
 }
 
@@ -98,15 +96,14 @@ void ClientList::CLERemoveZSRef(ZoneServer* iZS) {
 
 void ClientList::GetCLEIP(uint32 in_ip) {
 	ClientListEntry* cle = nullptr;
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+	auto iterator = clientlist.begin();
 
 	int count = 0;
-	iterator.Reset();
 
 	const auto& zones = Strings::Split(RuleS(World, IPExemptionZones), ",");
 
-	while (iterator.MoreElements()) {
-		cle = iterator.GetData();
+	while (iterator != clientlist.end()) {
+		cle = iterator->get();
 
 		if (!zones.empty() && cle->zone()) {
 			auto it = std::ranges::find_if(
@@ -117,7 +114,7 @@ void ClientList::GetCLEIP(uint32 in_ip) {
 			);
 
 			if (it != zones.end()) {
-				iterator.Advance();
+				++iterator;
 				continue;
 			}
 		}
@@ -152,7 +149,7 @@ void ClientList::GetCLEIP(uint32 in_ip) {
 					} else {
 						LogClientLogin("Disconnect: Account [{}] on IP [{}]", cle->LSName(), ip_string);
 						cle->SetOnline(CLE_Status::Offline);
-						iterator.RemoveCurrent();
+						iterator = RemoveCLE(iterator);
 						continue;
 					}
 				}
@@ -179,7 +176,7 @@ void ClientList::GetCLEIP(uint32 in_ip) {
 							} else {
 								LogClientLogin("Disconnect: Account [{}] on IP [{}]", cle->LSName(), ip_string);
 								cle->SetOnline(CLE_Status::Offline); // Remove the connection
-								iterator.RemoveCurrent();
+								iterator = RemoveCLE(iterator);
 								continue;
 							}
 						}
@@ -194,7 +191,7 @@ void ClientList::GetCLEIP(uint32 in_ip) {
 						} else {
 							LogClientLogin("Disconnect: Account [{}] on IP [{}]", cle->LSName(), ip_string);
 							cle->SetOnline(CLE_Status::Offline); // Remove the connection
-							iterator.RemoveCurrent();
+							iterator = RemoveCLE(iterator);
 							continue;
 						}
 					} else if (
@@ -208,7 +205,7 @@ void ClientList::GetCLEIP(uint32 in_ip) {
 						} else {
 							LogClientLogin("Disconnect: Account [{}] on IP [{}]", cle->LSName(), ip_string);
 							cle->SetOnline(CLE_Status::Offline); // Remove the connection
-							iterator.RemoveCurrent();
+							iterator = RemoveCLE(iterator);
 							continue;
 						}
 					}
@@ -216,17 +213,16 @@ void ClientList::GetCLEIP(uint32 in_ip) {
 			}
 		}
 
-		iterator.Advance();
+		++iterator;
 	}
 }
 
 void ClientList::DisconnectByIP(uint32 in_ip) {
 	ClientListEntry* cle = nullptr;
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-	iterator.Reset();
+	auto iterator = clientlist.begin();
 
-	while (iterator.MoreElements()) {
-		cle = iterator.GetData();
+	while (iterator != clientlist.end()) {
+		cle = iterator->get();
 		if (cle->GetIP() == in_ip) {
 			if (strlen(cle->name())) {
 				auto pack = new ServerPacket(ServerOP_KickPlayer, sizeof(ServerKickPlayer_Struct));
@@ -238,54 +234,30 @@ void ClientList::DisconnectByIP(uint32 in_ip) {
 				safe_delete(pack);
 			}
 			cle->SetOnline(CLE_Status::Offline);
-			iterator.RemoveCurrent();
+			iterator = RemoveCLE(iterator);
+			continue;
 		}
-		iterator.Advance();
+		++iterator;
 	}
 }
 
 ClientListEntry* ClientList::FindCharacter(const char* name) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-
-	iterator.Reset();
-	while(iterator.MoreElements())
-	{
-		if (strcasecmp(iterator.GetData()->name(), name) == 0) {
-			return iterator.GetData();
-		}
-		iterator.Advance();
+	if (!name) {
+		return nullptr;
 	}
-	return nullptr;
+
+	return m_cle_index.FindByName(Strings::ToLower(name));
 }
 
 ClientListEntry* ClientList::FindCLEByAccountID(uint32 iAccID) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->AccountID() == iAccID) {
-			return iterator.GetData();
-		}
-		iterator.Advance();
-	}
-	return nullptr;
+	return m_cle_index.FindByAccountID(iAccID);
 }
 
 ClientListEntry* ClientList::FindCLEByCharacterID(uint32 iCharID) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->CharID() == iCharID) {
-			return iterator.GetData();
-		}
-		iterator.Advance();
-	}
-	return nullptr;
+	return m_cle_index.FindByCharacterID(iCharID);
 }
 
 void ClientList::SendCLEList(const int16& admin, const char* to, WorldTCPConnection* connection, const char* iName) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
 	int x = 0, y = 0;
 	int namestrlen = iName == 0 ? 0 : strlen(iName);
 	bool addnewline = false;
@@ -296,9 +268,8 @@ void ClientList::SendCLEList(const int16& admin, const char* to, WorldTCPConnect
 		strcpy(newline, "^");
 
 	auto out = fmt::memory_buffer();
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		ClientListEntry* cle = iterator.GetData();
+	for (auto &e : clientlist) {
+		ClientListEntry* cle = e.get();
 		if (admin >= cle->Admin() && (iName == 0 || namestrlen == 0 || strncasecmp(cle->name(), iName, namestrlen) == 0 || strncasecmp(cle->AccountName(), iName, namestrlen) == 0 || strncasecmp(cle->LSName(), iName, namestrlen) == 0)) {
 			struct in_addr in;
 			in.s_addr = cle->GetIP();
@@ -326,7 +297,6 @@ void ClientList::SendCLEList(const int16& admin, const char* to, WorldTCPConnect
 			}
 			y++;
 		}
-		iterator.Advance();
 		x++;
 	}
 	fmt::format_to(std::back_inserter(out), "{}{} CLEs in memory. {} CLEs listed. numplayers = {}.", newline, x, y, numplayers);
@@ -361,43 +331,124 @@ void ClientList::CLEAdd(
 		is_local
 	);
 
-	clientlist.Append(tmp);
+	AddCLE(tmp, false);
 }
 
-void ClientList::CLCheckStale() {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+void ClientList::AddCLE(ClientListEntry *cle, bool front)
+{
+	// orders mirror the list, entries put in front count down and the ones appended count up
+	if (front) {
+		clientlist.emplace_front(cle);
+		m_cle_index.Add(cle, --m_front_order, CLEKeys(cle));
+	}
+	else {
+		clientlist.emplace_back(cle);
+		m_cle_index.Add(cle, m_back_order++, CLEKeys(cle));
+	}
+}
 
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->CheckStale()) {
-			iterator.RemoveCurrent();
+ClientList::CLEList::iterator ClientList::RemoveCLE(CLEList::iterator iter)
+{
+	// out of the index before the entry goes, its destructor camps it and refiles on the way
+	m_cle_index.Remove(iter->get());
+	return clientlist.erase(iter);
+}
+
+ClientListKeys ClientList::CLEKeys(ClientListEntry *cle)
+{
+	ClientListKeys k;
+	k.id           = cle->GetID();
+	k.name         = Strings::ToLower(cle->name());
+	k.account_id   = cle->AccountID();
+	k.character_id = cle->CharID();
+	k.ls_id        = cle->LSID();
+	k.guild_id     = cle->GuildID();
+	k.zone_id      = cle->zone();
+	k.online       = cle->Online() >= CLE_Status::Zoning;
+	k.level        = cle->level();
+	k.class_id     = cle->class_();
+	k.race         = cle->race();
+	k.gm           = cle->GetGM() != 0;
+	k.lfg          = cle->LFG();
+	return k;
+}
+
+std::vector<ClientListEntry *> ClientList::WhoCandidates(int16 admin, Who_All_Struct *whom)
+{
+	// a superset of what the who predicates accept, they still run on every candidate
+	ClientListWhoFilter f;
+	if (whom) {
+		f.gm = whom->gmlookup != 0xFFFF;
+
+		if (whom->lvllow != 0xFFFF) {
+			f.level_low  = std::min<uint32>(whom->lvllow, 256);
+			f.level_high = std::min<uint32>(whom->lvlhigh, 255);
+		}
+
+		if (whom->wclass != 0xFFFF) {
+			f.class_id = std::min<uint32>(whom->wclass, 256);
+		}
+
+		if (whom->wrace != 0xFFFF) {
+			f.race = std::min<uint32>(whom->wrace, 65536);
+		}
+
+		// account names aren't indexed, admins who can match on them walk every online entry
+		const size_t whomlen = strlen(whom->whom);
+		if (whomlen > 0 && admin < AccountStatus::GMAdmin) {
+			f.text        = true;
+			f.name_prefix = Strings::ToLower(whom->whom);
+
+			for (auto zone_id : m_cle_index.Zones()) {
+				const char *zone_name = ZoneName(zone_id);
+				if (zone_name != 0 && strncasecmp(zone_name, whom->whom, whomlen) == 0) {
+					f.zones.push_back(zone_id);
+				}
+			}
+
+			for (auto guild_id : m_cle_index.Guilds()) {
+				if (strncasecmp(guild_mgr.GetGuildName(guild_id), whom->whom, whomlen) == 0) {
+					f.guilds.push_back(guild_id);
+				}
+			}
+		}
+	}
+
+	return m_cle_index.Who(f);
+}
+
+void ClientList::CLEChanged(ClientListEntry *cle)
+{
+	// entries refile from their constructors too, before they are in the list, that is a no-op
+	m_cle_index.Update(cle, CLEKeys(cle));
+}
+
+void ClientList::CLCheckStale() {
+	auto iterator = clientlist.begin();
+	while (iterator != clientlist.end()) {
+		if ((*iterator)->CheckStale()) {
+			iterator = RemoveCLE(iterator);
 		}
 		else
-			iterator.Advance();
+			++iterator;
 	}
 }
 
 void ClientList::ClientUpdate(ZoneServer *zoneserver, ServerClientList_Struct *scl)
 {
-	LinkedListIterator<ClientListEntry *> iterator(clientlist);
-	ClientListEntry                       *cle;
-	iterator.Reset();
-	while (iterator.MoreElements()) {
-		if (iterator.GetData()->GetID() == scl->wid) {
-			cle = iterator.GetData();
-			if (scl->remove == 2) {
-				cle->LeavingZone(zoneserver, CLE_Status::Offline);
-			}
-			else if (scl->remove == 1) {
-				cle->LeavingZone(zoneserver, CLE_Status::Zoning);
-			}
-			else {
-				cle->Update(zoneserver, scl);
-				AddToZoneServerCaches(cle);
-			}
-			return;
+	ClientListEntry *cle = m_cle_index.FindByID(scl->wid);
+	if (cle) {
+		if (scl->remove == 2) {
+			cle->LeavingZone(zoneserver, CLE_Status::Offline);
 		}
-		iterator.Advance();
+		else if (scl->remove == 1) {
+			cle->LeavingZone(zoneserver, CLE_Status::Zoning);
+		}
+		else {
+			cle->Update(zoneserver, scl);
+			AddToZoneServerCaches(cle);
+		}
+		return;
 	}
 	if (scl->remove == 2) {
 		cle = new ClientListEntry(GetNextCLEID(), zoneserver, scl, CLE_Status::Online);
@@ -467,35 +518,27 @@ void ClientList::ClientUpdate(ZoneServer *zoneserver, ServerClientList_Struct *s
 		scl->LFGComments
 	);
 
-	clientlist.Insert(cle);
+	AddCLE(cle, true);
 	AddToZoneServerCaches(cle);
 	zoneserver->ChangeWID(scl->charid, cle->GetID());
 }
 
 void ClientList::CLEKeepAlive(uint32 numupdates, uint32* wid) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-	uint32 i;
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		for (i=0; i<numupdates; i++) {
-			if (wid[i] == iterator.GetData()->GetID())
-				iterator.GetData()->KeepAlive();
+	for (uint32 i = 0; i < numupdates; i++) {
+		ClientListEntry *cle = m_cle_index.FindByID(wid[i]);
+		if (cle) {
+			cle->KeepAlive();
 		}
-		iterator.Advance();
 	}
 }
 
 ClientListEntry *ClientList::CheckAuth(uint32 loginserver_account_id, const char *key)
 {
-	LinkedListIterator<ClientListEntry *> iterator(clientlist);
-
-	iterator.Reset();
-	while (iterator.MoreElements()) {
-		if (iterator.GetData()->CheckAuth(loginserver_account_id, key)) {
-			return iterator.GetData();
+	// an entry only passes CheckAuth with its own login server id
+	for (auto cle : m_cle_index.WithLSID(loginserver_account_id)) {
+		if (cle->CheckAuth(loginserver_account_id, key)) {
+			return cle;
 		}
-		iterator.Advance();
 	}
 
 	return nullptr;
@@ -514,26 +557,14 @@ void ClientList::SendOnlineGuildMembers(uint32 FromID, uint32 GuildID)
 		return;
 	}
 
-	LinkedListIterator<ClientListEntry*> Iterator(clientlist);
-
-	Iterator.Reset();
+	auto members = m_cle_index.InGuild(GuildID);
 
-	while(Iterator.MoreElements())
+	for (auto CLE : members)
 	{
-		ClientListEntry* CLE = Iterator.GetData();
-
-		if(CLE && (CLE->GuildID() == GuildID))
-		{
-			PacketLength += (strlen(CLE->name()) + 5);
-			++Count;
-		}
-
-		Iterator.Advance();
-
+		PacketLength += (strlen(CLE->name()) + 5);
+		++Count;
 	}
 
-	Iterator.Reset();
-
 	auto pack = new ServerPacket(ServerOP_OnlineGuildMembersResponse, PacketLength);
 
 	char *Buffer = (char *)pack->pBuffer;
@@ -541,17 +572,10 @@ void ClientList::SendOnlineGuildMembers(uint32 FromID, uint32 GuildID)
 	VARSTRUCT_ENCODE_TYPE(uint32, Buffer, FromID);
 	VARSTRUCT_ENCODE_TYPE(uint32, Buffer, Count);
 
-	while(Iterator.MoreElements())
+	for (auto CLE : members)
 	{
-		ClientListEntry* CLE = Iterator.GetData();
-
-		if(CLE && (CLE->GuildID() == GuildID))
-		{
-			VARSTRUCT_ENCODE_STRING(Buffer, CLE->name());
-			VARSTRUCT_ENCODE_TYPE(uint32, Buffer, CLE->zone());
-		}
-
-		Iterator.Advance();
+		VARSTRUCT_ENCODE_STRING(Buffer, CLE->name());
+		VARSTRUCT_ENCODE_TYPE(uint32, Buffer, CLE->zone());
 	}
 	zoneserver_list.SendPacket(from->zone(), from->instance(), pack);
 	safe_delete(pack);
@@ -559,8 +583,6 @@ void ClientList::SendOnlineGuildMembers(uint32 FromID, uint32 GuildID)
 
 void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_Struct* whom, WorldTCPConnection* connection) {
 	try {
-		LinkedListIterator<ClientListEntry*> iterator(clientlist);
-		LinkedListIterator<ClientListEntry*> countclients(clientlist);
 		ClientListEntry* cle = 0;
 		ClientListEntry* countcle = 0;
 		//char tmpgm[25] = "";
@@ -607,9 +629,9 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 
 		uint32 totalusers=0;
 		uint32 totallength=0;
-		countclients.Reset();
-		while (countclients.MoreElements()) {
-			countcle = countclients.GetData();
+		auto candidates = WhoCandidates(admin, whom);
+		for (auto candidate : candidates) {
+			countcle = candidate;
 			const char* tmpZone = ZoneName(countcle->zone());
 			if (
 				(countcle->Online() >= CLE_Status::Zoning) &&
@@ -655,7 +677,6 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 					}
 				}
 			}
-			countclients.Advance();
 		}
 
 		uint32 plid=fromid;
@@ -705,10 +726,9 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 		memcpy(bufptr,&totalusers, sizeof(uint32));
 		bufptr+=sizeof(uint32);
 
-		iterator.Reset();
 		int idx=-1;
-		while(iterator.MoreElements()) {
-			cle = iterator.GetData();
+		for (auto candidate : candidates) {
+			cle = candidate;
 			const char* tmpZone = ZoneName(cle->zone());
 
 			if (
@@ -732,15 +752,12 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 				// These lines can be simplified but easier to conceptualize this way
 				if ((cle->Anon()==1 && cle->GetGM() && cle->Admin()>admin) || (idx>=20 && admin < AccountStatus::GMAdmin)) { //hide gms that are anon from lesser gms and normal players, cut off at 20
 					rankstring = 0;
-					iterator.Advance();
 					continue;
 				} else if (cle->Anon() == 1 && cle->Admin()>=admin && (whomlen == 0 || (whomlen !=0 && strncasecmp(cle->name(), whom->whom, whomlen) != 0))) {
 					rankstring = 0;
-					iterator.Advance();
 					continue;
 				} else if (cle->Anon() == 2 && cle->Admin()>=admin && (whomlen == 0 || (whomlen !=0 && strncasecmp(cle->name(), whom->whom, whomlen) != 0 && strncasecmp(guild_mgr.GetGuildName(cle->GuildID()), whom->whom, whomlen) != 0))) {
 					rankstring = 0;
-					iterator.Advance();
 					continue;
 				} else if (cle->GetGM()) {
 					if (cle->Admin() >= AccountStatus::GMImpossible) {
@@ -866,7 +883,6 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 				memcpy(bufptr,&ending, sizeof(uint32));
 				bufptr+=sizeof(uint32);
 			}
-			iterator.Advance();
 		}
 
 		SendPacket(to,pack2);
@@ -1024,15 +1040,19 @@ void ClientList::SendLFGMatches(ServerLFGMatchesRequest_Struct *smrs) {
 
 	// Send back matches when someone searches player's Looking For A Group.
 
-	LinkedListIterator<ClientListEntry*> Iterator(clientlist);
 	ClientListEntry* CLE = 0;
 	int Matches = 0;
 
-	Iterator.Reset();
+	ClientListWhoFilter f;
+	f.lfg        = true;
+	f.level_low  = smrs->FromLevel;
+	f.level_high = smrs->ToLevel;
 
-	// We run the ClientList twice. The first time is to determine how big the outgoing packet needs to be.
-	while(Iterator.MoreElements()) {
-		CLE = Iterator.GetData();
+	auto candidates = m_cle_index.Who(f);
+
+	// We run the candidates twice. The first time is to determine how big the outgoing packet needs to be.
+	for (auto candidate : candidates) {
+		CLE = candidate;
 		if(CLE->LFG()) {
 			unsigned int BitMask = 1 << CLE->class_();
 			// First we check that the player meets the level and class criteria of the person
@@ -1050,7 +1070,6 @@ void ClientList::SendLFGMatches(ServerLFGMatchesRequest_Struct *smrs) {
 								(smrs->QuerierLevel <= CLE->GetLFGToLevel())))
 					Matches++;
 		}
-		Iterator.Advance();
 	}
 	auto Pack = new ServerPacket(ServerOP_LFGMatches, (sizeof(ServerLFGMatchesResponse_Struct) * Matches) + 4);
 
@@ -1060,11 +1079,9 @@ void ClientList::SendLFGMatches(ServerLFGMatchesRequest_Struct *smrs) {
 
 	ServerLFGMatchesResponse_Struct* Buffer = (ServerLFGMatchesResponse_Struct*)Buf;
 
-	Iterator.Reset();
-
 	if(Matches) {
-		while(Iterator.MoreElements() && (Matches > 0)) {
-			CLE = Iterator.GetData();
+		for (auto iterator = candidates.begin(); iterator != candidates.end() && (Matches > 0); ++iterator) {
+			CLE = *iterator;
 			if(CLE->LFG()) {
 				unsigned int BitMask = 1 << CLE->class_();
 				if((CLE->level() >= smrs->FromLevel) && (CLE->level() <= smrs->ToLevel) &&
@@ -1083,7 +1100,6 @@ void ClientList::SendLFGMatches(ServerLFGMatchesRequest_Struct *smrs) {
 					Buffer++;
 				}
 			}
-			Iterator.Advance();
 		}
 	}
 	SendPacket(smrs->FromName,Pack);
@@ -1091,7 +1107,6 @@ void ClientList::SendLFGMatches(ServerLFGMatchesRequest_Struct *smrs) {
 }
 
 void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct* whom, WorldTCPConnection* connection) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
 	ClientListEntry* cle = 0;
 	char tmpgm[25] = "";
 	char accinfo[150] = "";
@@ -1109,9 +1124,8 @@ void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct*
 		fmt::format_to(std::back_inserter(out), "\r\n");
 	else
 		fmt::format_to(std::back_inserter(out), "\n");
-	iterator.Reset();
-	while (iterator.MoreElements()) {
-		cle = iterator.GetData();
+	for (auto candidate : WhoCandidates(admin, whom)) {
+		cle = candidate;
 		const char* tmpZone = ZoneName(cle->zone());
 		if (
 			(cle->Online() >= CLE_Status::Zoning)
@@ -1185,7 +1199,6 @@ void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct*
 				if (admin >= AccountStatus::GMAdmin && admin >= cle->Admin())
 					sprintf(line, "  %s[RolePlay %i %s] %s (%s)%s zone: %s%s%s", tmpgm, cle->level(), GetClassIDName(cle->class_(), cle->level()), cle->name(), GetRaceIDName(cle->race()), tmpguild, tmpZone, LFG, accinfo);
 				else if (cle->Admin() >= AccountStatus::QuestTroupe && admin < AccountStatus::QuestTroupe && cle->GetGM()) {
-					iterator.Advance();
 					continue;
 				}
 				else
@@ -1195,7 +1208,6 @@ void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct*
 				if (admin >= AccountStatus::GMAdmin && admin >= cle->Admin())
 					sprintf(line, "  %s[ANON %i %s] %s (%s)%s zone: %s%s%s", tmpgm, cle->level(), GetClassIDName(cle->class_(), cle->level()), cle->name(), GetRaceIDName(cle->race()), tmpguild, tmpZone, LFG, accinfo);
 				else if (cle->Admin() >= AccountStatus::QuestTroupe && cle->GetGM()) {
-					iterator.Advance();
 					continue;
 				}
 				else
@@ -1225,7 +1237,6 @@ void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct*
 			if (x >= 20 && admin < AccountStatus::QuestTroupe)
 				break;
 		}
-		iterator.Advance();
 	}
 
 	if (x >= 20 && admin < AccountStatus::QuestTroupe)
@@ -1346,26 +1357,16 @@ bool ClientList::SendPacket(const char* to, ServerPacket* pack) {
 }
 
 void ClientList::UpdateClientGuild(uint32 char_id, uint32 guild_id) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		ClientListEntry *cle = iterator.GetData();
-		if (cle->CharID() == char_id) {
-			cle->SetGuild(guild_id);
-		}
-		iterator.Advance();
+	for (auto cle : m_cle_index.WithCharacterID(char_id)) {
+		cle->SetGuild(guild_id);
 	}
 }
 
 bool ClientList::IsAccountInGame(uint32 iLSID) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-	iterator.Reset();
-	while (iterator.MoreElements()) {
-		if (iterator.GetData()->LSID() == iLSID && iterator.GetData()->Online() == CLE_Status::InZone) {
+	for (auto cle : m_cle_index.WithLSID(iLSID)) {
+		if (cle->Online() == CLE_Status::InZone) {
 			return true;
 		}
-		iterator.Advance();
 	}
 
 	return false;
@@ -1376,23 +1377,13 @@ int ClientList::GetClientCount() {
 }
 
 void ClientList::GetClients(const char *zone_name, std::vector<ClientListEntry *> &res) {
-	LinkedListIterator<ClientListEntry *> iterator(clientlist);
-	iterator.Reset();
-
 	if(zone_name[0] == '\0') {
-		while(iterator.MoreElements()) {
-			ClientListEntry* tmp = iterator.GetData();
-			res.push_back(tmp);
-			iterator.Advance();
+		for (auto &e : clientlist) {
+			res.push_back(e.get());
 		}
 	} else {
-		uint32 zoneid = ZoneID(zone_name);
-		while(iterator.MoreElements()) {
-			ClientListEntry* tmp = iterator.GetData();
-			if(tmp->zone() == zoneid)
-				res.push_back(tmp);
-			iterator.Advance();
-		}
+		auto in_zone = m_cle_index.InZone(ZoneID(zone_name));
+		res.insert(res.end(), in_zone.begin(), in_zone.end());
 	}
 }
 
@@ -1408,10 +1399,8 @@ void ClientList::SendClientVersionSummary(const char *Name)
 		{ EQ::versions::ClientVersion::RoF2, 0 }
 	};
 
-	LinkedListIterator<ClientListEntry*> Iterator(clientlist);
-	Iterator.Reset();
-	while (Iterator.MoreElements()) {
-		auto CLE = Iterator.GetData();
+	for (auto &e : clientlist) {
+		auto CLE = e.get();
 		if (CLE && CLE->zone()) {
 			auto client_version = CLE->GetClientVersion();
 			if (
@@ -1425,8 +1414,6 @@ void ClientList::SendClientVersionSummary(const char *Name)
 				unique_ips.push_back(CLE->GetIP());
 			}
 		}
-
-		Iterator.Advance();
 	}
 
 	uint32 total_clients = (
@@ -1541,13 +1528,9 @@ void ClientList::OnTick(EQ::Timer *t)
 	out["event"] = "EQW::ClientUpdate";
 	out["data"] = Json::Value();
 
-	LinkedListIterator<ClientListEntry*> Iterator(clientlist);
-
-	Iterator.Reset();
-
-	while (Iterator.MoreElements())
+	for (auto &e : clientlist)
 	{
-		ClientListEntry* cle = Iterator.GetData();
+		ClientListEntry* cle = e.get();
 
 		Json::Value outclient;
 
@@ -1609,8 +1592,6 @@ void ClientList::OnTick(EQ::Timer *t)
 		outclient["LFGComments"] = cle->GetLFGComments();
 		outclient["ClientVersion"] = cle->GetClientVersion();
 		out["data"].append(outclient);
-
-		Iterator.Advance();
 	}
 
 	web_interface.SendEvent(out);
@@ -1621,12 +1602,8 @@ void ClientList::OnTick(EQ::Timer *t)
  */
 void ClientList::GetClientList(Json::Value &response, bool full_list)
 {
-	LinkedListIterator<ClientListEntry *> Iterator(clientlist);
-
-	Iterator.Reset();
-
-	while (Iterator.MoreElements()) {
-		ClientListEntry *cle = Iterator.GetData();
+	for (auto &e : clientlist) {
+		ClientListEntry *cle = e.get();
 
 		Json::Value row;
 
@@ -1694,8 +1671,6 @@ void ClientList::GetClientList(Json::Value &response, bool full_list)
 		}
 
 		response.append(row);
-
-		Iterator.Advance();
 	}
 }
 
@@ -1776,16 +1751,7 @@ void ClientList::SendCharacterMessageID(ClientListEntry* character,
 
 void ClientList::GetGuildClientList(Json::Value& response, uint32 guild_id)
 {
-	LinkedListIterator<ClientListEntry*> Iterator(clientlist);
-
-	Iterator.Reset();
-
-	while (Iterator.MoreElements()) {
-		ClientListEntry* cle = Iterator.GetData();
-		if (cle->GuildID() != guild_id) {
-			Iterator.Advance();
-			continue;
-		}
+	for (auto cle : m_cle_index.InGuild(guild_id)) {
 		Json::Value row;
 
 		row["account_id"]             = cle->AccountID();
@@ -1846,8 +1812,6 @@ void ClientList::GetGuildClientList(Json::Value& response, uint32 guild_id)
 		row["zone"]                 = cle->zone();
 
 		response.append(row);
-
-		Iterator.Advance();
 	}
 }
 
@@ -1855,15 +1819,10 @@ std::map<uint32, ClientListEntry *> ClientList::GetGuildClientsWithTributeOptIn(
 {
 	std::map<uint32, ClientListEntry *> guild_members;
 
-	LinkedListIterator<ClientListEntry *> Iterator(clientlist);
-	Iterator.Reset();
-
-	while (Iterator.MoreElements()) {
-		auto c = Iterator.GetData();
-		if (c->GuildID() == guild_id && c->GuildTributeOptIn()) {
+	for (auto c : m_cle_index.InGuild(guild_id)) {
+		if (c->GuildTributeOptIn()) {
 			guild_members.emplace(c->CharID(), c);
 		}
-		Iterator.Advance();
 	}
 	return guild_members;
 }
@@ -1874,14 +1833,10 @@ void ClientList::RebuildZoneServerCaches()
 	m_gm_zone_server_ids.clear();
 	m_guild_zone_server_ids.clear();
 
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-	iterator.Reset();
-
-	while (iterator.MoreElements()) {
-		ClientListEntry* cle = iterator.GetData();
+	for (auto &e : clientlist) {
+		ClientListEntry* cle = e.get();
 
 		if (cle->Online() != CLE_Status::InZone || !cle->Server()) {
-			iterator.Advance();
 			continue;
 		}
 
@@ -1897,8 +1852,6 @@ void ClientList::RebuildZoneServerCaches()
 			auto& guild_set = m_guild_zone_server_ids[cle->GuildID()];
 			guild_set.insert(server_id);
 		}
-
-		iterator.Advance();
 	}
 }
 
@@ -1908,30 +1861,19 @@ std::vector<uint32_t> ClientList::GetGuildZoneServers(uint32 guild_id)
 		std::vector<uint32_t>        zone_server_ids;
 		std::unordered_set<uint32_t> seen_ids;
 
-		LinkedListIterator<ClientListEntry *> iterator(clientlist);
-
-		iterator.Reset();
-		while (iterator.MoreElements()) {
-			ClientListEntry *cle = iterator.GetData();
-
+		for (auto cle : m_cle_index.InGuild(guild_id)) {
 			if (cle->Online() != CLE_Status::InZone) {
-				iterator.Advance();
 				continue;
 			}
 
 			if (!cle->Server()) {
-				iterator.Advance();
 				continue;
 			}
 
-			if (cle->GuildID() == guild_id) {
-				uint32_t id = cle->Server()->GetID();
-				if (seen_ids.insert(id).second) {
-					zone_server_ids.emplace_back(id);
-				}
+			uint32_t id = cle->Server()->GetID();
+			if (seen_ids.insert(id).second) {
+				zone_server_ids.emplace_back(id);
 			}
-
-			iterator.Advance();
 		}
 
 		return zone_server_ids;
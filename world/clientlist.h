@@ -9,6 +9,9 @@
 #include "../common/servertalk.h"
 #include "../common/event/timer.h"
 #include "../common/net/console_server_connection.h"
+#include "client_list_index.h"
+#include <list>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -61,6 +64,7 @@ public:
 	void	CLEKeepAlive(uint32 numupdates, uint32* wid);
 	void	CLEAdd(uint32 login_server_id, const char* login_server_name, const char* login_name, const char* login_key, int16 world_admin = AccountStatus::Player, uint32 ip_address = 0, uint8 is_local=0);
 	void	UpdateClientGuild(uint32 char_id, uint32 guild_id);
+	void	CLEChanged(ClientListEntry *cle); // refiles an entry whose name, ids, guild or zone may have changed
 	bool    IsAccountInGame(uint32 iLSID);
 
 	int GetClientCount();
@@ -89,13 +93,25 @@ private:
 	void OnTick(EQ::Timer *t);
 	inline uint32 GetNextCLEID() { return NextCLEID++; }
 
+	typedef std::list<std::unique_ptr<ClientListEntry>> CLEList;
+
+	void AddCLE(ClientListEntry *cle, bool front);
+	CLEList::iterator RemoveCLE(CLEList::iterator iter);
+	static ClientListKeys CLEKeys(ClientListEntry *cle);
+	std::vector<ClientListEntry *> WhoCandidates(int16 admin, Who_All_Struct *whom);
+
 	//this is the list of people actively connected to zone
 	LinkedList<Client*> list;
 
 	//this is the list of people in any zone, not nescesarily connected to world
 	Timer	CLStale_timer;
 	uint32 NextCLEID;
-	LinkedList<ClientListEntry *> clientlist;
+
+	// the index outlives the list, entries refile themselves while they are torn down
+	ClientListIndex<ClientListEntry> m_cle_index;
+	CLEList                          clientlist;
+	int64                            m_front_order;
+	int64                            m_back_order;
 
 
 	std::unique_ptr<EQ::Timer> m_tick;
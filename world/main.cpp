@@ -355,6 +355,7 @@ int main(int argc, char **argv)
 	opts.daybreak_options.resend_delay_min    = RuleI(Network, ResendDelayMinMS);
 	opts.daybreak_options.resend_delay_max    = RuleI(Network, ResendDelayMaxMS);
 	opts.daybreak_options.outgoing_data_rate  = RuleR(Network, ClientDataRate);
+	opts.daybreak_options.batched_io          = RuleB(Network, BatchedUDPIO);
 
 	EQ::Net::EQStreamManager eqsm(opts);
 
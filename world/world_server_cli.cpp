@@ -22,6 +22,8 @@ void WorldserverCLI::CommandHandler(int argc, char **argv)
 	function_map["mercs:disable"]               = &WorldserverCLI::MercsDisable;
 	function_map["world:version"]               = &WorldserverCLI::Version;
 	function_map["character:copy-character"]    = &WorldserverCLI::CopyCharacter;
+	function_map["benchmark:client-list"]       = &WorldserverCLI::BenchmarkClientList;
+	function_map["benchmark:daybreak-dispatch"] = &WorldserverCLI::BenchmarkDaybreakDispatch;
 	function_map["database:version"]            = &WorldserverCLI::DatabaseVersion;
 	function_map["database:set-account-status"] = &WorldserverCLI::DatabaseSetAccountStatus;
 	function_map["database:schema"]             = &WorldserverCLI::DatabaseGetSchema;
@@ -39,6 +41,8 @@ void WorldserverCLI::CommandHandler(int argc, char **argv)
 	EQEmuCommand::HandleMenu(function_map, cmd, argc, argv);
 }
 
+#include "cli/benchmark_client_list.cpp"
+#include "cli/benchmark_daybreak_dispatch.cpp"
 #include "cli/database_concurrency.cpp"
 #include "cli/bots_enable.cpp"
 #include "cli/bots_disable.cpp"
@@ -25,6 +25,8 @@ public:
 	static void TestRepository2(int argc, char **argv, argh::parser &cmd, std::string &description);
 	static void TestDatabaseConcurrency(int argc, char **argv, argh::parser &cmd, std::string &description);
 	static void TestStringBenchmarkCommand(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkClientList(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkDaybreakDispatch(int argc, char **argv, argh::parser &cmd, std::string &description);
 	static void EtlGetSettings(int argc, char **argv, argh::parser &cmd, std::string &description);
 };
 
@@ -1713,8 +1713,8 @@ bool Mob::CanPurchaseAlternateAdvancementRank(AA::Rank *rank, bool check_price,
 	return true;
 }
 
-void Zone::LoadAlternateAdvancement() {
-	if (!content_db.LoadAlternateAdvancementAbilities(aa_abilities, aa_ranks)) {
+void Zone::LoadAlternateAdvancement(ZoneDatabase &db) {
+	if (!db.LoadAlternateAdvancementAbilities(aa_abilities, aa_ranks)) {
 		aa_abilities.clear();
 		aa_ranks.clear();
 		LogInfo("Failed to load Alternate Advancement Data");
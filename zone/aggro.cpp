@@ -373,6 +373,24 @@ void NPC::DescribeAggro(Client *to_who, Mob *mob, bool verbose) {
 	to keep the #aggro command accurate.
 */
 bool Mob::CheckWillAggro(Mob *mob) {
+	if (!CheckWillAggroExceptLoS(mob)) {
+		return false;
+	}
+
+	if (!CheckLosFN(mob)) {
+		LogAggro("[{}] can not see [{}]", GetName(), mob->GetName());
+		return false;
+	}
+
+	LogAggro("Check aggro for [{}] target [{}]", GetName(), mob->GetName());
+	return true;
+}
+
+/*
+	Everything CheckWillAggro looks at but line of sight, so scans over many mobs can
+	batch the LoS checks for the ones that pass.
+*/
+bool Mob::CheckWillAggroExceptLoS(Mob *mob) {
 	if(!mob) {
 		return false;
 	}
@@ -530,10 +548,7 @@ bool Mob::CheckWillAggro(Mob *mob) {
 			)
 		)
 	) {
-		if(CheckLosFN(mob)) {
-			LogAggro("Check aggro for [{}] target [{}]", GetName(), mob->GetName());
-			return true;
-		}
+		return true;
 	} else {
 		if (
 			(
@@ -559,10 +574,7 @@ bool Mob::CheckWillAggro(Mob *mob) {
 				)
 			)
 		) {
-			if(CheckLosFN(mob)) {
-				LogAggro("Check aggro for [{}] target [{}]", GetName(), mob->GetName());
-				return true;
-			}
+			return true;
 		}
 	}
 
@@ -1319,6 +1331,70 @@ bool Mob::CheckLosFN(glm::vec3 posWatcher, float sizeWatcher, glm::vec3 posTarge
 	return zone->zonemap->CheckLoS(posWatcher, posTarget);
 }
 
+void Mob::CheckLosFN(const std::vector<Mob *> &others, std::vector<bool> &results) {
+	std::vector<glm::vec4> targets;
+	targets.reserve(others.size());
+	for (auto o : others) {
+		targets.emplace_back(o->GetX(), o->GetY(), o->GetZ(), o->GetSize());
+	}
+
+	CheckLosFN(targets, results);
+
+	if (!results.empty()) {
+		SetLastLosState(results.back());
+	}
+}
+
+void Mob::CheckLosFN(const std::vector<glm::vec4> &targets, std::vector<bool> &results) {
+	if (zone->zonemap == nullptr) {
+#ifdef LOS_DEFAULT_CAN_SEE
+		results.assign(targets.size(), true);
+#else
+		results.assign(targets.size(), false);
+#endif
+		return;
+	}
+
+	glm::vec3 myloc(GetX(), GetY(), GetZ() + (GetSize()==0.0?LOS_DEFAULT_HEIGHT:GetSize())/2 * HEAD_POSITION);
+
+	std::vector<glm::vec3> olocs;
+	olocs.reserve(targets.size());
+	for (auto &t : targets) {
+		olocs.emplace_back(t.x, t.y, t.z + (t.w==0.0?LOS_DEFAULT_HEIGHT:t.w)/2 * SEE_POSITION);
+	}
+
+	zone->zonemap->CheckLoS(myloc, olocs, results);
+}
+
+void Mob::CheckLosFN(const std::vector<Mob *> &watchers, Mob *other, std::vector<bool> &results) {
+	if (zone->zonemap == nullptr) {
+#ifdef LOS_DEFAULT_CAN_SEE
+		results.assign(watchers.size(), true);
+#else
+		results.assign(watchers.size(), false);
+#endif
+	} else {
+		glm::vec3 oloc(
+			other->GetX(),
+			other->GetY(),
+			other->GetZ() + (other->GetSize()==0.0?LOS_DEFAULT_HEIGHT:other->GetSize())/2 * SEE_POSITION
+		);
+
+		std::vector<glm::vec3> mylocs;
+		std::vector<glm::vec3> olocs(watchers.size(), oloc);
+		mylocs.reserve(watchers.size());
+		for (auto w : watchers) {
+			mylocs.emplace_back(w->GetX(), w->GetY(), w->GetZ() + (w->GetSize()==0.0?LOS_DEFAULT_HEIGHT:w->GetSize())/2 * HEAD_POSITION);
+		}
+
+		zone->zonemap->CheckLoS(mylocs, olocs, results);
+	}
+
+	for (size_t i = 0; i < watchers.size(); ++i) {
+		watchers[i]->SetLastLosState(results[i]);
+	}
+}
+
 bool Mob::CheckPositioningLosFN(Mob* other, float x, float y, float z) {
 	if (!zone->zonemap) {
 		//not sure what the best return is on error
@@ -29,6 +29,7 @@
 #include "object.h"
 #include "zone.h"
 #include "doors.h"
+#include "tick_profiler.h"
 #include <iostream>
 
 extern Zone *zone;
@@ -822,6 +823,42 @@ Json::Value ApiGetZoneAttributes(EQ::Net::WebsocketServerConnection *connection,
 	return response;
 }
 
+Json::Value ApiGetTickProfile(EQ::Net::WebsocketServerConnection *connection, Json::Value params)
+{
+	auto &profiler = TickProfiler::Get();
+
+	Json::Value response;
+
+	auto fill = [](Json::Value &row, const TickProfiler::PhaseSummary &s) {
+		row["name"]          = s.name;
+		row["samples"]       = static_cast<Json::UInt64>(s.samples);
+		row["p50_us"]        = s.p50_us;
+		row["p99_us"]        = s.p99_us;
+		row["max_us"]        = s.max_us;
+		row["avg_us"]        = s.avg_us;
+		row["worst_tick_us"] = s.worst_tick_us;
+	};
+
+	Json::Value tick;
+	fill(tick, profiler.GetTickSummary());
+	response["tick"] = tick;
+
+	Json::Value phases(Json::arrayValue);
+	for (auto &s : profiler.GetPhaseSummaries()) {
+		Json::Value row;
+		fill(row, s);
+		phases.append(row);
+	}
+
+	response["phases"]          = phases;
+	response["window_seconds"]  = TickProfiler::WindowSeconds;
+	response["worst_tick_time"] = static_cast<Json::Int64>(
+		std::chrono::system_clock::to_time_t(profiler.GetWorstTick().when)
+	);
+
+	return response;
+}
+
 Json::Value ApiGetLogsysCategories(EQ::Net::WebsocketServerConnection *connection, Json::Value params)
 {
 	if (!zone || (zone && zone->GetZoneID() == 0)) {
@@ -904,6 +941,7 @@ void RegisterApiService(std::unique_ptr<EQ::Net::WebsocketServer> &server)
 	server->SetMethodHandler("get_mob_list_detail", &ApiGetMobListDetail, 50);
 	server->SetMethodHandler("get_client_list_detail", &ApiGetClientListDetail, 50);
 	server->SetMethodHandler("get_zone_attributes", &ApiGetZoneAttributes, 50);
+	server->SetMethodHandler("get_tick_profile", &ApiGetTickProfile, 50);
 	server->SetMethodHandler("get_logsys_categories", &ApiGetLogsysCategories, 50);
 	server->SetMethodHandler("set_logging_level", &ApiSetLoggingLevel, 50);
 
@@ -2441,6 +2441,8 @@ bool NPC::Attack(Mob* other, int Hand, bool bRiposte, bool IsStrikethrough, bool
 }
 
 void NPC::Damage(Mob* other, int64 damage, uint16 spell_id, EQ::skills::SkillType attack_skill, bool avoidable, int8 buffslot, bool iBuffTic, eSpecialAttacks special) {
+	entity_list.WakeMob(GetID());
+
 	if (spell_id == 0)
 		spell_id = SPELL_UNKNOWN;
 
@@ -2979,6 +2981,7 @@ bool NPC::Death(Mob* killer_mob, int64 damage, uint16 spell, EQ::skills::SkillTy
 	WipeHateList();
 
 	p_depop = true;
+	entity_list.WakeMob(GetID());
 
 	if (killer_mob && killer_mob->GetTarget() == this) { // We can kill things without having them targeted
 		killer_mob->SetTarget(nullptr);
@@ -3050,6 +3053,8 @@ void Mob::AddToHateList(Mob* other, int64 hate /*= 0*/, int64 damage /*= 0*/, bo
 	if (other->IsDestroying())
 		return;
 
+	entity_list.WakeMob(GetID());
+
 	if (other == this)
 		return;
 
@@ -739,6 +739,7 @@ bool Aura::Process()
 
 	if (movement_type == AuraMovement::Follow && GetPosition() != owner->GetPosition() && movement_timer.Check()) {
 		m_Position = owner->GetPosition();
+		entity_list.UpdateCloseGrid(this);
 
 		static EQApplicationPacket packet(OP_ClientUpdate, sizeof(PlayerPositionUpdateServer_Struct));
 		auto                       spu = (PlayerPositionUpdateServer_Struct *) packet.pBuffer;
@@ -40,7 +40,7 @@
 void Mob::CalcBonuses()
 {
 	CalcSpellBonuses(&spellbonuses);
-	CalcAABonuses(&aabonuses);
+	UpdateAABonuses();
 	CalcMaxHP();
 	CalcMaxMana();
 	SetAttackTimer();
@@ -69,12 +69,9 @@ void NPC::CalcBonuses()
 
 void Client::CalcBonuses()
 {
-	memset(&itembonuses, 0, sizeof(StatBonuses));
-	CalcItemBonuses(&itembonuses);
-	CalcHeroicBonuses(&itembonuses);
-	CalcEdibleBonuses(&itembonuses);
+	UpdateItemBonuses();
 	CalcSpellBonuses(&spellbonuses);
-	CalcAABonuses(&aabonuses);
+	UpdateAABonuses();
 
 	CalcSeeInvisibleLevel();
 	CalcInvisibleLevel();
@@ -123,6 +120,157 @@ void Client::CalcBonuses()
 		consume_food_timer.SetTimer(timer);
 }
 
+/*
+	Buffs land and fade far more often than gear, levels or AAs change, so a buff only
+	recalculation copies the item and AA folds from the last one when everything they were built
+	from is the same, and only the spell fold and the derived stats are redone.
+	A full CalcBonuses always rebuilds every fold.
+*/
+void Mob::CalcBuffBonuses()
+{
+	m_buff_bonus_recalc = true;
+	CalcBonuses();
+	m_buff_bonus_recalc = false;
+}
+
+void Mob::UpdateAABonuses()
+{
+	// nothing to save for a mob without ranks
+	if (aa_ranks.empty()) {
+		m_aa_bonus_cache.reset();
+		CalcAABonuses(&aabonuses);
+		return;
+	}
+
+	const bool reusable = (
+		m_buff_bonus_recalc &&
+		m_aa_bonus_cache &&
+		m_aa_bonus_cache->level == GetLevel() &&
+		m_aa_bonus_cache->ranks == aa_ranks
+	);
+
+	if (reusable && !RuleB(Character, VerifyBuffBonusCache)) {
+		memcpy(&aabonuses, &m_aa_bonus_cache->bonuses, sizeof(StatBonuses));
+		ReplayCachedWeaponStance(aabonuses);
+		return;
+	}
+
+	CalcAABonuses(&aabonuses);
+
+	if (reusable && memcmp(&aabonuses, &m_aa_bonus_cache->bonuses, sizeof(StatBonuses)) != 0) {
+		LogError("Cached AA bonuses for [{}] differ from a full recalculation", GetCleanName());
+	}
+
+	if (!m_buff_bonus_recalc && !m_aa_bonus_cache) {
+		return;
+	}
+
+	if (!m_aa_bonus_cache) {
+		m_aa_bonus_cache = std::make_unique<AABonusCache>();
+	}
+
+	memcpy(&m_aa_bonus_cache->bonuses, &aabonuses, sizeof(StatBonuses));
+	m_aa_bonus_cache->level = GetLevel();
+	m_aa_bonus_cache->ranks = aa_ranks;
+}
+
+// the folds enable weapon stance as a side effect, which a copied fold has to do as well
+void Mob::ReplayCachedWeaponStance(const StatBonuses &b)
+{
+	for (int i = 0; i <= WEAPON_STANCE_TYPE_MAX; i++) {
+		if (IsValidSpell(b.WeaponStance[i])) {
+			SetWeaponStanceEnabled(true);
+			return;
+		}
+	}
+}
+
+void Client::UpdateItemBonuses()
+{
+	const bool cached = m_buff_bonus_recalc || m_item_bonus_cache;
+	if (cached) {
+		GetItemBonusSignature(m_item_bonus_signature);
+	}
+
+	const bool reusable = (
+		m_buff_bonus_recalc &&
+		m_item_bonus_cache &&
+		m_item_bonus_cache->signature == m_item_bonus_signature
+	);
+
+	// equip flags and item faction bonuses are left as the cached fold set them
+	if (reusable && !RuleB(Character, VerifyBuffBonusCache)) {
+		memcpy(&itembonuses, &m_item_bonus_cache->bonuses, sizeof(StatBonuses));
+		ReplayCachedWeaponStance(itembonuses);
+		return;
+	}
+
+	memset(&itembonuses, 0, sizeof(StatBonuses));
+	CalcItemBonuses(&itembonuses);
+	CalcHeroicBonuses(&itembonuses);
+	CalcEdibleBonuses(&itembonuses);
+
+	if (reusable && memcmp(&itembonuses, &m_item_bonus_cache->bonuses, sizeof(StatBonuses)) != 0) {
+		LogError("Cached item bonuses for [{}] differ from a full recalculation", GetCleanName());
+	}
+
+	if (!cached) {
+		return;
+	}
+
+	if (!m_item_bonus_cache) {
+		m_item_bonus_cache = std::make_unique<ItemBonusCache>();
+	}
+
+	// stored before spell negation and ProcessItemCaps touch it, those run again on every recalculation
+	memcpy(&m_item_bonus_cache->bonuses, &itembonuses, sizeof(StatBonuses));
+	m_item_bonus_cache->signature.swap(m_item_bonus_signature);
+}
+
+// everything the item fold reads that can change without a full CalcBonuses, instances are
+// compared by address and by the item data they point at so a scaled or swapped item differs
+void Client::GetItemBonusSignature(std::vector<uintptr_t> &signature)
+{
+	signature.clear();
+	signature.push_back(GetLevel());
+	signature.push_back(GetBaseRace());
+	signature.push_back(GetClass());
+	signature.push_back(static_cast<uint32>(spellbonuses.ItemATKCap + aabonuses.ItemATKCap));
+
+	auto add_instance = [&](const EQ::ItemInstance *inst) {
+		signature.push_back(reinterpret_cast<uintptr_t>(inst));
+		if (!inst) {
+			return;
+		}
+
+		signature.push_back(reinterpret_cast<uintptr_t>(inst->GetItem()));
+		for (int i = EQ::invaug::SOCKET_BEGIN; i <= EQ::invaug::SOCKET_END; i++) {
+			const auto *augment = inst->GetAugment(i);
+			signature.push_back(reinterpret_cast<uintptr_t>(augment ? augment->GetItem() : nullptr));
+		}
+	};
+
+	for (int16 i = EQ::invslot::BONUS_BEGIN; i <= EQ::invslot::BONUS_SKILL_END; i++) {
+		add_instance(GetInv().GetItem(i));
+	}
+
+	for (int16 i = EQ::invslot::GUILD_TRIBUTE_BEGIN; i <= EQ::invslot::GUILD_TRIBUTE_END; i++) {
+		add_instance(GetInv().GetItem(i));
+	}
+
+	signature.push_back(GetPP().tribute_active);
+	if (GetPP().tribute_active) {
+		for (auto const &t: GetPP().tributes) {
+			signature.push_back(t.tribute);
+			signature.push_back(t.tier);
+		}
+	}
+
+	for (auto inst: GetEdibleBonusItems()) {
+		add_instance(inst);
+	}
+}
+
 int Mob::CalcRecommendedLevelBonus(uint8 current_level, uint8 recommended_level, int base_stat)
 {
 	if (recommended_level && current_level < recommended_level) {
@@ -556,15 +704,22 @@ void Mob::AdditiveWornBonuses(const EQ::ItemInstance* inst, StatBonuses* b, bool
 }
 
 void Client::CalcEdibleBonuses(StatBonuses* newbon) {
-	uint32 i;
+	for (auto inst : GetEdibleBonusItems()) {
+		if (inst) {
+			AddItemBonuses(inst, newbon);
+		}
+	}
+}
+
+// the first food and the first drink in the general slots and then the bags, in slot order
+std::array<const EQ::ItemInstance*, 2> Client::GetEdibleBonusItems() {
+	std::array<const EQ::ItemInstance*, 2> edibles = { nullptr, nullptr };
+	size_t found = 0;
 
 	bool food = false;
 	bool drink = false;
-	for (i = EQ::invslot::GENERAL_BEGIN; i <= EQ::invslot::GENERAL_END; i++)
-	{
-		if (food && drink)
-			break;
-		const EQ::ItemInstance* inst = GetInv().GetItem(i);
+	auto check_slot = [&](int16 slot_id) {
+		const EQ::ItemInstance* inst = GetInv().GetItem(slot_id);
 		if (inst && inst->GetItem() && inst->IsClassCommon()) {
 			const EQ::ItemData *item = inst->GetItem();
 			if (!food && item->ItemType == EQ::item::ItemTypeFood)
@@ -572,26 +727,19 @@ void Client::CalcEdibleBonuses(StatBonuses* newbon) {
 			else if (!drink && item->ItemType == EQ::item::ItemTypeDrink)
 				drink = true;
 			else
-				continue;
-			AddItemBonuses(inst, newbon);
+				return;
+			edibles[found++] = inst;
 		}
+	};
+
+	for (int16 i = EQ::invslot::GENERAL_BEGIN; i <= EQ::invslot::GENERAL_END && !(food && drink); i++) {
+		check_slot(i);
 	}
-	for (i = EQ::invbag::GENERAL_BAGS_BEGIN; i <= EQ::invbag::GENERAL_BAGS_END; i++)
-	{
-		if (food && drink)
-			break;
-		const EQ::ItemInstance* inst = GetInv().GetItem(i);
-		if (inst && inst->GetItem() && inst->IsClassCommon()) {
-			const EQ::ItemData *item = inst->GetItem();
-			if (!food && item->ItemType == EQ::item::ItemTypeFood)
-				food = true;
-			else if (!drink && item->ItemType == EQ::item::ItemTypeDrink)
-				drink = true;
-			else
-				continue;
-			AddItemBonuses(inst, newbon);
-		}
+	for (int16 i = EQ::invbag::GENERAL_BAGS_BEGIN; i <= EQ::invbag::GENERAL_BAGS_END && !(food && drink); i++) {
+		check_slot(i);
 	}
+
+	return edibles;
 }
 
 void Mob::CalcAABonuses(StatBonuses *newbon)
@@ -3627,9 +3627,7 @@ bool Bot::Spawn(Client* botCharacterOwner) {
 		}
 
 		// Spawn the bot at the bot owner's loc
-		m_Position.x = botCharacterOwner->GetX();
-		m_Position.y = botCharacterOwner->GetY();
-		m_Position.z = botCharacterOwner->GetZ();
+		SetPosition(botCharacterOwner->GetX(), botCharacterOwner->GetY(), botCharacterOwner->GetZ());
 
 		// Make the bot look at the bot owner
 		FaceTarget(botCharacterOwner);
@@ -6296,7 +6294,7 @@ void Bot::CalcBonuses() {
 	CalcItemBonuses(&itembonuses);
 	CalcHeroicBonuses(&itembonuses);
 	CalcSpellBonuses(&spellbonuses);
-	CalcAABonuses(&aabonuses);
+	UpdateAABonuses();
 	SetAttackTimer();
 	CalcSeeInvisibleLevel();
 	CalcInvisibleLevel();
@@ -7520,6 +7518,7 @@ void EntityList::AddBot(Bot *new_bot, bool send_spawn_packet, bool dont_queue) {
 		new_bot->SetID(GetFreeID());
 		bot_list.emplace(std::pair<uint16, Bot*>(new_bot->GetID(), new_bot));
 		mob_list.emplace(std::pair<uint16, Mob*>(new_bot->GetID(), new_bot));
+		AddToCloseGrid(new_bot);
 
 		if (parse->BotHasQuestSub(EVENT_SPAWN)) {
 			parse->EventBot(EVENT_SPAWN, new_bot, nullptr, "", 0);
@@ -0,0 +1,189 @@
+#include "character_save_queue.h"
+#include "../common/event/task_scheduler.h"
+#include "../common/extprofile.h"
+#include "client.h"
+#include "zonedb.h"
+#include <algorithm>
+#include <vector>
+
+struct CharacterSaveQueue::Snapshot
+{
+	uint32                    account_id;
+	PlayerProfile_Struct      pp;
+	ExtendedProfile_Struct    epp;
+	bool                      exp_enabled;
+	std::string               mail_key;
+	bool                      illusion_block;
+	std::vector<Buffs_Struct> buffs;
+};
+
+CharacterSaveQueue::CharacterSaveQueue()
+	: m_writing(0), m_queued(0), m_coalesced(0), m_saved(0), m_failed(0), m_waits(0), m_max_pending(0)
+{
+}
+
+CharacterSaveQueue::~CharacterSaveQueue()
+{
+	Stop();
+}
+
+bool CharacterSaveQueue::Start(
+	const std::string &host,
+	const std::string &user,
+	const std::string &password,
+	const std::string &database,
+	uint32 port
+)
+{
+	if (IsRunning()) {
+		return true;
+	}
+
+	// the worker gets a connection of its own, sharing the zone's would serialize on its mutex
+	m_db = std::make_unique<ZoneDatabase>();
+	if (!m_db->Connect(host, user, password, database, port, "saves")) {
+		LogError("Character saves will be written synchronously, the save connection failed");
+		m_db.reset();
+		return false;
+	}
+
+	// a single thread, saves of one character are written in the order they were taken
+	m_worker = std::make_unique<EQ::Event::TaskScheduler>(1);
+	m_worker->Enqueue([this]() { m_worker_thread = std::this_thread::get_id(); }).wait();
+
+	return true;
+}
+
+void CharacterSaveQueue::Stop()
+{
+	if (!IsRunning()) {
+		return;
+	}
+
+	Flush();
+
+	m_worker.reset();
+	m_db.reset();
+
+	LogInfo("Character save queue stopped [{}]", GetStats());
+}
+
+void CharacterSaveQueue::Save(Client *c)
+{
+	auto s = std::make_unique<Snapshot>();
+	s->account_id     = c->AccountID();
+	s->pp             = c->GetPP();
+	s->epp            = c->GetEPP();
+	s->exp_enabled    = c->IsEXPEnabled();
+	s->mail_key       = c->GetMailKeyFull();
+	s->illusion_block = c->GetIllusionBlock();
+	s->buffs.assign(c->GetBuffs(), c->GetBuffs() + c->GetMaxBuffSlots());
+
+	const uint32 character_id = c->CharacterID();
+
+	std::unique_lock<std::mutex> lock(m_lock);
+	m_queued++;
+
+	auto iter = m_pending.find(character_id);
+	if (iter != m_pending.end()) {
+		iter->second = std::move(s);
+		m_coalesced++;
+		return;
+	}
+
+	m_pending.emplace(character_id, std::move(s));
+	m_max_pending = std::max(m_max_pending, m_pending.size());
+	m_worker->Enqueue([this, character_id]() { Write(character_id); });
+}
+
+void CharacterSaveQueue::Wait(uint32 character_id)
+{
+	// the worker itself goes through the same database calls, it never waits on its own writes
+	if (!IsRunning() || std::this_thread::get_id() == m_worker_thread) {
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_lock);
+	if (m_writing != character_id && m_pending.find(character_id) == m_pending.end()) {
+		return;
+	}
+
+	m_waits++;
+	m_written.wait(
+		lock,
+		[this, character_id]() {
+			return m_writing != character_id && m_pending.find(character_id) == m_pending.end();
+		}
+	);
+}
+
+void CharacterSaveQueue::Flush()
+{
+	if (!IsRunning()) {
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_lock);
+	m_written.wait(lock, [this]() { return m_writing == 0 && m_pending.empty(); });
+}
+
+std::string CharacterSaveQueue::GetStats()
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+	return fmt::format(
+		"queued [{}] coalesced [{}] saved [{}] failed [{}] waits [{}] pending [{}] max pending [{}]",
+		m_queued,
+		m_coalesced,
+		m_saved,
+		m_failed,
+		m_waits,
+		m_pending.size(),
+		m_max_pending
+	);
+}
+
+void CharacterSaveQueue::Write(uint32 character_id)
+{
+	std::unique_ptr<Snapshot> s;
+	{
+		std::unique_lock<std::mutex> lock(m_lock);
+		auto                         iter = m_pending.find(character_id);
+		if (iter == m_pending.end()) {
+			return;
+		}
+
+		s = std::move(iter->second);
+		m_pending.erase(iter);
+		m_writing = character_id;
+	}
+
+	bool saved = m_db->SaveCharacterCurrency(character_id, &s->pp);
+	m_db->SaveCharacterBinds(character_id, &s->pp);
+	m_db->SaveBuffs(character_id, s->buffs.data(), static_cast<int>(s->buffs.size()));
+	saved = m_db->SaveCharacterData(
+		character_id,
+		s->account_id,
+		&s->pp,
+		&s->epp,
+		s->exp_enabled,
+		s->mail_key,
+		s->illusion_block
+	) && saved;
+
+	if (!saved) {
+		LogError("Write-behind save failed for [{}] ID [{}]", s->pp.name, character_id);
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(m_lock);
+		m_writing = 0;
+		if (saved) {
+			m_saved++;
+		}
+		else {
+			m_failed++;
+		}
+	}
+
+	m_written.notify_all();
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include "../common/types.h"
+
+class Client;
+class ZoneDatabase;
+
+namespace EQ
+{
+	namespace Event
+	{
+		class TaskScheduler;
+	}
+}
+
+/*
+	Write-behind for the character tables Client::Save rewrites every time: character_data,
+	character_currency, character_bind and character_buffs.
+
+	Save takes a snapshot of the client on the zone thread and hands it to a single worker with
+	its own database connection, so the zone keeps running while the rows are written. A save of
+	a character that is still queued replaces the queued snapshot instead of adding a second one.
+
+	Durability:
+	- Save(2), used when a client leaves the zone, waits until that character is written, the
+	  next zone reads these rows as soon as the client arrives.
+	- Anything on the zone thread that writes one of these tables directly for a character first
+	  waits for that character's queued save, so an older snapshot never lands on top of it.
+	- Stop flushes every queued save before the worker goes away, it runs on a normal shutdown.
+	- If the zone crashes, snapshots still queued are lost. The queue is normally empty within a
+	  few milliseconds of an autosave, so that is at most the last save of each character.
+*/
+class CharacterSaveQueue {
+public:
+	static CharacterSaveQueue &Get()
+	{
+		static CharacterSaveQueue inst;
+		return inst;
+	}
+
+	~CharacterSaveQueue();
+
+	bool Start(
+		const std::string &host,
+		const std::string &user,
+		const std::string &password,
+		const std::string &database,
+		uint32 port
+	);
+	void Stop();
+	bool IsRunning() const { return m_worker != nullptr; }
+
+	void Save(Client *c);
+	void Wait(uint32 character_id);
+	void Flush();
+
+	std::string GetStats();
+
+private:
+	struct Snapshot;
+
+	CharacterSaveQueue();
+	CharacterSaveQueue(const CharacterSaveQueue &) = delete;
+	CharacterSaveQueue &operator=(const CharacterSaveQueue &) = delete;
+
+	void Write(uint32 character_id);
+
+	std::unique_ptr<ZoneDatabase>                          m_db;
+	std::unique_ptr<EQ::Event::TaskScheduler>              m_worker;
+	std::thread::id                                        m_worker_thread;
+	std::mutex                                             m_lock;
+	std::condition_variable                                m_written;
+	std::unordered_map<uint32, std::unique_ptr<Snapshot>>  m_pending;
+	uint32                                                 m_writing;
+
+	uint64 m_queued;
+	uint64 m_coalesced;
+	uint64 m_saved;
+	uint64 m_failed;
+	uint64 m_waits;
+	size_t m_max_pending;
+};
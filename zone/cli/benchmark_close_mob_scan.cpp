@@ -0,0 +1,124 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <glm/geometric.hpp>
+#include "../../common/eqemu_logsys.h"
+#include "../../common/strings.h"
+#include "../../common/timer.h"
+#include "../spatial_grid.h"
+
+// stand-in for Mob, carries only what ScanCloseMobs touches
+struct CloseScanBenchEntity {
+	uint16                                            id;
+	glm::vec3                                         position;
+	float                                             aggro_range;
+	std::unordered_map<uint16, CloseScanBenchEntity *> close;
+};
+
+void RunCloseMobScanBenchmark(size_t entity_count, float scan_range, float zone_extent)
+{
+	std::mt19937                          rng(static_cast<uint32>(entity_count));
+	std::uniform_real_distribution<float> coord(-zone_extent, zone_extent);
+	std::uniform_real_distribution<float> step(-10.0f, 10.0f);
+	std::uniform_int_distribution<int>    wide_aggro(0, 99);
+
+	std::vector<CloseScanBenchEntity>                    entities(entity_count);
+	std::unordered_map<uint16, CloseScanBenchEntity *> list;
+	SpatialGrid<CloseScanBenchEntity>                    grid(scan_range / 2.0f);
+
+	for (size_t i = 0; i < entity_count; ++i) {
+		auto &e = entities[i];
+		e.id          = static_cast<uint16>(i + 1);
+		e.position    = glm::vec3(coord(rng), coord(rng), 0.0f);
+		e.aggro_range = wide_aggro(rng) == 0 ? scan_range : 70.0f; // ~1% of spawns with zone wide aggro
+		list.emplace(e.id, &e);
+		grid.Update(&e, e.position, e.aggro_range >= scan_range);
+	}
+
+	auto scan = [&](CloseScanBenchEntity *s, CloseScanBenchEntity *e) {
+		float distance = glm::distance(s->position, e->position);
+		if (distance <= scan_range || e->aggro_range >= scan_range) {
+			if (e->close.find(s->id) == e->close.end()) {
+				e->close[s->id] = s;
+			}
+			s->close[e->id] = e;
+		}
+	};
+
+	// linear mob_list walk, the pre-grid ScanCloseMobs
+	BenchTimer timer;
+	size_t     linear_found = 0;
+	for (auto &s: entities) {
+		s.close.clear();
+		for (auto &e: list) {
+			scan(&s, e.second);
+		}
+		linear_found += s.close.size();
+	}
+	double linear_us = static_cast<double>(timer.elapsedMicroseconds()) / entity_count;
+
+	for (auto &e: entities) {
+		e.close.clear();
+	}
+
+	// grid scan, including moving every entity a step so cell changes are paid for
+	timer.reset();
+	size_t grid_found = 0;
+	for (auto &s: entities) {
+		s.position.x += step(rng);
+		s.position.y += step(rng);
+		grid.Move(&s, s.position, s.aggro_range >= scan_range);
+
+		s.close.clear();
+		grid.ForEachInRange(s.position, scan_range, [&](CloseScanBenchEntity *e) { scan(&s, e); });
+		grid_found += s.close.size();
+	}
+	double grid_us = static_cast<double>(timer.elapsedMicroseconds()) / entity_count;
+
+	std::cout << fmt::format(
+		"| {:>6} mobs | linear {:>9.2f} us/scan | grid {:>9.2f} us/scan | {:>6.1f}x | avg close linear [{}] grid [{}] cells [{}]\n",
+		Strings::Commify(entity_count),
+		linear_us,
+		grid_us,
+		grid_us > 0 ? linear_us / grid_us : 0.0,
+		linear_found / entity_count,
+		grid_found / entity_count,
+		grid.CellCount()
+	);
+}
+
+void ZoneCLI::BenchmarkCloseMobScan(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark ScanCloseMobs style close list scans, linear mob_list walk versus the close grid.";
+
+	std::vector<std::string> options = {
+		"--range=<distance> (default 600, Range:MobCloseScanDistance)",
+		"--extent=<units> (default 3000, mobs are spread over -extent..extent on x and y)",
+	};
+
+	if (cmd[{"-h", "--help"}]) {
+		std::cout << "Usage: benchmark:close-mob-scan [options]\n";
+		for (auto &o: options) {
+			std::cout << "  " << o << "\n";
+		}
+		return;
+	}
+
+	float scan_range  = 600.0f;
+	float zone_extent = 3000.0f;
+	if (!cmd("--range").str().empty()) {
+		scan_range = Strings::ToFloat(cmd("--range").str());
+	}
+	if (!cmd("--extent").str().empty()) {
+		zone_extent = Strings::ToFloat(cmd("--extent").str());
+	}
+
+	std::cout << Strings::Repeat("-", 70) << "\n";
+	std::cout << fmt::format("Close mob scan benchmark range [{}] extent [{}]\n", scan_range, zone_extent);
+	std::cout << Strings::Repeat("-", 70) << "\n";
+
+	for (auto count: {500, 2000, 5000}) {
+		RunCloseMobScanBenchmark(count, scan_range, zone_extent);
+	}
+}
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include "../../common/data_bucket.h"
+#include "../../common/data_bucket_index.h"
+#include "../../common/strings.h"
+#include "../../common/timer.h"
+
+void ZoneCLI::BenchmarkDatabucketCache(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark data bucket cache lookups, the scope index against a linear scan (no database needed).";
+
+	std::vector<std::string> options = {
+		"--buckets=<count> (default 50000, cached rows spread over characters, accounts and zones)",
+		"--lookups=<count> (default 100000, half of them hit a cached row, half a remembered miss)",
+	};
+
+	if (cmd[{"-h", "--help"}]) {
+		std::cout << "Usage: benchmark:databucket-cache [options]\n";
+		for (auto &o: options) {
+			std::cout << "  " << o << "\n";
+		}
+		return;
+	}
+
+	uint32 bucket_count = 50000;
+	uint32 lookup_count = 100000;
+	if (!cmd("--buckets").str().empty()) {
+		bucket_count = std::max(1u, Strings::ToUnsignedInt(cmd("--buckets").str()));
+	}
+	if (!cmd("--lookups").str().empty()) {
+		lookup_count = std::max(1u, Strings::ToUnsignedInt(cmd("--lookups").str()));
+	}
+
+	const uint32 now = 1000000;
+
+	std::mt19937                          rng(bucket_count);
+	std::uniform_int_distribution<uint32> scope_type(0, 2);
+	std::uniform_int_distribution<uint32> owner(1, std::max(1u, bucket_count / 20));
+	std::uniform_int_distribution<uint32> expiry(0, 3);
+
+	// what the cache looks like in a busy zone, a few dozen keys per character plus account and zone keys
+	std::vector<DataBucketsRepository::DataBuckets> rows;
+	std::vector<DataBucketKey>                      keys;
+	for (uint32 i = 0; i < bucket_count; ++i) {
+		auto b = DataBucketsRepository::NewEntity();
+		b.key_    = fmt::format("bench_key_{}", i % 40);
+		b.value   = std::to_string(i);
+		b.expires = expiry(rng) == 0 ? now + (i % 3600) : 0;
+
+		switch (scope_type(rng)) {
+			case 0: b.character_id = owner(rng) * 40 + i % 40; break;
+			case 1: b.account_id = owner(rng) * 40 + i % 40; break;
+			default: b.zone_id = 1 + i % 400; b.instance_id = i / 400; break;
+		}
+
+		// every other row is a remembered miss, which is what repeated reads of unset keys leave behind
+		b.id = i % 2 == 0 ? i + 1 : 0;
+
+		rows.emplace_back(b);
+		keys.emplace_back(
+			DataBucketKey{
+				.key = b.key_,
+				.account_id = b.account_id,
+				.character_id = b.character_id,
+				.npc_id = b.npc_id,
+				.bot_id = b.bot_id,
+				.zone_id = b.zone_id,
+				.instance_id = b.instance_id,
+			}
+		);
+	}
+
+	DataBucketIndex index;
+	for (auto &b: rows) {
+		index.Put(b);
+	}
+
+	// duplicate scopes collapse in the index, scan only what the index kept so both answer the same
+	std::vector<DataBucketsRepository::DataBuckets> scan;
+	index.AnyOf(
+		[&](const DataBucketsRepository::DataBuckets &e) {
+			scan.emplace_back(e);
+			return false;
+		}
+	);
+
+	std::uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+	std::vector<size_t>                   order(lookup_count);
+	for (auto &o: order) {
+		o = pick(rng);
+	}
+
+	std::cout << Strings::Repeat("-", 70) << "\n";
+	std::cout << fmt::format(
+		"Data bucket cache benchmark buckets [{}] cached [{}] lookups [{}]\n",
+		Strings::Commify(bucket_count),
+		Strings::Commify(index.Size()),
+		Strings::Commify(lookup_count)
+	);
+	std::cout << Strings::Repeat("-", 70) << "\n";
+
+	BenchTimer timer;
+	uint64     found = 0;
+	for (auto o: order) {
+		auto &k = keys[o];
+		auto e  = index.Find(
+			DataBucketIndex::ScopeRef{
+				k.key,
+				k.account_id,
+				k.character_id,
+				k.npc_id,
+				k.bot_id,
+				k.zone_id,
+				k.instance_id
+			}
+		);
+		found += e ? 1 : 0;
+	}
+	double index_us = timer.elapsedMicroseconds();
+
+	// the scan is slow enough that a slice of the lookups is plenty to measure it
+	uint32 scan_count = std::min<uint32>(lookup_count, 2000);
+	uint64 scanned    = 0;
+	timer.reset();
+	for (uint32 i = 0; i < scan_count; ++i) {
+		auto &k = keys[order[i]];
+		for (auto &e: scan) {
+			if (DataBucket::CheckBucketMatch(e, k)) {
+				scanned++;
+				break;
+			}
+		}
+	}
+	double scan_us = timer.elapsedMicroseconds();
+
+	double index_per = index_us / lookup_count;
+	double scan_per  = scan_us / scan_count;
+	std::cout << fmt::format("| index  {:>10.3f} us/lookup | found [{}/{}]\n", index_per, found, lookup_count);
+	std::cout << fmt::format("| scan   {:>10.3f} us/lookup | found [{}/{}]\n", scan_per, scanned, scan_count);
+	std::cout << fmt::format("| speedup {:>9.1f}x\n", index_per > 0 ? scan_per / index_per : 0.0);
+
+	// an hour of expiries in one sweep, the worst single call GetData can make
+	timer.reset();
+	size_t expired = index.EraseExpired(now + 3600);
+	std::cout << fmt::format(
+		"| expire {:>10.1f} us | removed [{}] left [{}]\n",
+		timer.elapsedMicroseconds(),
+		Strings::Commify(expired),
+		Strings::Commify(index.Size())
+	);
+}
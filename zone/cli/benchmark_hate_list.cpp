@@ -0,0 +1,108 @@
+#include <iostream>
+#include <list>
+#include <random>
+#include <vector>
+#include "../../common/strings.h"
+#include "../../common/timer.h"
+#include "../hate_list.h"
+#include "../hate_list_index_reference.h"
+
+/*
+	A hate list taking damage from random attackers, with attackers dropping off and joining
+	along the way, doing a top hate lookup every tick. Returns the seconds spent and the sum of
+	the top entries' sequence numbers so both runs can be checked against each other.
+*/
+static double RunHateListChurn(bool indexed, int entries, int ticks, uint64 &checksum)
+{
+	// the index never dereferences its mobs, any distinct address will do
+	std::vector<char> mobs(entries);
+	auto              mob_at = [&](int i) { return reinterpret_cast<Mob *>(&mobs[i]); };
+
+	HateListIndex<struct_HateList> index;
+	std::list<struct_HateList *>   l;
+	std::mt19937                   rng(42);
+
+	auto add = [&](int mob, int64 hate) {
+		auto e = new struct_HateList{};
+		e->entity_on_hatelist = mob_at(mob);
+		e->stored_hate_amount = hate;
+		l.push_back(e);
+		index.Insert(e);
+		return e;
+	};
+
+	for (int i = 0; i < entries; ++i) {
+		add(i, rng() % 1000);
+	}
+
+	checksum = 0;
+
+	BenchTimer timer;
+	for (int t = 0; t < ticks; ++t) {
+		int  mob = static_cast<int>(rng() % entries);
+		auto e   = index.Find(mob_at(mob));
+		if (rng() % 50 == 0) {
+			index.Remove(e);
+			l.remove(e);
+			delete e;
+
+			e = add(mob, 0);
+		}
+
+		e->stored_hate_amount += rng() % 500;
+		index.Update(e);
+
+		auto top = indexed ? HateListIndexTop(index) : HateListScanTop(l);
+		checksum += top ? top->sequence : 0;
+	}
+
+	double seconds = timer.elapsed();
+	for (auto e: l) {
+		delete e;
+	}
+
+	return seconds;
+}
+
+void ZoneCLI::BenchmarkHateList(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark top hate lookups under damage churn, list scan versus the hate list index.";
+
+	std::vector<std::string> options = {
+		"--ticks=<count> (default 200000, damage and top hate lookups per list size)",
+	};
+
+	if (cmd[{"-h", "--help"}]) {
+		std::cout << "Usage: benchmark:hate-list [options]\n";
+		for (auto &o: options) {
+			std::cout << "  " << o << "\n";
+		}
+		return;
+	}
+
+	int ticks = 200000;
+	if (!cmd("--ticks").str().empty()) {
+		ticks = std::max(1, Strings::ToInt(cmd("--ticks").str()));
+	}
+
+	std::cout << Strings::Repeat("-", 70) << "\n";
+	std::cout << fmt::format("Hate list benchmark ticks [{}]\n", Strings::Commify(ticks));
+	std::cout << Strings::Repeat("-", 70) << "\n";
+
+	for (auto entries: {10, 100, 500}) {
+		uint64 scan_checksum  = 0;
+		uint64 index_checksum = 0;
+
+		double scan_seconds  = RunHateListChurn(false, entries, ticks, scan_checksum);
+		double index_seconds = RunHateListChurn(true, entries, ticks, index_checksum);
+
+		std::cout << fmt::format(
+			"| {:>4} entries | scan {:>8.2f} ns/tick | indexed {:>8.2f} ns/tick | {:>6.1f}x | tops {}\n",
+			entries,
+			scan_seconds * 1e9 / ticks,
+			index_seconds * 1e9 / ticks,
+			index_seconds > 0 ? scan_seconds / index_seconds : 0.0,
+			scan_checksum == index_checksum ? "match" : "DIFFER"
+		);
+	}
+}
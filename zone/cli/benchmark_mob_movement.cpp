@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include "../../common/eqemu_logsys.h"
+#include "../../common/strings.h"
+#include "../../common/timer.h"
+#include "../mob_movement_manager.h"
+#include "../npc.h"
+#include "../zone.h"
+
+extern Zone   *zone;
+extern double frame_time;
+
+void ZoneCLI::BenchmarkMobMovement(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark MobMovementManager::Process with a zone full of pathing NPCs.";
+
+	std::vector<std::string> options = {
+		"--zone=<short name> (required, the zone is booted with its map, water map and navmesh)",
+		"--npcs=<count> (default 3000)",
+		"--ticks=<count> (default 300)",
+		"--frame=<ms> (default 30, frame time handed to the movement step)",
+		"--extent=<units> (default 500, NPCs and their destinations are spread this far around the safe point)",
+	};
+
+	if (cmd[{"-h", "--help"}] || cmd("--zone").str().empty()) {
+		std::cout << "Usage: benchmark:mob-movement [options]\n";
+		for (auto &o: options) {
+			std::cout << "  " << o << "\n";
+		}
+		return;
+	}
+
+	uint32 npc_count  = 3000;
+	uint32 tick_count = 300;
+	double frame_ms   = 30.0;
+	float  extent     = 500.0f;
+	if (!cmd("--npcs").str().empty()) {
+		npc_count = Strings::ToUnsignedInt(cmd("--npcs").str());
+	}
+	if (!cmd("--ticks").str().empty()) {
+		tick_count = std::max(1u, Strings::ToUnsignedInt(cmd("--ticks").str()));
+	}
+	if (!cmd("--frame").str().empty()) {
+		frame_ms = Strings::ToFloat(cmd("--frame").str());
+	}
+	if (!cmd("--extent").str().empty()) {
+		extent = Strings::ToFloat(cmd("--extent").str());
+	}
+
+	LogSys.SilenceConsoleLogging();
+
+	std::string zone_name = Strings::ToLower(cmd("--zone").str());
+	Zone::Bootup(ZoneID(zone_name), 0, false);
+	if (!zone) {
+		LogSys.EnableConsoleLogging();
+		LogError("Failed to boot zone [{}]", zone_name);
+		return;
+	}
+
+	zone->StopShutdownTimer();
+	entity_list.Process();
+	entity_list.MobProcess();
+
+	// one plain runner shared by every spawned NPC
+	auto npc_type = new NPCType;
+	memset(npc_type, 0, sizeof(NPCType));
+	strn0cpy(npc_type->name, "movement_bench", sizeof(npc_type->name));
+	npc_type->current_hp = 1000;
+	npc_type->max_hp     = 1000;
+	npc_type->race       = 1;
+	npc_type->class_     = 1;
+	npc_type->level      = 10;
+	npc_type->size       = 6;
+	npc_type->runspeed   = 1.25f;
+	npc_type->bodytype   = 1;
+
+	auto                                  safe = zone->GetSafePoint();
+	std::mt19937                          rng(npc_count);
+	std::uniform_real_distribution<float> offset(-extent, extent);
+
+	std::vector<NPC *> npcs;
+	for (uint32 i = 0; i < npc_count; ++i) {
+		auto npc = new NPC(npc_type, nullptr, glm::vec4(safe.x + offset(rng), safe.y + offset(rng), safe.z, 0.0f), GravityBehavior::Ground);
+		entity_list.AddNPC(npc);
+		npc->FixZ();
+		npcs.push_back(npc);
+	}
+
+	LogSys.EnableConsoleLogging();
+
+	std::cout << Strings::Repeat("-", 70) << "\n";
+	std::cout << fmt::format(
+		"Mob movement benchmark zone [{}] npcs [{}] ticks [{}] frame [{}ms]\n",
+		zone_name,
+		Strings::Commify(npc_count),
+		tick_count,
+		frame_ms
+	);
+	std::cout << Strings::Repeat("-", 70) << "\n";
+
+	frame_time = frame_ms / 1000.0;
+
+	auto       &mgr         = MobMovementManager::Get();
+	double     process_us   = 0.0;
+	double     worst_us     = 0.0;
+	double     navigate_us  = 0.0;
+	uint64     moving_total = 0;
+	BenchTimer timer;
+	for (uint32 tick = 0; tick < tick_count; ++tick) {
+		// anything that has stopped gets a fresh destination, pathfinding is timed apart from the tick
+		timer.reset();
+		for (auto npc: npcs) {
+			if (!npc->IsMoving()) {
+				npc->RunTo(safe.x + offset(rng), safe.y + offset(rng), safe.z);
+			}
+		}
+		navigate_us += timer.elapsedMicroseconds();
+
+		for (auto npc: npcs) {
+			moving_total += npc->IsMoving() ? 1 : 0;
+		}
+
+		timer.reset();
+		mgr.Process();
+		double us = timer.elapsedMicroseconds();
+		process_us += us;
+		worst_us = std::max(worst_us, us);
+	}
+
+	double avg_moving = static_cast<double>(moving_total) / tick_count;
+	double avg_us     = process_us / tick_count;
+	std::cout << fmt::format(
+		"| process {:>9.1f} us/tick | worst {:>9.1f} us | {:>6.3f} us/moving mob | moving [{:.0f}]\n",
+		avg_us,
+		worst_us,
+		avg_moving > 0 ? avg_us / avg_moving : 0.0,
+		avg_moving
+	);
+	std::cout << fmt::format("| navigate {:>8.1f} us/tick (pathfinding for mobs that stopped)\n", navigate_us / tick_count);
+}
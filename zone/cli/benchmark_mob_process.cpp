@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include "../../common/eqemu_logsys.h"
+#include "../../common/rulesys.h"
+#include "../../common/strings.h"
+#include "../../common/timer.h"
+#include "../entity.h"
+#include "../npc.h"
+#include "../zone.h"
+
+extern Zone *zone;
+
+void ZoneCLI::BenchmarkMobProcess(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark EntityList::MobProcess with a zone full of idle NPCs, polled every tick and then sleeping.";
+
+	std::vector<std::string> options = {
+		"--zone=<short name> (required)",
+		"--npcs=<count> (default 2000)",
+		"--ticks=<count> (default 300, measured ticks per pass)",
+		"--warmup=<count> (default 200, ticks run before measuring so spawn timers settle)",
+		"--frame=<ms> (default 32, the zone main loop interval)",
+		"--extent=<units> (default 500, NPCs are spread this far around the safe point)",
+	};
+
+	if (cmd[{"-h", "--help"}] || cmd("--zone").str().empty()) {
+		std::cout << "Usage: benchmark:mob-process [options]\n";
+		for (auto &o: options) {
+			std::cout << "  " << o << "\n";
+		}
+		return;
+	}
+
+	uint32 npc_count    = 2000;
+	uint32 tick_count   = 300;
+	uint32 warmup_count = 200;
+	uint32 frame_ms     = 32;
+	float  extent       = 500.0f;
+	if (!cmd("--npcs").str().empty()) {
+		npc_count = Strings::ToUnsignedInt(cmd("--npcs").str());
+	}
+	if (!cmd("--ticks").str().empty()) {
+		tick_count = std::max(1u, Strings::ToUnsignedInt(cmd("--ticks").str()));
+	}
+	if (!cmd("--warmup").str().empty()) {
+		warmup_count = Strings::ToUnsignedInt(cmd("--warmup").str());
+	}
+	if (!cmd("--frame").str().empty()) {
+		frame_ms = std::max(1u, Strings::ToUnsignedInt(cmd("--frame").str()));
+	}
+	if (!cmd("--extent").str().empty()) {
+		extent = Strings::ToFloat(cmd("--extent").str());
+	}
+
+	LogSys.SilenceConsoleLogging();
+
+	std::string zone_name = Strings::ToLower(cmd("--zone").str());
+	Zone::Bootup(ZoneID(zone_name), 0, false);
+	if (!zone) {
+		LogSys.EnableConsoleLogging();
+		LogError("Failed to boot zone [{}]", zone_name);
+		return;
+	}
+
+	zone->StopShutdownTimer();
+
+	// one plain idle spawn shared by every NPC, no grid, no spells, no quest
+	auto npc_type = new NPCType;
+	memset(npc_type, 0, sizeof(NPCType));
+	strn0cpy(npc_type->name, "process_bench", sizeof(npc_type->name));
+	npc_type->current_hp = 1000;
+	npc_type->max_hp     = 1000;
+	npc_type->race       = 1;
+	npc_type->class_     = 1;
+	npc_type->level      = 10;
+	npc_type->size       = 6;
+	npc_type->runspeed   = 1.25f;
+	npc_type->bodytype   = 1;
+
+	auto                                  safe = zone->GetSafePoint();
+	std::mt19937                          rng(npc_count);
+	std::uniform_real_distribution<float> offset(-extent, extent);
+
+	std::vector<NPC *> npcs;
+	for (uint32 i = 0; i < npc_count; ++i) {
+		auto npc = new NPC(npc_type, nullptr, glm::vec4(safe.x + offset(rng), safe.y + offset(rng), safe.z, 0.0f), GravityBehavior::Ground);
+		entity_list.AddNPC(npc);
+		npcs.push_back(npc);
+	}
+
+	auto next_frame = std::chrono::steady_clock::now();
+	auto tick       = [&]() {
+		next_frame += std::chrono::milliseconds(frame_ms);
+		std::this_thread::sleep_until(next_frame);
+		Timer::SetCurrentTime();
+
+		BenchTimer timer;
+		entity_list.MobProcess();
+		return timer.elapsedMicroseconds();
+	};
+
+	LogSys.EnableConsoleLogging();
+
+	std::cout << Strings::Repeat("-", 70) << "\n";
+	std::cout << fmt::format(
+		"Mob process benchmark zone [{}] npcs [{}] ticks [{}] frame [{}ms]\n",
+		zone_name,
+		Strings::Commify(npc_count),
+		tick_count,
+		frame_ms
+	);
+	std::cout << Strings::Repeat("-", 70) << "\n";
+
+	for (bool sleep: {false, true}) {
+		RuleManager::Instance()->SetRule("NPC:SleepWhenIdle", sleep ? "true" : "false");
+		for (auto npc: npcs) {
+			entity_list.WakeMob(npc->GetID());
+		}
+
+		next_frame = std::chrono::steady_clock::now();
+		for (uint32 i = 0; i < warmup_count; ++i) {
+			tick();
+		}
+
+		double process_us  = 0.0;
+		double worst_us    = 0.0;
+		uint64 awake_total = 0;
+		for (uint32 i = 0; i < tick_count; ++i) {
+			awake_total += npc_count - std::min<size_t>(npc_count, entity_list.GetSleepingMobCount());
+
+			double us = tick();
+			process_us += us;
+			worst_us = std::max(worst_us, us);
+		}
+
+		std::cout << fmt::format(
+			"| {:<8} {:>9.1f} us/tick | worst {:>9.1f} us | awake [{:.0f}] of [{}]\n",
+			sleep ? "sleeping" : "polled",
+			process_us / tick_count,
+			worst_us,
+			static_cast<double>(awake_total) / tick_count,
+			npc_count
+		);
+	}
+}
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include "../../common/eqemu_logsys.h"
+#include "../../common/strings.h"
+#include "../../common/timer.h"
+#include "../client.h"
+#include "../entity.h"
+#include "../npc.h"
+#include "../quest_parser_collection.h"
+#include "../zone.h"
+#ifdef EMBPERL
+#include "../embparser.h"
+#endif
+
+extern Zone *zone;
+
+void ZoneCLI::BenchmarkPerlEvents(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark Perl quest event dispatch for an NPC script with say, timer and combat subs.";
+
+	std::vector<std::string> options = {
+		"--zone=<short name> (required)",
+		"--events=<count> (default 100000, dispatches per event type)",
+	};
+
+	if (cmd[{"-h", "--help"}] || cmd("--zone").str().empty()) {
+		std::cout << "Usage: benchmark:perl-events [options]\n";
+		for (auto &o: options) {
+			std::cout << "  " << o << "\n";
+		}
+		return;
+	}
+
+#ifndef EMBPERL
+	std::cout << "benchmark:perl-events needs a zone built with Perl support\n";
+#else
+	uint32 event_count = 100000;
+	if (!cmd("--events").str().empty()) {
+		event_count = std::max(1u, Strings::ToUnsignedInt(cmd("--events").str()));
+	}
+
+	LogSys.SilenceConsoleLogging();
+
+	std::string zone_name = Strings::ToLower(cmd("--zone").str());
+	Zone::Bootup(ZoneID(zone_name), 0, false);
+	if (!zone) {
+		LogSys.EnableConsoleLogging();
+		LogError("Failed to boot zone [{}]", zone_name);
+		return;
+	}
+
+	zone->StopShutdownTimer();
+
+	// cli commands run before the quest parsers are set up
+	auto perl_parser = new PerlembParser();
+	parse = new QuestParserCollection();
+	parse->RegisterQuestInterface(perl_parser, "pl");
+	parse->LoadPerlEventExportSettings(parse->perl_event_export_settings);
+
+	// an npc type id no content uses, so the script can't clash with a real quest
+	const uint32 npc_type_id = 4294967;
+	const auto   script      = std::filesystem::temp_directory_path() / "benchmark_perl_events.pl";
+	std::ofstream(script) << "sub EVENT_SAY { my $said = $text; }\n"
+		"sub EVENT_TIMER { my $fired = $timer; }\n"
+		"sub EVENT_COMBAT { my $engaged = $combat_state; }\n";
+
+	perl_parser->LoadNPCScript(script.string(), npc_type_id);
+	std::filesystem::remove(script);
+
+	auto npc_type = new NPCType;
+	memset(npc_type, 0, sizeof(NPCType));
+	strn0cpy(npc_type->name, "perl_bench", sizeof(npc_type->name));
+	npc_type->npc_id     = npc_type_id;
+	npc_type->current_hp = 1000;
+	npc_type->max_hp     = 1000;
+	npc_type->race       = 1;
+	npc_type->class_     = 1;
+	npc_type->level      = 10;
+	npc_type->size       = 6;
+	npc_type->bodytype   = 1;
+
+	auto npc = new NPC(npc_type, nullptr, zone->GetSafePoint(), GravityBehavior::Ground);
+	entity_list.AddNPC(npc);
+
+	Client *c = new Client();
+
+	LogSys.EnableConsoleLogging();
+
+	std::cout << Strings::Repeat("-", 70) << "\n";
+	std::cout << fmt::format(
+		"Perl event benchmark zone [{}] events [{}] per type\n",
+		zone_name,
+		Strings::Commify(event_count)
+	);
+	std::cout << Strings::Repeat("-", 70) << "\n";
+
+	struct BenchEvent {
+		const char   *name;
+		QuestEventID event_id;
+		Mob          *init;
+		std::string  data;
+	};
+
+	std::vector<BenchEvent> events = {
+		{"say", EVENT_SAY, c, "Hail"},
+		{"timer", EVENT_TIMER, nullptr, "bench_timer"},
+		{"combat", EVENT_COMBAT, c, "1"},
+	};
+
+	for (auto &e: events) {
+		BenchTimer timer;
+		for (uint32 i = 0; i < event_count; ++i) {
+			perl_parser->EventNPC(e.event_id, npc, e.init, e.data, 0, nullptr);
+		}
+
+		double seconds = timer.elapsed();
+		std::cout << fmt::format(
+			"| {:<8} {:>12.0f} events/s | {:>7.2f} us/event\n",
+			e.name,
+			event_count / seconds,
+			seconds * 1000000.0 / event_count
+		);
+	}
+#endif
+}
@@ -0,0 +1,237 @@
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include "../../common/eqemu_logsys.h"
+#include "../../common/path_manager.h"
+#include "../../common/strings.h"
+#include "../../common/timer.h"
+#include "../map.h"
+
+struct RaycastBenchQuery {
+	bool      los;
+	glm::vec3 a;
+	glm::vec3 b;
+};
+
+// reads the "los x y z x y z" / "bestz x y z" lines written by Map::RecordQueries
+std::vector<RaycastBenchQuery> LoadRaycastBenchQueries(const std::string &file)
+{
+	std::vector<RaycastBenchQuery> queries;
+	std::ifstream                  in(file);
+	std::string                    line;
+	while (std::getline(in, line)) {
+		std::istringstream s(line);
+		std::string        type;
+		RaycastBenchQuery  q{};
+		s >> type >> q.a.x >> q.a.y >> q.a.z;
+		q.los = type == "los";
+		if (q.los) {
+			s >> q.b.x >> q.b.y >> q.b.z;
+		}
+
+		if (!s.fail() && (q.los || type == "bestz")) {
+			queries.push_back(q);
+		}
+	}
+
+	return queries;
+}
+
+// half LoS checks between points up to 500 units apart, half best Z lookups
+std::vector<RaycastBenchQuery> RandomRaycastBenchQueries(size_t count, float extent)
+{
+	std::mt19937                          rng(static_cast<uint32>(count));
+	std::uniform_real_distribution<float> coord(-extent, extent);
+	std::uniform_real_distribution<float> height(-extent / 4.0f, extent / 4.0f);
+	std::uniform_real_distribution<float> offset(-500.0f, 500.0f);
+
+	std::vector<RaycastBenchQuery> queries(count);
+	for (size_t i = 0; i < count; ++i) {
+		auto &q = queries[i];
+		q.los = i % 2 == 0;
+		q.a   = glm::vec3(coord(rng), coord(rng), height(rng));
+		q.b   = q.a + glm::vec3(offset(rng), offset(rng), offset(rng) / 10.0f);
+	}
+
+	return queries;
+}
+
+double RunRaycastBenchQueries(const Map *m, const std::vector<RaycastBenchQuery> &queries, std::vector<float> &results)
+{
+	results.resize(queries.size());
+
+	BenchTimer timer;
+	for (size_t i = 0; i < queries.size(); ++i) {
+		auto &q = queries[i];
+		if (q.los) {
+			results[i] = m->CheckLoS(q.a, q.b) ? 1.0f : 0.0f;
+		}
+		else {
+			glm::vec3 start = q.a;
+			results[i] = m->FindBestZ(start, nullptr);
+		}
+	}
+
+	return static_cast<double>(timer.elapsedMicroseconds()) / std::max<size_t>(queries.size(), 1);
+}
+
+// the same queries through the batched Map calls, batch_size consecutive queries of a kind at a time
+double RunRaycastBenchBatches(const Map *m, const std::vector<RaycastBenchQuery> &queries, size_t batch_size, std::vector<float> &results)
+{
+	results.resize(queries.size());
+
+	std::vector<size_t>    los_index;
+	std::vector<glm::vec3> los_from;
+	std::vector<glm::vec3> los_to;
+	std::vector<size_t>    bestz_index;
+	std::vector<glm::vec3> bestz_start;
+	std::vector<bool>      los_results;
+	std::vector<float>     bestz_results;
+
+	auto flush_los = [&]() {
+		m->CheckLoS(los_from, los_to, los_results);
+		for (size_t i = 0; i < los_index.size(); ++i) {
+			results[los_index[i]] = los_results[i] ? 1.0f : 0.0f;
+		}
+
+		los_index.clear();
+		los_from.clear();
+		los_to.clear();
+	};
+
+	auto flush_bestz = [&]() {
+		m->FindBestZ(bestz_start, bestz_results);
+		for (size_t i = 0; i < bestz_index.size(); ++i) {
+			results[bestz_index[i]] = bestz_results[i];
+		}
+
+		bestz_index.clear();
+		bestz_start.clear();
+	};
+
+	BenchTimer timer;
+	for (size_t i = 0; i < queries.size(); ++i) {
+		auto &q = queries[i];
+		if (q.los) {
+			los_index.push_back(i);
+			los_from.push_back(q.a);
+			los_to.push_back(q.b);
+			if (los_index.size() == batch_size) {
+				flush_los();
+			}
+		}
+		else {
+			bestz_index.push_back(i);
+			bestz_start.push_back(q.a);
+			if (bestz_index.size() == batch_size) {
+				flush_bestz();
+			}
+		}
+	}
+
+	flush_los();
+	flush_bestz();
+
+	return static_cast<double>(timer.elapsedMicroseconds()) / std::max<size_t>(queries.size(), 1);
+}
+
+void ZoneCLI::BenchmarkRaycast(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark LoS and best Z raycasts against a zone map, AABB tree versus the BVH backend.";
+
+	std::vector<std::string> options = {
+		"--zone=<short name> (required, loads maps/base/<zone>.map)",
+		"--queries=<file> (replay queries recorded with Map:RecordRaycastQueries, default maps/base/<zone>.raycast)",
+		"--random=<count> (use random queries instead of a recording)",
+		"--extent=<units> (default 2000, random queries are spread over -extent..extent)",
+	};
+
+	if (cmd[{"-h", "--help"}] || cmd("--zone").str().empty()) {
+		std::cout << "Usage: benchmark:raycast [options]\n";
+		for (auto &o: options) {
+			std::cout << "  " << o << "\n";
+		}
+		return;
+	}
+
+	std::string zone_name = Strings::ToLower(cmd("--zone").str());
+	std::string map_file  = fmt::format("{}/base/{}.map", path.GetMapsPath(), zone_name);
+
+	std::vector<RaycastBenchQuery> queries;
+	if (!cmd("--random").str().empty()) {
+		float extent = 2000.0f;
+		if (!cmd("--extent").str().empty()) {
+			extent = Strings::ToFloat(cmd("--extent").str());
+		}
+
+		queries = RandomRaycastBenchQueries(Strings::ToUnsignedInt(cmd("--random").str()), extent);
+	}
+	else {
+		std::string queries_file = cmd("--queries").str();
+		if (queries_file.empty()) {
+			queries_file = fmt::format("{}/base/{}.raycast", path.GetMapsPath(), zone_name);
+		}
+
+		queries = LoadRaycastBenchQueries(queries_file);
+		if (queries.empty()) {
+			LogError("No queries found in [{}], record some with Map:RecordRaycastQueries or pass --random", queries_file);
+			return;
+		}
+	}
+
+	std::cout << Strings::Repeat("-", 70) << "\n";
+	std::cout << fmt::format("Raycast benchmark [{}] queries [{}]\n", map_file, Strings::Commify(queries.size()));
+	std::cout << Strings::Repeat("-", 70) << "\n";
+
+	Map        aabb(false);
+	Map        bvh(true);
+	BenchTimer timer;
+	if (!aabb.Load(map_file)) {
+		LogError("Failed to load [{}]", map_file);
+		return;
+	}
+	double aabb_load = timer.elapsed();
+
+	timer.reset();
+	if (!bvh.Load(map_file)) {
+		LogError("Failed to load [{}]", map_file);
+		return;
+	}
+	double bvh_load = timer.elapsed();
+
+	std::vector<float> aabb_results;
+	std::vector<float> bvh_results;
+	double             aabb_us = RunRaycastBenchQueries(&aabb, queries, aabb_results);
+	double             bvh_us  = RunRaycastBenchQueries(&bvh, queries, bvh_results);
+
+	std::vector<float> batch_results;
+	double             batch_us = RunRaycastBenchBatches(&bvh, queries, 32, batch_results);
+
+	size_t mismatches       = 0;
+	size_t batch_mismatches = 0;
+	for (size_t i = 0; i < queries.size(); ++i) {
+		if (aabb_results[i] != bvh_results[i]) {
+			mismatches++;
+		}
+
+		if (aabb_results[i] != batch_results[i]) {
+			batch_mismatches++;
+		}
+	}
+
+	std::cout << fmt::format("| aabb tree | load {:>7.3f}s | {:>8.3f} us/query |\n", aabb_load, aabb_us);
+	std::cout << fmt::format(
+		"| bvh       | load {:>7.3f}s | {:>8.3f} us/query | {:>5.1f}x | mismatches [{}]\n",
+		bvh_load,
+		bvh_us,
+		bvh_us > 0 ? aabb_us / bvh_us : 0.0,
+		mismatches
+	);
+	std::cout << fmt::format(
+		"| bvh x32   |               | {:>8.3f} us/query | {:>5.1f}x | mismatches [{}]\n",
+		batch_us,
+		batch_us > 0 ? aabb_us / batch_us : 0.0,
+		batch_mismatches
+	);
+}
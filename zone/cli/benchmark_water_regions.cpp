@@ -0,0 +1,217 @@
+#include <cfloat>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include "../../common/path_manager.h"
+#include "../../common/strings.h"
+#include "../../common/timer.h"
+#include "../oriented_bounding_box.h"
+#include "../water_region_grid.h"
+
+// a V2 water map's regions, read the same way WaterMapV2::Load does
+static bool ReadWaterRegionBenchMap(const std::string &file, std::vector<OrientedBoundingBox> &boxes, std::vector<glm::vec3> &centers)
+{
+	FILE *f = fopen(file.c_str(), "rb");
+	if (!f) {
+		return false;
+	}
+
+	char   magic[10];
+	uint32 version = 0;
+	uint32 count   = 0;
+	bool   ok      = fread(magic, 10, 1, f) == 1 && strncmp(magic, "EQEMUWATER", 10) == 0 &&
+		fread(&version, sizeof(version), 1, f) == 1 && version == 2 &&
+		fread(&count, sizeof(count), 1, f) == 1;
+
+	for (uint32 i = 0; ok && i < count; ++i) {
+		uint32 type;
+		float  v[12];
+		ok = fread(&type, sizeof(type), 1, f) == 1 && fread(v, sizeof(float), 12, f) == 12;
+		if (ok) {
+			boxes.emplace_back(glm::vec3(v[0], v[1], v[2]), glm::vec3(v[3], v[4], v[5]), glm::vec3(v[6], v[7], v[8]), glm::vec3(v[9], v[10], v[11]));
+			centers.emplace_back(v[0], v[1], v[2]);
+		}
+	}
+
+	fclose(f);
+	return ok;
+}
+
+// 400 scattered regions with a few zone sized oceans, for trees without water maps
+static void RandomWaterRegionBenchMap(std::vector<OrientedBoundingBox> &boxes, std::vector<glm::vec3> &centers)
+{
+	std::mt19937                          rng(99);
+	std::uniform_real_distribution<float> position(-2000.0f, 2000.0f);
+	std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+	std::uniform_real_distribution<float> scale(0.5f, 3.0f);
+	std::uniform_real_distribution<float> extent(5.0f, 200.0f);
+
+	for (int i = 0; i < 400; ++i) {
+		glm::vec3 center(position(rng), position(rng), position(rng) / 10.0f);
+		glm::vec3 extents(extent(rng), extent(rng), extent(rng));
+		if (i % 50 == 0) {
+			extents *= 20.0f;
+		}
+
+		boxes.emplace_back(center, glm::vec3(angle(rng), angle(rng), angle(rng)), glm::vec3(scale(rng), scale(rng), scale(rng)), extents);
+		centers.push_back(center);
+	}
+}
+
+// points spread over the regions, plus points on and just around each region center
+static std::vector<glm::vec3> WaterRegionBenchPoints(const std::vector<OrientedBoundingBox> &boxes, const std::vector<glm::vec3> &centers, size_t count)
+{
+	glm::vec3 min(FLT_MAX);
+	glm::vec3 max(-FLT_MAX);
+	for (auto &b: boxes) {
+		glm::vec3 bmin, bmax;
+		b.GetAxisAlignedBounds(bmin, bmax);
+		min = glm::min(min, bmin);
+		max = glm::max(max, bmax);
+	}
+
+	std::vector<glm::vec3>                points;
+	std::mt19937                          rng(1234);
+	std::uniform_real_distribution<float> unit(-0.1f, 1.1f);
+	std::uniform_real_distribution<float> jitter(-25.0f, 25.0f);
+	for (size_t i = 0; i < count; ++i) {
+		points.emplace_back(
+			min.x + (max.x - min.x) * unit(rng),
+			min.y + (max.y - min.y) * unit(rng),
+			min.z + (max.z - min.z) * unit(rng)
+		);
+	}
+
+	for (auto &c: centers) {
+		points.push_back(c);
+		for (int i = 0; i < 8; ++i) {
+			points.push_back(c + glm::vec3(jitter(rng), jitter(rng), jitter(rng)));
+		}
+	}
+
+	return points;
+}
+
+static void RunWaterRegionBenchmark(const std::string &name, const std::vector<OrientedBoundingBox> &boxes, const std::vector<glm::vec3> &centers, size_t lookups)
+{
+	if (boxes.empty()) {
+		return;
+	}
+
+	std::vector<glm::vec3> mins(boxes.size());
+	std::vector<glm::vec3> maxs(boxes.size());
+	for (size_t i = 0; i < boxes.size(); ++i) {
+		boxes[i].GetAxisAlignedBounds(mins[i], maxs[i]);
+	}
+
+	WaterRegionGrid grid;
+	grid.Build(mins, maxs);
+
+	auto points = WaterRegionBenchPoints(boxes, centers, lookups);
+
+	// the scan WaterMapV2::ReturnRegionType did before the grid
+	std::vector<int> linear(points.size(), -1);
+	BenchTimer       timer;
+	for (size_t p = 0; p < points.size(); ++p) {
+		for (size_t i = 0; i < boxes.size(); ++i) {
+			if (boxes[i].ContainsPoint(points[p])) {
+				linear[p] = static_cast<int>(i);
+				break;
+			}
+		}
+	}
+	double linear_ns = static_cast<double>(timer.elapsedNanoseconds()) / points.size();
+
+	std::vector<int> indexed(points.size(), -1);
+	timer.reset();
+	for (size_t p = 0; p < points.size(); ++p) {
+		auto &point = points[p];
+		indexed[p] = grid.FindFirst(point, [&](uint32 i) { return boxes[i].ContainsPoint(point); });
+	}
+	double grid_ns = static_cast<double>(timer.elapsedNanoseconds()) / points.size();
+
+	size_t mismatches = 0;
+	for (size_t p = 0; p < points.size(); ++p) {
+		mismatches += linear[p] != indexed[p] ? 1 : 0;
+	}
+
+	std::cout << fmt::format(
+		"| {:<16} {:>5} regions | linear {:>9.1f} ns/lookup | grid {:>7.1f} ns/lookup | {:>6.1f}x | cells [{}] mismatches [{}]\n",
+		name,
+		boxes.size(),
+		linear_ns,
+		grid_ns,
+		grid_ns > 0 ? linear_ns / grid_ns : 0.0,
+		grid.CellCount(),
+		mismatches
+	);
+}
+
+void ZoneCLI::BenchmarkWaterRegions(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark water region lookups, linear region scan versus the region grid, on installed water maps.";
+
+	std::vector<std::string> options = {
+		"--zone=<short name> (default every V2 water map under maps/water)",
+		"--lookups=<count> (default 100000, random points per map on top of the points around each region)",
+	};
+
+	if (cmd[{"-h", "--help"}]) {
+		std::cout << "Usage: benchmark:water-regions [options]\n";
+		for (auto &o: options) {
+			std::cout << "  " << o << "\n";
+		}
+		return;
+	}
+
+	size_t lookups = 100000;
+	if (!cmd("--lookups").str().empty()) {
+		lookups = std::max(1u, Strings::ToUnsignedInt(cmd("--lookups").str()));
+	}
+
+	std::cout << Strings::Repeat("-", 70) << "\n";
+	std::cout << fmt::format("Water region benchmark lookups [{}]\n", Strings::Commify(lookups));
+	std::cout << Strings::Repeat("-", 70) << "\n";
+
+	{
+		std::vector<OrientedBoundingBox> boxes;
+		std::vector<glm::vec3>           centers;
+		RandomWaterRegionBenchMap(boxes, centers);
+		RunWaterRegionBenchmark("random", boxes, centers, lookups);
+	}
+
+	std::error_code ec;
+	std::string     dir = path.GetMapsPath() + "/water";
+
+	std::vector<std::filesystem::path> files;
+	if (!cmd("--zone").str().empty()) {
+		files.emplace_back(fmt::format("{}/{}.wtr", dir, Strings::ToLower(cmd("--zone").str())));
+	}
+	else if (std::filesystem::is_directory(dir, ec)) {
+		for (auto &entry: std::filesystem::directory_iterator(dir, ec)) {
+			if (entry.path().extension() == ".wtr") {
+				files.push_back(entry.path());
+			}
+		}
+
+		std::sort(files.begin(), files.end());
+	}
+
+	if (files.empty()) {
+		std::cout << fmt::format("No water maps found under [{}]\n", dir);
+		return;
+	}
+
+	for (auto &file: files) {
+		std::vector<OrientedBoundingBox> boxes;
+		std::vector<glm::vec3>           centers;
+		if (!ReadWaterRegionBenchMap(file.string(), boxes, centers)) {
+			std::cout << fmt::format("| {:<16} not a V2 water map\n", file.stem().string());
+			continue;
+		}
+
+		RunWaterRegionBenchmark(file.stem().string(), boxes, centers, lookups);
+	}
+}
@@ -56,6 +56,7 @@ extern volatile bool RunLoops;
 #include "quest_parser_collection.h"
 #include "queryserv.h"
 #include "mob_movement_manager.h"
+#include "character_save_queue.h"
 #include "cheat_manager.h"
 #include "lua_parser.h"
 
@@ -785,9 +786,7 @@ Client::~Client() {
 	{
 		m_pp.zone_id = m_pp.binds[0].zone_id;
 		m_pp.zoneInstance = m_pp.binds[0].instance_id;
-		m_Position.x = m_pp.binds[0].x;
-		m_Position.y = m_pp.binds[0].y;
-		m_Position.z = m_pp.binds[0].z;
+		SetPosition(m_pp.binds[0].x, m_pp.binds[0].y, m_pp.binds[0].z);
 	}
 
 	// we save right now, because the client might be zoning and the world
@@ -1024,16 +1023,8 @@ bool Client::Save(uint8 iCommitNow) {
 		m_pp.endurance = current_endurance;
 	}
 
-	/* Save Character Currency */
-	database.SaveCharacterCurrency(CharacterID(), &m_pp);
-
-	// save character binds
-	// this may not need to be called in Save() but it's here for now
-	// to maintain the current behavior
-	database.SaveCharacterBinds(this);
-
-	/* Save Character Buffs */
-	database.SaveBuffs(this);
+	/* Negative coin is saved as zero, keep the profile in line with what gets written */
+	database.ZeroPlayerProfileCurrency(&m_pp);
 
 	/* Total Time Played */
 	TotalSecondsPlayed += (time(nullptr) - m_pp.lastlogin);
@@ -1099,7 +1090,26 @@ bool Client::Save(uint8 iCommitNow) {
 		}
 	}
 
-	database.SaveCharacterData(this, &m_pp, &m_epp); /* Save Character Data */
+	// character data, currency, binds and buffs are written behind the zone thread when the save queue runs
+	auto &saves = CharacterSaveQueue::Get();
+	if (saves.IsRunning()) {
+		saves.Save(this);
+		if (iCommitNow == 2) {
+			saves.Wait(CharacterID());
+		}
+	}
+	else {
+		database.SaveCharacterCurrency(CharacterID(), &m_pp);
+
+		// save character binds
+		// this may not need to be called in Save() but it's here for now
+		// to maintain the current behavior
+		database.SaveCharacterBinds(this);
+
+		database.SaveBuffs(this);
+
+		database.SaveCharacterData(this, &m_pp, &m_epp); /* Save Character Data */
+	}
 
 	database.SaveCharacterEXPModifier(this);
 
@@ -1171,27 +1181,48 @@ bool Client::SendAllPackets() {
 }
 
 void Client::QueuePacket(const EQApplicationPacket* app, bool ack_req, CLIENT_CONN_STATUS required_state, eqFilterType filter) {
-	if (filter != FilterNone && GetFilter(filter) == FilterHide) {
+	if (!ReadyForPacket(app, ack_req, required_state, filter)) {
 		return;
 	}
 
-	if (RuleB(Character, AutoIdleFilterPackets) && m_is_idle && IsFilteredAFKPacket(app)) {
+	if (eqs) {
+		eqs->QueuePacket(app, ack_req);
+	}
+}
+
+void Client::QueuePacket(MulticastPacket &packet, CLIENT_CONN_STATUS required_state, eqFilterType filter) {
+	if (!ReadyForPacket(packet.GetPacket(), packet.IsAckRequired(), required_state, filter)) {
 		return;
 	}
 
+	if (eqs) {
+		packet.QueueTo(eqs);
+	}
+}
+
+// false when the packet is filtered or held back until the client reaches required_state
+bool Client::ReadyForPacket(const EQApplicationPacket* app, bool ack_req, CLIENT_CONN_STATUS required_state, eqFilterType filter) {
+	if (filter != FilterNone && GetFilter(filter) == FilterHide) {
+		return false;
+	}
+
+	if (RuleB(Character, AutoIdleFilterPackets) && m_is_idle && IsFilteredAFKPacket(app)) {
+		return false;
+	}
+
 	if (client_state != CLIENT_CONNECTED && required_state == CLIENT_CONNECTED) {
 		AddPacket(app, ack_req);
-		return;
+		return false;
 	}
 
 	// if the program doesnt care about the status or if the status isnt what we requested
 	if (required_state != CLIENT_CONNECTINGALL && client_state != required_state) {
 		// todo: save packets for later use
 		AddPacket(app, ack_req);
+		return false;
 	}
-	else if (eqs) {
-		eqs->QueuePacket(app, ack_req);
-	}
+
+	return true;
 }
 
 void Client::FastQueuePacket(EQApplicationPacket** app, bool ack_req, CLIENT_CONN_STATUS required_state) {
@@ -9670,6 +9701,8 @@ bool Client::IsEXPEnabled() const {
 
 void Client::SetEXPEnabled(bool is_exp_enabled)
 {
+	CharacterSaveQueue::Get().Wait(CharacterID());
+
 	auto c = CharacterDataRepository::FindOne(database, CharacterID());
 
 	c.exp_enabled = is_exp_enabled;
@@ -12851,6 +12884,9 @@ void Client::ClientToNpcAggroProcess()
 {
 	if (zone->CanDoCombat() && !GetFeigned() && m_client_npc_aggro_scan_timer.Check()) {
 		int npc_scan_count = 0;
+
+		// line of sight goes last in CheckWillAggro, gather everything that passes the rest and check them in one batch
+		std::vector<Mob *> will_aggro;
 		for (auto& close_mob : GetCloseMobList()) {
 			Mob* mob = close_mob.second;
 			if (!mob) {
@@ -12861,12 +12897,20 @@ void Client::ClientToNpcAggroProcess()
 				continue;
 			}
 
-			if (mob->CheckWillAggro(this) && !mob->CheckAggro(this)) {
-				mob->AddToHateList(this, 25);
+			if (mob->CheckWillAggroExceptLoS(this)) {
+				will_aggro.push_back(mob);
 			}
 
 			npc_scan_count++;
 		}
+
+		std::vector<bool> can_see;
+		Mob::CheckLosFN(will_aggro, this, can_see);
+		for (size_t i = 0; i < will_aggro.size(); ++i) {
+			if (can_see[i] && !will_aggro[i]->CheckAggro(this)) {
+				will_aggro[i]->AddToHateList(this, 25);
+			}
+		}
 		LogAggro("Checking Reverse Aggro (client->npc) scanned_npcs ([{}])", npc_scan_count);
 	}
 }
@@ -45,6 +45,7 @@ namespace EQ
 #include "../common/emu_constants.h"
 #include "../common/eq_stream_intf.h"
 #include "../common/eq_packet.h"
+#include "../common/multicast_packet.h"
 #include "../common/linked_list.h"
 #include "../common/extprofile.h"
 #include "../common/races.h"
@@ -86,6 +87,7 @@ namespace EQ
 
 #include <float.h>
 #include <set>
+#include <array>
 #include <algorithm>
 #include <memory>
 #include <deque>
@@ -455,6 +457,7 @@ public:
 	bool ShouldISpawnFor(Client *c) { return !GMHideMe(c) && !IsHoveringForRespawn(); }
 	virtual bool Process();
 	void QueuePacket(const EQApplicationPacket* app, bool ack_req = true, CLIENT_CONN_STATUS = CLIENT_CONNECTINGALL, eqFilterType filter=FilterNone);
+	void QueuePacket(MulticastPacket &packet, CLIENT_CONN_STATUS = CLIENT_CONNECTINGALL, eqFilterType filter=FilterNone);
 	void FastQueuePacket(EQApplicationPacket** app, bool ack_req = true, CLIENT_CONN_STATUS = CLIENT_CONNECTINGALL);
 	void ChannelMessageReceived(uint8 chan_num, uint8 language, uint8 lang_skill, const char* orig_message, const char* targetname = nullptr, bool is_silent = false);
 	void ChannelMessageSend(const char* from, const char* to, uint8 channel_id, uint8 language_id, uint8 language_skill, const char* message, ...);
@@ -483,7 +486,7 @@ public:
 	void UpdateLFP();
 
 	virtual bool Save() { return Save(0); }
-	bool Save(uint8 iCommitNow); // 0 = delayed, 1=async now, 2=sync now
+	bool Save(uint8 iCommitNow); // 0 = delayed, 1=async now, 2=sync now (waits for the save queue)
 	inline void SaveCharacterData() {
 		database.SaveCharacterData(this, &m_pp, &m_epp);
 	};
@@ -1962,6 +1965,17 @@ public:
 protected:
 	friend class Mob;
 	void CalcEdibleBonuses(StatBonuses* newbon);
+	std::array<const EQ::ItemInstance*, 2> GetEdibleBonusItems();
+	void UpdateItemBonuses();
+	void GetItemBonusSignature(std::vector<uintptr_t> &signature);
+
+	// item, heroic and edible fold from the last recalculation, with everything it was built from
+	struct ItemBonusCache {
+		StatBonuses bonuses;
+		std::vector<uintptr_t> signature;
+	};
+	std::unique_ptr<ItemBonusCache> m_item_bonus_cache;
+	std::vector<uintptr_t> m_item_bonus_signature;
 	void MakeBuffFadePacket(uint16 spell_id, int slot_id, bool send_message = true);
 	bool client_data_loaded;
 
@@ -2044,6 +2058,7 @@ private:
 	uint8 playeraction;
 
 	EQStreamInterface* eqs;
+	bool ReadyForPacket(const EQApplicationPacket* app, bool ack_req, CLIENT_CONN_STATUS required_state, eqFilterType filter);
 
 	uint32 ip;
 	uint16 port;
@@ -43,6 +43,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "../common/data_verification.h"
 #include "../common/rdtsc.h"
 #include "../common/data_bucket.h"
+#include "character_save_queue.h"
 #include "dynamic_zone.h"
 #include "event_codes.h"
 #include "guild_mgr.h"
@@ -808,6 +809,8 @@ void Client::CompleteConnect()
 
 	/* This sub event is for if a player logs in for the first time since entering world. */
 	if (ingame) {
+		CharacterSaveQueue::Get().Wait(CharacterID());
+
 		auto e = CharacterDataRepository::FindOne(
 			database,
 			CharacterID()
@@ -1455,6 +1458,7 @@ void Client::Handle_Connect_OP_ZoneEntry(const EQApplicationPacket *app)
 	m_Position.y = m_pp.y;
 	m_Position.z = m_pp.z;
 	m_Position.w = m_pp.heading;
+	entity_list.UpdateCloseGrid(this);
 	race = m_pp.race;
 	base_race = m_pp.race;
 	gender = m_pp.gender;
@@ -5024,6 +5028,7 @@ void Client::Handle_OP_ClientUpdate(const EQApplicationPacket *app) {
 	m_Position.x = cx;
 	m_Position.y = cy;
 	m_Position.z = cz;
+	entity_list.UpdateCloseGrid(this);
 
 	/* Visual Debugging */
 	if (RuleB(Character, OPClientUpdateVisualDebug)) {
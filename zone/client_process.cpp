@@ -2193,9 +2193,7 @@ void Client::HandleRespawnFromHover(uint32 Option)
 
 			if (corpse)
 			{
-				m_Position.x = corpse->GetX();
-				m_Position.y = corpse->GetY();
-				m_Position.z = corpse->GetZ();
+				SetPosition(corpse->GetX(), corpse->GetY(), corpse->GetZ());
 			}
 
 			auto outapp =
@@ -2250,10 +2248,8 @@ void Client::HandleRespawnFromHover(uint32 Option)
 			RestoreMana();
 			RestoreEndurance();
 
-			m_Position.x = chosen->x;
-			m_Position.y = chosen->y;
-			m_Position.z = chosen->z;
 			m_Position.w = chosen->heading;
+			SetPosition(chosen->x, chosen->y, chosen->z);
 
 			ClearHover();
 			entity_list.RefreshClientXTargets(this);
@@ -227,6 +227,7 @@ int command_init(void)
 		command_add("takeplatinum", "[Platinum] - Takes specified amount of platinum from you or your player target", AccountStatus::GMMgmt, command_takeplatinum) ||
 		command_add("task", "(subcommand) - Task system commands", AccountStatus::GMLeadAdmin, command_task) ||
 		command_add("petname", "[newname] - Temporarily renames your pet. Leave name blank to restore the original name.", AccountStatus::GMAdmin, command_petname) ||
+		command_add("tickprofile", "[reset] - Show per phase timings of the zone main loop (p50, p99, max and the worst tick)", AccountStatus::GMMgmt, command_tickprofile) ||
 		command_add("traindisc", "[level] - Trains all the disciplines usable by the target, up to level specified. (may freeze client for a few seconds)", AccountStatus::GMLeadAdmin, command_traindisc) ||
 		command_add("tune", "Calculate statistical values related to combat.", AccountStatus::GMAdmin, command_tune) ||
 		command_add("undye", "Remove dye from all of your or your target's armor slots", AccountStatus::GMAdmin, command_undye) ||
@@ -920,6 +921,7 @@ void command_bot(Client *c, const Seperator *sep)
 #include "gm_commands/suspendmulti.cpp"
 #include "gm_commands/takeplatinum.cpp"
 #include "gm_commands/task.cpp"
+#include "gm_commands/tickprofile.cpp"
 #include "gm_commands/traindisc.cpp"
 #include "gm_commands/tune.cpp"
 #include "gm_commands/undye.cpp"
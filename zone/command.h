@@ -179,6 +179,7 @@ void command_suspendmulti(Client *c, const Seperator *sep);
 void command_takeplatinum(Client* c, const Seperator* sep);
 void command_task(Client *c, const Seperator *sep);
 void command_petname(Client *c, const Seperator *sep);
+void command_tickprofile(Client *c, const Seperator *sep);
 void command_traindisc(Client *c, const Seperator *sep);
 void command_tune(Client *c, const Seperator *sep);
 void command_undye(Client *c, const Seperator *sep);
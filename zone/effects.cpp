@@ -1125,6 +1125,12 @@ void EntityList::AESpell(
 		RuleI(Range, MobCloseScanDistance),
 		distance
 	);
+	const bool check_los = is_detrimental_spell && !spells[spell_id].npc_no_los;
+
+	// everything that passes the cheaper checks, line of sight for these is then done in batches
+	std::vector<Mob *> targets;
+	std::vector<float> target_distances;
+
 	auto list = caster_mob->GetCloseMobList(distance);
 	for (auto& it: list) {
 		current_mob = it.second;
@@ -1201,18 +1207,6 @@ void EntityList::AESpell(
 			if (!caster_mob->IsAttackAllowed(current_mob, true)) {
 				continue;
 			}
-
-			if (center_mob && !spells[spell_id].npc_no_los && !center_mob->CheckLosFN(current_mob)) {
-				continue;
-			}
-
-			if (!center_mob && !spells[spell_id].npc_no_los && !caster_mob->CheckLosFN(
-				caster_mob->GetTargetRingX(),
-				caster_mob->GetTargetRingY(),
-				caster_mob->GetTargetRingZ(),
-				current_mob->GetSize())) {
-				continue;
-			}
 		} else {
 			/**
 			 * Check to stop casting beneficial ae buffs (to wit: bard songs) on enemies...
@@ -1229,18 +1223,67 @@ void EntityList::AESpell(
 			}
 		}
 
-		current_mob->CalcSpellPowerDistanceMod(spell_id, distance_to_target);
-		caster_mob->SpellOnTarget(spell_id, current_mob, 0, true, resist_adjust);
+		targets.push_back(current_mob);
+		target_distances.push_back(distance_to_target);
+	}
 
-		/**
-		 * Increment hit count if max targets
-		 */
+	/**
+	 * With a target cap only as many LoS checks as there are targets left are batched at a time,
+	 * so a capped AE over a crowd does not pay for checks it never uses
+	 */
+	std::vector<Mob *>     batch;
+	std::vector<glm::vec4> ring_batch;
+	std::vector<bool>      can_see;
+	size_t                 next = 0;
+	while (next < targets.size()) {
+		size_t batch_size = targets.size() - next;
 		if (max_targets_allowed) {
-			target_hit_counter++;
-			if (target_hit_counter >= max_targets_allowed) {
-				break;
+			batch_size = std::min(batch_size, static_cast<size_t>(std::max(max_targets_allowed - target_hit_counter, 1)));
+		}
+
+		if (check_los) {
+			if (center_mob) {
+				batch.assign(targets.begin() + next, targets.begin() + next + batch_size);
+				center_mob->CheckLosFN(batch, can_see);
+			} else {
+				ring_batch.clear();
+				for (size_t i = next; i < next + batch_size; ++i) {
+					ring_batch.emplace_back(
+						caster_mob->GetTargetRingX(),
+						caster_mob->GetTargetRingY(),
+						caster_mob->GetTargetRingZ(),
+						targets[i]->GetSize()
+					);
+				}
+
+				caster_mob->CheckLosFN(ring_batch, can_see);
+			}
+		}
+
+		for (size_t i = next; i < next + batch_size; ++i) {
+			if (check_los && !can_see[i - next]) {
+				continue;
+			}
+
+			current_mob = targets[i];
+			current_mob->CalcSpellPowerDistanceMod(spell_id, target_distances[i]);
+			caster_mob->SpellOnTarget(spell_id, current_mob, 0, true, resist_adjust);
+
+			/**
+			 * Increment hit count if max targets
+			 */
+			if (max_targets_allowed) {
+				target_hit_counter++;
+				if (target_hit_counter >= max_targets_allowed) {
+					break;
+				}
 			}
 		}
+
+		next += batch_size;
+		if (max_targets_allowed && target_hit_counter >= max_targets_allowed) {
+			break;
+		}
 	}
 
 	LogAoeCast("Done iterating [{}]", caster_mob->GetCleanName());
@@ -226,6 +226,9 @@ PerlembParser::PerlembParser() : perl(nullptr)
 
 PerlembParser::~PerlembParser()
 {
+	// the handles go with the interpreter
+	packages_.clear();
+	clear_packages_.clear();
 	safe_delete(perl);
 }
 
@@ -236,6 +239,9 @@ void PerlembParser::Init()
 
 void PerlembParser::ReloadQuests()
 {
+	packages_.clear();
+	clear_packages_.clear();
+
 	try {
 		if (!perl) {
 			perl = new Embperl;
@@ -884,14 +890,8 @@ void PerlembParser::ExportVar(const char* prefix, const char* variable_name, int
 	}
 
 	try {
-		perl->seti(
-			fmt::format(
-				"{}::{}",
-				prefix,
-				variable_name
-			).c_str(),
-			value
-		);
+		dTHX;
+		sv_setiv(GetPackageVar(GetPerlPackage(prefix), variable_name), value);
 	} catch (std::string e) {
 		AddError(
 			fmt::format(
@@ -909,14 +909,8 @@ void PerlembParser::ExportVar(const char* prefix, const char* variable_name, uns
 	}
 
 	try {
-		perl->seti(
-			fmt::format(
-				"{}::{}",
-				prefix,
-				variable_name
-			).c_str(),
-			value
-		);
+		dTHX;
+		sv_setiv(GetPackageVar(GetPerlPackage(prefix), variable_name), static_cast<int>(value));
 	} catch (std::string e) {
 		AddError(
 			fmt::format(
@@ -934,14 +928,8 @@ void PerlembParser::ExportVar(const char* prefix, const char* variable_name, flo
 	}
 
 	try {
-		perl->setd(
-			fmt::format(
-				"{}::{}",
-				prefix,
-				variable_name
-			).c_str(),
-			value
-		);
+		dTHX;
+		sv_setnv(GetPackageVar(GetPerlPackage(prefix), variable_name), value);
 	} catch (std::string e) {
 		AddError(
 			fmt::format(
@@ -959,14 +947,8 @@ void PerlembParser::ExportVar(const char* prefix, const char* variable_name, con
 	}
 
 	try {
-		perl->setstr(
-			fmt::format(
-				"{}::{}",
-				prefix,
-				variable_name
-			).c_str(),
-			value
-		);
+		dTHX;
+		sv_setpv(GetPackageVar(GetPerlPackage(prefix), variable_name), value);
 	} catch (std::string e) {
 		AddError(
 			fmt::format(
@@ -985,15 +967,8 @@ void PerlembParser::ExportVar(const char* prefix, const char* variable_name, con
 	}
 
 	try {
-		perl->setptr(
-			fmt::format(
-				"{}::{}",
-				prefix,
-				variable_name
-			).c_str(),
-			class_name,
-			value
-		);
+		dTHX;
+		sv_setref_pv(GetPackageVar(GetPerlPackage(prefix), variable_name), class_name, value);
 	} catch (std::string e) {
 		AddError(fmt::format("Error exporting Perl variable [{}]", e));
 	}
@@ -1020,37 +995,15 @@ int PerlembParser::SendCommands(
 		quest_manager.StartQuest(other);
 	}
 
-	try {
-		perl->eval(fmt::format("package {};", prefix).c_str());
+	auto& package = GetPerlPackage(prefix);
 
+	try {
 #ifdef EMBPERL_XS_CLASSES
 		dTHX;
-		{
-			const std::vector<std::string>& suffixes = {
-				"bot",
-				"client",
-				"entity_list",
-				"merc",
-				"npc",
-				"questitem",
-				"spell"
-			};
-
-			for (const auto& suffix : suffixes) {
-				const std::string& key = fmt::format("${}::{}", prefix, suffix);
-				if (clear_vars_.find(suffix) != clear_vars_.end()) {
-					auto e = fmt::format("{} = undef;", key);
-					perl->eval(e.c_str());
-				}
-			}
-		}
-
-		std::string buf;
 
 		//init a couple special vars: client, npc, entity_list
 		Client* c = quest_manager.GetInitiator();
-		buf = fmt::format("{}::client", prefix);
-		SV* client = get_sv(buf.c_str(), true);
+		SV* client = GetPackageVar(package, "client");
 		if (c) {
 			sv_setref_pv(client, "Client", c);
 		} else {
@@ -1060,66 +1013,44 @@ int PerlembParser::SendCommands(
 
 		if (other->IsBot()) {
 			Bot* b = quest_manager.GetBot();
-			buf = fmt::format("{}::bot", prefix);
-			SV* bot = get_sv(buf.c_str(), true);
-			sv_setref_pv(bot, "Bot", b);
+			sv_setref_pv(GetPackageVar(package, "bot"), "Bot", b);
 		} else if (other->IsMerc()) {
 			Merc* m = quest_manager.GetMerc();
-			buf = fmt::format("{}::merc", prefix);
-			SV* merc = get_sv(buf.c_str(), true);
-			sv_setref_pv(merc, "Merc", m);
+			sv_setref_pv(GetPackageVar(package, "merc"), "Merc", m);
 		} else if (other->IsNPC()) {
 			NPC* n = quest_manager.GetNPC();
-			buf = fmt::format("{}::npc", prefix);
-			SV* npc = get_sv(buf.c_str(), true);
-			sv_setref_pv(npc, "NPC", n);
+			sv_setref_pv(GetPackageVar(package, "npc"), "NPC", n);
 		}
 
 		//only export QuestItem if it's an inst quest
 		if (inst) {
 			auto i = quest_manager.GetQuestItem();
-			buf = fmt::format("{}::questitem", prefix);
-			SV* questitem = get_sv(buf.c_str(), true);
-			sv_setref_pv(questitem, "QuestItem", i);
+			sv_setref_pv(GetPackageVar(package, "questitem"), "QuestItem", i);
 		}
 
 		if (spell) {
 			const auto current_spell = quest_manager.GetQuestSpell();
 			auto       real_spell    = const_cast<SPDat_Spell_Struct*>(current_spell);
-			buf = fmt::format("{}::spell", prefix);
-			SV* spell = get_sv(buf.c_str(), true);
-			sv_setref_pv(spell, "Spell", (void*) real_spell);
+			sv_setref_pv(GetPackageVar(package, "spell"), "Spell", (void*) real_spell);
 		}
 
-
-		buf = fmt::format("{}::entity_list", prefix);
-		SV* el = get_sv(buf.c_str(), true);
-		sv_setref_pv(el, "EntityList", &entity_list);
+		sv_setref_pv(GetPackageVar(package, "entity_list"), "EntityList", &entity_list);
 #endif
 
 		//now call the requested sub
-		const std::string& sub_key = fmt::format("{}::{}", prefix, event_id);
-		ret_value = perl->dosub(sub_key.c_str());
+		CV* sub = GetPackageSub(package, event_id);
+		if (sub) {
+			ret_value = perl->dosub(sub);
+		} else {
+			ret_value = perl->dosub(fmt::format("{}::{}", prefix, event_id).c_str());
+		}
 
 #ifdef EMBPERL_XS_CLASSES
-		{
-			const std::vector<std::string>& suffixes = {
-				"bot",
-				"client",
-				"entity_list",
-				"merc",
-				"npc",
-				"questitem",
-				"spell"
-			};
-
-			for (const auto& suffix : suffixes) {
-				const std::string& key = fmt::format("${}::{}", prefix, suffix);
-				clear_vars_[key] = 1;
-			}
+		if (!package.clear_pending) {
+			package.clear_pending = true;
+			clear_packages_.push_back(&package);
 		}
 #endif
-
 	} catch (std::string e) {
 		AddError(
 			fmt::format(
@@ -1135,27 +1066,76 @@ int PerlembParser::SendCommands(
 
 #ifdef EMBPERL_XS_CLASSES
 	if (!quest_manager.QuestsRunning()) {
-		std::string eval_str;
-		for (const auto& v: clear_vars_) {
-			eval_str += fmt::format("{} = undef;", v.first);
+		ClearPackageExports();
+	}
+#endif
+
+	return ret_value;
+}
+
+PerlembParser::PerlPackage& PerlembParser::GetPerlPackage(const char* package_name)
+{
+	auto iter = packages_.find(std::string_view(package_name));
+	if (iter == packages_.end()) {
+		iter = packages_.emplace(package_name, PerlPackage{}).first;
+		iter->second.name = package_name;
+	}
+
+	return iter->second;
+}
+
+SV* PerlembParser::GetPackageVar(PerlPackage& package, const char* variable_name)
+{
+	dTHX;
+
+	auto iter = package.vars.find(std::string_view(variable_name));
+	if (iter == package.vars.end()) {
+		const auto& name = fmt::format("{}::{}", package.name, variable_name);
+
+		// held so the handle outlives anything a script does to its symbol table
+		GV* gv = gv_fetchpv(name.c_str(), GV_ADD, SVt_PV);
+		SvREFCNT_inc_simple_void_NN(gv);
+		iter = package.vars.emplace(variable_name, gv).first;
+	}
+
+	return GvSVn(iter->second);
+}
+
+CV* PerlembParser::GetPackageSub(PerlPackage& package, const char* sub_name)
+{
+	dTHX;
+
+	auto iter = package.subs.find(std::string_view(sub_name));
+	if (iter == package.subs.end()) {
+		const auto& name = fmt::format("{}::{}", package.name, sub_name);
+
+		// not added, SubExists treats any symbol of the name as a sub
+		GV* gv = gv_fetchpv(name.c_str(), 0, SVt_PVCV);
+		if (!gv) {
+			return nullptr;
 		}
 
-		clear_vars_.clear();
+		SvREFCNT_inc_simple_void_NN(gv);
+		iter = package.subs.emplace(sub_name, gv).first;
+	}
+
+	return GvCV(iter->second);
+}
 
-		try {
-			perl->eval(eval_str.c_str());
-		} catch (std::string e) {
-			AddError(
-				fmt::format(
-					"Script Clear Error | Error [{}]",
-					e
-				)
-			);
+// drops the objects exported to every package that ran since the outermost quest started
+void PerlembParser::ClearPackageExports()
+{
+	dTHX;
+
+	for (auto package : clear_packages_) {
+		for (const char* name : {"bot", "client", "entity_list", "merc", "npc", "questitem", "spell"}) {
+			sv_setsv(GetPackageVar(*package, name), &PL_sv_undef);
 		}
+
+		package->clear_pending = false;
 	}
-#endif
 
-	return ret_value;
+	clear_packages_.clear();
 }
 
 void PerlembParser::MapFunctions()
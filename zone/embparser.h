@@ -25,6 +25,8 @@
 #include <string>
 #include <queue>
 #include <map>
+#include <string_view>
+#include <unordered_map>
 #include "embperl.h"
 
 class Mob;
@@ -197,6 +199,35 @@ private:
 		const SPDat_Spell_Struct* spell
 	);
 
+	/*
+		Globs of the package variables and event subs dispatch touches, fetched by name once per
+		interpreter so an event sets its exports and calls its sub without formatting names or
+		compiling Perl. A glob's scalar and sub slots are read on each use so redefined subs and
+		local'd variables are still followed.
+	*/
+	struct PerlNameHash {
+		using is_transparent = void;
+		size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+	};
+
+	template<typename T>
+	using PerlNameMap = std::unordered_map<std::string, T, PerlNameHash, std::equal_to<>>;
+
+	struct PerlPackage {
+		std::string      name;
+		PerlNameMap<GV*> vars;
+		PerlNameMap<GV*> subs;
+		bool             clear_pending = false;
+	};
+
+	PerlPackage& GetPerlPackage(const char* package_name);
+	SV* GetPackageVar(PerlPackage& package, const char* variable_name);
+	CV* GetPackageSub(PerlPackage& package, const char* sub_name);
+	void ClearPackageExports();
+
+	PerlNameMap<PerlPackage>  packages_;
+	std::vector<PerlPackage*> clear_packages_;
+
 	void MapFunctions();
 
 	void GetQuestTypes(
@@ -299,7 +330,6 @@ private:
 	SV* _empty_sv;
 
 	std::map<std::string, std::string> vars_;
-	std::map<std::string, int>         clear_vars_;
 };
 
 #endif
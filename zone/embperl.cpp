@@ -295,6 +295,48 @@ int Embperl::dosub(const char* sub_name, const std::vector<std::string>* args, i
 	return ret_value;
 }
 
+int Embperl::dosub(CV* sub, int mode)
+{
+	dSP;
+	int  ret_value = 0;
+	int  count;
+	bool failed    = false;
+
+	ENTER;
+	SAVETMPS;
+	PUSHMARK(SP);
+	PUTBACK;
+
+	count = call_sv(reinterpret_cast<SV*>(sub), mode);
+	SPAGAIN;
+
+	if (SvTRUE(ERRSV)) {
+		failed = true;
+		POPs;
+	} else {
+		if (count == 1) {
+			SV* ret = POPs;
+			if (SvTYPE(ret) == SVt_IV) {
+				IV v = SvIV(ret);
+				ret_value = v;
+			}
+
+			PUTBACK;
+		}
+	}
+
+	FREETMPS;
+	LEAVE;
+
+	if (failed) {
+		std::string errmsg = "Perl runtime error: ";
+		errmsg += SvPVX(ERRSV);
+		throw errmsg;
+	}
+
+	return ret_value;
+}
+
 //evaluate an expression. throw error on fail
 int Embperl::eval(const char* code)
 {
@@ -91,6 +91,8 @@ public:
 	int eval(const char* code);
 	//execute a subroutine. throws lasterr on failure
 	int dosub(const char* sub_name, const std::vector<std::string>* args = nullptr, int mode = G_SCALAR | G_EVAL);
+	//execute a subroutine from a held handle, skipping the lookup by name. throws lasterr on failure
+	int dosub(CV* sub, int mode = G_SCALAR | G_EVAL);
 
 	//put an integer into a perl varable
 	void seti(const char* variable_name, int val) const
@@ -297,6 +297,9 @@ EntityList::EntityList()
 	// enough entities to exhaust this list
 	for (uint16 i = 1; i <= 1500; i++)
 		free_ids.push(i);
+
+	m_mob_sleep_clock      = 0;
+	m_mob_sleep_clock_last = Timer::GetCurrentTime();
 }
 
 EntityList::~EntityList()
@@ -331,6 +334,7 @@ void EntityList::AddClient(Client *client)
 	client->SetID(GetFreeID());
 	client_list.emplace(std::pair<uint16, Client *>(client->GetID(), client));
 	mob_list.emplace(std::pair<uint16, Mob *>(client->GetID(), client));
+	AddToCloseGrid(client);
 }
 
 
@@ -471,10 +475,48 @@ void EntityList::CorpseProcess()
 	}
 }
 
+uint64 EntityList::MobSleepClock()
+{
+	uint32 now = Timer::GetCurrentTime();
+	m_mob_sleep_clock += static_cast<uint32>(now - m_mob_sleep_clock_last);
+	m_mob_sleep_clock_last = now;
+	return m_mob_sleep_clock;
+}
+
+void EntityList::WakeMob(uint16 id)
+{
+	m_mob_sleep.Cancel(id);
+}
+
+// processes a mob unless it is asleep, an idle NPC then sleeps until the first of its timers is due
+bool EntityList::ProcessMob(Mob *mob)
+{
+	if (m_mob_sleep.IsScheduled(mob->GetID())) {
+		return true;
+	}
+
+	if (!mob->Process()) {
+		return false;
+	}
+
+	if (mob->IsNPC()) {
+		uint32 sleep = mob->CastToNPC()->GetIdleSleepTime();
+		if (sleep > 0) {
+			m_mob_sleep.Schedule(mob->GetID(), m_mob_sleep_clock + sleep);
+		}
+	}
+
+	return true;
+}
+
 void EntityList::MobProcess()
 {
 	bool mob_dead;
 
+	// NPCs whose timers are due are processed again, the rest stay skipped
+	m_mob_woken.clear();
+	m_mob_sleep.Advance(MobSleepClock(), m_mob_woken);
+
 	auto it = mob_list.begin();
 	while (it != mob_list.end()) {
 		uint16 id = it->first;
@@ -532,14 +574,14 @@ void EntityList::MobProcess()
 				(mob && s2 && s2->PathWhenZoneIdle()) ||
 				mob_settle_timer->Enabled()
 			) {
-				mob_dead = !mob->Process();
+				mob_dead = !ProcessMob(mob);
 			} else {
 				// spawn_events can cause spawns and deaths while zone empty.
 				// At the very least, process that.
 				mob_dead = mob->CastToNPC()->GetDepop();
 			}
 		} else {
-			mob_dead = !mob->Process();
+			mob_dead = !ProcessMob(mob);
 		}
 
 		size_t a_sz = mob_list.size();
@@ -698,6 +740,7 @@ void EntityList::AddNPC(NPC *npc, bool send_spawn_packet, bool dont_queue)
 
 	npc_list.emplace(std::pair<uint16, NPC *>(npc->GetID(), npc));
 	mob_list.emplace(std::pair<uint16, Mob *>(npc->GetID(), npc));
+	AddToCloseGrid(npc);
 
 	entity_list.ScanCloseMobs(npc);
 
@@ -779,6 +822,7 @@ void EntityList::AddMerc(Merc *merc, bool SendSpawnPacket, bool dontqueue)
 
 		merc_list.emplace(std::pair<uint16, Merc *>(merc->GetID(), merc));
 		mob_list.emplace(std::pair<uint16, Mob *>(merc->GetID(), merc));
+		AddToCloseGrid(merc);
 
 		if (parse->MercHasQuestSub(EVENT_SPAWN)) {
 			parse->EventMerc(EVENT_SPAWN, merc, nullptr, "", 0);
@@ -1739,15 +1783,15 @@ void EntityList::QueueCloseClients(
 		distance = zone->GetClientUpdateRange();
 	}
 
-	float distance_squared = distance * distance;
-	for (auto &e : sender->GetCloseMobList(distance)) {
-		Mob *mob = e.second;
+	float           distance_squared = distance * distance;
+	MulticastPacket packet(app, is_ack_required);
+	auto            queue_to_mob     = [&](Mob *mob) {
 		if (!mob) {
-			continue;
+			return;
 		}
 
 		if (!mob->IsClient()) {
-			continue;
+			return;
 		}
 
 		Client *client = mob->CastToClient();
@@ -1755,11 +1799,11 @@ void EntityList::QueueCloseClients(
 		if ((!ignore_sender || client != sender) && (client != skipped_mob)) {
 
 			if (DistanceSquared(client->GetPosition(), sender->GetPosition()) >= distance_squared) {
-				continue;
+				return;
 			}
 
 			if (!client->Connected()) {
-				continue;
+				return;
 			}
 
 			eqFilterMode client_filter = client->GetFilter(filter);
@@ -1769,9 +1813,19 @@ void EntityList::QueueCloseClients(
 				 (sender == client || (client->GetGroup() && client->GetGroup()->IsGroupMember(sender)))) ||
 				(client_filter == FilterShowSelfOnly && client == sender)
 				) {
-				client->QueuePacket(app, is_ack_required, Client::CLIENT_CONNECTED);
+				client->QueuePacket(packet, Client::CLIENT_CONNECTED);
 			}
 		}
+	};
+
+	// beyond the close list range only visit the grid cells that can contain a recipient
+	if (distance > RuleI(Range, MobCloseScanDistance)) {
+		m_close_grid.ForEachInRange(glm::vec3(sender->GetPosition()), distance, queue_to_mob);
+		return;
+	}
+
+	for (auto &e : sender->GetCloseMobList(distance)) {
+		queue_to_mob(e.second);
 	}
 }
 
@@ -1781,12 +1835,14 @@ void EntityList::QueueClients(
 	bool ignore_sender, bool ackreq
 )
 {
+	MulticastPacket packet(app, ackreq);
+
 	auto it = client_list.begin();
 	while (it != client_list.end()) {
 		Client *ent = it->second;
 
 		if ((!ignore_sender || ent != sender))
-			ent->QueuePacket(app, ackreq, Client::CLIENT_CONNECTED);
+			ent->QueuePacket(packet, Client::CLIENT_CONNECTED);
 
 		++it;
 	}
@@ -2656,6 +2712,9 @@ void EntityList::RemoveAllMobs()
 		free_ids.push(it->first);
 		it = mob_list.erase(it);
 	}
+
+	m_close_grid.Clear();
+	m_mob_sleep.Reset(MobSleepClock());
 }
 
 void EntityList::RemoveAllClients()
@@ -2798,6 +2857,7 @@ bool EntityList::RemoveMob(uint16 delete_id)
 		else if (client_list.count(delete_id)) {
 			entity_list.RemoveClient(delete_id);
 		}
+		m_mob_sleep.Cancel(delete_id);
 		safe_delete(it->second);
 		if (!corpse_list.count(delete_id)) {
 			free_ids.push(it->first);
@@ -2858,6 +2918,8 @@ bool EntityList::RemoveMobFromCloseLists(Mob *mob)
 		++it;
 	}
 
+	m_close_grid.Remove(mob);
+
 	return false;
 }
 
@@ -2908,9 +2970,46 @@ void EntityList::RemoveAuraFromMobs(Mob *aura)
 // All of the above makes a tremendous impact on the bottom line of cpu cycle performance because we run an order of magnitude
 // less checks by focusing our hot path logic down to a very small subset of relevant entities instead of looping an entire
 // entity list (zone wide)
+//
+// The scan itself only visits the grid cells around the scanning mob (m_close_grid) rather than the whole mob_list, the
+// grid is kept up to date as mobs move (UpdateCloseGrid) and each scan re-buckets the scanning mob in case its position
+// was changed without going through one of the movement paths
 
 BenchTimer g_scan_bench_timer;
 
+// cells are half the scan distance so a scan touches a 5x5 block of cells
+static inline float GetCloseGridCellSize()
+{
+	return std::max(1.0f, static_cast<float>(RuleI(Range, MobCloseScanDistance)) / 2.0f);
+}
+
+void EntityList::AddToCloseGrid(Mob *mob)
+{
+	if (!mob) {
+		return;
+	}
+
+	m_close_grid.SetCellSize(GetCloseGridCellSize());
+	m_close_grid.Update(
+		mob,
+		glm::vec3(mob->GetPosition()),
+		mob->GetAggroRange() >= RuleI(Range, MobCloseScanDistance)
+	);
+}
+
+void EntityList::UpdateCloseGrid(Mob *mob)
+{
+	if (!mob) {
+		return;
+	}
+
+	m_close_grid.Move(
+		mob,
+		glm::vec3(mob->GetPosition()),
+		mob->GetAggroRange() >= RuleI(Range, MobCloseScanDistance)
+	);
+}
+
 void EntityList::ScanCloseMobs(Mob *scanning_mob)
 {
 	if (!scanning_mob) {
@@ -2925,31 +3024,31 @@ void EntityList::ScanCloseMobs(Mob *scanning_mob)
 
 	float scan_range = RuleI(Range, MobCloseScanDistance);
 
-	// Reserve memory in m_close_mobs to avoid frequent re-allocations if not already reserved.
-	// Assuming mob_list.size() as an upper bound for reservation.
-	if (scanning_mob->m_close_mobs.bucket_count() < mob_list.size()) {
-		scanning_mob->m_close_mobs.reserve(mob_list.size());
-	}
+	// rules may have been reloaded since the grid was built
+	m_close_grid.SetCellSize(GetCloseGridCellSize());
+	UpdateCloseGrid(scanning_mob);
 
 	scanning_mob->m_close_mobs.clear();
 
-	for (auto &e : mob_list) {
-		auto mob = e.second;
-
-		if (mob && (mob->GetID() <= 0 || mob->IsZoneController())) {
-			continue;
-		}
+	m_close_grid.ForEachInRange(
+		glm::vec3(scanning_mob->GetPosition()),
+		scan_range,
+		[&](Mob *mob) {
+			if (!mob || mob->GetID() <= 0 || mob->IsZoneController()) {
+				return;
+			}
 
-		float distance = Distance(scanning_mob->GetPosition(), mob->GetPosition());
-		if (distance <= scan_range || mob->GetAggroRange() >= scan_range) {
-			// add mob to scanning_mob's close list and vice versa
-			// check if the mob is already in the close mobs list before inserting
-			if (mob->m_close_mobs.find(scanning_mob->GetID()) == mob->m_close_mobs.end()) {
-				mob->m_close_mobs[scanning_mob->GetID()] = scanning_mob;
+			float distance = Distance(scanning_mob->GetPosition(), mob->GetPosition());
+			if (distance <= scan_range || mob->GetAggroRange() >= scan_range) {
+				// add mob to scanning_mob's close list and vice versa
+				// check if the mob is already in the close mobs list before inserting
+				if (mob->m_close_mobs.find(scanning_mob->GetID()) == mob->m_close_mobs.end()) {
+					mob->m_close_mobs[scanning_mob->GetID()] = scanning_mob;
+				}
+				scanning_mob->m_close_mobs[mob->GetID()] = mob;
 			}
-			scanning_mob->m_close_mobs[mob->GetID()] = mob;
 		}
-	}
+	);
 
 	LogAIScanClose(
 		"[{}] Scanning close list > list_size [{}] moving [{}] elapsed [{}] us",
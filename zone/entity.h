@@ -29,6 +29,8 @@
 #include "../common/emu_constants.h"
 
 #include "position.h"
+#include "sleep_wheel.h"
+#include "spatial_grid.h"
 #include "zonedump.h"
 #include "common.h"
 
@@ -268,6 +270,9 @@ public:
 	void	ObjectProcess();
 	void	CorpseProcess();
 	void	MobProcess();
+	void	WakeMob(uint16 id); // an idle NPC put to sleep by MobProcess is processed again from the next tick
+	inline bool IsMobSleeping(uint16 id) const { return m_mob_sleep.IsScheduled(id); }
+	inline size_t GetSleepingMobCount() const { return m_mob_sleep.Size(); }
 	void	TrapProcess();
 	void	BeaconProcess();
 	void	EncounterProcess();
@@ -570,6 +575,8 @@ public:
 	void RefreshClientXTargets(Client *c);
 	void SendAlternateAdvancementStats();
 	void ScanCloseMobs(Mob *scanning_mob);
+	void UpdateCloseGrid(Mob *mob);
+	inline const SpatialGrid<Mob> &GetCloseGrid() const { return m_close_grid; }
 
 	void GetTrapInfo(Client* c);
 	bool IsTrapGroupSpawned(uint32 trap_id, uint8 group);
@@ -589,6 +596,9 @@ protected:
 
 private:
 	void	AddToSpawnQueue(uint16 entityid, NewSpawn_Struct** app);
+	bool	ProcessMob(Mob *mob);
+	uint64	MobSleepClock();
+	void	AddToCloseGrid(Mob *mob);
 	void	CheckSpawnQueue();
 
 	//used for limiting spawns
@@ -601,6 +611,11 @@ private:
 
 	std::unordered_map<uint16, Client *> client_list;
 	std::unordered_map<uint16, Mob *> mob_list;
+	SpatialGrid<Mob> m_close_grid;
+	SleepWheel m_mob_sleep;
+	uint64 m_mob_sleep_clock;      // milliseconds on the sleep wheel, Timer time doesn't fit past 49 days
+	uint32 m_mob_sleep_clock_last; // Timer time the clock was last moved at
+	std::vector<uint16> m_mob_woken;
 	std::unordered_map<uint16, NPC *> npc_list;
 	std::unordered_map<uint16, Merc *> merc_list;
 	std::unordered_map<uint16, Corpse *> corpse_list;
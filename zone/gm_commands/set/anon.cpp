@@ -1,4 +1,5 @@
 #include "../../client.h"
+#include "../../character_save_queue.h"
 #include "../../../common/repositories/character_data_repository.h"
 
 void SetAnon(Client *c, const Seperator *sep)
@@ -48,6 +49,8 @@ void SetAnon(Client *c, const Seperator *sep)
 		const int   character_id = Strings::ToInt(sep->arg[2]);
 		const uint8 anon_flag    = static_cast<uint8>(Strings::ToUnsignedInt(sep->arg[3]));
 
+		CharacterSaveQueue::Get().Wait(character_id);
+
 		auto e = CharacterDataRepository::FindOne(content_db, character_id);
 		if (!e.id) {
 			c->Message(
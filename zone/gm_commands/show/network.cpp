@@ -129,6 +129,11 @@ void ShowNetwork(Client *c, const Seperator *sep)
 		DialogueWindow::TableCell(Strings::Commify(opts.daybreak_options.port))
 	);
 
+	popup_table += DialogueWindow::TableRow(
+		DialogueWindow::TableCell("Batched I/O") +
+		DialogueWindow::TableCell(opts.daybreak_options.batched_io ? "Yes" : "No")
+	);
+
 	popup_table = DialogueWindow::Table(popup_table);
 
 	c->SendPopupToClient(
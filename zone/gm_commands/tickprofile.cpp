@@ -0,0 +1,70 @@
+#include "../client.h"
+#include "../dialogue_window.h"
+#include "../tick_profiler.h"
+
+void command_tickprofile(Client *c, const Seperator *sep)
+{
+	auto &profiler = TickProfiler::Get();
+
+	if (!strcasecmp(sep->arg[1], "reset")) {
+		profiler.Reset();
+		c->Message(Chat::White, "Tick profile has been reset.");
+		return;
+	}
+
+	auto format_us = [](uint32 us) {
+		return us >= 1000 ? fmt::format("{:.2f}ms", us / 1000.0) : fmt::format("{}us", us);
+	};
+
+	std::string popup_table;
+
+	popup_table += DialogueWindow::TableRow(
+		DialogueWindow::TableCell("Phase") +
+		DialogueWindow::TableCell("p50") +
+		DialogueWindow::TableCell("p99") +
+		DialogueWindow::TableCell("Max") +
+		DialogueWindow::TableCell("Worst Tick")
+	);
+
+	auto add_row = [&](const TickProfiler::PhaseSummary &s) {
+		popup_table += DialogueWindow::TableRow(
+			DialogueWindow::TableCell(s.name) +
+			DialogueWindow::TableCell(format_us(s.p50_us)) +
+			DialogueWindow::TableCell(format_us(s.p99_us)) +
+			DialogueWindow::TableCell(format_us(s.max_us)) +
+			DialogueWindow::TableCell(format_us(s.worst_tick_us))
+		);
+	};
+
+	auto tick = profiler.GetTickSummary();
+	add_row(tick);
+
+	for (auto &s : profiler.GetPhaseSummaries()) {
+		if (s.samples) {
+			add_row(s);
+		}
+	}
+
+	popup_table = DialogueWindow::Table(popup_table);
+
+	c->SendPopupToClient(
+		fmt::format(
+			"Tick Profile ({} Ticks, Last {} Seconds)",
+			Strings::Commify(tick.samples),
+			TickProfiler::WindowSeconds * 2
+		).c_str(),
+		popup_table.c_str()
+	);
+
+	auto worst = profiler.GetWorstTick();
+	if (worst.total_us) {
+		c->Message(
+			Chat::White,
+			fmt::format(
+				"Worst tick took {} ({} seconds ago), use #tickprofile reset to start a new capture.",
+				format_us(worst.total_us),
+				std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - worst.when).count()
+			).c_str()
+		);
+	}
+}
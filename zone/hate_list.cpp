@@ -66,8 +66,7 @@ void HateList::WipeHateList(bool npc_only) {
 					m->CastToClient()->RemoveXTarget(hate_owner, true);
 				}
 
-				delete (*iterator);
-				iterator = list.erase(iterator);
+				iterator = EraseEntry(iterator);
 			}
 		}
 	}
@@ -84,13 +83,30 @@ struct_HateList* HateList::Find(Mob* m)
 		return nullptr;
 	}
 
-	for (auto e : list) {
-		if (e->entity_on_hatelist && e->entity_on_hatelist == m) {
-			return e;
-		}
-	}
+	return index.Find(m);
+}
 
-	return nullptr;
+std::list<struct_HateList *>::iterator HateList::EraseEntry(std::list<struct_HateList *>::iterator it)
+{
+	index.Remove(*it);
+	delete (*it);
+	return list.erase(it);
+}
+
+void HateList::SetEntryEntity(struct_HateList *entry, Mob *m)
+{
+	index.SetKey(entry, m);
+}
+
+void HateList::SetEntryHate(struct_HateList *entry, int64 in_hate)
+{
+	entry->stored_hate_amount = in_hate;
+	index.Update(entry);
+}
+
+void HateList::SetEntryFrenzy(struct_HateList *entry, bool in_is_frenzied)
+{
+	index.SetFrenzy(entry, in_is_frenzied);
 }
 
 void HateList::SetHateAmountOnEnt(Mob* other, int64 in_hate, uint64 in_damage)
@@ -101,7 +117,7 @@ void HateList::SetHateAmountOnEnt(Mob* other, int64 in_hate, uint64 in_damage)
 		if (in_damage > 0)
 			entity->hatelist_damage = in_damage;
 		if (in_hate > 0)
-			entity->stored_hate_amount = in_hate;
+			SetEntryHate(entity, in_hate);
 		entity->last_modified = Timer::GetCurrentTime();
 	}
 }
@@ -221,8 +237,8 @@ void HateList::AddEntToHateList(Mob *in_entity, int64 in_hate, int64 in_damage,
 	struct_HateList *entity = Find(in_entity);
 	if (entity) {
 		entity->hatelist_damage += (in_damage >= 0) ? in_damage : 0;
-		entity->stored_hate_amount += in_hate;
-		entity->is_entity_frenzy = in_is_entity_frenzied;
+		SetEntryHate(entity, entity->stored_hate_amount + in_hate);
+		SetEntryFrenzy(entity, in_is_entity_frenzied);
 		entity->last_modified = Timer::GetCurrentTime();
 
 		LogHate(
@@ -242,7 +258,9 @@ void HateList::AddEntToHateList(Mob *in_entity, int64 in_hate, int64 in_damage,
 		entity->is_entity_frenzy = in_is_entity_frenzied;
 		entity->oor_count = 0;
 		entity->last_modified = Timer::GetCurrentTime();
+		entity->owner = this;
 		list.push_back(entity);
+		index.Insert(entity);
 
 		if (parse->HasQuestSub(hate_owner->GetNPCTypeID(), EVENT_HATE_LIST)) {
 			parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), in_entity, "1", 0);
@@ -256,7 +274,7 @@ void HateList::AddEntToHateList(Mob *in_entity, int64 in_hate, int64 in_damage,
 
 bool HateList::RemoveEntFromHateList(Mob *in_entity)
 {
-	if (!in_entity) {
+	if (!Find(in_entity)) {
 		return false;
 	}
 
@@ -271,8 +289,7 @@ bool HateList::RemoveEntFromHateList(Mob *in_entity)
 				in_entity->CastToClient()->DecrementAggroCount();
 			}
 
-			delete (*iterator);
-			iterator = list.erase(iterator);
+			iterator = EraseEntry(iterator);
 
 			if (in_entity) {
 				if (parse->HasQuestSub(hate_owner->GetNPCTypeID(), EVENT_HATE_LIST)) {
@@ -345,6 +362,176 @@ int HateList::GetHateRatio(Mob *top, Mob *other)
 	return EQ::Clamp(static_cast<int>((other_entry->stored_hate_amount * 100) / top_entry->stored_hate_amount), 1, 999);
 }
 
+int64 HateList::GetSmartAggroHate(Mob *center, struct_HateList *e, bool &client_in_melee_range)
+{
+	Mob   *m           = e->entity_on_hatelist;
+	int64 current_hate = e->stored_hate_amount;
+	int16 aggro_mod    = 0;
+
+	client_in_melee_range = false;
+
+	if (m->IsOfClientBot()) {
+		if (m->IsClient() && m->CastToClient()->IsSitting()) {
+			aggro_mod += RuleI(Aggro, SittingAggroMod);
+		}
+
+		if (center) {
+			if (center->GetTarget() == m) {
+				aggro_mod += RuleI(Aggro, CurrentTargetAggroMod);
+			}
+
+			if (RuleI(Aggro, MeleeRangeAggroMod) != 0) {
+				if (center->CombatRange(m)) {
+					aggro_mod += RuleI(Aggro, MeleeRangeAggroMod);
+					client_in_melee_range = true;
+				}
+			}
+		}
+	} else {
+		if (center) {
+			if (center->GetTarget() == m) {
+				aggro_mod += RuleI(Aggro, CurrentTargetAggroMod);
+			}
+
+			if (RuleI(Aggro, MeleeRangeAggroMod) != 0) {
+				if (center->CombatRange(m)) {
+					aggro_mod += RuleI(Aggro, MeleeRangeAggroMod);
+				}
+			}
+		}
+	}
+
+	if (m->GetMaxHP() != 0 && ((m->GetHP() * 100 / m->GetMaxHP()) < 20)) {
+		aggro_mod += RuleI(Aggro, CriticallyWoundedAggroMod);
+	}
+
+	if (aggro_mod) {
+		current_hate += (current_hate * aggro_mod / 100);
+	}
+
+	return current_hate;
+}
+
+/*
+	Smart aggro selection driven by the hate index instead of a full scan.
+
+	Entries are walked from highest stored hate down. The aggro mods can only raise hate by at
+	most the sum of the positive mod rules, so once an entry's best possible modified hate falls
+	below the best found so far nothing further down the heap can win and the walk stops, usually
+	after a handful of entries. Ties resolve to the oldest entry like the list scan does.
+
+	Frenzied entries, negative mod rules and results of 1 hate or less (where Sanctuary, Divine
+	Aura and mez fallbacks depend on list order) are left to the list scan, resolved is false then.
+*/
+Mob *HateList::GetSmartAggroTopIndexed(
+	Mob *center,
+	Mob *skip,
+	bool skip_mezzed,
+	EntityFilterType filter_type,
+	bool &resolved
+)
+{
+	resolved = false;
+
+	const int sitting_mod = RuleI(Aggro, SittingAggroMod);
+	const int target_mod  = RuleI(Aggro, CurrentTargetAggroMod);
+	const int melee_mod   = RuleI(Aggro, MeleeRangeAggroMod);
+	const int wounded_mod = RuleI(Aggro, CriticallyWoundedAggroMod);
+
+	if (index.FrenzyCount() > 0 || sitting_mod < 0 || target_mod < 0 || melee_mod < 0 || wounded_mod < 0) {
+		return nullptr;
+	}
+
+	const int64 max_mod = sitting_mod + target_mod + melee_mod + wounded_mod;
+
+	auto is_candidate = [&](Mob *m) {
+		return (
+			m &&
+			m != skip &&
+			!(skip_mezzed && m->IsMezzed()) &&
+			!(filter_type == EntityFilterType::Bots && !m->IsBot()) &&
+			!(filter_type == EntityFilterType::Clients && !m->IsClient()) &&
+			!(filter_type == EntityFilterType::NPCs && !m->IsNPC()) &&
+			!m->Sanctuary() &&
+			!m->DivineAura() &&
+			!m->IsMezzed() &&
+			!m->IsFeared()
+		);
+	};
+
+	struct_HateList *top_entry                = nullptr;
+	int64           top_hate                  = -1;
+	Mob             *top_client_type_in_range = nullptr;
+
+	index.VisitByHate(
+		[&](struct_HateList *e) {
+			if (!is_candidate(e->entity_on_hatelist)) {
+				return true;
+			}
+
+			const int64 stored = e->stored_hate_amount;
+			if (stored < 0 || (top_entry && stored + stored * max_mod / 100 < top_hate)) {
+				return false;
+			}
+
+			bool  in_melee_range = false;
+			int64 current_hate   = GetSmartAggroHate(center, e, in_melee_range);
+
+			if (in_melee_range && !top_client_type_in_range) {
+				top_client_type_in_range = e->entity_on_hatelist;
+			}
+
+			if (current_hate > top_hate || (current_hate == top_hate && e->sequence < top_entry->sequence)) {
+				top_entry = e;
+				top_hate  = current_hate;
+			}
+
+			return true;
+		}
+	);
+
+	if (!top_entry || top_hate <= 1) {
+		return nullptr;
+	}
+
+	resolved = true;
+
+	Mob *top = top_entry->entity_on_hatelist;
+	if (
+		top->IsClient() ||
+		top->IsBot() ||
+		top->IsMerc() ||
+		top->GetSpecialAbility(SpecialAbility::AllowedToTank)
+	) {
+		return top;
+	}
+
+	// the walk above may have stopped before reaching a client in melee range, finish it
+	if (!top_client_type_in_range && melee_mod != 0) {
+		index.VisitByHate(
+			[&](struct_HateList *e) {
+				if (!is_candidate(e->entity_on_hatelist)) {
+					return true;
+				}
+
+				if (e->stored_hate_amount < 0) {
+					return false;
+				}
+
+				Mob *m = e->entity_on_hatelist;
+				if (m->IsOfClientBot() && center->CombatRange(m)) {
+					top_client_type_in_range = m;
+					return false;
+				}
+
+				return true;
+			}
+		);
+	}
+
+	return top_client_type_in_range ? top_client_type_in_range : top;
+}
+
 // skip is used to ignore a certain mob on the list
 // Currently used for getting 2nd on list for aggro meter
 Mob *HateList::GetMobWithMostHateOnList(
@@ -366,14 +553,19 @@ Mob *HateList::GetMobWithMostHateOnList(
 	}
 
 	if (RuleB(Aggro, SmartAggroList)) {
+		bool resolved = false;
+		Mob  *indexed = GetSmartAggroTopIndexed(center, skip, skip_mezzed, filter_type, resolved);
+		if (resolved) {
+			return indexed;
+		}
+
 		Mob   *top_client_type_in_range = nullptr;
 		int64 hate_client_type_in_range = -1;
 		int   skipped_count             = 0;
 
 		auto iterator = list.begin();
 		while (iterator != list.end()) {
-			struct_HateList *cur      = (*iterator);
-			int16           aggro_mod = 0;
+			struct_HateList *cur = (*iterator);
 
 			if (!cur) {
 				++iterator;
@@ -426,49 +618,14 @@ Mob *HateList::GetMobWithMostHateOnList(
 				continue;
 			}
 
-			int64 current_hate = cur->stored_hate_amount;
+			bool  in_melee_range = false;
+			int64 current_hate   = GetSmartAggroHate(center, cur, in_melee_range);
 
-			if (m->IsOfClientBot()) {
-				if (m->IsClient() && m->CastToClient()->IsSitting()) {
-					aggro_mod += RuleI(Aggro, SittingAggroMod);
+			if (in_melee_range) {
+				if (cur->stored_hate_amount > hate_client_type_in_range || cur->is_entity_frenzy) {
+					hate_client_type_in_range = cur->stored_hate_amount;
+					top_client_type_in_range  = m;
 				}
-
-				if (center) {
-					if (center->GetTarget() == m) {
-						aggro_mod += RuleI(Aggro, CurrentTargetAggroMod);
-					}
-
-					if (RuleI(Aggro, MeleeRangeAggroMod) != 0) {
-						if (center->CombatRange(m)) {
-							aggro_mod += RuleI(Aggro, MeleeRangeAggroMod);
-
-							if (current_hate > hate_client_type_in_range || cur->is_entity_frenzy) {
-								hate_client_type_in_range = current_hate;
-								top_client_type_in_range  = m;
-							}
-						}
-					}
-				}
-			} else {
-				if (center) {
-					if (center->GetTarget() == m) {
-						aggro_mod += RuleI(Aggro, CurrentTargetAggroMod);
-					}
-
-					if (RuleI(Aggro, MeleeRangeAggroMod) != 0) {
-						if (center->CombatRange(m)) {
-							aggro_mod += RuleI(Aggro, MeleeRangeAggroMod);
-						}
-					}
-				}
-			}
-
-			if (m->GetMaxHP() != 0 && ((m->GetHP() * 100 / m->GetMaxHP()) < 20)) {
-				aggro_mod += RuleI(Aggro, CriticallyWoundedAggroMod);
-			}
-
-			if (aggro_mod) {
-				current_hate += (current_hate * aggro_mod / 100);
 			}
 
 			if (current_hate > hate || cur->is_entity_frenzy) {
@@ -515,6 +672,26 @@ Mob *HateList::GetMobWithMostHateOnList(
 			return top_hate ? top_hate : nullptr;
 		}
 	} else {
+		// without frenzied entries the first usable entry in hate order is the answer
+		if (index.FrenzyCount() == 0) {
+			index.VisitByHate(
+				[&](struct_HateList *e) {
+					Mob *m = e->entity_on_hatelist;
+					if (!m || m == skip || (skip_mezzed && m->IsMezzed())) {
+						return true;
+					}
+
+					if (e->stored_hate_amount > hate) {
+						top_hate = m;
+					}
+
+					return false;
+				}
+			);
+
+			return top_hate;
+		}
+
 		auto iterator      = list.begin();
 		int  skipped_count = 0;
 		while (iterator != list.end()) {
@@ -557,37 +734,28 @@ Mob *HateList::GetMobWithMostHateOnList(
 
 Mob *HateList::GetMobWithMostHateOnList(bool skip_mezzed){
 	Mob* top = nullptr;
-	int64 hate = -1;
 
-	auto iterator = list.begin();
-	while (iterator != list.end())
-	{
-		struct_HateList *cur = (*iterator);
-
-		if (cur) {
-			LogHateDetail(
-				"Looping GetMobWithMostHateOnList1 [{}] cur [{}] hate [{}] calc [{}]",
-				cur->entity_on_hatelist->GetMobDescription(),
-				cur->stored_hate_amount,
-				hate,
-				(cur->stored_hate_amount > hate)
-			);
+	// frenzy is not considered here, the highest hate entry that is not skipped wins
+	index.VisitByHate(
+		[&](struct_HateList *e) {
+			if (!e->entity_on_hatelist || (skip_mezzed && e->entity_on_hatelist->IsMezzed())) {
+				return true;
+			}
 
-			if (cur->entity_on_hatelist != nullptr && (cur->stored_hate_amount > hate))
-			{
+			if (e->stored_hate_amount > -1) {
 				LogHateDetail(
-					"Looping GetMobWithMostHateOnList2 [{}]",
-					cur->entity_on_hatelist->GetMobDescription()
+					"GetMobWithMostHateOnList [{}] hate [{}]",
+					e->entity_on_hatelist->GetMobDescription(),
+					e->stored_hate_amount
 				);
 
-				if (!skip_mezzed || !cur->entity_on_hatelist->IsMezzed()) {
-					top = cur->entity_on_hatelist;
-					hate = cur->stored_hate_amount;
-				}
+				top = e->entity_on_hatelist;
 			}
+
+			return false;
 		}
-		++iterator;
-	}
+	);
+
 	return top;
 }
 
@@ -889,8 +1057,7 @@ void HateList::RemoveStaleEntries(int time_ms, float dist)
 					m->CastToClient()->RemoveXTarget(hate_owner, true);
 				}
 
-				delete (*it);
-				it = list.erase(it);
+				it = EraseEntry(it);
 				continue;
 			}
 		}
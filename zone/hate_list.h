@@ -20,12 +20,16 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #define HATELIST_H
 
 #include "../common/emu_constants.h"
+#include "hate_list_index.h"
+
+#include <list>
 
 class Client;
 class Group;
 class Mob;
 class Raid;
 struct ExtraAttackOptions;
+class HateList;
 
 struct struct_HateList {
 	Mob    *entity_on_hatelist;
@@ -34,6 +38,9 @@ struct struct_HateList {
 	bool   is_entity_frenzy;
 	int8   oor_count; // count on how long we've been out of range
 	uint32 last_modified; // we need to remove this if it gets higher than 10 mins
+	HateList *owner;  // set while on a list, script setters go through it to keep the index current
+	uint32 heap_index;
+	uint32 sequence;
 };
 
 enum class HateListCountType {
@@ -95,12 +102,21 @@ public:
 	void WipeHateList(bool npc_only = false);
 	void RemoveStaleEntries(int time_ms, float dist);
 
+	// used by the script bindings, changes an entry in place and keeps the index in sync
+	void SetEntryEntity(struct_HateList *entry, Mob *m);
+	void SetEntryHate(struct_HateList *entry, int64 in_hate);
+	void SetEntryFrenzy(struct_HateList *entry, bool in_is_frenzied);
 
 protected:
 	struct_HateList* Find(Mob* m);
 private:
-	std::list<struct_HateList *> list;
-	Mob                          *hate_owner;
+	std::list<struct_HateList *>::iterator EraseEntry(std::list<struct_HateList *>::iterator it);
+	int64 GetSmartAggroHate(Mob *center, struct_HateList *e, bool &client_in_melee_range);
+	Mob *GetSmartAggroTopIndexed(Mob *center, Mob *skip, bool skip_mezzed, EntityFilterType filter_type, bool &resolved);
+
+	std::list<struct_HateList *>    list;
+	HateListIndex<struct_HateList> index;
+	Mob                             *hate_owner;
 };
 
 #endif
@@ -0,0 +1,245 @@
+#ifndef EQEMU_HATE_LIST_INDEX_H
+#define EQEMU_HATE_LIST_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+	Intrusive index over the entries of a hate list.
+
+	Entries are kept in a binary max heap ordered by stored hate, ties going to the entry that
+	was added first, so Top() is the same entry a front to back scan of the list for the highest
+	hate would settle on. Each entry carries its own heap slot (heap_index) and insertion order
+	(sequence), which is what makes updates O(log n) without a search.
+
+	The entity map answers Find() in O(1). Scripts can point an entry at a mob that is already
+	on the list, in that case the map holds the oldest entry for the mob, matching what a list
+	scan would return.
+*/
+template<typename Entry>
+class HateListIndex {
+public:
+	using Key = decltype(Entry::entity_on_hatelist);
+
+	size_t Size() const { return m_heap.size(); }
+	bool Empty() const { return m_heap.empty(); }
+	int FrenzyCount() const { return m_frenzy_count; }
+
+	void Clear()
+	{
+		m_heap.clear();
+		m_entities.clear();
+		m_frenzy_count = 0;
+		m_aliased      = false;
+	}
+
+	void Insert(Entry *e)
+	{
+		e->sequence   = m_next_sequence++;
+		e->heap_index = static_cast<uint32_t>(m_heap.size());
+		m_heap.push_back(e);
+		SiftUp(e->heap_index);
+
+		if (e->is_entity_frenzy) {
+			m_frenzy_count++;
+		}
+
+		MapKey(e);
+	}
+
+	void Remove(Entry *e)
+	{
+		uint32_t index = e->heap_index;
+		uint32_t last  = static_cast<uint32_t>(m_heap.size() - 1);
+		if (index != last) {
+			Swap(index, last);
+			m_heap.pop_back();
+			Fix(index);
+		} else {
+			m_heap.pop_back();
+		}
+
+		if (e->is_entity_frenzy) {
+			m_frenzy_count--;
+		}
+
+		UnmapKey(e);
+	}
+
+	Entry *Find(Key key) const
+	{
+		if (!key) {
+			return nullptr;
+		}
+
+		auto it = m_entities.find(key);
+		return it != m_entities.end() ? it->second : nullptr;
+	}
+
+	// call after changing stored_hate_amount on an indexed entry
+	void Update(Entry *e) { Fix(e->heap_index); }
+
+	void SetKey(Entry *e, Key key)
+	{
+		UnmapKey(e);
+		e->entity_on_hatelist = key;
+		MapKey(e);
+	}
+
+	void SetFrenzy(Entry *e, bool is_frenzy)
+	{
+		if (e->is_entity_frenzy != is_frenzy) {
+			m_frenzy_count += is_frenzy ? 1 : -1;
+		}
+
+		e->is_entity_frenzy = is_frenzy;
+	}
+
+	Entry *Top() const { return m_heap.empty() ? nullptr : m_heap.front(); }
+
+	/*
+		Visits entries from highest to lowest hate (oldest first on ties) until f returns false.
+		Only the part of the heap that is actually walked is touched, so stopping after k entries
+		costs O(k log k) regardless of the list size.
+	*/
+	template<typename F>
+	void VisitByHate(F f) const
+	{
+		if (m_heap.empty()) {
+			return;
+		}
+
+		std::vector<uint32_t> frontier;
+		frontier.reserve(16);
+		frontier.push_back(0);
+
+		auto after = [this](uint32_t a, uint32_t b) { return Before(m_heap[b], m_heap[a]); };
+		while (!frontier.empty()) {
+			std::pop_heap(frontier.begin(), frontier.end(), after);
+			uint32_t index = frontier.back();
+			frontier.pop_back();
+
+			if (!f(m_heap[index])) {
+				return;
+			}
+
+			for (uint32_t child = index * 2 + 1; child <= index * 2 + 2 && child < m_heap.size(); ++child) {
+				frontier.push_back(child);
+				std::push_heap(frontier.begin(), frontier.end(), after);
+			}
+		}
+	}
+
+private:
+	static bool Before(const Entry *a, const Entry *b)
+	{
+		if (a->stored_hate_amount != b->stored_hate_amount) {
+			return a->stored_hate_amount > b->stored_hate_amount;
+		}
+
+		return a->sequence < b->sequence;
+	}
+
+	void Swap(uint32_t a, uint32_t b)
+	{
+		std::swap(m_heap[a], m_heap[b]);
+		m_heap[a]->heap_index = a;
+		m_heap[b]->heap_index = b;
+	}
+
+	void Fix(uint32_t index)
+	{
+		if (index > 0 && Before(m_heap[index], m_heap[(index - 1) / 2])) {
+			SiftUp(index);
+		} else {
+			SiftDown(index);
+		}
+	}
+
+	void SiftUp(uint32_t index)
+	{
+		while (index > 0) {
+			uint32_t parent = (index - 1) / 2;
+			if (!Before(m_heap[index], m_heap[parent])) {
+				break;
+			}
+
+			Swap(index, parent);
+			index = parent;
+		}
+	}
+
+	void SiftDown(uint32_t index)
+	{
+		uint32_t size = static_cast<uint32_t>(m_heap.size());
+		for (;;) {
+			uint32_t best  = index;
+			uint32_t left  = index * 2 + 1;
+			uint32_t right = left + 1;
+			if (left < size && Before(m_heap[left], m_heap[best])) {
+				best = left;
+			}
+
+			if (right < size && Before(m_heap[right], m_heap[best])) {
+				best = right;
+			}
+
+			if (best == index) {
+				break;
+			}
+
+			Swap(index, best);
+			index = best;
+		}
+	}
+
+	void MapKey(Entry *e)
+	{
+		if (!e->entity_on_hatelist) {
+			return;
+		}
+
+		auto r = m_entities.emplace(e->entity_on_hatelist, e);
+		if (!r.second) {
+			m_aliased = true;
+			if (e->sequence < r.first->second->sequence) {
+				r.first->second = e;
+			}
+		}
+	}
+
+	void UnmapKey(Entry *e)
+	{
+		if (!e->entity_on_hatelist) {
+			return;
+		}
+
+		auto it = m_entities.find(e->entity_on_hatelist);
+		if (it == m_entities.end() || it->second != e) {
+			return;
+		}
+
+		m_entities.erase(it);
+		if (!m_aliased) {
+			return;
+		}
+
+		// another entry may be pointing at the same mob, hand the key to the oldest of them
+		for (auto h : m_heap) {
+			if (h != e && h->entity_on_hatelist == e->entity_on_hatelist) {
+				MapKey(h);
+			}
+		}
+	}
+
+	std::vector<Entry *>             m_heap;
+	std::unordered_map<Key, Entry *> m_entities;
+	uint32_t                         m_next_sequence = 0;
+	int                              m_frenzy_count  = 0;
+	bool                             m_aliased       = false;
+};
+
+#endif //EQEMU_HATE_LIST_INDEX_H
@@ -0,0 +1,49 @@
+#ifndef EQEMU_HATE_LIST_INDEX_REFERENCE_H
+#define EQEMU_HATE_LIST_INDEX_REFERENCE_H
+
+#include <list>
+#include "hate_list_index.h"
+
+/*
+	The top hate lookup two ways, for checking and timing the index against the list it replaced.
+	Both skip entries without a mob and settle ties on the entry added first.
+*/
+
+// the list scan HateList::GetMobWithMostHateOnList used before the index
+template<typename Entry>
+Entry *HateListScanTop(const std::list<Entry *> &l)
+{
+	Entry   *top = nullptr;
+	int64_t hate = -1;
+	for (auto e : l) {
+		if (e->entity_on_hatelist && e->stored_hate_amount > hate) {
+			top  = e;
+			hate = e->stored_hate_amount;
+		}
+	}
+
+	return top;
+}
+
+template<typename Entry>
+Entry *HateListIndexTop(const HateListIndex<Entry> &index)
+{
+	Entry *top = nullptr;
+	index.VisitByHate(
+		[&](Entry *e) {
+			if (!e->entity_on_hatelist) {
+				return true;
+			}
+
+			if (e->stored_hate_amount > -1) {
+				top = e;
+			}
+
+			return false;
+		}
+	);
+
+	return top;
+}
+
+#endif
@@ -14,7 +14,11 @@ Lua_Mob Lua_HateEntry::GetEnt() {
 
 void Lua_HateEntry::SetEnt(Lua_Mob e) {
 	Lua_Safe_Call_Void();
-	self->entity_on_hatelist = e;
+	if (self->owner) {
+		self->owner->SetEntryEntity(self, e);
+	} else {
+		self->entity_on_hatelist = e;
+	}
 }
 
 int64 Lua_HateEntry::GetDamage() {
@@ -34,7 +38,11 @@ int64 Lua_HateEntry::GetHate() {
 
 void Lua_HateEntry::SetHate(int64 value) {
 	Lua_Safe_Call_Void();
-	self->stored_hate_amount = value;
+	if (self->owner) {
+		self->owner->SetEntryHate(self, value);
+	} else {
+		self->stored_hate_amount = value;
+	}
 }
 
 bool Lua_HateEntry::GetFrenzy() {
@@ -44,7 +52,11 @@ bool Lua_HateEntry::GetFrenzy() {
 
 void Lua_HateEntry::SetFrenzy(bool value) {
 	Lua_Safe_Call_Void();
-	self->is_entity_frenzy = value;
+	if (self->owner) {
+		self->owner->SetEntryFrenzy(self, value);
+	} else {
+		self->is_entity_frenzy = value;
+	}
 }
 
 luabind::scope lua_register_hate_entry() {
@@ -90,6 +90,9 @@ extern volatile bool is_zone_loaded;
 #include "../common/skill_caps.h"
 #include "zone_event_scheduler.h"
 #include "zone_cli.h"
+#include "tick_profiler.h"
+#include "character_save_queue.h"
+#include "zone_boot_pipeline.h"
 
 EntityList  entity_list;
 WorldServer worldserver;
@@ -298,6 +301,16 @@ int main(int argc, char **argv)
 		EQ::InitializeDynamicLookups();
 	}
 
+	if (RuleB(Character, WriteBehindSaves)) {
+		CharacterSaveQueue::Get().Start(
+			Config->DatabaseHost,
+			Config->DatabaseUsername,
+			Config->DatabasePassword,
+			Config->DatabaseDB,
+			Config->DatabasePort
+		);
+	}
+
 	// command handler (no sidecar or test commands)
 	if (ZoneCLI::RanConsoleCommand(argc, argv) && !(ZoneCLI::RanSidecarCommand(argc, argv) || ZoneCLI::RanTestCommand(argc, argv))) {
 		LogSys.EnableConsoleLogging();
@@ -393,6 +406,8 @@ int main(int argc, char **argv)
 		return 1;
 	}
 
+	Mob::LoadBuffTicSpells();
+
 
 	guild_mgr.LoadGuilds();
 	content_db.LoadFactionData();
@@ -540,6 +555,9 @@ int main(int argc, char **argv)
 	std::unique_ptr<EQ::Net::WebsocketServer>          ws_server;
 
 	auto loop_fn = [&](EQ::Timer *t) {
+		auto &tick_profiler = TickProfiler::Get();
+		tick_profiler.BeginTick();
+
 		//Advance the timer to our current point in time
 		Timer::SetCurrentTime();
 
@@ -572,6 +590,7 @@ int main(int argc, char **argv)
 			opts.daybreak_options.resend_delay_min    = RuleI(Network, ResendDelayMinMS);
 			opts.daybreak_options.resend_delay_max    = RuleI(Network, ResendDelayMaxMS);
 			opts.daybreak_options.outgoing_data_rate  = RuleR(Network, ClientDataRate);
+			opts.daybreak_options.batched_io          = RuleB(Network, BatchedUDPIO);
 			eqsm      = std::make_unique<EQ::Net::EQStreamManager>(opts);
 			eqsf_open = true;
 
@@ -588,6 +607,7 @@ int main(int argc, char **argv)
 		}
 
 		//give the stream identifier a chance to do its work....
+		tick_profiler.Enter(TickProfiler::PhaseStreams);
 		stream_identifier.Process();
 
 		//check the stream identifier for any now-identified streams
@@ -620,23 +640,36 @@ int main(int argc, char **argv)
 		}
 
 		if (WorldserverProcess.Check()) {
+			tick_profiler.Enter(TickProfiler::PhaseWorldServer);
 			worldserver.Process();
 		}
 
 		if (is_zone_loaded) {
 			{
+				tick_profiler.Enter(TickProfiler::PhaseGroup);
 				entity_list.GroupProcess();
+				tick_profiler.Enter(TickProfiler::PhaseDoor);
 				entity_list.DoorProcess();
+				tick_profiler.Enter(TickProfiler::PhaseObject);
 				entity_list.ObjectProcess();
+				tick_profiler.Enter(TickProfiler::PhaseCorpse);
 				entity_list.CorpseProcess();
+				tick_profiler.Enter(TickProfiler::PhaseTrap);
 				entity_list.TrapProcess();
+				tick_profiler.Enter(TickProfiler::PhaseRaid);
 				entity_list.RaidProcess();
+				tick_profiler.Enter(TickProfiler::PhaseEntity);
 				entity_list.Process();
+				tick_profiler.Enter(TickProfiler::PhaseMob);
 				entity_list.MobProcess();
+				tick_profiler.Enter(TickProfiler::PhaseBeacon);
 				entity_list.BeaconProcess();
+				tick_profiler.Enter(TickProfiler::PhaseEncounter);
 				entity_list.EncounterProcess();
+				tick_profiler.Enter(TickProfiler::PhaseEventScheduler);
 				event_scheduler.Process(zone, &content_service);
 
+				tick_profiler.Enter(TickProfiler::PhaseZone);
 				if (zone) {
 					if (!zone->Process()) {
 						zone->Shutdown();
@@ -644,11 +677,13 @@ int main(int argc, char **argv)
 				}
 
 				if (quest_timers.Check()) {
+					tick_profiler.Enter(TickProfiler::PhaseQuest);
 					quest_manager.Process();
 				}
 			}
 		}
 
+		tick_profiler.Enter(TickProfiler::PhaseOther);
 		QServ->CheckForConnectState();
 
 		if (InterserverTimer.Check()) {
@@ -660,6 +695,8 @@ int main(int argc, char **argv)
 				entity_list.UpdateWho();
 			}
 		}
+
+		tick_profiler.EndTick();
 	};
 
 	EQ::Timer process_timer(loop_fn);
@@ -682,6 +719,10 @@ int main(int argc, char **argv)
 		zone->SetSaveZoneState(false);
 		zone->Shutdown(true);
 	}
+
+	// every client has been saved by now, don't exit with any of those saves still queued
+	CharacterSaveQueue::Get().Stop();
+	ZoneBootPipeline::CloseConnections();
 	//Fix for Linux world server problem.
 	safe_delete(task_manager);
 	safe_delete(npc_scale_manager);
@@ -5,6 +5,7 @@
 #include "client.h"
 #include "map.h"
 #include "raycast_mesh.h"
+#include "raycast_bvh.h"
 #include "zone.h"
 #include "../common/file.h"
 #include "../common/memory/ksm.hpp"
@@ -18,19 +19,72 @@
 struct Map::impl
 {
 	RaycastMesh *rm;
+	FILE        *record_file      = nullptr;
+	uint32      record_remaining = 0;
+
+	void Record(const char *type, const glm::vec3 &a, const glm::vec3 *b = nullptr)
+	{
+		if (!record_file) {
+			return;
+		}
+
+		if (b) {
+			fprintf(record_file, "%s %.3f %.3f %.3f %.3f %.3f %.3f\n", type, a.x, a.y, a.z, b->x, b->y, b->z);
+		} else {
+			fprintf(record_file, "%s %.3f %.3f %.3f\n", type, a.x, a.y, a.z);
+		}
+
+		if (--record_remaining == 0) {
+			fclose(record_file);
+			record_file = nullptr;
+		}
+	}
 };
 
-Map::Map() {
-	imp = nullptr;
+static RaycastMesh *CreateRaycast(bool use_bvh, RmUint32 vcount, const RmReal *vertices, RmUint32 tcount, const RmUint32 *indices)
+{
+	if (use_bvh) {
+		return createRaycastBVH(vcount, vertices, tcount, indices);
+	}
+
+	return createRaycastMesh(vcount, vertices, tcount, indices);
+}
+
+Map::Map() : Map(RuleB(Map, UseBVHRaycast)) {
+}
+
+Map::Map(bool use_bvh) {
+	imp       = nullptr;
+	m_use_bvh = use_bvh;
 }
 
 Map::~Map() {
 	if(imp) {
+		if (imp->record_file) {
+			fclose(imp->record_file);
+		}
+
 		imp->rm->release();
 		safe_delete(imp);
 	}
 }
 
+void Map::RecordQueries(const std::string &file, uint32 count) {
+	if (!imp || count == 0) {
+		return;
+	}
+
+	if (imp->record_file) {
+		fclose(imp->record_file);
+	}
+
+	imp->record_file      = fopen(file.c_str(), "a");
+	imp->record_remaining = count;
+	if (imp->record_file) {
+		LogInfo("Recording [{}] raycast queries to [{}]", count, file);
+	}
+}
+
 float Map::FindBestZ(glm::vec3 &start, glm::vec3 *result) const {
 	if (!imp) {
 		return BEST_Z_INVALID;
@@ -41,6 +95,8 @@ float Map::FindBestZ(glm::vec3 &start, glm::vec3 *result) const {
 		result = &tmp;
 	}
 
+	imp->Record("bestz", start);
+
 	start.z += RuleI(Map, FindBestZHeightAdjust);
 	glm::vec3 from(start.x, start.y, start.z);
 	glm::vec3 to(start.x, start.y, BEST_Z_INVALID);
@@ -48,7 +104,7 @@ float Map::FindBestZ(glm::vec3 &start, glm::vec3 *result) const {
 	bool hit = false;
 
 	hit = imp->rm->raycast((const RmReal*)&from, (const RmReal*)&to, (RmReal*)result, nullptr, &hit_distance);
-	if (hit && zone->newzone_data.underworld != 0.0f && result->z < zone->newzone_data.underworld) {
+	if (hit && zone && zone->newzone_data.underworld != 0.0f && result->z < zone->newzone_data.underworld) {
 		hit = false;
 	}
 
@@ -59,7 +115,7 @@ float Map::FindBestZ(glm::vec3 &start, glm::vec3 *result) const {
 	// Find nearest Z above us
 	to.z = -BEST_Z_INVALID;
 	hit = imp->rm->raycast((const RmReal*)&from, (const RmReal*)&to, (RmReal*)result, nullptr, &hit_distance);
-	if (zone->newzone_data.max_z != 0.0f && result->z > zone->newzone_data.max_z) {
+	if (zone && zone->newzone_data.max_z != 0.0f && result->z > zone->newzone_data.max_z) {
 		hit = false;
 	}
 
@@ -152,7 +208,7 @@ float Map::FindGround(glm::vec3 &start, glm::vec3 *result) const {
 	// Find nearest Z below us
 	hit = imp->rm->raycast((const RmReal*)&from, (const RmReal*)&to, (RmReal*)result, nullptr, &hit_distance);
 
-	if (hit && zone->newzone_data.underworld != 0.0f && result->z < zone->newzone_data.underworld) {
+	if (hit && zone && zone->newzone_data.underworld != 0.0f && result->z < zone->newzone_data.underworld) {
 		hit = false;
 	}
 
@@ -258,9 +314,82 @@ bool Map::CheckLoS(glm::vec3 myloc, glm::vec3 oloc) const {
 	if(!imp)
 		return false;
 
+	imp->Record("los", myloc, &oloc);
+
 	return !imp->rm->raycast((const RmReal*)&myloc, (const RmReal*)&oloc, nullptr, nullptr, nullptr);
 }
 
+void Map::CheckLoS(const glm::vec3 &myloc, const std::vector<glm::vec3> &targets, std::vector<bool> &results) const {
+	std::vector<glm::vec3> from(targets.size(), myloc);
+	CheckLoS(from, targets, results);
+}
+
+void Map::CheckLoS(const std::vector<glm::vec3> &from, const std::vector<glm::vec3> &to, std::vector<bool> &results) const {
+	results.assign(from.size(), false);
+	if (!imp || from.empty()) {
+		return;
+	}
+
+	for (size_t i = 0; i < from.size(); ++i) {
+		imp->Record("los", from[i], &to[i]);
+	}
+
+	std::vector<unsigned char> hits(from.size());
+	imp->rm->raycastBatch((RmUint32)from.size(), (const RmReal*)from.data(), (const RmReal*)to.data(), hits.data(), nullptr);
+
+	for (size_t i = 0; i < hits.size(); ++i) {
+		results[i] = !hits[i];
+	}
+}
+
+// same steps as FindBestZ, each pass casting every ray that still needs an answer in one batch
+void Map::FindBestZ(const std::vector<glm::vec3> &starts, std::vector<float> &results) const {
+	results.assign(starts.size(), BEST_Z_INVALID);
+	if (!imp || starts.empty()) {
+		return;
+	}
+
+	std::vector<glm::vec3> from;
+	std::vector<glm::vec3> to;
+	from.reserve(starts.size());
+	to.reserve(starts.size());
+	for (auto &start : starts) {
+		imp->Record("bestz", start);
+
+		from.emplace_back(start.x, start.y, start.z + RuleI(Map, FindBestZHeightAdjust));
+		to.emplace_back(start.x, start.y, BEST_Z_INVALID);
+	}
+
+	std::vector<unsigned char> hits(from.size());
+	std::vector<glm::vec3>     locations(from.size());
+	imp->rm->raycastBatch((RmUint32)from.size(), (const RmReal*)from.data(), (const RmReal*)to.data(), hits.data(), (RmReal*)locations.data());
+
+	// Find nearest Z above us for the ones that found nothing below
+	std::vector<size_t> misses;
+	for (size_t i = 0; i < hits.size(); ++i) {
+		if (hits[i] && !(zone && zone->newzone_data.underworld != 0.0f && locations[i].z < zone->newzone_data.underworld)) {
+			results[i] = locations[i].z;
+			continue;
+		}
+
+		from[misses.size()] = from[i];
+		to[misses.size()]   = glm::vec3(from[i].x, from[i].y, -BEST_Z_INVALID);
+		misses.push_back(i);
+	}
+
+	if (misses.empty()) {
+		return;
+	}
+
+	imp->rm->raycastBatch((RmUint32)misses.size(), (const RmReal*)from.data(), (const RmReal*)to.data(), hits.data(), (RmReal*)locations.data());
+
+	for (size_t i = 0; i < misses.size(); ++i) {
+		if (hits[i] && !(zone && zone->newzone_data.max_z != 0.0f && locations[i].z > zone->newzone_data.max_z)) {
+			results[misses[i]] = locations[i].z;
+		}
+	}
+}
+
 // returns true if a collision happens
 bool Map::DoCollisionCheck(glm::vec3 myloc, glm::vec3 oloc, glm::vec3 &outnorm, float &distance) const {
 	if(!imp)
@@ -277,6 +406,13 @@ Map *Map::LoadMapFile(std::string file) {
 
 	auto m = new Map();
 	if (m->Load(filename)) {
+		if (RuleI(Map, RecordRaycastQueries) > 0) {
+			m->RecordQueries(
+				fmt::format("{}/base/{}.raycast", path.GetMapsPath(), file),
+				RuleI(Map, RecordRaycastQueries)
+			);
+		}
+
 		return m;
 	}
 
@@ -412,7 +548,7 @@ bool Map::LoadV1(FILE *f) {
 		imp = new impl;
 	}
 
-	imp->rm = createRaycastMesh((RmUint32)verts.size(), (const RmReal*)&verts[0], face_count, &indices[0]);
+	imp->rm = CreateRaycast(m_use_bvh, (RmUint32)verts.size(), (const RmReal*)&verts[0], face_count, &indices[0]);
 
 	if(!imp->rm) {
 		delete imp;
@@ -943,7 +1079,7 @@ bool Map::LoadV2(FILE *f) {
 		imp = new impl;
 	}
 
-	imp->rm = createRaycastMesh((RmUint32)verts.size(), (const RmReal*)&verts[0], face_count, &indices[0]);
+	imp->rm = CreateRaycast(m_use_bvh, (RmUint32)verts.size(), (const RmReal*)&verts[0], face_count, &indices[0]);
 
 	if (!imp->rm) {
 		delete imp;
@@ -994,6 +1130,12 @@ inline void strip_map_extension(std::string& map_file_name)
 		map_file_name.erase(ext_off, strlen(".map"));
 }
 
+// the .mmf file_version records which raycast backend the buffer was serialized from
+enum : uint32 {
+	MMF_VERSION_AABB_TREE = 0,
+	MMF_VERSION_BVH       = 1
+};
+
 inline bool add_mmf_extension(std::string& mmf_file_name)
 {
 	if (mmf_file_name.empty())
@@ -1029,6 +1171,11 @@ bool Map::LoadMMF(const std::string& map_file_name, bool force_mmf_overwrite)
 		LogInfo("Failed to load Map MMF file: [{}] - f@file_version", mmf_file_name.c_str());
 		return false;
 	}
+	if (file_version != (m_use_bvh ? MMF_VERSION_BVH : MMF_VERSION_AABB_TREE)) {
+		fclose(f);
+		LogInfo("Failed to load Map MMF file: [{}] - built for the other raycast backend", mmf_file_name.c_str());
+		return false;
+	}
 
 	uint32 rm_buffer_size;
 	if (fread(&rm_buffer_size, sizeof(uint32), 1, f) != 1) {
@@ -1077,7 +1224,12 @@ bool Map::LoadMMF(const std::string& map_file_name, bool force_mmf_overwrite)
 	}
 
 	bool load_success = false;
-	imp->rm = loadRaycastMesh(rm_buffer, load_success);
+	if (m_use_bvh) {
+		imp->rm = loadRaycastBVH(rm_buffer, load_success);
+	}
+	else {
+		imp->rm = loadRaycastMesh(rm_buffer, load_success);
+	}
 	if (imp->rm && !load_success) {
 		imp->rm->release();
 		imp->rm = nullptr;
@@ -1107,15 +1259,25 @@ bool Map::SaveMMF(const std::string& map_file_name, bool force_mmf_overwrite)
 		return false;
 	}
 
+	uint32 file_version = m_use_bvh ? MMF_VERSION_BVH : MMF_VERSION_AABB_TREE;
+
+	// an existing file built for the other raycast backend is replaced
 	FILE* f = fopen(mmf_file_name.c_str(), "rb");
 	if (f) {
+		uint32 existing_version;
+		bool same_backend = fread(&existing_version, sizeof(uint32), 1, f) == 1 && existing_version == file_version;
 		fclose(f);
-		if (!force_mmf_overwrite)
+		if (same_backend && !force_mmf_overwrite)
 			return true;
 	}
 
 	std::vector<char> rm_buffer; // size set in MyRaycastMesh::serialize()
-	serializeRaycastMesh(imp->rm, rm_buffer);
+	if (m_use_bvh) {
+		serializeRaycastBVH(imp->rm, rm_buffer);
+	}
+	else {
+		serializeRaycastMesh(imp->rm, rm_buffer);
+	}
 	if (rm_buffer.empty()) {
 		LogInfo("Failed to save Map MMF file: [{}] - empty RaycastMesh buffer", mmf_file_name.c_str());
 		return false;
@@ -1138,7 +1300,6 @@ bool Map::SaveMMF(const std::string& map_file_name, bool force_mmf_overwrite)
 		return false;
 	}
 
-	uint32 file_version = 0;
 	if (fwrite(&file_version, sizeof(uint32), 1, f) != 1) {
 		fclose(f);
 		std::remove(mmf_file_name.c_str());
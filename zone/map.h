@@ -24,6 +24,7 @@
 
 #include "position.h"
 #include <stdio.h>
+#include <vector>
 
 #include "zone_config.h"
 
@@ -35,6 +36,7 @@ class Map
 {
 public:
 	Map();
+	explicit Map(bool use_bvh);
 	~Map();
 
 	float FindBestZ(glm::vec3 &start, glm::vec3 *result) const;
@@ -46,12 +48,20 @@ public:
 	bool CheckLoS(glm::vec3 myloc, glm::vec3 oloc) const;
 	bool DoCollisionCheck(glm::vec3 myloc, glm::vec3 oloc, glm::vec3 &outnorm, float &distance) const;
 
+	// batched forms for callers with many queries in hand, results[i] matches the single query for element i
+	void CheckLoS(const glm::vec3 &myloc, const std::vector<glm::vec3> &targets, std::vector<bool> &results) const;
+	void CheckLoS(const std::vector<glm::vec3> &from, const std::vector<glm::vec3> &to, std::vector<bool> &results) const;
+	void FindBestZ(const std::vector<glm::vec3> &starts, std::vector<float> &results) const;
+
 #ifdef USE_MAP_MMFS
 	bool Load(std::string filename, bool force_mmf_overwrite = false);
 #else
 	bool Load(const std::string& filename);
 #endif
 
+	// appends the next count CheckLoS / FindBestZ queries to file, for benchmark:raycast to replay
+	void RecordQueries(const std::string &file, uint32 count);
+
 	static Map *LoadMapFile(std::string file);
 private:
 	void RotateVertex(glm::vec3 &v, float rx, float ry, float rz);
@@ -67,6 +77,7 @@ private:
 
 	struct impl;
 	impl *imp;
+	bool m_use_bvh;
 };
 
 #endif
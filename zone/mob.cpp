@@ -24,6 +24,7 @@
 #include "../common/repositories/bot_data_repository.h"
 #include "../common/repositories/character_data_repository.h"
 
+#include "character_save_queue.h"
 #include "data_bucket.h"
 #include "quest_parser_collection.h"
 #include "string_ids.h"
@@ -3635,6 +3636,7 @@ void Mob::GMMove(float x, float y, float z, float heading, bool save_guard_spot)
 	m_Position.y = y;
 	m_Position.z = z;
 	SetHeading(heading);
+	entity_list.UpdateCloseGrid(this);
 	mMovementManager->SendCommandToClients(this, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeAny);
 
 	if (IsNPC() && save_guard_spot) {
@@ -3647,6 +3649,7 @@ void Mob::GMMove(const glm::vec4 &position, bool save_guard_spot) {
 	m_Position.y = position.y;
 	m_Position.z = position.z;
 	SetHeading(position.w);
+	entity_list.UpdateCloseGrid(this);
 	mMovementManager->SendCommandToClients(this, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeAny);
 
 	if (IsNPC() && save_guard_spot) {
@@ -4571,6 +4574,7 @@ void Mob::SetOwnerID(uint16 new_owner_id) {
 	}
 
 	ownerid = new_owner_id;
+	entity_list.WakeMob(GetID());
 
 	// if we're setting the owner ID to 0 and they're not either charmed or not-a-pet then
 	// they're a normal pet and should be despawned
@@ -4584,6 +4588,12 @@ void Mob::SetOwnerID(uint16 new_owner_id) {
 	}
 }
 
+void Mob::SetFollowID(uint32 id)
+{
+	follow_id = id;
+	entity_list.WakeMob(GetID());
+}
+
 // used in checking for behind (backstab) and checking in front (melee LoS)
 float Mob::MobAngle(Mob *other, float ourx, float oury) const {
 	if (!other || other == this)
@@ -8545,6 +8555,8 @@ void Mob::SetExtraHaste(int haste, bool need_to_save)
 
 			BotDataRepository::UpdateOne(database, e);
 		} else if (IsClient()) {
+			CharacterSaveQueue::Get().Wait(CastToClient()->CharacterID());
+
 			auto e = CharacterDataRepository::FindOne(database, CastToClient()->CharacterID());
 			if (!e.id) {
 				return;
@@ -8590,9 +8602,6 @@ bool Mob::HasBotAttackFlag(Mob* tar) {
 }
 
 
-const uint16 scan_close_mobs_timer_moving = 6000; // 6 seconds
-const uint16 scan_close_mobs_timer_idle = 60000; // 60 seconds
-
 // If the moving timer triggers, lets see if we are moving or idle to restart the appropriate dynamic timer
 void Mob::CheckScanCloseMobsMovingTimer()
 {
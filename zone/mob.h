@@ -208,6 +208,9 @@ public:
 	Timer                              m_see_close_mobs_timer;
 	Timer                              m_mob_check_moving_timer;
 
+	static constexpr uint16 scan_close_mobs_timer_moving = 6000;  // 6 seconds
+	static constexpr uint16 scan_close_mobs_timer_idle   = 60000; // 60 seconds
+
 	// Bot attack flag
 	Timer bot_attack_flag_timer;
 
@@ -421,6 +424,7 @@ public:
 	void CalcDestFromHeading(float heading, float distance, float MaxZDiff, float StartX, float StartY, float &dX, float &dY, float &dZ);
 	void BeamDirectional(uint16 spell_id, int16 resist_adjust);
 	void ConeDirectional(uint16 spell_id, int16 resist_adjust);
+	void DirectionalSpellOnTargets(uint16 spell_id, int16 resist_adjust, const std::vector<Mob *> &targets);
 	void ApplyHealthTransferDamage(Mob *caster, Mob *target, uint16 spell_id);
 	void ApplySpellEffectIllusion(int32 spell_id, Mob* caster, int buffslot, int base, int limit, int max);
 	void ApplyIllusionToCorpse(int32 spell_id, Corpse* new_corpse);
@@ -441,6 +445,9 @@ public:
 	//Buff
 	void BuffProcess();
 	virtual void DoBuffTic(const Buffs_Struct &buff, int slot, Mob* caster = nullptr);
+	bool HasBuffTicQuestSub(uint16 spell_id);
+	static void LoadBuffTicSpells(); // after spells are (re)loaded
+	static bool SpellHasBuffTic(uint16 spell_id);
 	void BuffFadeBySpellID(uint16 spell_id);
 	void BuffFadeBySpellIDAndCaster(uint16 spell_id, uint16 caster_id);
 	void BuffFadeByEffect(int effect_id, int slot_to_skip = -1);
@@ -675,7 +682,7 @@ public:
 	inline bool IsZoneController() const { return npctype_id == ZONE_CONTROLLER_NPC_ID; }
 	void SetNPCTypeID(uint32 npctypeid) { npctype_id = npctypeid; }
 	inline const glm::vec4& GetPosition() const { return m_Position; }
-	inline void SetPosition(const float x, const float y, const float z) { m_Position.x = x; m_Position.y = y; m_Position.z = z; }
+	inline void SetPosition(const float x, const float y, const float z) { m_Position.x = x; m_Position.y = y; m_Position.z = z; entity_list.UpdateCloseGrid(this); }
 	inline const float GetX() const { return m_Position.x; }
 	inline const float GetY() const { return m_Position.y; }
 	inline const float GetZ() const { return m_Position.z; }
@@ -797,6 +804,10 @@ public:
 	bool CheckLosFN(Mob* other);
 	bool CheckLosFN(float posX, float posY, float posZ, float mobSize);
 	static bool CheckLosFN(glm::vec3 posWatcher, float sizeWatcher, glm::vec3 posTarget, float sizeTarget);
+	// batched CheckLosFN, one Map::CheckLoS call for the whole set. targets carry their size in w
+	void CheckLosFN(const std::vector<Mob *> &others, std::vector<bool> &results);
+	void CheckLosFN(const std::vector<glm::vec4> &targets, std::vector<bool> &results);
+	static void CheckLosFN(const std::vector<Mob *> &watchers, Mob *other, std::vector<bool> &results);
 	virtual bool CheckWaterLoS(Mob* m);
 	bool CheckPositioningLosFN(Mob* other, float posX, float posY, float posZ);
 	bool CheckDoorLoSCheat(Mob* other); //door skipping checks for LoS
@@ -901,7 +912,7 @@ public:
 	virtual bool IsAttackAllowed(Mob *target, bool isSpellAttack = false);
 	bool IsTargeted() const { return (targeted > 0); }
 	inline void IsTargeted(int in_tar) { targeted += in_tar; if(targeted < 0) targeted = 0;}
-	void SetFollowID(uint32 id) { follow_id = id; }
+	void SetFollowID(uint32 id);
 	void SetFollowDistance(uint32 dist) { follow_dist = dist; }
 	void SetFollowCanRun(bool v) { follow_run = v; }
 	uint32 GetFollowID() const { return follow_id; }
@@ -1292,6 +1303,7 @@ public:
 	void SetLooting(uint16 val) { entity_id_being_looted = val; }
 
 	bool CheckWillAggro(Mob *mob);
+	bool CheckWillAggroExceptLoS(Mob *mob);
 	bool IsPetAggroExempt(Mob *pet_owner);
 
 	void InstillDoubt(Mob *who);
@@ -1645,6 +1657,9 @@ protected:
 	bool spawned;
 	void CalcSpellBonuses(StatBonuses* newbon);
 	virtual void CalcBonuses();
+	void CalcBuffBonuses(); // CalcBonuses for buff changes, reuses the item and AA folds while their inputs are unchanged
+	void UpdateAABonuses();
+	void ReplayCachedWeaponStance(const StatBonuses &b);
 	void TrySkillProc(Mob *on, EQ::skills::SkillType skill, uint16 ReuseTime, bool Success = false, uint16 hand = 0, bool IsDefensive = false); // hand if 0 means its a skill ability for proc rate checks, otherwise hand is passed.
 	bool PassLimitToSkill(EQ::skills::SkillType skill, int32 spell_id, int proc_type, int aa_id=0);
 	bool PassLimitClass(uint32 Classes_, uint16 Class_);
@@ -1918,6 +1933,15 @@ protected:
 	std::unordered_map<uint32, std::pair<uint32, uint32>> aa_ranks;
 	Timer aa_timers[aaTimerMax];
 
+	// AA fold from the last recalculation, only kept for mobs with ranks once a buff changed
+	struct AABonusCache {
+		StatBonuses bonuses;
+		uint8 level;
+		std::unordered_map<uint32, std::pair<uint32, uint32>> ranks;
+	};
+	std::unique_ptr<AABonusCache> m_aa_bonus_cache;
+	bool m_buff_bonus_recalc = false;
+
 	bool is_horse;
 
 	AuraMgr aura_mgr;
@@ -4,669 +4,713 @@
 #include "zone.h"
 #include "position.h"
 #include "water_map.h"
+#include "spatial_grid.h"
+#include "path_request_slot.h"
 #include "../common/eq_packet_structs.h"
 #include "../common/misc_functions.h"
 #include "../common/data_verification.h"
-
+#include "../common/event/task_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <vector>
-#include <deque>
-#include <map>
+#include <unordered_map>
 #include <stdlib.h>
 
 extern double frame_time;
 extern Zone   *zone;
 
-class IMovementCommand {
-public:
-	IMovementCommand() = default;
-	virtual ~IMovementCommand() = default;
-	virtual bool Process(MobMovementManager *mob_movement_manager, Mob *mob) = 0;
-	virtual bool Started() const = 0;
+enum MovementCommandType : uint8 {
+	MovementCommandRotateTo,
+	MovementCommandMoveTo,
+	MovementCommandSwimTo,
+	MovementCommandFlyTo,
+	MovementCommandTeleportTo,
+	MovementCommandStopMoving,
+	MovementCommandEvadeCombat
 };
 
-class RotateToCommand : public IMovementCommand {
-public:
-	RotateToCommand(double rotate_to, double dir, MobMovementMode mob_movement_mode)
+// One queued movement step, stored by value. Which fields are used depends on type:
+// moves use x, y, z and the progress fields, RotateTo keeps the heading in x and the turn direction in heading,
+// TeleportTo uses x, y, z and heading.
+struct MovementCommand {
+	MovementCommandType type;
+	MobMovementMode     mode;
+	bool                started;
+	uint16              resends;
+	int                 last_sent_speed;
+	double              x;
+	double              y;
+	double              z;
+	double              heading;
+	double              last_sent_time;
+	double              total_h_dist;
+	double              total_v_dist;
+	double              distance_moved_since_correction;
+
+	static MovementCommand Make(MovementCommandType type, double x = 0.0, double y = 0.0, double z = 0.0, double heading = 0.0, MobMovementMode mode = MovementRunning)
 	{
-		m_rotate_to      = rotate_to;
-		m_rotate_to_dir  = dir;
-		m_rotate_to_mode = mob_movement_mode;
-		m_started        = false;
+		MovementCommand cmd{};
+		cmd.type    = type;
+		cmd.mode    = mode;
+		cmd.x       = x;
+		cmd.y       = y;
+		cmd.z       = z;
+		cmd.heading = heading;
+		return cmd;
 	}
 
-	virtual ~RotateToCommand()
+	bool IsMove() const
 	{
-
+		return type == MovementCommandMoveTo || type == MovementCommandSwimTo || type == MovementCommandFlyTo;
 	}
+};
 
-	virtual bool Process(MobMovementManager *mob_movement_manager, Mob *mob)
-	{
-		if (!mob->IsAIControlled()) {
-			return true;
-		}
-
-		auto rotate_to_speed = m_rotate_to_mode == MovementRunning ? 200.0 : 16.0; //todo: get this from mob
-
-		auto from = FixHeading(mob->GetHeading());
-		auto to   = FixHeading(m_rotate_to);
-		auto diff = to - from;
-
-		while (diff < -256.0) {
-			diff += 512.0;
-		}
+// A mob's pending commands. Popping only advances Head, so a mob that paths over and over keeps reusing
+// the same storage. Generation changes whenever the queue is thrown away, which lets Process notice that
+// a command it is holding a copy of was cleared out from under it.
+struct MobMovementEntry {
+	std::vector<MovementCommand> Commands;
+	size_t                       Head       = 0;
+	uint32                       Generation = 0;
 
-		while (diff > 256) {
-			diff -= 512.0;
-		}
+	bool Empty() const { return Head == Commands.size(); }
+	size_t Size() const { return Commands.size() - Head; }
+	MovementCommand &Front() { return Commands[Head]; }
 
-		auto dist = std::abs(diff);
-
-		if (!m_started) {
-			m_started = true;
-			mob->turning = true;
-			mob->SetMoving(true);
-
-			if (dist > 15.0f && rotate_to_speed > 0.0 && rotate_to_speed <= 25.0) { //send basic rotation
-				mob_movement_manager->SendCommandToClients(
-					mob,
-					0.0,
-					0.0,
-					0.0,
-					m_rotate_to_dir * rotate_to_speed,
-					0,
-					ClientRangeClose
-				);
-			}
-		}
+	void Push(const MovementCommand &cmd) { Commands.push_back(cmd); }
 
-		auto td = rotate_to_speed * 19.0 * frame_time;
-
-		if (td >= dist) {
-			mob->SetHeading(to);
-			mob->SetMoving(false);
-			mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeCloseMedium);
-			mob->turning = false;
-			return true;
+	void PopFront()
+	{
+		if (++Head == Commands.size()) {
+			Commands.clear();
+			Head = 0;
 		}
-
-		from += td * m_rotate_to_dir;
-		mob->SetHeading(FixHeading(from));
-		return false;
 	}
 
-	virtual bool Started() const
+	void Clear()
 	{
-		return m_started;
+		Commands.clear();
+		Head = 0;
+		Generation++;
 	}
-
-private:
-	double          m_rotate_to;
-	double          m_rotate_to_dir;
-	MobMovementMode m_rotate_to_mode;
-	bool            m_started;
 };
 
-class MoveToCommand : public IMovementCommand {
-public:
-	MoveToCommand(float x, float y, float z, MobMovementMode mob_movement_mode)
-	{
-		m_distance_moved_since_correction = 0.0;
-		m_move_to_x                       = x;
-		m_move_to_y                       = y;
-		m_move_to_z                       = z;
-		m_move_to_mode                    = mob_movement_mode;
-		m_last_sent_time                  = 0.0;
-		m_last_sent_speed                 = 0;
-		m_started                         = false;
-		m_total_h_dist                    = 0.0;
-		m_total_v_dist                    = 0.0;
-	}
-
-	virtual ~MoveToCommand()
+struct MovementStats {
+	MovementStats()
 	{
-
+		LastResetTime     = static_cast<double>(Timer::GetCurrentTime()) / 1000.0;
+		TotalSent         = 0ULL;
+		TotalSentMovement = 0ULL;
+		TotalSentPosition = 0ULL;
+		TotalSentHeading  = 0ULL;
+		TotalEncoded      = 0ULL;
+		TickEncoded       = 0ULL;
+		LastTickEncoded   = 0ULL;
+		TotalCoalesced    = 0ULL;
 	}
 
-	virtual bool Process(MobMovementManager *mob_movement_manager, Mob *mob)
-	{
-		if (!mob->IsAIControlled()) {
-			return true;
-		}
-
-		//Send a movement packet when you start moving
-		double current_time  = static_cast<double>(Timer::GetCurrentTime()) / 1000.0;
-		int    current_speed = 0;
-
-		if (m_move_to_mode == MovementRunning) {
-			if (mob->IsFeared()) {
-				current_speed = mob->GetFearSpeed();
-			}
-			else {
-				current_speed = mob->GetRunspeed();
-			}
-		}
-		else {
-			current_speed = mob->GetWalkspeed();
-		}
-
-		if (!m_started) {
-			m_started = true;
-			//rotate to the point
-			mob->SetMoving(true);
-			mob->SetHeading(mob->CalculateHeadingToTarget(m_move_to_x, m_move_to_y));
-
-			m_last_sent_speed = current_speed;
-			m_last_sent_time  = current_time;
-			m_total_h_dist    = DistanceNoZ(mob->GetPosition(), glm::vec4(m_move_to_x, m_move_to_y, 0.0f, 0.0f));
-			m_total_v_dist    = m_move_to_z - mob->GetZ();
-			mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, current_speed, ClientRangeCloseMedium);
-		}
+	double   LastResetTime;
+	uint64_t TotalSent;
+	uint64_t TotalSentMovement;
+	uint64_t TotalSentPosition;
+	uint64_t TotalSentHeading;
+	uint64_t TotalEncoded;
+	uint64_t TickEncoded;
+	uint64_t LastTickEncoded;
+	uint64_t TotalCoalesced;
+};
 
-		//When speed changes
-		if (current_speed != m_last_sent_speed) {
-			if (RuleB(Map, FixZWhenPathing)) {
-				mob->FixZ();
-			}
+struct NavigateTo {
+	NavigateTo()
+	{
+		navigate_to_x       = 0.0;
+		navigate_to_y       = 0.0;
+		navigate_to_z       = 0.0;
+		navigate_to_heading = 0.0;
+		last_set_time       = 0.0;
+	}
 
-			m_distance_moved_since_correction = 0.0;
+	double navigate_to_x;
+	double navigate_to_y;
+	double navigate_to_z;
+	double navigate_to_heading;
+	double last_set_time;
+	PathRequestSlot path_request; // ground path search still running for this mob
+};
 
-			m_last_sent_speed = current_speed;
-			m_last_sent_time  = current_time;
-			mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, current_speed, ClientRangeCloseMedium);
-		}
+// A ground path search for one mob. Worker threads fill in the route, the movement tick after it
+// finishes turns it into commands, unless the mob has navigated somewhere else or stopped meanwhile.
+struct PathRequest {
+	uint32                                id;
+	Mob                                   *mob;
+	float                                 x;
+	float                                 y;
+	float                                 z;
+	MobMovementMode                       mode;
+	glm::vec3                             start;
+	PathfinderOptions                     opts;
+	std::chrono::steady_clock::time_point submitted;
+	IPathfinder::IPath                    route;
+	bool                                  partial;
+	bool                                  stuck;
+};
 
-		//If x seconds have passed without sending an update.
-		if (current_time - m_last_sent_time >= 5.0) {
-			if (RuleB(Map, FixZWhenPathing)) {
-				mob->FixZ();
-			}
+struct AsyncPathing {
+	std::unique_ptr<EQ::Event::TaskScheduler> Workers;
+	std::mutex                                Lock;
+	std::condition_variable                   Idle;
+	std::vector<PathRequest>                  Done;
+	std::vector<PathRequest>                  Finished;
+	uint32                                    InFlight = 0;
+	uint32                                    NextId   = 0;
+
+	uint64 Submitted      = 0;
+	uint64 Applied        = 0;
+	uint64 Discarded      = 0;
+	double TotalLatencyMs = 0.0;
+	double MaxLatencyMs   = 0.0;
+
+	void ClearStats()
+	{
+		Submitted      = 0;
+		Applied        = 0;
+		Discarded      = 0;
+		TotalLatencyMs = 0.0;
+		MaxLatencyMs   = 0.0;
+	}
+};
 
-			m_distance_moved_since_correction = 0.0;
+enum MovementStepResult : uint8 {
+	MovementStepAtTarget, // already standing on the node, nothing moved
+	MovementStepArrived,  // reached the node this tick
+	MovementStepMoving
+};
 
-			m_last_sent_speed = current_speed;
-			m_last_sent_time  = current_time;
-			mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, current_speed, ClientRangeCloseMedium);
-		}
+// the position update of MoveTo, SwimTo and FlyTo, shared by the batched pass and the single command path
+inline MovementStepResult StepToward(
+	float pos_x, float pos_y,
+	double to_x, double to_y, double to_z,
+	double total_h_dist, double total_v_dist, double distance_moved,
+	float &new_x, float &new_y, double &new_z
+)
+{
+	float  dx  = static_cast<float>(to_x) - pos_x;
+	float  dy  = static_cast<float>(to_y) - pos_y;
+	float  d2  = dx * dx + dy * dy;
+	double len = std::sqrt(d2);
+	if (len == 0) {
+		return MovementStepAtTarget;
+	}
+
+	if (distance_moved > len) {
+		new_x = static_cast<float>(to_x);
+		new_y = static_cast<float>(to_y);
+		new_z = to_z;
+		return MovementStepArrived;
+	}
+
+	float inv  = 1.0f / std::sqrt(d2);
+	float step = static_cast<float>(distance_moved);
+	new_x = pos_x + dx * inv * step;
+	new_y = pos_y + dy * inv * step;
+
+	len -= distance_moved;
+	double total_distance_traveled = total_h_dist - len;
+	double start_z                 = to_z - total_v_dist;
+	new_z = start_z + (total_v_dist * (total_distance_traveled / total_h_dist));
+	return MovementStepMoving;
+}
 
-		auto      &p  = mob->GetPosition();
-		glm::vec2 tar(m_move_to_x, m_move_to_y);
-		glm::vec2 pos(p.x, p.y);
-		double    len = glm::distance(pos, tar);
-		if (len == 0) {
-			return true;
+// Every mob mid-move this tick, one column per field so the position step runs as a single linear pass
+struct MovementStepBatch {
+	std::vector<uint32>  Slot;
+	std::vector<Mob *>   Mobs;
+	std::vector<uint32>  Generation;
+	std::vector<float>   PosX;
+	std::vector<float>   PosY;
+	std::vector<double>  ToX;
+	std::vector<double>  ToY;
+	std::vector<double>  ToZ;
+	std::vector<double>  TotalH;
+	std::vector<double>  TotalV;
+	std::vector<double>  Distance;
+	std::vector<uint8>   Result;
+	std::vector<float>   NewX;
+	std::vector<float>   NewY;
+	std::vector<double>  NewZ;
+
+	size_t Size() const { return Slot.size(); }
+
+	void Clear()
+	{
+		Slot.clear();
+		Mobs.clear();
+		Generation.clear();
+		PosX.clear();
+		PosY.clear();
+		ToX.clear();
+		ToY.clear();
+		ToZ.clear();
+		TotalH.clear();
+		TotalV.clear();
+		Distance.clear();
+	}
+
+	void Add(uint32 slot, Mob *mob, uint32 generation, const MovementCommand &cmd, double distance)
+	{
+		auto &p = mob->GetPosition();
+		Slot.push_back(slot);
+		Mobs.push_back(mob);
+		Generation.push_back(generation);
+		PosX.push_back(p.x);
+		PosY.push_back(p.y);
+		ToX.push_back(cmd.x);
+		ToY.push_back(cmd.y);
+		ToZ.push_back(cmd.z);
+		TotalH.push_back(cmd.total_h_dist);
+		TotalV.push_back(cmd.total_v_dist);
+		Distance.push_back(distance);
+	}
+
+	void Integrate()
+	{
+		size_t n = Size();
+		Result.resize(n);
+		NewX.resize(n);
+		NewY.resize(n);
+		NewZ.resize(n);
+		for (size_t i = 0; i < n; ++i) {
+			Result[i] = StepToward(PosX[i], PosY[i], ToX[i], ToY[i], ToZ[i], TotalH[i], TotalV[i], Distance[i], NewX[i], NewY[i], NewZ[i]);
 		}
+	}
+};
 
-		mob->SetMoved(true);
+void AdjustRoute(std::list<IPathfinder::IPathNode> &nodes, Mob *who)
+{
+	if (!zone->HasMap() || !zone->HasWaterMap()) {
+		return;
+	}
 
-		glm::vec2 dir            = tar - pos;
-		glm::vec2 ndir           = glm::normalize(dir);
-		double    distance_moved = frame_time * current_speed * 0.4f * 1.45f;
+	auto offset = who->GetZOffset();
 
-		if (distance_moved > len) {
-			if (mob->IsNPC()) {
-				entity_list.ProcessMove(mob->CastToNPC(), m_move_to_x, m_move_to_y, m_move_to_z);
+	for (auto &node : nodes) {
+		if (!zone->watermap->InLiquid(node.pos)) {
+			auto best_z = zone->zonemap->FindBestZ(node.pos, nullptr);
+			if (best_z != BEST_Z_INVALID) {
+				node.pos.z = best_z + offset;
 			}
+		} // todo: floating logic?
+	}
+}
 
-			mob->SetPosition(m_move_to_x, m_move_to_y, m_move_to_z);
+static bool ProcessRotateTo(MobMovementManager *mob_movement_manager, Mob *mob, MovementCommand &cmd)
+{
+	auto rotate_to_speed = cmd.mode == MovementRunning ? 200.0 : 16.0; //todo: get this from mob
 
-			if (RuleB(Map, FixZWhenPathing)) {
-				mob->FixZ();
-			}
-			return true;
-		}
-		else {
-			glm::vec2 npos = pos + (ndir * static_cast<float>(distance_moved));
+	auto from = FixHeading(mob->GetHeading());
+	auto to   = FixHeading(cmd.x);
+	auto diff = to - from;
 
-			len -= distance_moved;
-			double total_distance_traveled = m_total_h_dist - len;
-			double start_z                 = m_move_to_z - m_total_v_dist;
-			double z_at_pos                = start_z + (m_total_v_dist * (total_distance_traveled / m_total_h_dist));
+	while (diff < -256.0) {
+		diff += 512.0;
+	}
 
-			if (mob->IsNPC()) {
-				entity_list.ProcessMove(mob->CastToNPC(), npos.x, npos.y, z_at_pos);
-			}
+	while (diff > 256) {
+		diff -= 512.0;
+	}
 
-			mob->SetPosition(npos.x, npos.y, z_at_pos);
+	auto dist = std::abs(diff);
 
+	if (!cmd.started) {
+		cmd.started = true;
+		mob->turning = true;
+		mob->SetMoving(true);
+		entity_list.WakeMob(mob->GetID());
 
-			if (RuleB(Map, FixZWhenPathing)) {
-				m_distance_moved_since_correction += distance_moved;
-				if (m_distance_moved_since_correction > (mob->IsEngaged() ? 1 : 10)) {
-					m_distance_moved_since_correction = 0.0;
-					mob->FixZ();
-				}
-			}
+		if (dist > 15.0f && rotate_to_speed > 0.0 && rotate_to_speed <= 25.0) { //send basic rotation
+			mob_movement_manager->SendCommandToClients(
+				mob,
+				0.0,
+				0.0,
+				0.0,
+				cmd.heading * rotate_to_speed,
+				0,
+				ClientRangeClose
+			);
 		}
-
-		return false;
-	}
-
-	virtual bool Started() const
-	{
-		return m_started;
 	}
 
-protected:
-	double          m_distance_moved_since_correction;
-	double          m_move_to_x;
-	double          m_move_to_y;
-	double          m_move_to_z;
-	MobMovementMode m_move_to_mode;
-	bool            m_started;
-
-	double m_last_sent_time;
-	int    m_last_sent_speed;
-	double m_total_h_dist;
-	double m_total_v_dist;
-};
-
-class FlyToCommand : public IMovementCommand {
-public:
-	FlyToCommand(float x, float y, float z, MobMovementMode mob_movement_mode)
-	{
-		m_distance_moved_since_correction = 0.0;
-		m_move_to_x                       = x;
-		m_move_to_y                       = y;
-		m_move_to_z                       = z;
-		m_move_to_mode                    = mob_movement_mode;
-		m_last_sent_time                  = 0.0;
-		m_last_sent_speed                 = 0;
-		m_started                         = false;
-		m_total_h_dist                    = 0.0;
-		m_total_v_dist                    = 0.0;
-	}
-
-	virtual ~FlyToCommand()
-	{
+	auto td = rotate_to_speed * 19.0 * frame_time;
 
+	if (td >= dist) {
+		mob->SetHeading(to);
+		mob->SetMoving(false);
+		mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeCloseMedium);
+		mob->turning = false;
+		return true;
 	}
 
-	virtual bool Process(MobMovementManager *mob_movement_manager, Mob *mob)
-	{
-		if (!mob->IsAIControlled()) {
-			return true;
-		}
+	from += td * cmd.heading;
+	mob->SetHeading(FixHeading(from));
+	return false;
+}
 
-		//Send a movement packet when you start moving
-		double current_time  = static_cast<double>(Timer::GetCurrentTime()) / 1000.0;
-		int    current_speed = 0;
+// the part of a move that talks to clients, returns how far the mob travels this tick
+static double BeginMoveStep(MobMovementManager *mob_movement_manager, Mob *mob, MovementCommand &cmd)
+{
+	//Send a movement packet when you start moving
+	double current_time  = static_cast<double>(Timer::GetCurrentTime()) / 1000.0;
+	int    current_speed = 0;
 
-		if (m_move_to_mode == MovementRunning) {
-			if (mob->IsFeared()) {
-				current_speed = mob->GetFearSpeed();
-			}
-			else {
-				current_speed = mob->GetRunspeed();
-			}
+	if (cmd.mode == MovementRunning) {
+		if (mob->IsFeared()) {
+			current_speed = mob->GetFearSpeed();
 		}
 		else {
-			current_speed = mob->GetWalkspeed();
+			current_speed = mob->GetRunspeed();
 		}
+	}
+	else {
+		current_speed = mob->GetWalkspeed();
+	}
 
-		if (!m_started) {
-			m_started = true;
-			//rotate to the point
-			mob->SetMoving(true);
-			mob->SetHeading(mob->CalculateHeadingToTarget(m_move_to_x, m_move_to_y));
-
-			m_last_sent_speed = current_speed;
-			m_last_sent_time  = current_time;
-			m_total_h_dist    = DistanceNoZ(mob->GetPosition(), glm::vec4(m_move_to_x, m_move_to_y, 0.0f, 0.0f));
-			m_total_v_dist    = m_move_to_z - mob->GetZ();
-			mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, current_speed, ClientRangeCloseMedium);
-		}
+	if (!cmd.started) {
+		cmd.started = true;
+		//rotate to the point
+		mob->SetMoving(true);
+		entity_list.WakeMob(mob->GetID());
+		mob->SetHeading(mob->CalculateHeadingToTarget(cmd.x, cmd.y));
 
-		//When speed changes
-		if (current_speed != m_last_sent_speed) {
-			m_distance_moved_since_correction = 0.0;
-			m_last_sent_speed = current_speed;
-			m_last_sent_time  = current_time;
-			mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, current_speed, ClientRangeCloseMedium);
-		}
+		cmd.last_sent_speed = current_speed;
+		cmd.last_sent_time  = current_time;
+		cmd.total_h_dist    = DistanceNoZ(mob->GetPosition(), glm::vec4(cmd.x, cmd.y, 0.0f, 0.0f));
+		cmd.total_v_dist    = cmd.z - mob->GetZ();
+		mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, current_speed, ClientRangeCloseMedium);
+	}
 
-		//If x seconds have passed without sending an update.
-		if (current_time - m_last_sent_time >= 0.5) {
-			m_distance_moved_since_correction = 0.0;
-			m_last_sent_speed = current_speed;
-			m_last_sent_time  = current_time;
-			mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, current_speed, ClientRangeCloseMedium);
-		}
+	// ground moves resync z whenever they resend, fliers resend often and swimmers in between
+	bool   fix_z           = cmd.type == MovementCommandMoveTo && RuleB(Map, FixZWhenPathing);
+	double resend_interval = cmd.type == MovementCommandFlyTo ? 0.5 : (cmd.type == MovementCommandSwimTo ? 1.5 : 5.0);
 
-		auto      &p  = mob->GetPosition();
-		glm::vec2 tar(m_move_to_x, m_move_to_y);
-		glm::vec2 pos(p.x, p.y);
-		double    len = glm::distance(pos, tar);
-		if (len == 0) {
-			return true;
+	//When speed changes
+	if (current_speed != cmd.last_sent_speed) {
+		if (fix_z) {
+			mob->FixZ();
 		}
 
-		mob->SetMoved(true);
+		cmd.distance_moved_since_correction = 0.0;
 
-		glm::vec2 dir            = tar - pos;
-		glm::vec2 ndir           = glm::normalize(dir);
-		double    distance_moved = frame_time * current_speed * 0.4f * 1.45f;
-
-		if (distance_moved > len) {
-			if (mob->IsNPC()) {
-				entity_list.ProcessMove(mob->CastToNPC(), m_move_to_x, m_move_to_y, m_move_to_z);
-			}
-
-			mob->SetPosition(m_move_to_x, m_move_to_y, m_move_to_z);
+		cmd.last_sent_speed = current_speed;
+		cmd.last_sent_time  = current_time;
+		mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, current_speed, ClientRangeCloseMedium);
+	}
 
-			if (RuleB(Map, FixZWhenPathing)) {
-				mob->FixZ();
-			}
-			return true;
+	//If x seconds have passed without sending an update.
+	if (current_time - cmd.last_sent_time >= resend_interval) {
+		if (fix_z) {
+			mob->FixZ();
 		}
-		else {
-			glm::vec2 npos = pos + (ndir * static_cast<float>(distance_moved));
-
-			len -= distance_moved;
-			double total_distance_traveled = m_total_h_dist - len;
-			double start_z                 = m_move_to_z - m_total_v_dist;
-			double z_at_pos                = start_z + (m_total_v_dist * (total_distance_traveled / m_total_h_dist));
 
-			if (mob->IsNPC()) {
-				entity_list.ProcessMove(mob->CastToNPC(), npos.x, npos.y, z_at_pos);
-			}
+		cmd.distance_moved_since_correction = 0.0;
 
-			mob->SetPosition(npos.x, npos.y, z_at_pos);
-		}
+		// clients out past the short update range only get every Nth resend, the client carries the mob along in between
+		int  medium_interval = std::max(1, RuleI(Pathing, MediumRangeResendInterval));
+		auto range           = (++cmd.resends % medium_interval) == 0 ? ClientRangeCloseMedium : ClientRangeClose;
 
-		return false;
+		cmd.last_sent_speed = current_speed;
+		cmd.last_sent_time  = current_time;
+		mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, current_speed, range);
 	}
 
-	virtual bool Started() const
-	{
-		return m_started;
-	}
-
-protected:
-	double          m_distance_moved_since_correction;
-	double          m_move_to_x;
-	double          m_move_to_y;
-	double          m_move_to_z;
-	MobMovementMode m_move_to_mode;
-	bool            m_started;
-
-	double m_last_sent_time;
-	int    m_last_sent_speed;
-	double m_total_h_dist;
-	double m_total_v_dist;
-};
-
-class SwimToCommand : public MoveToCommand {
-public:
-	SwimToCommand(float x, float y, float z, MobMovementMode mob_movement_mode) : MoveToCommand(x, y, z, mob_movement_mode)
-	{
+	return frame_time * current_speed * 0.4f * 1.45f;
+}
 
+// moves the mob to the position StepToward worked out, returns true once the node is reached
+static bool FinishMoveStep(Mob *mob, MovementCommand &cmd, MovementStepResult result, float x, float y, double z, double distance_moved)
+{
+	if (result == MovementStepAtTarget) {
+		return true;
 	}
 
-	virtual bool Process(MobMovementManager *mob_movement_manager, Mob *mob)
-	{
-		if (!mob->IsAIControlled()) {
-			return true;
-		}
-
-		//Send a movement packet when you start moving
-		double current_time  = static_cast<double>(Timer::GetCurrentTime()) / 1000.0;
-		int    current_speed = 0;
+	mob->SetMoved(true);
 
-		if (m_move_to_mode == MovementRunning) {
-			if (mob->IsFeared()) {
-				current_speed = mob->GetFearSpeed();
-			}
-			else {
-				current_speed = mob->GetRunspeed();
-			}
-		}
-		else {
-			current_speed = mob->GetWalkspeed();
+	if (result == MovementStepArrived) {
+		if (mob->IsNPC()) {
+			entity_list.ProcessMove(mob->CastToNPC(), cmd.x, cmd.y, cmd.z);
 		}
 
-		if (!m_started) {
-			m_started = true;
-			//rotate to the point
-			mob->SetMoving(true);
-			mob->SetHeading(mob->CalculateHeadingToTarget(m_move_to_x, m_move_to_y));
-
-			m_last_sent_speed = current_speed;
-			m_last_sent_time  = current_time;
-			m_total_h_dist    = DistanceNoZ(mob->GetPosition(), glm::vec4(m_move_to_x, m_move_to_y, 0.0f, 0.0f));
-			m_total_v_dist    = m_move_to_z - mob->GetZ();
-			mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, current_speed, ClientRangeCloseMedium);
-		}
+		mob->SetPosition(cmd.x, cmd.y, cmd.z);
 
-		//When speed changes
-		if (current_speed != m_last_sent_speed) {
-			m_last_sent_speed = current_speed;
-			m_last_sent_time  = current_time;
-			mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, current_speed, ClientRangeCloseMedium);
+		if (cmd.type != MovementCommandSwimTo && RuleB(Map, FixZWhenPathing)) {
+			mob->FixZ();
 		}
+		return true;
+	}
 
-		//If x seconds have passed without sending an update.
-		if (current_time - m_last_sent_time >= 1.5) {
-			m_last_sent_speed = current_speed;
-			m_last_sent_time  = current_time;
-			mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, current_speed, ClientRangeCloseMedium);
-		}
+	if (mob->IsNPC()) {
+		entity_list.ProcessMove(mob->CastToNPC(), x, y, z);
+	}
 
-		auto      &p  = mob->GetPosition();
-		glm::vec2 tar(m_move_to_x, m_move_to_y);
-		glm::vec2 pos(p.x, p.y);
-		double    len = glm::distance(pos, tar);
-		if (len == 0) {
-			return true;
+	mob->SetPosition(x, y, z);
+
+	if (cmd.type == MovementCommandMoveTo && RuleB(Map, FixZWhenPathing)) {
+		cmd.distance_moved_since_correction += distance_moved;
+		if (cmd.distance_moved_since_correction > (mob->IsEngaged() ? 1 : 10)) {
+			cmd.distance_moved_since_correction = 0.0;
+			mob->FixZ();
 		}
+	}
 
-		mob->SetMoved(true);
+	return false;
+}
 
-		glm::vec2 dir            = tar - pos;
-		glm::vec2 ndir           = glm::normalize(dir);
-		double    distance_moved = frame_time * current_speed * 0.4f * 1.45f;
+// runs one command to completion or for this tick, returns true when it is done
+static bool ProcessMovementCommand(MobMovementManager *mob_movement_manager, Mob *mob, MovementCommand &cmd)
+{
+	if (!mob->IsAIControlled()) {
+		return true;
+	}
 
-		if (distance_moved > len) {
+	switch (cmd.type) {
+		case MovementCommandRotateTo:
+			return ProcessRotateTo(mob_movement_manager, mob, cmd);
+		case MovementCommandMoveTo:
+		case MovementCommandSwimTo:
+		case MovementCommandFlyTo: {
+			double distance_moved = BeginMoveStep(mob_movement_manager, mob, cmd);
+			auto   &p             = mob->GetPosition();
+			float  x              = 0.0f;
+			float  y              = 0.0f;
+			double z              = 0.0;
+			auto   result         = StepToward(p.x, p.y, cmd.x, cmd.y, cmd.z, cmd.total_h_dist, cmd.total_v_dist, distance_moved, x, y, z);
+			return FinishMoveStep(mob, cmd, result, x, y, z, distance_moved);
+		}
+		case MovementCommandTeleportTo:
 			if (mob->IsNPC()) {
-				entity_list.ProcessMove(mob->CastToNPC(), m_move_to_x, m_move_to_y, m_move_to_z);
+				entity_list.ProcessMove(mob->CastToNPC(), cmd.x, cmd.y, cmd.z);
 			}
 
-			mob->SetPosition(m_move_to_x, m_move_to_y, m_move_to_z);
+			mob->SetPosition(cmd.x, cmd.y, cmd.z);
+			mob->SetHeading(mob_movement_manager->FixHeading(cmd.heading));
+			mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeAny);
 			return true;
-		}
-		else {
-			glm::vec2 npos = pos + (ndir * static_cast<float>(distance_moved));
-
-			len -= distance_moved;
-			double total_distance_traveled = m_total_h_dist - len;
-			double start_z                 = m_move_to_z - m_total_v_dist;
-			double z_at_pos                = start_z + (m_total_v_dist * (total_distance_traveled / m_total_h_dist));
-
-			if (mob->IsNPC()) {
-				entity_list.ProcessMove(mob->CastToNPC(), npos.x, npos.y, z_at_pos);
+		case MovementCommandStopMoving:
+			if (mob->IsMoving()) {
+				mob->SetMoving(false);
+				if (RuleB(Map, FixZWhenPathing)) {
+					mob->FixZ();
+				}
+				mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeCloseMedium);
+			}
+			return true;
+		case MovementCommandEvadeCombat:
+			if (mob->IsMoving()) {
+				mob->SetMoving(false);
+				mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeCloseMedium);
 			}
 
-			mob->SetPosition(npos.x, npos.y, z_at_pos);
-		}
-
-		return false;
+			mob->BuffFadeAll();
+			mob->WipeHateList();
+			mob->RestoreHealth();
+			return false;
 	}
-};
 
-class TeleportToCommand : public IMovementCommand {
-public:
-	TeleportToCommand(float x, float y, float z, float heading)
-	{
-		m_teleport_to_x       = x;
-		m_teleport_to_y       = y;
-		m_teleport_to_z       = z;
-		m_teleport_to_heading = heading;
-	}
+	return true;
+}
 
-	virtual ~TeleportToCommand()
-	{
+// a client within long range of a mob and how far away it is
+struct ClientInterest {
+	Client *client;
+	float   distance;
+};
 
-	}
+// the clients a mob's close and medium range updates go to, worked out on its first update of a tick
+struct MobInterest {
+	uint32                      Stamp = 0;
+	std::vector<ClientInterest> Clients;
+};
 
-	virtual bool Process(MobMovementManager *mob_movement_manager, Mob *mob)
-	{
-		if (!mob->IsAIControlled()) {
-			return true;
-		}
+// Updates held for one client while Process runs. A client gets at most one update per mob per tick, the
+// latest, and the lot is queued back to back at the end of the tick so the stream packs them into combined
+// packets instead of interleaving them with everything else the zone sends.
+struct ClientOutbox {
+	std::vector<uint32>                Updates;
+	std::unordered_map<uint16, size_t> ByMob;
+};
 
-		if (mob->IsNPC()) {
-			entity_list.ProcessMove(mob->CastToNPC(), m_teleport_to_x, m_teleport_to_y, m_teleport_to_z);
-		}
+struct MobMovementManager::Implementation {
+	// one row per mob, Mobs[i], Entries[i] and NavTo[i] belong together
+	std::vector<Mob *>                Mobs;
+	std::vector<MobMovementEntry>     Entries;
+	std::vector<::NavigateTo>         NavTo;
+	std::unordered_map<Mob *, uint32> Slots;
+	std::vector<MobInterest>          Interest;
+	std::vector<Client *>             Clients;
+	MovementStats                     Stats;
+	MovementStepBatch                 Batch;
+	AsyncPathing                      Paths;
 
-		mob->SetPosition(m_teleport_to_x, m_teleport_to_y, m_teleport_to_z);
-		mob->SetHeading(mob_movement_manager->FixHeading(m_teleport_to_heading));
-		mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeAny);
+	// clients bucketed by position once per tick, mob interest sets are only valid for the current stamp
+	SpatialGrid<Client> ClientGrid;
+	MobInterest         ScratchInterest;
+	uint32              InterestStamp = 1;
 
-		return true;
-	}
+	// while Process runs updates are copied into the pool and collected per client instead of sent
+	bool                                              Deferring = false;
+	std::vector<std::unique_ptr<EQApplicationPacket>> UpdatePackets;
+	std::vector<MulticastPacket>                      Updates;
+	std::unordered_map<Client *, ClientOutbox>        Outboxes;
 
-	virtual bool Started() const
+	int Find(Mob *mob) const
 	{
-		return false;
+		auto iter = Slots.find(mob);
+		return iter != Slots.end() ? static_cast<int>(iter->second) : -1;
 	}
 
-private:
-
-	double m_teleport_to_x;
-	double m_teleport_to_y;
-	double m_teleport_to_z;
-	double m_teleport_to_heading;
-};
-
-class StopMovingCommand : public IMovementCommand {
-public:
-	StopMovingCommand()
+	MobMovementEntry *Entry(Mob *mob)
 	{
+		int slot = Find(mob);
+		return slot >= 0 ? &Entries[slot] : nullptr;
 	}
 
-	virtual ~StopMovingCommand()
+	// the row still holds the same mob and queue it did when a command was copied out of it
+	bool Unchanged(uint32 slot, Mob *mob, uint32 generation) const
 	{
-
+		return slot < Mobs.size() && Mobs[slot] == mob && Entries[slot].Generation == generation && !Entries[slot].Empty();
 	}
 
-	virtual bool Process(MobMovementManager *mob_movement_manager, Mob *mob)
+	void BeginTick()
 	{
-		if (!mob->IsAIControlled()) {
-			return true;
-		}
+		Stats.LastTickEncoded = Stats.TickEncoded;
+		Stats.TickEncoded     = 0;
 
-		if (mob->IsMoving()) {
-			mob->SetMoving(false);
-			if (RuleB(Map, FixZWhenPathing)) {
-				mob->FixZ();
-			}
-			mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeCloseMedium);
+		ClientGrid.SetCellSize(static_cast<float>(RuleI(Range, MobCloseScanDistance)));
+		for (auto c : Clients) {
+			ClientGrid.Update(c, glm::vec3(c->GetPosition()));
 		}
 
-		return true;
+		InterestStamp++;
+		Deferring = true;
 	}
 
-	virtual bool Started() const
+	const std::vector<ClientInterest> &InterestIn(Mob *mob, float long_range)
 	{
-		return false;
-	}
-};
+		int  slot      = Find(mob);
+		auto &interest = slot >= 0 ? Interest[slot] : ScratchInterest;
+		if (slot >= 0 && interest.Stamp == InterestStamp) {
+			return interest.Clients;
+		}
 
-class EvadeCombatCommand : public IMovementCommand {
-public:
-	EvadeCombatCommand()
-	{
-	}
+		interest.Stamp = InterestStamp;
+		interest.Clients.clear();
 
-	virtual ~EvadeCombatCommand()
-	{
+		auto &p = mob->GetPosition();
+		ClientGrid.ForEachInRange(
+			glm::vec3(p), long_range, [&](Client *c) {
+				float distance = c->CalculateDistance(p.x, p.y, p.z);
+				if (distance < long_range) {
+					interest.Clients.push_back(ClientInterest{ c, distance });
+				}
+			}
+		);
 
+		return interest.Clients;
 	}
 
-	virtual bool Process(MobMovementManager *mob_movement_manager, Mob *mob)
+	uint32 AddUpdate(const EQApplicationPacket &p)
 	{
-		if (!mob->IsAIControlled()) {
-			return true;
+		uint32 index = static_cast<uint32>(Updates.size());
+		if (index == UpdatePackets.size()) {
+			UpdatePackets.emplace_back(p.Copy());
 		}
-
-		if (mob->IsMoving()) {
-			mob->SetMoving(false);
-			mob_movement_manager->SendCommandToClients(mob, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeCloseMedium);
+		else if (UpdatePackets[index]->size != p.size) {
+			UpdatePackets[index].reset(p.Copy());
+		}
+		else {
+			memcpy(UpdatePackets[index]->pBuffer, p.pBuffer, p.size);
 		}
 
-		mob->BuffFadeAll();
-		mob->WipeHateList();
-		mob->RestoreHealth();
-
-		return false;
+		Updates.emplace_back(UpdatePackets[index].get(), false);
+		return index;
 	}
 
-	virtual bool Started() const
+	void Defer(Client *c, uint16 mob_id, uint32 update)
 	{
-		return false;
+		auto &box  = Outboxes[c];
+		auto iter = box.ByMob.find(mob_id);
+		if (iter != box.ByMob.end()) {
+			box.Updates[iter->second] = update;
+			Stats.TotalCoalesced++;
+			return;
+		}
+
+		box.ByMob.emplace(mob_id, box.Updates.size());
+		box.Updates.push_back(update);
 	}
-};
 
-struct MovementStats {
-	MovementStats()
+	void Flush()
 	{
-		LastResetTime     = static_cast<double>(Timer::GetCurrentTime()) / 1000.0;
-		TotalSent         = 0ULL;
-		TotalSentMovement = 0ULL;
-		TotalSentPosition = 0ULL;
-		TotalSentHeading  = 0ULL;
-	}
+		Deferring = false;
 
-	double   LastResetTime;
-	uint64_t TotalSent;
-	uint64_t TotalSentMovement;
-	uint64_t TotalSentPosition;
-	uint64_t TotalSentHeading;
-};
+		for (auto c : Clients) {
+			auto box = Outboxes.find(c);
+			if (box == Outboxes.end() || box->second.Updates.empty()) {
+				continue;
+			}
 
-struct NavigateTo {
-	NavigateTo()
-	{
-		navigate_to_x       = 0.0;
-		navigate_to_y       = 0.0;
-		navigate_to_z       = 0.0;
-		navigate_to_heading = 0.0;
-		last_set_time       = 0.0;
-	}
+			for (auto update : box->second.Updates) {
+				c->QueuePacket(Updates[update]);
+			}
 
-	double navigate_to_x;
-	double navigate_to_y;
-	double navigate_to_z;
-	double navigate_to_heading;
-	double last_set_time;
-};
+			box->second.Updates.clear();
+			box->second.ByMob.clear();
+		}
 
-struct MobMovementEntry {
-	std::deque<std::unique_ptr<IMovementCommand>> Commands;
-	NavigateTo                                    NavTo;
-};
+		for (auto &u : Updates) {
+			Stats.TotalEncoded += u.GetEncodeCount();
+			Stats.TickEncoded  += u.GetEncodeCount();
+		}
 
-void AdjustRoute(std::list<IPathfinder::IPathNode> &nodes, Mob *who)
-{
-	if (!zone->HasMap() || !zone->HasWaterMap()) {
-		return;
+		Updates.clear();
 	}
 
-	auto offset = who->GetZOffset();
+	// Works through a mob's queue until a command needs more ticks. Commands run on a copy that is only written
+	// back if the queue survived, quest events fired from inside a command are free to clear or refill it.
+	// With defer_moves set a move stops after its client updates and is left for the batched position pass.
+	void RunCommands(MobMovementManager *mob_movement_manager, uint32 slot, bool defer_moves)
+	{
+		Mob *mob = Mobs[slot];
+		while (slot < Mobs.size() && Mobs[slot] == mob && !Entries[slot].Empty()) {
+			uint32          generation = Entries[slot].Generation;
+			MovementCommand cmd        = Entries[slot].Front();
+
+			if (defer_moves && cmd.IsMove() && mob->IsAIControlled()) {
+				double distance_moved = BeginMoveStep(mob_movement_manager, mob, cmd);
+				if (Unchanged(slot, mob, generation)) {
+					Entries[slot].Front() = cmd;
+					Batch.Add(slot, mob, generation, cmd, distance_moved);
+				}
+				return;
+			}
 
-	for (auto &node : nodes) {
-		if (!zone->watermap->InLiquid(node.pos)) {
-			auto best_z = zone->zonemap->FindBestZ(node.pos, nullptr);
-			if (best_z != BEST_Z_INVALID) {
-				node.pos.z = best_z + offset;
+			bool done = ProcessMovementCommand(mob_movement_manager, mob, cmd);
+			if (!Unchanged(slot, mob, generation)) {
+				return;
 			}
-		} // todo: floating logic?
-	}
-}
 
-struct MobMovementManager::Implementation {
-	std::map<Mob *, MobMovementEntry> Entries;
-	std::vector<Client *>             Clients;
-	MovementStats                     Stats;
+			Entries[slot].Front() = cmd;
+			if (!done) {
+				return;
+			}
+
+			Entries[slot].PopFront();
+		}
+	}
 };
 
 MobMovementManager::MobMovementManager()
@@ -680,40 +724,104 @@ MobMovementManager::~MobMovementManager()
 
 void MobMovementManager::Process()
 {
-	for (auto &iter : _impl->Entries) {
-		auto &ent      = iter.second;
-		auto &commands = ent.Commands;
+	_impl->BeginTick();
 
-		while (true != commands.empty()) {
-			auto &cmd = commands.front();
-			auto r    = cmd->Process(this, iter.first);
+	ApplyFinishedPaths();
 
-			if (true != r) {
-				break;
-			}
+	auto &batch = _impl->Batch;
+	batch.Clear();
+
+	for (uint32 slot = 0; slot < _impl->Mobs.size(); ++slot) {
+		_impl->RunCommands(this, slot, true);
+	}
 
-			commands.pop_front();
+	batch.Integrate();
+
+	for (size_t i = 0; i < batch.Size(); ++i) {
+		uint32 slot = batch.Slot[i];
+		Mob    *mob = batch.Mobs[i];
+		if (!_impl->Unchanged(slot, mob, batch.Generation[i])) {
+			continue;
+		}
+
+		MovementCommand cmd  = _impl->Entries[slot].Front();
+		bool            done = FinishMoveStep(
+			mob,
+			cmd,
+			static_cast<MovementStepResult>(batch.Result[i]),
+			batch.NewX[i],
+			batch.NewY[i],
+			batch.NewZ[i],
+			batch.Distance[i]
+		);
+
+		if (!_impl->Unchanged(slot, mob, batch.Generation[i])) {
+			continue;
+		}
+
+		_impl->Entries[slot].Front() = cmd;
+		if (done) {
+			// reached the node, the rest of the path carries on this tick as it always has
+			_impl->Entries[slot].PopFront();
+			_impl->RunCommands(this, slot, false);
 		}
 	}
+
+	_impl->Flush();
 }
 
 void MobMovementManager::AddMob(Mob *mob)
 {
-	_impl->Entries.insert(std::make_pair(mob, MobMovementEntry()));
+	if (_impl->Slots.find(mob) != _impl->Slots.end()) {
+		return;
+	}
+
+	_impl->Slots.emplace(mob, static_cast<uint32>(_impl->Mobs.size()));
+	_impl->Mobs.push_back(mob);
+	_impl->Entries.emplace_back();
+	_impl->NavTo.emplace_back();
+	_impl->Interest.emplace_back();
 }
 
 void MobMovementManager::RemoveMob(Mob *mob)
 {
-	_impl->Entries.erase(mob);
+	auto iter = _impl->Slots.find(mob);
+	if (iter == _impl->Slots.end()) {
+		return;
+	}
+
+	// move the last row into the hole
+	uint32 slot = iter->second;
+	uint32 last = static_cast<uint32>(_impl->Mobs.size() - 1);
+	_impl->Slots.erase(iter);
+
+	if (slot != last) {
+		_impl->Mobs[slot]     = _impl->Mobs[last];
+		_impl->Entries[slot]  = std::move(_impl->Entries[last]);
+		_impl->NavTo[slot]    = _impl->NavTo[last];
+		_impl->Interest[slot] = std::move(_impl->Interest[last]);
+		_impl->Slots[_impl->Mobs[slot]] = slot;
+	}
+
+	_impl->Mobs.pop_back();
+	_impl->Entries.pop_back();
+	_impl->NavTo.pop_back();
+	_impl->Interest.pop_back();
 }
 
 void MobMovementManager::AddClient(Client *client)
 {
 	_impl->Clients.push_back(client);
+	_impl->ClientGrid.Update(client, glm::vec3(client->GetPosition()));
+	_impl->InterestStamp++;
 }
 
 void MobMovementManager::RemoveClient(Client *client)
 {
+	_impl->ClientGrid.Remove(client);
+	_impl->Outboxes.erase(client);
+	_impl->InterestStamp++;
+
 	auto iter = _impl->Clients.begin();
 	while (iter != _impl->Clients.end()) {
 		if (client == *iter) {
@@ -727,24 +835,26 @@ void MobMovementManager::RemoveClient(Client *client)
 
 void MobMovementManager::RotateTo(Mob *who, float to, MobMovementMode mob_movement_mode)
 {
-	auto iter = _impl->Entries.find(who);
-	auto &ent = (*iter);
-
-	if (true != ent.second.Commands.empty()) {
+	auto ent = _impl->Entry(who);
+	if (!ent || !ent->Empty()) {
 		return;
 	}
 
-	PushRotateTo(ent.second, who, to, mob_movement_mode);
+	PushRotateTo(*ent, who, to, mob_movement_mode);
 }
 
 void MobMovementManager::Teleport(Mob *who, float x, float y, float z, float heading)
 {
-	auto iter = _impl->Entries.find(who);
-	auto &ent = (*iter);
+	int slot = _impl->Find(who);
+	if (slot < 0) {
+		return;
+	}
 
-	ent.second.Commands.clear();
+	auto &ent = _impl->Entries[slot];
+	ent.Clear();
+	_impl->NavTo[slot].path_request.Cancel();
 
-	PushTeleportTo(ent.second, x, y, z, heading);
+	PushTeleportTo(ent, x, y, z, heading);
 }
 
 void MobMovementManager::NavigateTo(Mob *who, float x, float y, float z, MobMovementMode mode)
@@ -753,9 +863,13 @@ void MobMovementManager::NavigateTo(Mob *who, float x, float y, float z, MobMove
 		return;
 	}
 
-	auto iter = _impl->Entries.find(who);
-	auto &ent = (*iter);
-	auto &nav = ent.second.NavTo;
+	int slot = _impl->Find(who);
+	if (slot < 0) {
+		return;
+	}
+
+	auto &ent = _impl->Entries[slot];
+	auto &nav = _impl->NavTo[slot];
 
 	double current_time = static_cast<double>(Timer::GetCurrentTime()) / 1000.0;
 	if ((current_time - nav.last_set_time) > 0.5) {
@@ -769,9 +883,8 @@ void MobMovementManager::NavigateTo(Mob *who, float x, float y, float z, MobMove
 		);
 		auto heading_match = IsHeadingEqual(0.0, nav.navigate_to_heading);
 
-		if (false == within || false == heading_match || ent.second.Commands.size() == 0) {
-			ent.second.Commands.clear();
-
+		// an empty queue with a search still out is waiting on that search, not idle
+		if (false == within || false == heading_match || (ent.Size() == 0 && !nav.path_request.Pending())) {
 			//Path is no longer valid, calculate a new path
 			UpdatePath(who, x, y, z, mode);
 			nav.navigate_to_x       = x;
@@ -785,27 +898,32 @@ void MobMovementManager::NavigateTo(Mob *who, float x, float y, float z, MobMove
 
 void MobMovementManager::StopNavigation(Mob *who)
 {
-	auto iter = _impl->Entries.find(who);
-	auto &ent = (*iter);
-	auto &nav = ent.second.NavTo;
+	int slot = _impl->Find(who);
+	if (slot < 0) {
+		return;
+	}
+
+	auto &ent = _impl->Entries[slot];
+	auto &nav = _impl->NavTo[slot];
 
 	nav.navigate_to_x       = 0.0;
 	nav.navigate_to_y       = 0.0;
 	nav.navigate_to_z       = 0.0;
 	nav.navigate_to_heading = 0.0;
+	nav.path_request.Cancel();
 
-	if (true == ent.second.Commands.empty()) {
-		PushStopMoving(ent.second);
+	if (true == ent.Empty()) {
+		PushStopMoving(ent);
 		return;
 	}
 
 	if (!who->IsMoving()) {
-		ent.second.Commands.clear();
+		ent.Clear();
 		return;
 	}
 
-	ent.second.Commands.clear();
-	PushStopMoving(ent.second);
+	ent.Clear();
+	PushStopMoving(ent);
 }
 
 void MobMovementManager::SendCommandToClients(
@@ -829,61 +947,74 @@ void MobMovementManager::SendCommandToClients(
 
 	FillCommandStruct(spu, mob, delta_x, delta_y, delta_z, delta_heading, anim);
 
-	if (range == ClientRangeAny) {
-		for (auto &c : _impl->Clients) {
-			if (single_client && c != single_client) {
-				continue;
-			}
+	// encoded once per client version, whoever ends up receiving it. Inside Process the packet is copied into
+	// the tick's update pool the first time a client wants it and goes out when the tick flushes.
+	MulticastPacket packet(&p, false);
+	int64           update = -1;
 
-			if (ignore_client && c == ignore_client) {
-				continue;
+	auto send_to = [&](Client *c) {
+		_impl->Stats.TotalSent++;
+
+		if (anim != 0) {
+			_impl->Stats.TotalSentMovement++;
+		}
+		else if (delta_heading != 0) {
+			_impl->Stats.TotalSentHeading++;
+		}
+		else {
+			_impl->Stats.TotalSentPosition++;
+		}
+
+		if (!mob->IsClient() && c->m_last_seen_mob_position.contains(mob->GetID())) {
+			if (c->m_last_seen_mob_position[mob->GetID()] == mob->GetPosition() && anim == 0) {
+				LogPositionUpdate(
+					"Mob [{}] has already been sent to client [{}] at this position, skipping",
+					mob->GetCleanName(),
+					c->GetCleanName()
+				);
+				return;
 			}
+		}
 
-			if (c->IsIdle()) {
-				continue;
+		if (_impl->Deferring) {
+			if (update < 0) {
+				update = _impl->AddUpdate(p);
 			}
 
-			_impl->Stats.TotalSent++;
+			_impl->Defer(c, mob->GetID(), static_cast<uint32>(update));
+		}
+		else {
+			c->QueuePacket(packet);
+		}
 
-			if (anim != 0) {
-				_impl->Stats.TotalSentMovement++;
-			}
-			else if (delta_heading != 0) {
-				_impl->Stats.TotalSentHeading++;
-			}
-			else {
-				_impl->Stats.TotalSentPosition++;
-			}
+		c->m_last_seen_mob_position[mob->GetID()] = mob->GetPosition();
+	};
 
-			if (!mob->IsClient() && c->m_last_seen_mob_position.contains(mob->GetID())) {
-				if (c->m_last_seen_mob_position[mob->GetID()] == mob->GetPosition() && anim == 0) {
-					LogPositionUpdate(
-						"Mob [{}] has already been sent to client [{}] at this position, skipping",
-						mob->GetCleanName(),
-						c->GetCleanName()
-					);
-					continue;
-				}
-			}
+	auto wants = [&](Client *c) {
+		if (single_client && c != single_client) {
+			return false;
+		}
 
-			c->QueuePacket(&p, false);
-			c->m_last_seen_mob_position[mob->GetID()] = mob->GetPosition();
+		if (ignore_client && c == ignore_client) {
+			return false;
 		}
-	}
-	else {
-		float short_range = RuleR(Pathing, ShortMovementUpdateRange);
-		float long_range  = RuleI(Range, MobCloseScanDistance);
 
-		for (auto &c : _impl->Clients) {
-			if (single_client && c != single_client) {
-				continue;
-			}
+		return !c->IsIdle();
+	};
 
-			if (ignore_client && c == ignore_client) {
-				continue;
-			}
+	float short_range = RuleR(Pathing, ShortMovementUpdateRange);
+	float long_range  = RuleI(Range, MobCloseScanDistance);
 
-			if (c->IsIdle()) {
+	if (range == ClientRangeAny) {
+		for (auto &c : _impl->Clients) {
+			if (wants(c)) {
+				send_to(c);
+			}
+		}
+	}
+	else if (range & ClientRangeLong) {
+		for (auto &c : _impl->Clients) {
+			if (!wants(c)) {
 				continue;
 			}
 
@@ -902,41 +1033,32 @@ void MobMovementManager::SendCommandToClients(
 				}
 			}
 
-			if (!match && range & ClientRangeLong) {
-				if (distance >= long_range) {
-					match = true;
-				}
+			if (!match && distance >= long_range) {
+				match = true;
 			}
 
 			if (match) {
-				_impl->Stats.TotalSent++;
-
-				if (anim != 0) {
-					_impl->Stats.TotalSentMovement++;
-				}
-				else if (delta_heading != 0) {
-					_impl->Stats.TotalSentHeading++;
-				}
-				else {
-					_impl->Stats.TotalSentPosition++;
-				}
-
-				if (!mob->IsClient() && c->m_last_seen_mob_position.contains(mob->GetID())) {
-					if (c->m_last_seen_mob_position[mob->GetID()] == mob->GetPosition() && anim == 0) {
-						LogPositionUpdate(
-							"Mob [{}] has already been sent to client [{}] at this position, skipping",
-							mob->GetCleanName(),
-							c->GetCleanName()
-						);
-						continue;
-					}
-				}
+				send_to(c);
+			}
+		}
+	}
+	else {
+		// close and medium updates only go to clients the interest set found within long range of the mob
+		for (auto &i : _impl->InterestIn(mob, long_range)) {
+			if (!wants(i.client)) {
+				continue;
+			}
 
-				c->QueuePacket(&p, false);
-				c->m_last_seen_mob_position[mob->GetID()] = mob->GetPosition();
+			bool match = (range & ClientRangeClose && i.distance < short_range) ||
+						 (range & ClientRangeMedium && i.distance >= short_range);
+			if (match) {
+				send_to(i.client);
 			}
 		}
 	}
+
+	_impl->Stats.TotalEncoded += packet.GetEncodeCount();
+	_impl->Stats.TickEncoded  += packet.GetEncodeCount();
 }
 
 float MobMovementManager::FixHeading(float in)
@@ -978,6 +1100,30 @@ void MobMovementManager::DumpStats(Client *client)
 		_impl->Stats.TotalSentPosition,
 		static_cast<double>(_impl->Stats.TotalSentPosition) / total_time
 	);
+	client->Message(
+		Chat::System,
+		"Total Encoded: %u (%.2f / sec) Last Tick: %u",
+		_impl->Stats.TotalEncoded,
+		static_cast<double>(_impl->Stats.TotalEncoded) / total_time,
+		_impl->Stats.LastTickEncoded
+	);
+	client->Message(
+		Chat::System,
+		"Total Coalesced: %u (%.2f / sec)",
+		_impl->Stats.TotalCoalesced,
+		static_cast<double>(_impl->Stats.TotalCoalesced) / total_time
+	);
+
+	auto &paths = _impl->Paths;
+	client->Message(
+		Chat::System,
+		"Async Paths: %u submitted %u applied %u discarded, queue latency avg %.2f ms max %.2f ms",
+		static_cast<uint32>(paths.Submitted),
+		static_cast<uint32>(paths.Applied),
+		static_cast<uint32>(paths.Discarded),
+		paths.Applied ? paths.TotalLatencyMs / static_cast<double>(paths.Applied) : 0.0,
+		paths.MaxLatencyMs
+	);
 }
 
 void MobMovementManager::ClearStats()
@@ -987,6 +1133,11 @@ void MobMovementManager::ClearStats()
 	_impl->Stats.TotalSentHeading  = 0;
 	_impl->Stats.TotalSentMovement = 0;
 	_impl->Stats.TotalSentPosition = 0;
+	_impl->Stats.TotalEncoded      = 0;
+	_impl->Stats.TickEncoded       = 0;
+	_impl->Stats.LastTickEncoded   = 0;
+	_impl->Stats.TotalCoalesced    = 0;
+	_impl->Paths.ClearStats();
 }
 
 /**
@@ -1032,41 +1183,49 @@ void MobMovementManager::UpdatePath(Mob *who, float x, float y, float z, MobMove
 {
 	Mob *target=who->GetTarget();
 
-	if (!zone->HasMap() || !zone->HasWaterMap()) {
-		auto iter = _impl->Entries.find(who);
-		auto &ent = (*iter);
+	int slot = _impl->Find(who);
+	if (slot < 0) {
+		return;
+	}
+
+	// whatever the mob was waiting on is for the old destination, only a search started below may land
+	_impl->NavTo[slot].path_request.Cancel();
 
-		PushMoveTo(ent.second, x, y, z, mob_movement_mode);
-		PushStopMoving(ent.second);
+	// every branch but an async ground search replaces the queue now, a mob waiting on a search
+	// keeps running its old commands until ApplyFinishedPaths swaps in the new route
+	auto &ent = _impl->Entries[slot];
+
+	if (!zone->HasMap() || !zone->HasWaterMap()) {
+		ent.Clear();
+		PushMoveTo(ent, x, y, z, mob_movement_mode);
+		PushStopMoving(ent);
 		return;
 	}
 
 	if (who->GetIsBoat()) {
+		ent.Clear();
 		UpdatePathBoat(who, x, y, z, mob_movement_mode);
 	}
 	else if (who->IsUnderwaterOnly()) {
+		ent.Clear();
 		UpdatePathUnderwater(who, x, y, z, mob_movement_mode);
 	}
 	// If we can fly, and we have a target and we have LoS, simply fly to them.
 	// if we ever lose LoS we go back to mesh run mode.
 	else if (target && who->GetFlyMode() == GravityBehavior::Flying &&
 				who->CheckLosFN(x,y,z,target->GetSize())) {
-		auto iter = _impl->Entries.find(who);
-		auto &ent = (*iter);
-
-		PushFlyTo(ent.second, x, y, z, mob_movement_mode);
-		PushStopMoving(ent.second);
+		ent.Clear();
+		PushFlyTo(ent, x, y, z, mob_movement_mode);
+		PushStopMoving(ent);
 		}
 	// Below for npcs that can traverse land or water so they don't sink
 	else if (who->GetFlyMode() == GravityBehavior::Water &&
 			 zone->watermap->InLiquid(who->GetPosition()) &&
 			 zone->watermap->InLiquid(glm::vec3(x, y, z)) &&
 			 zone->zonemap->CheckLoS(who->GetPosition(), glm::vec3(x, y, z))) {
-		auto iter = _impl->Entries.find(who);
-		auto &ent = (*iter);
-
-		PushSwimTo(ent.second, x, y, z, mob_movement_mode);
-		PushStopMoving(ent.second);
+		ent.Clear();
+		PushSwimTo(ent, x, y, z, mob_movement_mode);
+		PushStopMoving(ent);
 	}
 	else {
 		UpdatePathGround(who, x, y, z, mob_movement_mode);
@@ -1075,25 +1234,132 @@ void MobMovementManager::UpdatePath(Mob *who, float x, float y, float z, MobMove
 
 void MobMovementManager::UpdatePathGround(Mob *who, float x, float y, float z, MobMovementMode mode)
 {
-	PathfinderOptions opts;
-	opts.smooth_path = true;
-	opts.step_size   = RuleR(Pathing, NavmeshStepSize);
-	opts.offset      = who->GetZOffset();
-	opts.flags       = PathingNotDisabled ^ PathingZoneLine;
-
+	PathRequest request{};
+	request.mob              = who;
+	request.x                = x;
+	request.y                = y;
+	request.z                = z;
+	request.mode             = mode;
+	request.start            = glm::vec3(who->GetX(), who->GetY(), who->GetZ());
+	request.opts.smooth_path = true;
+	request.opts.step_size   = RuleR(Pathing, NavmeshStepSize);
+	request.opts.offset      = who->GetZOffset();
 	//This is probably pointless since the nav mesh tool currently sets zonelines to disabled anyway
-	auto partial = false;
-	auto stuck   = false;
-	auto route   = zone->pathing->FindPath(
-		glm::vec3(who->GetX(), who->GetY(), who->GetZ()),
-		glm::vec3(x, y, z),
-		partial,
-		stuck,
-		opts
+	request.opts.flags       = PathingNotDisabled ^ PathingZoneLine;
+
+	// a mob that was never added to the manager has no entry to push the path onto
+	int slot = _impl->Find(who);
+	if (slot < 0) {
+		return;
+	}
+
+	int threads = RuleI(Pathing, AsyncThreads);
+	if (threads <= 0 || !zone->pathing->IsThreadSafe()) {
+		request.route = zone->pathing->FindPath(request.start, glm::vec3(x, y, z), request.partial, request.stuck, request.opts);
+		_impl->Entries[slot].Clear();
+		ApplyPathGround(request);
+		return;
+	}
+
+	auto &paths = _impl->Paths;
+	if (!paths.Workers) {
+		paths.Workers = std::make_unique<EQ::Event::TaskScheduler>(threads);
+	}
+
+	request.id        = PathRequestSlot::NextId(paths.NextId);
+	request.submitted = std::chrono::steady_clock::now();
+	_impl->NavTo[slot].path_request.Submit(request.id);
+
+	{
+		std::lock_guard<std::mutex> lock(paths.Lock);
+		paths.InFlight++;
+		paths.Submitted++;
+	}
+
+	auto pathing = zone->pathing;
+	paths.Workers->Enqueue(
+		[&paths, pathing, request]() mutable {
+			try {
+				request.route = pathing->FindPath(
+					request.start,
+					glm::vec3(request.x, request.y, request.z),
+					request.partial,
+					request.stuck,
+					request.opts
+				);
+			}
+			catch (...) {
+				request.route.clear();
+			}
+
+			std::lock_guard<std::mutex> lock(paths.Lock);
+			paths.Done.push_back(std::move(request));
+			if (--paths.InFlight == 0) {
+				paths.Idle.notify_all();
+			}
+		}
 	);
+}
+
+void MobMovementManager::ApplyFinishedPaths()
+{
+	auto &paths    = _impl->Paths;
+	auto &finished = paths.Finished;
+	{
+		std::lock_guard<std::mutex> lock(paths.Lock);
+		if (paths.Done.empty()) {
+			return;
+		}
+
+		finished.swap(paths.Done);
+	}
+
+	auto now = std::chrono::steady_clock::now();
+	for (auto &request : finished) {
+		int slot = _impl->Find(request.mob);
+		if (slot < 0 || !_impl->NavTo[slot].path_request.Accept(request.id)) {
+			paths.Discarded++;
+			continue;
+		}
+
+		double latency = std::chrono::duration<double, std::milli>(now - request.submitted).count();
+		paths.Applied++;
+		paths.TotalLatencyMs += latency;
+		paths.MaxLatencyMs = std::max(paths.MaxLatencyMs, latency);
+
+		_impl->Entries[slot].Clear();
+		ApplyPathGround(request);
+	}
+
+	finished.clear();
+}
+
+void MobMovementManager::CancelPathRequests()
+{
+	auto &paths = _impl->Paths;
+	{
+		std::unique_lock<std::mutex> lock(paths.Lock);
+		paths.Idle.wait(lock, [&paths]() { return paths.InFlight == 0; });
+		paths.Discarded += paths.Done.size();
+		paths.Done.clear();
+	}
+
+	for (auto &nav : _impl->NavTo) {
+		nav.path_request.Cancel();
+	}
+}
+
+void MobMovementManager::ApplyPathGround(PathRequest &request)
+{
+	Mob             *who   = request.mob;
+	float           x      = request.x;
+	float           y      = request.y;
+	float           z      = request.z;
+	MobMovementMode mode   = request.mode;
+	auto            &route = request.route;
+	bool            stuck  = request.stuck;
 
-	auto eiter = _impl->Entries.find(who);
-	auto &ent  = (*eiter);
+	auto &ent = *_impl->Entry(who);
 
 	if (route.size() == 0) {
 		HandleStuckBehavior(who, x, y, z, mode);
@@ -1133,7 +1399,7 @@ void MobMovementManager::UpdatePathGround(Mob *who, float x, float y, float z, M
 		if (noValidPath) {
 			//we are 'stuck' in a path, lets just get out of this by 'teleporting' to the next position.
 			PushTeleportTo(
-				ent.second,
+				ent,
 				x,
 				y,
 				z,
@@ -1166,7 +1432,7 @@ void MobMovementManager::UpdatePathGround(Mob *who, float x, float y, float z, M
 
 			if (mode == MovementWalking) {
 				auto h = who->CalculateHeadingToTarget(next_node.pos.x, next_node.pos.y);
-				PushRotateTo(ent.second, who, h, mode);
+				PushRotateTo(ent, who, h, mode);
 			}
 
 			first_node = false;
@@ -1175,7 +1441,7 @@ void MobMovementManager::UpdatePathGround(Mob *who, float x, float y, float z, M
 		//move to / teleport to node + 1
 		if (next_node.teleport && next_node.pos.x != 0.0f && next_node.pos.y != 0.0f) {
 			PushTeleportTo(
-				ent.second,
+				ent,
 				next_node.pos.x,
 				next_node.pos.y,
 				next_node.pos.z,
@@ -1189,10 +1455,10 @@ void MobMovementManager::UpdatePathGround(Mob *who, float x, float y, float z, M
 		}
 		else if(!next_node.teleport) {
 			if (zone->watermap->InLiquid(previous_pos)) {
-				PushSwimTo(ent.second, next_node.pos.x, next_node.pos.y, next_node.pos.z, mode);
+				PushSwimTo(ent, next_node.pos.x, next_node.pos.y, next_node.pos.z, mode);
 			}
 			else {
-				PushMoveTo(ent.second, next_node.pos.x, next_node.pos.y, next_node.pos.z, mode);
+				PushMoveTo(ent, next_node.pos.x, next_node.pos.y, next_node.pos.z, mode);
 			}
 		}
 	}
@@ -1201,18 +1467,17 @@ void MobMovementManager::UpdatePathGround(Mob *who, float x, float y, float z, M
 		HandleStuckBehavior(who, x, y, z, mode);
 	}
 	else {
-		PushStopMoving(ent.second);
+		PushStopMoving(ent);
 	}
 }
 
 void MobMovementManager::UpdatePathUnderwater(Mob *who, float x, float y, float z, MobMovementMode movement_mode)
 {
-	auto eiter = _impl->Entries.find(who);
-	auto &ent  = (*eiter);
+	auto &ent = *_impl->Entry(who);
 	if (zone->watermap->InLiquid(who->GetPosition()) && zone->watermap->InLiquid(glm::vec3(x, y, z)) &&
 		zone->zonemap->CheckLoS(who->GetPosition(), glm::vec3(x, y, z))) {
-		PushSwimTo(ent.second, x, y, z, movement_mode);
-		PushStopMoving(ent.second);
+		PushSwimTo(ent, x, y, z, movement_mode);
+		PushStopMoving(ent);
 		return;
 	}
 
@@ -1283,7 +1548,7 @@ void MobMovementManager::UpdatePathUnderwater(Mob *who, float x, float y, float
 
 			if (movement_mode == MovementWalking) {
 				auto h = who->CalculateHeadingToTarget(next_node.pos.x, next_node.pos.y);
-				PushRotateTo(ent.second, who, h, movement_mode);
+				PushRotateTo(ent, who, h, movement_mode);
 			}
 
 			first_node = false;
@@ -1292,7 +1557,7 @@ void MobMovementManager::UpdatePathUnderwater(Mob *who, float x, float y, float
 		//move to / teleport to node + 1
 		if (next_node.teleport && next_node.pos.x != 0.0f && next_node.pos.y != 0.0f) {
 			PushTeleportTo(
-				ent.second, next_node.pos.x, next_node.pos.y, next_node.pos.z,
+				ent, next_node.pos.x, next_node.pos.y, next_node.pos.z,
 				CalculateHeadingAngleBetweenPositions(
 					current_node.pos.x,
 					current_node.pos.y,
@@ -1301,7 +1566,7 @@ void MobMovementManager::UpdatePathUnderwater(Mob *who, float x, float y, float
 				));
 		}
 		else if(!next_node.teleport) {
-			PushSwimTo(ent.second, next_node.pos.x, next_node.pos.y, next_node.pos.z, movement_mode);
+			PushSwimTo(ent, next_node.pos.x, next_node.pos.y, next_node.pos.z, movement_mode);
 		}
 	}
 
@@ -1309,34 +1574,33 @@ void MobMovementManager::UpdatePathUnderwater(Mob *who, float x, float y, float
 		HandleStuckBehavior(who, x, y, z, movement_mode);
 	}
 	else {
-		PushStopMoving(ent.second);
+		PushStopMoving(ent);
 	}
 }
 
 void MobMovementManager::UpdatePathBoat(Mob *who, float x, float y, float z, MobMovementMode mode)
 {
-	auto eiter = _impl->Entries.find(who);
-	auto &ent  = (*eiter);
+	auto &ent = *_impl->Entry(who);
 	float to = who->CalculateHeadingToTarget(x, y);
 
-	PushRotateTo(ent.second, who, to, mode);
-	PushSwimTo(ent.second, x, y, z, mode);
-	PushStopMoving(ent.second);
+	PushRotateTo(ent, who, to, mode);
+	PushSwimTo(ent, x, y, z, mode);
+	PushStopMoving(ent);
 }
 
 void MobMovementManager::PushTeleportTo(MobMovementEntry &ent, float x, float y, float z, float heading)
 {
-	ent.Commands.emplace_back(std::unique_ptr<IMovementCommand>(new TeleportToCommand(x, y, z, heading)));
+	ent.Push(MovementCommand::Make(MovementCommandTeleportTo, x, y, z, heading));
 }
 
 void MobMovementManager::PushMoveTo(MobMovementEntry &ent, float x, float y, float z, MobMovementMode mob_movement_mode)
 {
-	ent.Commands.emplace_back(std::unique_ptr<IMovementCommand>(new MoveToCommand(x, y, z, mob_movement_mode)));
+	ent.Push(MovementCommand::Make(MovementCommandMoveTo, x, y, z, 0.0, mob_movement_mode));
 }
 
 void MobMovementManager::PushSwimTo(MobMovementEntry &ent, float x, float y, float z, MobMovementMode mob_movement_mode)
 {
-	ent.Commands.emplace_back(std::unique_ptr<IMovementCommand>(new SwimToCommand(x, y, z, mob_movement_mode)));
+	ent.Push(MovementCommand::Make(MovementCommandSwimTo, x, y, z, 0.0, mob_movement_mode));
 }
 
 void MobMovementManager::PushRotateTo(MobMovementEntry &ent, Mob *who, float to, MobMovementMode mob_movement_mode)
@@ -1358,22 +1622,22 @@ void MobMovementManager::PushRotateTo(MobMovementEntry &ent, Mob *who, float to,
 		diff -= 512.0;
 	}
 
-	ent.Commands.emplace_back(std::unique_ptr<IMovementCommand>(new RotateToCommand(to, diff > 0 ? 1.0 : -1.0, mob_movement_mode)));
+	ent.Push(MovementCommand::Make(MovementCommandRotateTo, to, 0.0, 0.0, diff > 0 ? 1.0 : -1.0, mob_movement_mode));
 }
 
 void MobMovementManager::PushFlyTo(MobMovementEntry &ent, float x, float y, float z, MobMovementMode mob_movement_mode)
 {
-	ent.Commands.emplace_back(std::unique_ptr<IMovementCommand>(new FlyToCommand(x, y, z, mob_movement_mode)));
+	ent.Push(MovementCommand::Make(MovementCommandFlyTo, x, y, z, 0.0, mob_movement_mode));
 }
 
 void MobMovementManager::PushStopMoving(MobMovementEntry &mob_movement_entry)
 {
-	mob_movement_entry.Commands.emplace_back(std::unique_ptr<IMovementCommand>(new StopMovingCommand()));
+	mob_movement_entry.Push(MovementCommand::Make(MovementCommandStopMoving));
 }
 
 void MobMovementManager::PushEvadeCombat(MobMovementEntry &mob_movement_entry)
 {
-	mob_movement_entry.Commands.emplace_back(std::unique_ptr<IMovementCommand>(new EvadeCombatCommand()));
+	mob_movement_entry.Push(MovementCommand::Make(MovementCommandEvadeCombat));
 }
 
 void MobMovementManager::HandleStuckBehavior(Mob *who, float x, float y, float z, MobMovementMode mob_movement_mode)
@@ -1387,23 +1651,22 @@ void MobMovementManager::HandleStuckBehavior(Mob *who, float x, float y, float z
 		behavior = (MobStuckBehavior) sb;
 	}
 
-	auto eiter = _impl->Entries.find(who);
-	auto &ent = (*eiter);
+	auto &ent = *_impl->Entry(who);
 
 	switch (sb) {
 		case RunToTarget:
-			PushMoveTo(ent.second, x, y, z, mob_movement_mode);
-			PushStopMoving(ent.second);
+			PushMoveTo(ent, x, y, z, mob_movement_mode);
+			PushStopMoving(ent);
 			break;
 		case WarpToTarget:
-			PushTeleportTo(ent.second, x, y, z, 0.0f);
-			PushStopMoving(ent.second);
+			PushTeleportTo(ent, x, y, z, 0.0f);
+			PushStopMoving(ent);
 			break;
 		case TakeNoAction:
-			PushStopMoving(ent.second);
+			PushStopMoving(ent);
 			break;
 		case EvadeCombat:
-			PushEvadeCombat(ent.second);
+			PushEvadeCombat(ent);
 			break;
 	}
 }
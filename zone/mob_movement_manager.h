@@ -7,6 +7,7 @@ class Client;
 struct RotateCommand;
 struct MovementCommand;
 struct MobMovementEntry;
+struct PathRequest;
 struct PlayerPositionUpdateServer_Struct;
 
 enum ClientRange : int
@@ -50,6 +51,9 @@ public:
 	void Teleport(Mob *who, float x, float y, float z, float heading);
 	void NavigateTo(Mob *who, float x, float y, float z, MobMovementMode mode = MovementRunning);
 	void StopNavigation(Mob *who);
+	// waits out ground path searches still running on worker threads and drops their results,
+	// call before the zone's pathfinder is replaced or freed
+	void CancelPathRequests();
 
 	void SendCommandToClients(
 		Mob *mob,
@@ -82,6 +86,8 @@ private:
 	void UpdatePathGround(Mob *who, float x, float y, float z, MobMovementMode mode);
 	void UpdatePathUnderwater(Mob *who, float x, float y, float z, MobMovementMode movement_mode);
 	void UpdatePathBoat(Mob *who, float x, float y, float z, MobMovementMode mode);
+	void ApplyPathGround(PathRequest &request);
+	void ApplyFinishedPaths();
 	void PushTeleportTo(MobMovementEntry &ent, float x, float y, float z, float heading);
 	void PushMoveTo(MobMovementEntry &ent, float x, float y, float z, MobMovementMode mob_movement_mode);
 	void PushSwimTo(MobMovementEntry &ent, float x, float y, float z, MobMovementMode mob_movement_mode);
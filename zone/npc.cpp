@@ -810,6 +810,111 @@ bool NPC::Process()
 	return true;
 }
 
+/**
+ * An NPC that isn't fighting, casting, moving or otherwise busy only does work in Process when one
+ * of its timers fires, so it can skip Process until the first of them is due. Everything that can
+ * make it busy again from outside (hate, damage, spells, signals, movement) wakes it through
+ * EntityList::WakeMob.
+ *
+ * Timers that only matter while engaged aren't waited on; AI_think_timer isn't either, it has long
+ * run out by the time any of the others fire.
+ */
+uint32 NPC::GetIdleSleepTime()
+{
+	if (!RuleB(NPC, SleepWhenIdle) || !IsAIControlled() || IsBot() || IsMerc() || IsAura()) {
+		return 0;
+	}
+
+	if (
+		p_depop ||
+		GetOwnerID() ||
+		GetSwarmOwner() ||
+		IsEngaged() ||
+		IsCasting() ||
+		delaytimer ||
+		IsMoving() ||
+		currently_fleeing ||
+		IsStunned() ||
+		IsMezzed() ||
+		ForcedMovement ||
+		!signal_q.empty()
+	) {
+		return 0;
+	}
+
+	uint32 sleep = 0xFFFFFFFF;
+	auto   until = [&sleep](Timer &t) {
+		if (t.Enabled()) {
+			sleep = std::min(sleep, t.GetRemainingTime());
+		}
+	};
+
+	until(tic_timer);
+	until(m_scan_close_mobs_timer);
+	until(swarm_timer);
+	until(viral_timer);
+	until(*reface_timer);
+	until(enraged_timer);
+	until(assist_cap_timer);
+	until(bot_attack_flag_timer);
+	until(forget_timer);
+
+	// the moving check only switches the close scan over to the idle interval
+	if (m_scan_close_mobs_timer.GetDuration() == scan_close_mobs_timer_moving) {
+		until(m_mob_check_moving_timer);
+	}
+
+	if (hp_regen_per_second > 0 && GetHP() < GetMaxHP()) {
+		until(hp_regen_per_second_timer);
+	}
+
+	if (RuleB(Zone, StateSavingOnShutdown)) {
+		until(m_resumed_from_zone_suspend_shutoff_timer);
+	}
+
+	if (spellbonuses.GravityEffect == 1) {
+		until(gravity_timer);
+	}
+
+	if (qGlobals) {
+		until(qglobal_purge_timer);
+	}
+
+	if (AIautocastspell_timer) {
+		until(*AIautocastspell_timer);
+	}
+
+	if (AI_scan_area_timer && GetNPCAggro()) {
+		until(*AI_scan_area_timer);
+	}
+
+	if (!feign_memory_list.empty()) {
+		until(*AI_feign_remember_timer);
+	}
+
+	// AI_DoMovement has nothing to do for a guard standing on its spot or a roamer pausing at a waypoint
+	bool settled = GetFollowID() == 0 && m_roambox.distance <= 0;
+	if (roamer) {
+		settled = settled && AI_walking_timer->Enabled() && !pause_timer_complete;
+		until(*AI_walking_timer);
+	}
+	else if (IsGuarding()) {
+		settled = settled && !moved && IsPositionEqualWithinCertainZ(m_Position, m_GuardPoint, 15.0f);
+	}
+
+	if (!settled) {
+		until(*AI_movement_timer);
+	}
+
+	// a timer that is due but wasn't checked yet needs another Process first
+	if (sleep == 0 || sleep == 0xFFFFFFFF) {
+		return 0;
+	}
+
+	// timers fire once their duration has been passed, not on it
+	return sleep + 1;
+}
+
 uint32 NPC::CountLoot() {
 	return(m_loot_items.size());
 }
@@ -861,6 +966,7 @@ void NPC::Depop(bool start_spawn_timer) {
 	}
 
 	p_depop = true;
+	entity_list.WakeMob(GetID());
 	if (respawn2) {
 		if (start_spawn_timer) {
 			respawn2->DeathReset();
@@ -2845,6 +2951,7 @@ int64 NPC::CalcMaxMana()
 void NPC::SignalNPC(int _signal_id)
 {
 	signal_q.push_back(_signal_id);
+	entity_list.WakeMob(GetID());
 }
 
 void NPC::SendPayload(int payload_id, std::string payload_value)
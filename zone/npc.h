@@ -142,6 +142,7 @@ public:
 	virtual bool IsNPC() const { return true; }
 
 	virtual bool Process();
+	uint32 GetIdleSleepTime(); // how long Process has nothing to do, 0 when the NPC must stay awake
 	virtual void	AI_Init();
 	virtual void	AI_Start(uint32 iMoveDelay = 0);
 	virtual void	AI_Stop();
@@ -1,6 +1,8 @@
 #include "oriented_bounding_box.h"
+#include <glm/common.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/transform.hpp>
+#include <cfloat>
 
 glm::mat4 CreateRotateMatrix(float rx, float ry, float rz) {
 	glm::mat4 rot_x(1.0f);
@@ -93,3 +95,25 @@ bool OrientedBoundingBox::ContainsPoint(const glm::vec3 &p) const {
 	
 	return false;
 }
+
+void OrientedBoundingBox::GetAxisAlignedBounds(glm::vec3 &min, glm::vec3 &max) const {
+	min = glm::vec3(FLT_MAX);
+	max = glm::vec3(-FLT_MAX);
+	for (int i = 0; i < 8; ++i) {
+		glm::vec4 corner(
+			(i & 1) ? max_x : min_x,
+			(i & 2) ? max_y : min_y,
+			(i & 4) ? max_z : min_z,
+			1
+		);
+
+		glm::vec3 p = glm::vec3(transformation * corner);
+		min = glm::min(min, p);
+		max = glm::max(max, p);
+	}
+
+	// ContainsPoint goes through the inverse transform, leave room for it rounding the other way
+	glm::vec3 pad = glm::vec3(0.01f) + (glm::abs(min) + glm::abs(max)) * 0.0001f;
+	min -= pad;
+	max += pad;
+}
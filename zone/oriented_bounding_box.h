@@ -12,6 +12,8 @@ public:
 	~OrientedBoundingBox() = default;
 
 	bool ContainsPoint(const glm::vec3 &p) const;
+	// world space box around the eight corners, padded so it holds every point ContainsPoint accepts
+	void GetAxisAlignedBounds(glm::vec3 &min, glm::vec3 &max) const;
 private:
 	float min_x, max_x;
 	float min_y, max_y;
@@ -0,0 +1,45 @@
+#ifndef EQEMU_PATH_REQUEST_SLOT_H
+#define EQEMU_PATH_REQUEST_SLOT_H
+
+#include <cstdint>
+
+/*
+	The ground path search a mob is waiting on.
+
+	Searches run on worker threads and can finish long after the mob was sent somewhere else,
+	by a newer search or by a flying, swimming or straight line move that never searched at all.
+	Only the search the mob asked for last may turn into movement commands, everything older is
+	thrown away when it finishes.
+*/
+class PathRequestSlot {
+public:
+	// ids handed out by one counter, never 0 so 0 can mean nothing pending
+	static uint32_t NextId(uint32_t &last)
+	{
+		if (++last == 0) {
+			++last;
+		}
+
+		return last;
+	}
+
+	void Submit(uint32_t id) { m_id = id; }
+	void Cancel() { m_id = 0; }
+	bool Pending() const { return m_id != 0; }
+
+	// true for the newest search only, and only the first time it finishes
+	bool Accept(uint32_t id)
+	{
+		if (m_id == 0 || m_id != id) {
+			return false;
+		}
+
+		m_id = 0;
+		return true;
+	}
+
+private:
+	uint32_t m_id = 0;
+};
+
+#endif
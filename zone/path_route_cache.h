@@ -0,0 +1,135 @@
+#ifndef EQEMU_PATH_ROUTE_CACHE_H
+#define EQEMU_PATH_ROUTE_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+	Recently searched navmesh corridors, the polygon lists findPath hands back.
+
+	A corridor only depends on the start and end polygons, the filter flags and the area costs,
+	so a herd of NPCs running at the same target from the same area shares one A* search and
+	each of them only runs the straight path pass for its own end points. Once full, the least
+	recently used corridor is dropped. Safe to use from several threads at once.
+*/
+class PathRouteCache {
+public:
+	static constexpr int CostCount = 10;
+
+	struct Key {
+		uint64_t start_ref;
+		uint64_t end_ref;
+		int      flags;
+		int      max_polys;
+		float    costs[CostCount];
+
+		bool operator==(const Key &o) const
+		{
+			return start_ref == o.start_ref && end_ref == o.end_ref && flags == o.flags && max_polys == o.max_polys &&
+				memcmp(costs, o.costs, sizeof(costs)) == 0;
+		}
+	};
+
+	explicit PathRouteCache(size_t capacity = 1024) : m_capacity(capacity), m_hits(0), m_misses(0) { }
+
+	void SetCapacity(size_t capacity)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_capacity = capacity;
+		Trim();
+	}
+
+	// copies the corridor out and marks it as recently used
+	bool Find(const Key &key, std::vector<uint64_t> &corridor)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		auto                        iter = m_index.find(key);
+		if (iter == m_index.end()) {
+			m_misses++;
+			return false;
+		}
+
+		m_entries.splice(m_entries.begin(), m_entries, iter->second);
+		corridor = iter->second->second;
+		m_hits++;
+		return true;
+	}
+
+	void Insert(const Key &key, std::vector<uint64_t> corridor)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		if (m_capacity == 0) {
+			return;
+		}
+
+		auto iter = m_index.find(key);
+		if (iter != m_index.end()) {
+			iter->second->second = std::move(corridor);
+			m_entries.splice(m_entries.begin(), m_entries, iter->second);
+			return;
+		}
+
+		m_entries.emplace_front(key, std::move(corridor));
+		m_index.emplace(key, m_entries.begin());
+		Trim();
+	}
+
+	void Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_entries.clear();
+		m_index.clear();
+	}
+
+	size_t Size() const
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		return m_entries.size();
+	}
+
+	uint64_t GetHits() const { return m_hits; }
+	uint64_t GetMisses() const { return m_misses; }
+
+	void ResetStats()
+	{
+		m_hits   = 0;
+		m_misses = 0;
+	}
+
+private:
+	struct KeyHash {
+		size_t operator()(const Key &k) const
+		{
+			size_t h = std::hash<uint64_t>()(k.start_ref);
+			h ^= std::hash<uint64_t>()(k.end_ref) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+			h ^= std::hash<int>()(k.flags ^ (k.max_polys << 16)) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+			return h;
+		}
+	};
+
+	typedef std::list<std::pair<Key, std::vector<uint64_t>>> EntryList;
+
+	void Trim()
+	{
+		while (m_entries.size() > m_capacity) {
+			m_index.erase(m_entries.back().first);
+			m_entries.pop_back();
+		}
+	}
+
+	mutable std::mutex                                        m_lock;
+	EntryList                                                 m_entries; // most recently used first
+	std::unordered_map<Key, EntryList::iterator, KeyHash>     m_index;
+	size_t                                                    m_capacity;
+	std::atomic<uint64_t>                                     m_hits;
+	std::atomic<uint64_t>                                     m_misses;
+};
+
+#endif //EQEMU_PATH_ROUTE_CACHE_H
@@ -78,5 +78,8 @@ public:
 	virtual glm::vec3 GetRandomLocation(const glm::vec3 &start, int flags = PathingNotDisabled) = 0;
 	virtual void DebugCommand(Client *c, const Seperator *sep) = 0;
 
+	// FindPath may be called from several threads at once
+	virtual bool IsThreadSafe() const { return false; }
+
 	static IPathfinder *Load(const std::string &zone);
 };
@@ -1,7 +1,10 @@
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <stdio.h>
 #include <vector>
 #include "pathfinder_nav_mesh.h"
+#include "path_route_cache.h"
 #include <DetourCommon.h>
 #include <DetourNavMeshQuery.h>
 
@@ -15,14 +18,78 @@ extern Zone *zone;
 struct PathfinderNavmesh::Implementation
 {
 	dtNavMesh *nav_mesh;
-	dtNavMeshQuery *query;
+
+	// Detour queries hold per search state, every search checks an idle one out so that
+	// path requests running on worker threads never share one
+	std::mutex queries_lock;
+	std::vector<dtNavMeshQuery*> queries;
+
+	PathRouteCache routes;
+
+	struct Query
+	{
+		Query(Implementation *impl) : impl(impl) {
+			{
+				std::lock_guard<std::mutex> lock(impl->queries_lock);
+				if (!impl->queries.empty()) {
+					query = impl->queries.back();
+					impl->queries.pop_back();
+				}
+				else {
+					query = dtAllocNavMeshQuery();
+				}
+			}
+
+			query->init(impl->nav_mesh, RuleI(Pathing, MaxNavmeshNodes));
+		}
+
+		~Query() {
+			std::lock_guard<std::mutex> lock(impl->queries_lock);
+			impl->queries.push_back(query);
+		}
+
+		dtNavMeshQuery *operator->() const { return query; }
+
+		Implementation *impl;
+		dtNavMeshQuery *query;
+	};
+
+	// the polygon corridor between two polys, from the route cache when another mob already searched it
+	int FindCorridor(dtNavMeshQuery *query, dtPolyRef start_ref, dtPolyRef end_ref, const glm::vec3 &start, const glm::vec3 &end,
+		const dtQueryFilter &filter, const float *costs, dtPolyRef *path, int max_polys)
+	{
+		PathRouteCache::Key key;
+		key.start_ref = start_ref;
+		key.end_ref = end_ref;
+		key.flags = filter.getIncludeFlags();
+		key.max_polys = max_polys;
+		memcpy(key.costs, costs, sizeof(key.costs));
+
+		std::vector<uint64_t> corridor;
+		if (routes.Find(key, corridor)) {
+			int npoly = std::min(static_cast<int>(corridor.size()), max_polys);
+			for (int i = 0; i < npoly; ++i) {
+				path[i] = static_cast<dtPolyRef>(corridor[i]);
+			}
+
+			return npoly;
+		}
+
+		int npoly = 0;
+		query->findPath(start_ref, end_ref, &start[0], &end[0], &filter, path, &npoly, max_polys);
+		if (npoly) {
+			routes.Insert(key, std::vector<uint64_t>(path, path + npoly));
+		}
+
+		return npoly;
+	}
 };
 
 PathfinderNavmesh::PathfinderNavmesh(const std::string &path)
 {
 	m_impl = std::make_unique<Implementation>();
 	m_impl->nav_mesh = nullptr;
-	m_impl->query = nullptr;
+	m_impl->routes.SetCapacity(std::max(0, RuleI(Pathing, RouteCacheSize)));
 	Load(path);
 }
 
@@ -39,46 +106,44 @@ IPathfinder::IPath PathfinderNavmesh::FindRoute(const glm::vec3 &start, const gl
 		return IPath();
 	}
 
-	if (!m_impl->query) {
-		m_impl->query = dtAllocNavMeshQuery();
-	}
-
-	m_impl->query->init(m_impl->nav_mesh, RuleI(Pathing, MaxNavmeshNodes));
+	Implementation::Query query(m_impl.get());
 	glm::vec3 current_location(start.x, start.z, start.y);
 	glm::vec3 dest_location(end.x, end.z, end.y);
 
+	static const float costs[PathRouteCache::CostCount] = { 1.0f, 3.0f, 5.0f, 1.0f, 2.0f, 2.0f, 4.0f, 1.0f, 0.1f, 0.1f };
+
 	dtQueryFilter filter;
 	filter.setIncludeFlags(flags);
-	filter.setAreaCost(0, 1.0f); //Normal
-	filter.setAreaCost(1, 3.0f); //Water
-	filter.setAreaCost(2, 5.0f); //Lava
-	filter.setAreaCost(4, 1.0f); //PvP
-	filter.setAreaCost(5, 2.0f); //Slime
-	filter.setAreaCost(6, 2.0f); //Ice
-	filter.setAreaCost(7, 4.0f); //V Water (Frigid Water)
-	filter.setAreaCost(8, 1.0f); //General Area
-	filter.setAreaCost(9, 0.1f); //Portal
-	filter.setAreaCost(10, 0.1f); //Prefer
+	filter.setAreaCost(0, costs[0]); //Normal
+	filter.setAreaCost(1, costs[1]); //Water
+	filter.setAreaCost(2, costs[2]); //Lava
+	filter.setAreaCost(4, costs[3]); //PvP
+	filter.setAreaCost(5, costs[4]); //Slime
+	filter.setAreaCost(6, costs[5]); //Ice
+	filter.setAreaCost(7, costs[6]); //V Water (Frigid Water)
+	filter.setAreaCost(8, costs[7]); //General Area
+	filter.setAreaCost(9, costs[8]); //Portal
+	filter.setAreaCost(10, costs[9]); //Prefer
 
 	dtPolyRef start_ref;
 	dtPolyRef end_ref;
 	glm::vec3 ext(5.0f, 100.0f, 5.0f);
 
-	m_impl->query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
-	m_impl->query->findNearestPoly(&dest_location[0], &ext[0], &filter, &end_ref, 0);
+	query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
+	query->findNearestPoly(&dest_location[0], &ext[0], &filter, &end_ref, 0);
 
 	if (!start_ref || !end_ref) {
 		return IPath();
 	}
 
-	int npoly = 0;
 	dtPolyRef path[1024] = { 0 };
-	auto status = m_impl->query->findPath(start_ref, end_ref, &current_location[0], &dest_location[0], &filter, path, &npoly, 1024);
+	int npoly = m_impl->FindCorridor(query.query, start_ref, end_ref, current_location, dest_location, filter, costs, path, 1024);
+	dtStatus status;
 
 	if (npoly) {
 		glm::vec3 epos = dest_location;
 		if (path[npoly - 1] != end_ref) {
-			m_impl->query->closestPointOnPoly(path[npoly - 1], &dest_location[0], &epos[0], 0);
+			query->closestPointOnPoly(path[npoly - 1], &dest_location[0], &epos[0], 0);
 			partial = true;
 
 			auto dist = DistanceSquared(epos, current_location);
@@ -93,7 +158,7 @@ IPathfinder::IPath PathfinderNavmesh::FindRoute(const glm::vec3 &start, const gl
 		int n_straight_polys;
 		dtPolyRef straight_path_polys[2048];
 
-		status = m_impl->query->findStraightPath(&current_location[0], &epos[0], path, npoly,
+		status = query->findStraightPath(&current_location[0], &epos[0], path, npoly,
 			straight_path, straight_path_flags,
 			straight_path_polys, &n_straight_polys, 2048, DT_STRAIGHTPATH_AREA_CROSSINGS);
 
@@ -137,11 +202,7 @@ IPathfinder::IPath PathfinderNavmesh::FindPath(const glm::vec3 &start, const glm
 		return IPath();
 	}
 
-	if (!m_impl->query) {
-		m_impl->query = dtAllocNavMeshQuery();
-	}
-
-	m_impl->query->init(m_impl->nav_mesh, RuleI(Pathing, MaxNavmeshNodes));
+	Implementation::Query query(m_impl.get());
 	glm::vec3 current_location(start.x, start.z, start.y);
 	glm::vec3 dest_location(end.x, end.z, end.y);
 
@@ -163,21 +224,20 @@ IPathfinder::IPath PathfinderNavmesh::FindPath(const glm::vec3 &start, const glm
 	dtPolyRef end_ref;
 	glm::vec3 ext(10.0f, 200.0f, 10.0f);
 
-	m_impl->query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
-	m_impl->query->findNearestPoly(&dest_location[0], &ext[0], &filter, &end_ref, 0);
+	query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
+	query->findNearestPoly(&dest_location[0], &ext[0], &filter, &end_ref, 0);
 
 	if (!start_ref || !end_ref) {
 		return IPath();
 	}
 
-	int npoly = 0;
 	dtPolyRef path[max_polys] = { 0 };
-	auto status = m_impl->query->findPath(start_ref, end_ref, &current_location[0], &dest_location[0], &filter, path, &npoly, max_polys);
+	int npoly = m_impl->FindCorridor(query.query, start_ref, end_ref, current_location, dest_location, filter, opts.flag_cost, path, max_polys);
 
 	if (npoly) {
 		glm::vec3 epos = dest_location;
 		if (path[npoly - 1] != end_ref) {
-			m_impl->query->closestPointOnPoly(path[npoly - 1], &dest_location[0], &epos[0], 0);
+			query->closestPointOnPoly(path[npoly - 1], &dest_location[0], &epos[0], 0);
 			partial = true;
 
 			auto dist = DistanceSquared(epos, current_location);
@@ -191,7 +251,7 @@ IPathfinder::IPath PathfinderNavmesh::FindPath(const glm::vec3 &start, const glm
 		unsigned char straight_path_flags[max_polys];
 		dtPolyRef straight_path_polys[max_polys];
 
-		auto status = m_impl->query->findStraightPath(&current_location[0], &epos[0], path, npoly,
+		auto status = query->findStraightPath(&current_location[0], &epos[0], path, npoly,
 			(float*)&straight_path[0], straight_path_flags,
 			straight_path_polys, &n_straight_polys, 2048, DT_STRAIGHTPATH_AREA_CROSSINGS | DT_STRAIGHTPATH_ALL_CROSSINGS);
 
@@ -309,10 +369,7 @@ glm::vec3 PathfinderNavmesh::GetRandomLocation(const glm::vec3 &start, int flags
 		return glm::vec3(0.f);
 	}
 
-	if (!m_impl->query) {
-		m_impl->query = dtAllocNavMeshQuery();
-		m_impl->query->init(m_impl->nav_mesh, RuleI(Pathing, MaxNavmeshNodes));
-	}
+	Implementation::Query query(m_impl.get());
 
 	dtQueryFilter filter;
 	filter.setIncludeFlags(flags);
@@ -334,14 +391,14 @@ glm::vec3 PathfinderNavmesh::GetRandomLocation(const glm::vec3 &start, int flags
 	glm::vec3 current_location(start.x, start.z, start.y);
 	glm::vec3 ext(5.0f, 100.0f, 5.0f);
 
-	m_impl->query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
+	query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
 
 	if (!start_ref)
 	{
 		return glm::vec3(0.f);
 	}
 
-	if (dtStatusSucceed(m_impl->query->findRandomPointAroundCircle(start_ref, &current_location[0], 100.f, &filter, []() { return (float)zone->random.Real(0.0, 1.0); }, &randomRef, point)))
+	if (dtStatusSucceed(query->findRandomPointAroundCircle(start_ref, &current_location[0], 100.f, &filter, []() { return (float)zone->random.Real(0.0, 1.0); }, &randomRef, point)))
 	{
 		return glm::vec3(point[0], point[2], point[1]);
 	}
@@ -354,6 +411,25 @@ void PathfinderNavmesh::DebugCommand(Client *c, const Seperator *sep)
 	if (sep->arg[1][0] == '\0' || !strcasecmp(sep->arg[1], "help"))
 	{
 		c->Message(Chat::White, "#path show: Plots a path from the user to their target.");
+		c->Message(Chat::White, "#path stats: Shows how often path searches were served from the route cache.");
+		return;
+	}
+
+	if (!strcasecmp(sep->arg[1], "stats"))
+	{
+		auto hits = m_impl->routes.GetHits();
+		auto misses = m_impl->routes.GetMisses();
+		auto total = hits + misses;
+
+		c->Message(
+			Chat::White,
+			"Route cache: %u corridors, %u hits, %u misses (%.1f%% hit rate)",
+			static_cast<uint32>(m_impl->routes.Size()),
+			static_cast<uint32>(hits),
+			static_cast<uint32>(misses),
+			total ? 100.0 * static_cast<double>(hits) / static_cast<double>(total) : 0.0
+		);
+
 		return;
 	}
 
@@ -377,9 +453,12 @@ void PathfinderNavmesh::Clear()
 		dtFreeNavMesh(m_impl->nav_mesh);
 	}
 
-	if (m_impl->query) {
-		dtFreeNavMeshQuery(m_impl->query);
+	for (auto query : m_impl->queries) {
+		dtFreeNavMeshQuery(query);
 	}
+
+	m_impl->queries.clear();
+	m_impl->routes.Clear();
 }
 
 void PathfinderNavmesh::Load(const std::string &path)
@@ -14,6 +14,7 @@ public:
 	virtual IPath FindPath(const glm::vec3 &start, const glm::vec3 &end, bool &partial, bool &stuck, const PathfinderOptions& opts);
 	virtual glm::vec3 GetRandomLocation(const glm::vec3 &start, int flags = PathingNotDisabled);
 	virtual void DebugCommand(Client *c, const Seperator *sep);
+	virtual bool IsThreadSafe() const { return true; }
 
 private:
 	void Clear();
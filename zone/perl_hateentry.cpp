@@ -34,17 +34,29 @@ void Perl_HateEntry_SetDamage(struct_HateList* self, int64 value) // @categories
 
 void Perl_HateEntry_SetEnt(struct_HateList* self, Mob* mob) // @categories Script Utility, Hate and Aggro
 {
-	self->entity_on_hatelist = mob;
+	if (self->owner) {
+		self->owner->SetEntryEntity(self, mob);
+	} else {
+		self->entity_on_hatelist = mob;
+	}
 }
 
 void Perl_HateEntry_SetFrenzy(struct_HateList* self, bool is_frenzy) // @categories Script Utility, Hate and Aggro
 {
-	self->is_entity_frenzy = is_frenzy;
+	if (self->owner) {
+		self->owner->SetEntryFrenzy(self, is_frenzy);
+	} else {
+		self->is_entity_frenzy = is_frenzy;
+	}
 }
 
 void Perl_HateEntry_SetHate(struct_HateList* self, int64 value) // @categories Script Utility, Hate and Aggro
 {
-	self->stored_hate_amount = value;
+	if (self->owner) {
+		self->owner->SetEntryHate(self, value);
+	} else {
+		self->stored_hate_amount = value;
+	}
 }
 
 void perl_register_hateentry()
@@ -103,6 +103,17 @@ void QuestParserCollection::ReloadQuests(bool reset_timers)
 	_item_quest_status.clear();
 	_encounter_quest_status.clear();
 
+	_npc_quest_subs.clear();
+	_spell_quest_subs.clear();
+	_item_quest_subs.clear();
+	_global_npc_quest_subs.reset();
+	_player_quest_subs.reset();
+	_global_player_quest_subs.reset();
+	_bot_quest_subs.reset();
+	_global_bot_quest_subs.reset();
+	_merc_quest_subs.reset();
+	_global_merc_quest_subs.reset();
+
 	for (const auto& e: _load_precedence) {
 		e->ReloadQuests();
 	}
@@ -124,64 +135,82 @@ bool QuestParserCollection::HasQuestSub(uint32 npc_id, QuestEventID event_id)
 	);
 }
 
+QuestParserCollection::QuestEventSubs QuestParserCollection::CompileQuestSubs(
+	const std::function<bool(QuestEventID)>& has_sub
+)
+{
+	QuestEventSubs subs;
+	for (int i = 0; i < _LargestEventID; i++) {
+		if (has_sub(static_cast<QuestEventID>(i))) {
+			subs.set(i);
+		}
+	}
+
+	return subs;
+}
+
 bool QuestParserCollection::NPCHasEncounterSub(uint32 npc_id, QuestEventID event_id)
 {
+	if (_encounter_quest_status.empty()) {
+		return false;
+	}
+
 	return HasEncounterSub(event_id, fmt::format("npc_{}", npc_id)) || HasEncounterSub(event_id, "npc_" + ENCOUNTER_NO_ENTITY_ID);
 }
 
 bool QuestParserCollection::HasQuestSubLocal(uint32 npc_id, QuestEventID event_id)
 {
-	auto iter = _npc_quest_status.find(npc_id);
+	auto subs = _npc_quest_subs.find(npc_id);
+	if (subs == _npc_quest_subs.end()) {
+		QuestInterface* qi   = nullptr;
+		auto            iter = _npc_quest_status.find(npc_id);
 
-	if (iter != _npc_quest_status.end()) {
-		if (iter->second != QuestFailedToLoad) { //loaded or failed to load
-			auto qiter = _interfaces.find(iter->second);
-			if (qiter->second->HasQuestSub(npc_id, event_id)) {
-				return true;
-			}
-		}
-	} else {
-		std::string filename;
-		auto        qi = GetQIByNPCQuest(npc_id, filename);
-
-		if (qi) {
-			_npc_quest_status[npc_id] = qi->GetIdentifier();
-
-			qi->LoadNPCScript(filename, npc_id);
-			if (qi->HasQuestSub(npc_id, event_id)) {
-				return true;
+		if (iter != _npc_quest_status.end()) {
+			if (iter->second != QuestFailedToLoad) { //loaded or failed to load
+				qi = _interfaces.find(iter->second)->second;
 			}
 		} else {
-			_npc_quest_status[npc_id] = QuestFailedToLoad;
+			std::string filename;
+			qi = GetQIByNPCQuest(npc_id, filename);
+
+			if (qi) {
+				_npc_quest_status[npc_id] = qi->GetIdentifier();
+				qi->LoadNPCScript(filename, npc_id);
+			} else {
+				_npc_quest_status[npc_id] = QuestFailedToLoad;
+			}
 		}
+
+		subs = _npc_quest_subs.emplace(
+			npc_id,
+			CompileQuestSubs([&](QuestEventID e) { return qi && qi->HasQuestSub(npc_id, e); })
+		).first;
 	}
 
-	return false;
+	return HasQuestEventSub(subs->second, event_id);
 }
 
 bool QuestParserCollection::HasQuestSubGlobal(QuestEventID event_id)
 {
-	if (_global_npc_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByGlobalNPCQuest(filename);
+	if (!_global_npc_quest_subs) {
+		QuestInterface* qi = nullptr;
 
-		if (qi) {
-			qi->LoadGlobalNPCScript(filename);
-			_global_npc_quest_status = qi->GetIdentifier();
-			if (qi->HasGlobalQuestSub(event_id)) {
-				return true;
-			}
-		}
-	} else {
-		if (_global_npc_quest_status != QuestFailedToLoad) {
-			auto qiter = _interfaces.find(_global_npc_quest_status);
-			if (qiter->second->HasGlobalQuestSub(event_id)) {
-				return true;
+		if (_global_npc_quest_status == QuestUnloaded) {
+			std::string filename;
+			qi = GetQIByGlobalNPCQuest(filename);
+
+			if (qi) {
+				qi->LoadGlobalNPCScript(filename);
+				_global_npc_quest_status = qi->GetIdentifier();
 			}
+		} else if (_global_npc_quest_status != QuestFailedToLoad) {
+			qi = _interfaces.find(_global_npc_quest_status)->second;
 		}
+
+		_global_npc_quest_subs = CompileQuestSubs([&](QuestEventID e) { return qi && qi->HasGlobalQuestSub(e); });
 	}
 
-	return false;
+	return HasQuestEventSub(*_global_npc_quest_subs, event_id);
 }
 
 bool QuestParserCollection::PlayerHasQuestSub(QuestEventID event_id)
@@ -200,44 +229,56 @@ bool QuestParserCollection::PlayerHasEncounterSub(QuestEventID event_id)
 
 bool QuestParserCollection::PlayerHasQuestSubLocal(QuestEventID event_id)
 {
-	if (_player_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByPlayerQuest(filename);
+	if (!_player_quest_subs) {
+		QuestInterface* qi = nullptr;
 
-		if (qi) {
-			_player_quest_status = qi->GetIdentifier();
-			qi->LoadPlayerScript(filename);
-			return qi->PlayerHasQuestSub(event_id);
+		if (_player_quest_status == QuestUnloaded) {
+			std::string filename;
+			qi = GetQIByPlayerQuest(filename);
+
+			if (qi) {
+				_player_quest_status = qi->GetIdentifier();
+				qi->LoadPlayerScript(filename);
+			}
+		} else if (_player_quest_status != QuestFailedToLoad) {
+			qi = _interfaces.find(_player_quest_status)->second;
 		}
-	} else if (_player_quest_status != QuestFailedToLoad) {
-		auto iter = _interfaces.find(_player_quest_status);
-		return iter->second->PlayerHasQuestSub(event_id);
+
+		_player_quest_subs = CompileQuestSubs([&](QuestEventID e) { return qi && qi->PlayerHasQuestSub(e); });
 	}
 
-	return false;
+	return HasQuestEventSub(*_player_quest_subs, event_id);
 }
 
 bool QuestParserCollection::PlayerHasQuestSubGlobal(QuestEventID event_id)
 {
-	if (_global_player_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByGlobalPlayerQuest(filename);
+	if (!_global_player_quest_subs) {
+		QuestInterface* qi = nullptr;
 
-		if (qi) {
-			_global_player_quest_status = qi->GetIdentifier();
-			qi->LoadGlobalPlayerScript(filename);
-			return qi->GlobalPlayerHasQuestSub(event_id);
+		if (_global_player_quest_status == QuestUnloaded) {
+			std::string filename;
+			qi = GetQIByGlobalPlayerQuest(filename);
+
+			if (qi) {
+				_global_player_quest_status = qi->GetIdentifier();
+				qi->LoadGlobalPlayerScript(filename);
+			}
+		} else if (_global_player_quest_status != QuestFailedToLoad) {
+			qi = _interfaces.find(_global_player_quest_status)->second;
 		}
-	} else if (_global_player_quest_status != QuestFailedToLoad) {
-		auto iter = _interfaces.find(_global_player_quest_status);
-		return iter->second->GlobalPlayerHasQuestSub(event_id);
+
+		_global_player_quest_subs = CompileQuestSubs([&](QuestEventID e) { return qi && qi->GlobalPlayerHasQuestSub(e); });
 	}
 
-	return false;
+	return HasQuestEventSub(*_global_player_quest_subs, event_id);
 }
 
 bool QuestParserCollection::SpellHasEncounterSub(uint32 spell_id, QuestEventID event_id)
 {
+	if (_encounter_quest_status.empty()) {
+		return false;
+	}
+
 	return HasEncounterSub(event_id, fmt::format("spell_{}", spell_id)) ||
 		   HasEncounterSub(event_id, "spell_" + ENCOUNTER_NO_ENTITY_ID);
 }
@@ -248,32 +289,40 @@ bool QuestParserCollection::SpellHasQuestSub(uint32 spell_id, QuestEventID event
 		return true;
 	}
 
-	auto iter = _spell_quest_status.find(spell_id);
-	if (iter != _spell_quest_status.end()) {
-		//loaded or failed to load
-		if (iter->second != QuestFailedToLoad) {
-			auto qiter = _interfaces.find(iter->second);
-			return qiter->second->SpellHasQuestSub(spell_id, event_id);
-		}
-	} else if (_spell_quest_status[spell_id] != QuestFailedToLoad) {
-		std::string filename;
-		auto        qi = GetQIBySpellQuest(spell_id, filename);
+	auto subs = _spell_quest_subs.find(spell_id);
+	if (subs == _spell_quest_subs.end()) {
+		QuestInterface* qi   = nullptr;
+		auto            iter = _spell_quest_status.find(spell_id);
 
-		if (qi) {
-			_spell_quest_status[spell_id] = qi->GetIdentifier();
-			qi->LoadSpellScript(filename, spell_id);
-			return qi->SpellHasQuestSub(spell_id, event_id);
+		if (iter != _spell_quest_status.end()) {
+			//loaded or failed to load
+			if (iter->second != QuestFailedToLoad) {
+				qi = _interfaces.find(iter->second)->second;
+			}
 		} else {
-			_spell_quest_status[spell_id] = QuestFailedToLoad;
+			std::string filename;
+			qi = GetQIBySpellQuest(spell_id, filename);
+
+			if (qi) {
+				_spell_quest_status[spell_id] = qi->GetIdentifier();
+				qi->LoadSpellScript(filename, spell_id);
+			} else {
+				_spell_quest_status[spell_id] = QuestFailedToLoad;
+			}
 		}
+
+		subs = _spell_quest_subs.emplace(
+			spell_id,
+			CompileQuestSubs([&](QuestEventID e) { return qi && qi->SpellHasQuestSub(spell_id, e); })
+		).first;
 	}
 
-	return false;
+	return HasQuestEventSub(subs->second, event_id);
 }
 
 bool QuestParserCollection::ItemHasEncounterSub(EQ::ItemInstance *inst, QuestEventID event_id)
 {
-	if (inst) {
+	if (inst && !_encounter_quest_status.empty()) {
 		return HasEncounterSub(event_id, fmt::format("item_{}", inst->GetID())) ||
 			   HasEncounterSub(event_id, "item_" + ENCOUNTER_NO_ENTITY_ID);
 	}
@@ -291,39 +340,47 @@ bool QuestParserCollection::ItemHasQuestSub(EQ::ItemInstance* inst, QuestEventID
 		return true;
 	}
 
-	std::string item_script;
-	if (inst->GetItem()->ScriptFileID != 0) {
-		item_script = fmt::format(
-			"script_{}",
-			inst->GetItem()->ScriptFileID
-		);
-	} else if (strlen(inst->GetItem()->CharmFile) > 0) {
-		item_script = inst->GetItem()->CharmFile;
-	} else {
-		item_script = std::to_string(inst->GetID());
-	}
-
 	uint32 item_id = inst->GetID();
-	auto   iter    = _item_quest_status.find(item_id);
-	if (iter != _item_quest_status.end()) {
-		//loaded or failed to load
-		if (iter->second != QuestFailedToLoad) {
-			auto qiter = _interfaces.find(iter->second);
-			return qiter->second->ItemHasQuestSub(inst, event_id);
-		}
-	} else {
-		std::string filename;
-		auto        qi = GetQIByItemQuest(item_script, filename);
-		if (qi) {
-			_item_quest_status[item_id] = qi->GetIdentifier();
-			qi->LoadItemScript(filename, inst);
-			return qi->ItemHasQuestSub(inst, event_id);
+	auto   subs    = _item_quest_subs.find(item_id);
+	if (subs == _item_quest_subs.end()) {
+		QuestInterface* qi   = nullptr;
+		auto            iter = _item_quest_status.find(item_id);
+
+		if (iter != _item_quest_status.end()) {
+			//loaded or failed to load
+			if (iter->second != QuestFailedToLoad) {
+				qi = _interfaces.find(iter->second)->second;
+			}
 		} else {
-			_item_quest_status[item_id] = QuestFailedToLoad;
+			std::string item_script;
+			if (inst->GetItem()->ScriptFileID != 0) {
+				item_script = fmt::format(
+					"script_{}",
+					inst->GetItem()->ScriptFileID
+				);
+			} else if (strlen(inst->GetItem()->CharmFile) > 0) {
+				item_script = inst->GetItem()->CharmFile;
+			} else {
+				item_script = std::to_string(inst->GetID());
+			}
+
+			std::string filename;
+			qi = GetQIByItemQuest(item_script, filename);
+			if (qi) {
+				_item_quest_status[item_id] = qi->GetIdentifier();
+				qi->LoadItemScript(filename, inst);
+			} else {
+				_item_quest_status[item_id] = QuestFailedToLoad;
+			}
 		}
+
+		subs = _item_quest_subs.emplace(
+			item_id,
+			CompileQuestSubs([&](QuestEventID e) { return qi && qi->ItemHasQuestSub(inst, e); })
+		).first;
 	}
 
-	return false;
+	return HasQuestEventSub(subs->second, event_id);
 }
 
 bool QuestParserCollection::HasEncounterSub(QuestEventID event_id, const std::string& package_name)
@@ -342,40 +399,48 @@ bool QuestParserCollection::HasEncounterSub(QuestEventID event_id, const std::st
 
 bool QuestParserCollection::BotHasQuestSubLocal(QuestEventID event_id)
 {
-	if (_bot_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByBotQuest(filename);
+	if (!_bot_quest_subs) {
+		QuestInterface* qi = nullptr;
 
-		if (qi) {
-			_bot_quest_status = qi->GetIdentifier();
-			qi->LoadBotScript(filename);
-			return qi->BotHasQuestSub(event_id);
+		if (_bot_quest_status == QuestUnloaded) {
+			std::string filename;
+			qi = GetQIByBotQuest(filename);
+
+			if (qi) {
+				_bot_quest_status = qi->GetIdentifier();
+				qi->LoadBotScript(filename);
+			}
+		} else if (_bot_quest_status != QuestFailedToLoad) {
+			qi = _interfaces.find(_bot_quest_status)->second;
 		}
-	} else if (_bot_quest_status != QuestFailedToLoad) {
-		auto iter = _interfaces.find(_bot_quest_status);
-		return iter->second->BotHasQuestSub(event_id);
+
+		_bot_quest_subs = CompileQuestSubs([&](QuestEventID e) { return qi && qi->BotHasQuestSub(e); });
 	}
 
-	return false;
+	return HasQuestEventSub(*_bot_quest_subs, event_id);
 }
 
 bool QuestParserCollection::BotHasQuestSubGlobal(QuestEventID event_id)
 {
-	if (_global_bot_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByGlobalBotQuest(filename);
+	if (!_global_bot_quest_subs) {
+		QuestInterface* qi = nullptr;
 
-		if (qi) {
-			_global_bot_quest_status = qi->GetIdentifier();
-			qi->LoadGlobalBotScript(filename);
-			return qi->GlobalBotHasQuestSub(event_id);
+		if (_global_bot_quest_status == QuestUnloaded) {
+			std::string filename;
+			qi = GetQIByGlobalBotQuest(filename);
+
+			if (qi) {
+				_global_bot_quest_status = qi->GetIdentifier();
+				qi->LoadGlobalBotScript(filename);
+			}
+		} else if (_global_bot_quest_status != QuestFailedToLoad) {
+			qi = _interfaces.find(_global_bot_quest_status)->second;
 		}
-	} else if (_global_bot_quest_status != QuestFailedToLoad) {
-		auto iter = _interfaces.find(_global_bot_quest_status);
-		return iter->second->GlobalBotHasQuestSub(event_id);
+
+		_global_bot_quest_subs = CompileQuestSubs([&](QuestEventID e) { return qi && qi->GlobalBotHasQuestSub(e); });
 	}
 
-	return false;
+	return HasQuestEventSub(*_global_bot_quest_subs, event_id);
 }
 
 bool QuestParserCollection::BotHasQuestSub(QuestEventID event_id)
@@ -385,40 +450,48 @@ bool QuestParserCollection::BotHasQuestSub(QuestEventID event_id)
 
 bool QuestParserCollection::MercHasQuestSubLocal(QuestEventID event_id)
 {
-	if (_merc_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByMercQuest(filename);
+	if (!_merc_quest_subs) {
+		QuestInterface* qi = nullptr;
 
-		if (qi) {
-			_merc_quest_status = qi->GetIdentifier();
-			qi->LoadMercScript(filename);
-			return qi->MercHasQuestSub(event_id);
+		if (_merc_quest_status == QuestUnloaded) {
+			std::string filename;
+			qi = GetQIByMercQuest(filename);
+
+			if (qi) {
+				_merc_quest_status = qi->GetIdentifier();
+				qi->LoadMercScript(filename);
+			}
+		} else if (_merc_quest_status != QuestFailedToLoad) {
+			qi = _interfaces.find(_merc_quest_status)->second;
 		}
-	} else if (_merc_quest_status != QuestFailedToLoad) {
-		auto iter = _interfaces.find(_merc_quest_status);
-		return iter->second->MercHasQuestSub(event_id);
+
+		_merc_quest_subs = CompileQuestSubs([&](QuestEventID e) { return qi && qi->MercHasQuestSub(e); });
 	}
 
-	return false;
+	return HasQuestEventSub(*_merc_quest_subs, event_id);
 }
 
 bool QuestParserCollection::MercHasQuestSubGlobal(QuestEventID event_id)
 {
-	if (_global_merc_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByGlobalMercQuest(filename);
+	if (!_global_merc_quest_subs) {
+		QuestInterface* qi = nullptr;
 
-		if (qi) {
-			_global_merc_quest_status = qi->GetIdentifier();
-			qi->LoadGlobalMercScript(filename);
-			return qi->GlobalMercHasQuestSub(event_id);
+		if (_global_merc_quest_status == QuestUnloaded) {
+			std::string filename;
+			qi = GetQIByGlobalMercQuest(filename);
+
+			if (qi) {
+				_global_merc_quest_status = qi->GetIdentifier();
+				qi->LoadGlobalMercScript(filename);
+			}
+		} else if (_global_merc_quest_status != QuestFailedToLoad) {
+			qi = _interfaces.find(_global_merc_quest_status)->second;
 		}
-	} else if (_global_merc_quest_status != QuestFailedToLoad) {
-		auto iter = _interfaces.find(_global_merc_quest_status);
-		return iter->second->GlobalMercHasQuestSub(event_id);
+
+		_global_merc_quest_subs = CompileQuestSubs([&](QuestEventID e) { return qi && qi->GlobalMercHasQuestSub(e); });
 	}
 
-	return false;
+	return HasQuestEventSub(*_global_merc_quest_subs, event_id);
 }
 
 bool QuestParserCollection::MercHasQuestSub(QuestEventID event_id)
@@ -463,6 +536,12 @@ int QuestParserCollection::EventNPCLocal(
 	std::vector<std::any>* extra_pointers
 )
 {
+	// a script that has been checked already, and doesn't define the event, has nothing to run
+	auto subs = _npc_quest_subs.find(npc->GetNPCTypeID());
+	if (subs != _npc_quest_subs.end() && !HasQuestEventSub(subs->second, event_id)) {
+		return 0;
+	}
+
 	auto iter = _npc_quest_status.find(npc->GetNPCTypeID());
 	if (iter != _npc_quest_status.end()) {
 		//loaded or failed to load
@@ -495,6 +574,10 @@ int QuestParserCollection::EventNPCGlobal(
 	std::vector<std::any>* extra_pointers
 )
 {
+	if (_global_npc_quest_subs && !HasQuestEventSub(*_global_npc_quest_subs, event_id)) {
+		return 0;
+	}
+
 	if (_global_npc_quest_status != QuestUnloaded && _global_npc_quest_status != QuestFailedToLoad) {
 		auto qiter = _interfaces.find(_global_npc_quest_status);
 		return qiter->second->EventGlobalNPC(event_id, npc, init, data, extra_data, extra_pointers);
@@ -545,6 +628,10 @@ int QuestParserCollection::EventPlayerLocal(
 	std::vector<std::any>* extra_pointers
 )
 {
+	if (_player_quest_subs && !HasQuestEventSub(*_player_quest_subs, event_id)) {
+		return 0;
+	}
+
 	if (_player_quest_status == QuestUnloaded) {
 		std::string filename;
 		auto        qi = GetQIByPlayerQuest(filename);
@@ -572,6 +659,10 @@ int QuestParserCollection::EventPlayerGlobal(
 	std::vector<std::any>* extra_pointers
 )
 {
+	if (_global_player_quest_subs && !HasQuestEventSub(*_global_player_quest_subs, event_id)) {
+		return 0;
+	}
+
 	if (_global_player_quest_status == QuestUnloaded) {
 		std::string filename;
 		auto        qi = GetQIByGlobalPlayerQuest(filename);
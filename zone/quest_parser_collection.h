@@ -36,8 +36,12 @@
 
 #include "zone_config.h"
 
+#include <bitset>
+#include <functional>
 #include <list>
 #include <map>
+#include <optional>
+#include <unordered_map>
 
 #define QuestFailedToLoad 0xFFFFFFFF
 #define QuestUnloaded 0x00
@@ -196,6 +200,16 @@ public:
 	void LoadPerlEventExportSettings(PerlEventExportSettings* s);
 
 private:
+	// the events a loaded script defines, asked of its interface once when first checked so every later
+	// check is a bit test, cleared by ReloadQuests
+	using QuestEventSubs = std::bitset<_LargestEventID>;
+
+	static QuestEventSubs CompileQuestSubs(const std::function<bool(QuestEventID)>& has_sub);
+	static inline bool HasQuestEventSub(const QuestEventSubs& subs, QuestEventID event_id)
+	{
+		return event_id < _LargestEventID && subs.test(event_id);
+	}
+
 	bool HasQuestSubLocal(uint32 npc_id, QuestEventID event_id);
 	bool HasQuestSubGlobal(QuestEventID event_id);
 	bool NPCHasEncounterSub(uint32 npc_id, QuestEventID event_id);
@@ -362,6 +376,17 @@ private:
 	std::map<uint32, uint32>      _spell_quest_status;
 	std::map<uint32, uint32>      _item_quest_status;
 	std::map<std::string, uint32> _encounter_quest_status;
+
+	std::unordered_map<uint32, QuestEventSubs> _npc_quest_subs;
+	std::unordered_map<uint32, QuestEventSubs> _spell_quest_subs;
+	std::unordered_map<uint32, QuestEventSubs> _item_quest_subs;
+	std::optional<QuestEventSubs>              _global_npc_quest_subs;
+	std::optional<QuestEventSubs>              _player_quest_subs;
+	std::optional<QuestEventSubs>              _global_player_quest_subs;
+	std::optional<QuestEventSubs>              _bot_quest_subs;
+	std::optional<QuestEventSubs>              _global_bot_quest_subs;
+	std::optional<QuestEventSubs>              _merc_quest_subs;
+	std::optional<QuestEventSubs>              _global_merc_quest_subs;
 };
 
 extern QuestParserCollection *parse;
@@ -0,0 +1,924 @@
+#include "raycast_bvh.h"
+#include "../common/memory/ksm.hpp"
+#include "../common/eqemu_logsys.h"
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RAYCAST_BVH_SSE
+#include <emmintrin.h>
+#endif
+
+namespace RAYCAST_BVH
+{
+
+static const RmUint32 LeafFlag         = 0x80000000;
+static const RmUint32 EmptyChild       = 0xFFFFFFFF;
+static const RmUint32 NoTriangle       = 0xFFFFFFFF;
+static const RmUint32 MaxLeafSize      = 4;
+static const RmUint32 BinCount         = 16;
+static const RmUint32 SerializeVersion = 1;
+
+struct alignas(16) Node4
+{
+	RmReal		bminX[4], bminY[4], bminZ[4];
+	RmReal		bmaxX[4], bmaxY[4], bmaxZ[4];
+	RmUint32	child[4];	// a Node4, LeafFlag | a TriPacket, or EmptyChild
+};
+
+struct alignas(16) TriPacket
+{
+	RmReal		v0X[4], v0Y[4], v0Z[4];
+	RmReal		e1X[4], e1Y[4], e1Z[4];	// v1 - v0
+	RmReal		e2X[4], e2Y[4], e2Z[4];	// v2 - v0
+	RmUint32	tri[4];	// source triangle, NoTriangle in unused lanes
+};
+
+typedef std::vector<Node4, PageAlignedAllocator<Node4>> NodeVector;
+typedef std::vector<TriPacket, PageAlignedAllocator<TriPacket>> PacketVector;
+typedef std::vector<RmReal, PageAlignedAllocator<RmReal>> RealVector;
+
+struct Bounds
+{
+	RmReal mMin[3];
+	RmReal mMax[3];
+
+	void clear()
+	{
+		for (int i = 0; i < 3; i++) {
+			mMin[i] = FLT_MAX;
+			mMax[i] = -FLT_MAX;
+		}
+	}
+
+	void grow(const RmReal *p)
+	{
+		for (int i = 0; i < 3; i++) {
+			mMin[i] = std::min(mMin[i], p[i]);
+			mMax[i] = std::max(mMax[i], p[i]);
+		}
+	}
+
+	void grow(const Bounds &b)
+	{
+		for (int i = 0; i < 3; i++) {
+			mMin[i] = std::min(mMin[i], b.mMin[i]);
+			mMax[i] = std::max(mMax[i], b.mMax[i]);
+		}
+	}
+
+	RmReal area() const
+	{
+		RmReal dx = mMax[0] - mMin[0];
+		RmReal dy = mMax[1] - mMin[1];
+		RmReal dz = mMax[2] - mMin[2];
+		if (dx < 0 || dy < 0 || dz < 0) {
+			return 0;
+		}
+
+		return 2.0f * (dx * dy + dy * dz + dz * dx);
+	}
+};
+
+struct BuildNode
+{
+	Bounds		mBounds;
+	RmUint32	mLeft;	// children, only set on inner nodes
+	RmUint32	mRight;
+	RmUint32	mFirst;	// range in the triangle order, only set on leaves
+	RmUint32	mCount;
+};
+
+// same face normal the AABB tree reports
+static void computeFaceNormal(const RmReal *A, const RmReal *B, const RmReal *C, RmReal *n)
+{
+	RmReal vx = (B[0] - C[0]);
+	RmReal vy = (B[1] - C[1]);
+	RmReal vz = (B[2] - C[2]);
+
+	RmReal wx = (A[0] - B[0]);
+	RmReal wy = (A[1] - B[1]);
+	RmReal wz = (A[2] - B[2]);
+
+	RmReal vw_x = vy * wz - vz * wy;
+	RmReal vw_y = vz * wx - vx * wz;
+	RmReal vw_z = vx * wy - vy * wx;
+
+	RmReal mag = sqrt((vw_x * vw_x) + (vw_y * vw_y) + (vw_z * vw_z));
+
+	if (mag < 0.000001f) {
+		mag = 0;
+	}
+	else {
+		mag = 1.0f / mag;
+	}
+
+	n[0] = vw_x * mag;
+	n[1] = vw_y * mag;
+	n[2] = vw_z * mag;
+}
+
+// binary SAH tree over the source triangles, collapsed into Node4s afterwards
+class BVHBuilder
+{
+public:
+	BVHBuilder(const RmReal *vertices, RmUint32 tcount, const RmUint32 *indices)
+	{
+		mVertices = vertices;
+		mIndices  = indices;
+		mTriBounds.resize(tcount);
+		mCentroids.resize(tcount * 3);
+		mOrder.resize(tcount);
+		mNodes.reserve(tcount / 2 + 1);
+
+		for (RmUint32 tri = 0; tri < tcount; tri++) {
+			Bounds &b = mTriBounds[tri];
+			b.clear();
+			b.grow(vertex(tri, 0));
+			b.grow(vertex(tri, 1));
+			b.grow(vertex(tri, 2));
+			for (int i = 0; i < 3; i++) {
+				mCentroids[tri * 3 + i] = (b.mMin[i] + b.mMax[i]) * 0.5f;
+			}
+
+			mOrder[tri] = tri;
+		}
+	}
+
+	const RmReal *vertex(RmUint32 tri, RmUint32 corner) const
+	{
+		return &mVertices[mIndices[tri * 3 + corner] * 3];
+	}
+
+	RmUint32 build(RmUint32 first, RmUint32 count)
+	{
+		RmUint32 index = (RmUint32) mNodes.size();
+		mNodes.emplace_back();
+
+		Bounds bounds;
+		Bounds centroid_bounds;
+		bounds.clear();
+		centroid_bounds.clear();
+		for (RmUint32 i = first; i < first + count; i++) {
+			bounds.grow(mTriBounds[mOrder[i]]);
+			centroid_bounds.grow(&mCentroids[mOrder[i] * 3]);
+		}
+
+		mNodes[index].mBounds = bounds;
+		if (count <= MaxLeafSize) {
+			mNodes[index].mFirst = first;
+			mNodes[index].mCount = count;
+			return index;
+		}
+
+		int      best_axis  = -1;
+		RmUint32 best_split = 0;
+		RmReal   best_cost  = FLT_MAX;
+
+		for (int axis = 0; axis < 3; axis++) {
+			RmReal extent = centroid_bounds.mMax[axis] - centroid_bounds.mMin[axis];
+			if (extent <= 0) {
+				continue;
+			}
+
+			Bounds   bins[BinCount];
+			RmUint32 bin_counts[BinCount] = {0};
+			for (auto &b : bins) {
+				b.clear();
+			}
+
+			RmReal scale = BinCount / extent;
+			for (RmUint32 i = first; i < first + count; i++) {
+				RmUint32 b = binFor(mOrder[i], axis, centroid_bounds.mMin[axis], scale);
+				bins[b].grow(mTriBounds[mOrder[i]]);
+				bin_counts[b]++;
+			}
+
+			// left_area[i] / left_count[i] cover bins 0..i, split i puts bins 0..i on the left
+			RmReal   left_area[BinCount - 1];
+			RmUint32 left_count[BinCount - 1];
+			Bounds   acc;
+			RmUint32 n = 0;
+			acc.clear();
+			for (RmUint32 i = 0; i < BinCount - 1; i++) {
+				acc.grow(bins[i]);
+				n += bin_counts[i];
+				left_area[i]  = acc.area();
+				left_count[i] = n;
+			}
+
+			acc.clear();
+			n = 0;
+			for (RmUint32 i = BinCount - 1; i > 0; i--) {
+				acc.grow(bins[i]);
+				n += bin_counts[i];
+
+				RmUint32 split = i - 1;
+				if (left_count[split] == 0 || n == 0) {
+					continue;
+				}
+
+				RmReal cost = left_area[split] * left_count[split] + acc.area() * n;
+				if (cost < best_cost) {
+					best_cost  = cost;
+					best_axis  = axis;
+					best_split = split;
+				}
+			}
+		}
+
+		// every centroid in the same spot when no axis could be binned, split the range down the middle
+		RmUint32 left_count = count / 2;
+		if (best_axis >= 0) {
+			RmReal lo    = centroid_bounds.mMin[best_axis];
+			RmReal scale = BinCount / (centroid_bounds.mMax[best_axis] - lo);
+			auto   mid   = std::partition(
+				mOrder.begin() + first,
+				mOrder.begin() + first + count,
+				[&](RmUint32 tri) { return binFor(tri, best_axis, lo, scale) <= best_split; }
+			);
+
+			left_count = (RmUint32) (mid - (mOrder.begin() + first));
+			if (left_count == 0 || left_count == count) {
+				left_count = count / 2;
+			}
+		}
+
+		RmUint32 left  = build(first, left_count);
+		RmUint32 right = build(first + left_count, count - left_count);
+
+		mNodes[index].mLeft  = left;
+		mNodes[index].mRight = right;
+		mNodes[index].mCount = 0;
+		return index;
+	}
+
+	RmUint32 binFor(RmUint32 tri, int axis, RmReal lo, RmReal scale) const
+	{
+		RmReal b = (mCentroids[tri * 3 + axis] - lo) * scale;
+		if (b <= 0) {
+			return 0;
+		}
+
+		return std::min(BinCount - 1, (RmUint32) b);
+	}
+
+	const RmReal				*mVertices;
+	const RmUint32				*mIndices;
+	std::vector<Bounds>			mTriBounds;
+	std::vector<RmReal>			mCentroids;
+	std::vector<RmUint32>		mOrder;
+	std::vector<BuildNode>		mNodes;
+};
+
+class MyRaycastBVH : public RaycastMesh
+{
+public:
+
+	MyRaycastBVH(RmUint32 vcount, const RmReal *vertices, RmUint32 tcount, const RmUint32 *indices)
+	{
+		mTcount = tcount;
+		mBounds.clear();
+		for (RmUint32 i = 0; i < vcount; i++) {
+			mBounds.grow(&vertices[i * 3]);
+		}
+
+		mNormals.resize(tcount * 3);
+		for (RmUint32 tri = 0; tri < tcount; tri++) {
+			const RmReal *p1 = &vertices[indices[tri * 3 + 0] * 3];
+			const RmReal *p2 = &vertices[indices[tri * 3 + 1] * 3];
+			const RmReal *p3 = &vertices[indices[tri * 3 + 2] * 3];
+			computeFaceNormal(p3, p2, p1, &mNormals[tri * 3]);
+		}
+
+		if (tcount > 0) {
+			BVHBuilder builder(vertices, tcount, indices);
+			builder.build(0, tcount);
+			mNodes.reserve(builder.mNodes.size() / 3 + 1);
+			mPackets.reserve(builder.mNodes.size() / 2 + 1);
+			collapse(builder, 0);
+		}
+
+		markForKSM();
+	}
+
+	void markForKSM()
+	{
+		if (!mNodes.empty()) {
+			KSM::MarkMemoryForKSM(mNodes.data(), mNodes.size() * sizeof(Node4));
+		}
+		if (!mPackets.empty()) {
+			KSM::MarkMemoryForKSM(mPackets.data(), mPackets.size() * sizeof(TriPacket));
+		}
+		if (!mNormals.empty()) {
+			KSM::MarkMemoryForKSM(mNormals.data(), mNormals.size() * sizeof(RmReal));
+		}
+	}
+
+	// pulls the largest inner nodes up until up to four children hang off one Node4
+	RmUint32 collapse(const BVHBuilder &builder, RmUint32 build_index)
+	{
+		RmUint32 kids[4];
+		int      kid_count = 0;
+
+		const BuildNode &root = builder.mNodes[build_index];
+		if (root.mCount > 0) {
+			kids[kid_count++] = build_index;
+		}
+		else {
+			kids[kid_count++] = root.mLeft;
+			kids[kid_count++] = root.mRight;
+		}
+
+		while (kid_count < 4) {
+			int    widest      = -1;
+			RmReal widest_area = -1.0f;
+			for (int i = 0; i < kid_count; i++) {
+				const BuildNode &k = builder.mNodes[kids[i]];
+				if (k.mCount == 0 && k.mBounds.area() > widest_area) {
+					widest      = i;
+					widest_area = k.mBounds.area();
+				}
+			}
+
+			if (widest < 0) {
+				break;
+			}
+
+			const BuildNode &k = builder.mNodes[kids[widest]];
+			kids[widest]        = k.mLeft;
+			kids[kid_count++]   = k.mRight;
+		}
+
+		RmUint32 index = (RmUint32) mNodes.size();
+		mNodes.emplace_back();
+		memset(&mNodes[index], 0, sizeof(Node4));
+		for (int i = 0; i < 4; i++) {
+			mNodes[index].child[i] = EmptyChild;
+		}
+
+		for (int i = 0; i < kid_count; i++) {
+			const BuildNode &k = builder.mNodes[kids[i]];
+
+			RmUint32 child;
+			if (k.mCount > 0) {
+				child = LeafFlag | makePacket(builder, k);
+			}
+			else {
+				child = collapse(builder, kids[i]);
+			}
+
+			// pad the boxes a little so rounding in the slab test never culls a triangle on the edge
+			Node4 &n = mNodes[index];
+			n.child[i] = child;
+			n.bminX[i] = pad(k.mBounds.mMin[0], -1.0f);
+			n.bminY[i] = pad(k.mBounds.mMin[1], -1.0f);
+			n.bminZ[i] = pad(k.mBounds.mMin[2], -1.0f);
+			n.bmaxX[i] = pad(k.mBounds.mMax[0], 1.0f);
+			n.bmaxY[i] = pad(k.mBounds.mMax[1], 1.0f);
+			n.bmaxZ[i] = pad(k.mBounds.mMax[2], 1.0f);
+		}
+
+		return index;
+	}
+
+	static RmReal pad(RmReal v, RmReal direction)
+	{
+		return v + direction * (0.001f + fabsf(v) * 0.00001f);
+	}
+
+	RmUint32 makePacket(const BVHBuilder &builder, const BuildNode &leaf)
+	{
+		TriPacket p;
+		memset(&p, 0, sizeof(p));
+		for (int lane = 0; lane < 4; lane++) {
+			p.tri[lane] = NoTriangle;
+		}
+
+		for (RmUint32 lane = 0; lane < leaf.mCount; lane++) {
+			RmUint32     tri = builder.mOrder[leaf.mFirst + lane];
+			const RmReal *v0 = builder.vertex(tri, 0);
+			const RmReal *v1 = builder.vertex(tri, 1);
+			const RmReal *v2 = builder.vertex(tri, 2);
+
+			p.v0X[lane] = v0[0];
+			p.v0Y[lane] = v0[1];
+			p.v0Z[lane] = v0[2];
+			p.e1X[lane] = v1[0] - v0[0];
+			p.e1Y[lane] = v1[1] - v0[1];
+			p.e1Z[lane] = v1[2] - v0[2];
+			p.e2X[lane] = v2[0] - v0[0];
+			p.e2Y[lane] = v2[1] - v0[1];
+			p.e2Z[lane] = v2[2] - v0[2];
+			p.tri[lane] = tri;
+		}
+
+		mPackets.push_back(p);
+		return (RmUint32) (mPackets.size() - 1);
+	}
+
+	// returns a bit per child whose box the ray enters before max_t, tnear gets the entry distances
+	static int intersectNode(const Node4 &n, const RmReal *from, const RmReal *inv, RmReal max_t, RmReal *tnear)
+	{
+#ifdef RAYCAST_BVH_SSE
+		const __m128 ox = _mm_set1_ps(from[0]);
+		const __m128 oy = _mm_set1_ps(from[1]);
+		const __m128 oz = _mm_set1_ps(from[2]);
+		const __m128 ix = _mm_set1_ps(inv[0]);
+		const __m128 iy = _mm_set1_ps(inv[1]);
+		const __m128 iz = _mm_set1_ps(inv[2]);
+
+		__m128 t0x = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(n.bminX), ox), ix);
+		__m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(n.bmaxX), ox), ix);
+		__m128 t0y = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(n.bminY), oy), iy);
+		__m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(n.bmaxY), oy), iy);
+		__m128 t0z = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(n.bminZ), oz), iz);
+		__m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(n.bmaxZ), oz), iz);
+
+		__m128 tmin = _mm_max_ps(
+			_mm_max_ps(_mm_min_ps(t0x, t1x), _mm_min_ps(t0y, t1y)),
+			_mm_max_ps(_mm_min_ps(t0z, t1z), _mm_setzero_ps())
+		);
+		__m128 tmax = _mm_min_ps(
+			_mm_min_ps(_mm_max_ps(t0x, t1x), _mm_max_ps(t0y, t1y)),
+			_mm_min_ps(_mm_max_ps(t0z, t1z), _mm_set1_ps(max_t))
+		);
+
+		_mm_storeu_ps(tnear, tmin);
+		return _mm_movemask_ps(_mm_cmple_ps(tmin, tmax));
+#else
+		int mask = 0;
+		for (int i = 0; i < 4; i++) {
+			RmReal t0x = (n.bminX[i] - from[0]) * inv[0];
+			RmReal t1x = (n.bmaxX[i] - from[0]) * inv[0];
+			RmReal t0y = (n.bminY[i] - from[1]) * inv[1];
+			RmReal t1y = (n.bmaxY[i] - from[1]) * inv[1];
+			RmReal t0z = (n.bminZ[i] - from[2]) * inv[2];
+			RmReal t1z = (n.bmaxZ[i] - from[2]) * inv[2];
+
+			RmReal tmin = std::max(std::max(std::min(t0x, t1x), std::min(t0y, t1y)), std::max(std::min(t0z, t1z), 0.0f));
+			RmReal tmax = std::min(std::min(std::max(t0x, t1x), std::max(t0y, t1y)), std::min(std::max(t0z, t1z), max_t));
+
+			tnear[i] = tmin;
+			if (tmin <= tmax) {
+				mask |= 1 << i;
+			}
+		}
+
+		return mask;
+#endif
+	}
+
+	// Moller-Trumbore on four triangles, same operation order as rayIntersectsTriangle in raycast_mesh.cpp
+	static void intersectPacket(const TriPacket &p, const RmReal *from, const RmReal *dir, RmReal &nearest, RmUint32 &nearest_tri)
+	{
+		RmReal t[4];
+		int    mask = 0;
+
+#ifdef RAYCAST_BVH_SSE
+		const __m128 dx = _mm_set1_ps(dir[0]);
+		const __m128 dy = _mm_set1_ps(dir[1]);
+		const __m128 dz = _mm_set1_ps(dir[2]);
+
+		const __m128 e1x = _mm_load_ps(p.e1X);
+		const __m128 e1y = _mm_load_ps(p.e1Y);
+		const __m128 e1z = _mm_load_ps(p.e1Z);
+		const __m128 e2x = _mm_load_ps(p.e2X);
+		const __m128 e2y = _mm_load_ps(p.e2Y);
+		const __m128 e2z = _mm_load_ps(p.e2Z);
+
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one  = _mm_set1_ps(1.0f);
+		const __m128 eps  = _mm_set1_ps(0.00001f);
+
+		__m128 hx = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(e2y, dz));
+		__m128 hy = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(e2z, dx));
+		__m128 hz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(e2x, dy));
+
+		__m128 a     = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, hx), _mm_mul_ps(e1y, hy)), _mm_mul_ps(e1z, hz));
+		__m128 valid = _mm_or_ps(_mm_cmple_ps(a, _mm_sub_ps(zero, eps)), _mm_cmpge_ps(a, eps));
+		if (!_mm_movemask_ps(valid)) {
+			return;
+		}
+
+		__m128 f  = _mm_div_ps(one, a);
+		__m128 sx = _mm_sub_ps(_mm_set1_ps(from[0]), _mm_load_ps(p.v0X));
+		__m128 sy = _mm_sub_ps(_mm_set1_ps(from[1]), _mm_load_ps(p.v0Y));
+		__m128 sz = _mm_sub_ps(_mm_set1_ps(from[2]), _mm_load_ps(p.v0Z));
+
+		__m128 u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, hx), _mm_mul_ps(sy, hy)), _mm_mul_ps(sz, hz)));
+		valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+		if (!_mm_movemask_ps(valid)) {
+			return;
+		}
+
+		__m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(e1y, sz));
+		__m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(e1z, sx));
+		__m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(e1x, sy));
+
+		__m128 v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+		valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+		__m128 tv = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)));
+		valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpgt_ps(tv, zero), _mm_cmple_ps(tv, _mm_set1_ps(nearest))));
+
+		mask = _mm_movemask_ps(valid);
+		if (!mask) {
+			return;
+		}
+
+		_mm_storeu_ps(t, tv);
+#else
+		for (int i = 0; i < 4; i++) {
+			RmReal hx = dir[1] * p.e2Z[i] - p.e2Y[i] * dir[2];
+			RmReal hy = dir[2] * p.e2X[i] - p.e2Z[i] * dir[0];
+			RmReal hz = dir[0] * p.e2Y[i] - p.e2X[i] * dir[1];
+
+			RmReal a = p.e1X[i] * hx + p.e1Y[i] * hy + p.e1Z[i] * hz;
+			if (a > -0.00001f && a < 0.00001f) {
+				continue;
+			}
+
+			RmReal f  = 1 / a;
+			RmReal sx = from[0] - p.v0X[i];
+			RmReal sy = from[1] - p.v0Y[i];
+			RmReal sz = from[2] - p.v0Z[i];
+
+			RmReal u = f * (sx * hx + sy * hy + sz * hz);
+			if (u < 0.0f || u > 1.0f) {
+				continue;
+			}
+
+			RmReal qx = sy * p.e1Z[i] - p.e1Y[i] * sz;
+			RmReal qy = sz * p.e1X[i] - p.e1Z[i] * sx;
+			RmReal qz = sx * p.e1Y[i] - p.e1X[i] * sy;
+
+			RmReal v = f * (dir[0] * qx + dir[1] * qy + dir[2] * qz);
+			if (v < 0.0f || u + v > 1.0f) {
+				continue;
+			}
+
+			t[i] = f * (p.e2X[i] * qx + p.e2Y[i] * qy + p.e2Z[i] * qz);
+			if (t[i] > 0 && t[i] <= nearest) {
+				mask |= 1 << i;
+			}
+		}
+#endif
+
+		for (int i = 0; i < 4; i++) {
+			if (!(mask & (1 << i))) {
+				continue;
+			}
+
+			RmUint32 tri = p.tri[i];
+			if (t[i] < nearest || (t[i] == nearest && tri < nearest_tri)) {
+				nearest     = t[i];
+				nearest_tri = tri;
+			}
+		}
+	}
+
+	// normalized direction, its reciprocal for the slab tests and the segment length
+	static bool setupRay(const RmReal *from, const RmReal *to, RmReal *dir, RmReal *inv, RmReal &distance)
+	{
+		dir[0] = to[0] - from[0];
+		dir[1] = to[1] - from[1];
+		dir[2] = to[2] - from[2];
+		distance = sqrtf(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+		if (distance < 0.0000000001f) return false;
+		RmReal recipDistance = 1.0f / distance;
+		dir[0] *= recipDistance;
+		dir[1] *= recipDistance;
+		dir[2] *= recipDistance;
+
+		// a zero component would turn into 0 * inf in the slab test, nudge it instead
+		for (int i = 0; i < 3; i++) {
+			RmReal d = dir[i];
+			if (fabsf(d) < 1e-20f) {
+				d = d < 0 ? -1e-20f : 1e-20f;
+			}
+
+			inv[i] = 1.0f / d;
+		}
+
+		return true;
+	}
+
+	struct StackEntry
+	{
+		RmUint32	node;
+		RmReal		tnear;
+	};
+
+	// Nearest hit along the ray up to nearest, or with any_hit set the first hit found, which is all a yes/no
+	// query needs. Children are visited nearest first so either way the search tends to end early.
+	void traverse(const RmReal *from, const RmReal *dir, const RmReal *inv, bool any_hit, RmReal &nearest, RmUint32 &nearest_tri)
+	{
+		if (mNodes.empty()) {
+			return;
+		}
+
+		thread_local std::vector<StackEntry> stack;
+		stack.clear();
+		stack.push_back({0, 0.0f});
+
+		while (!stack.empty()) {
+			StackEntry e = stack.back();
+			stack.pop_back();
+
+			if (e.tnear > nearest) {
+				continue;
+			}
+
+			if (e.node & LeafFlag) {
+				intersectPacket(mPackets[e.node & ~LeafFlag], from, dir, nearest, nearest_tri);
+				if (any_hit && nearest_tri != NoTriangle) {
+					return;
+				}
+
+				continue;
+			}
+
+			const Node4 &n = mNodes[e.node];
+
+			RmReal tnear[4];
+			int    mask = intersectNode(n, from, inv, nearest, tnear);
+			if (!mask) {
+				continue;
+			}
+
+			// push the farthest child first so the nearest one is popped next
+			StackEntry hits[4];
+			int        hit_count = 0;
+			for (int i = 0; i < 4; i++) {
+				if (!(mask & (1 << i)) || n.child[i] == EmptyChild) {
+					continue;
+				}
+
+				int j = hit_count++;
+				while (j > 0 && hits[j - 1].tnear < tnear[i]) {
+					hits[j] = hits[j - 1];
+					j--;
+				}
+
+				hits[j] = {n.child[i], tnear[i]};
+			}
+
+			for (int i = 0; i < hit_count; i++) {
+				stack.push_back(hits[i]);
+			}
+		}
+	}
+
+	virtual bool raycast(const RmReal *from, const RmReal *to, RmReal *hitLocation, RmReal *hitNormal, RmReal *hitDistance)
+	{
+		RmReal dir[3];
+		RmReal inv[3];
+		RmReal distance;
+		if (!setupRay(from, to, dir, inv, distance)) {
+			return false;
+		}
+
+		RmReal   nearest     = distance;
+		RmUint32 nearest_tri = NoTriangle;
+		traverse(from, dir, inv, false, nearest, nearest_tri);
+
+		if (nearest_tri == NoTriangle) {
+			return false;
+		}
+
+		if (hitLocation) {
+			hitLocation[0] = from[0] + dir[0] * nearest;
+			hitLocation[1] = from[1] + dir[1] * nearest;
+			hitLocation[2] = from[2] + dir[2] * nearest;
+		}
+
+		if (hitNormal) {
+			hitNormal[0] = mNormals[nearest_tri * 3 + 0];
+			hitNormal[1] = mNormals[nearest_tri * 3 + 1];
+			hitNormal[2] = mNormals[nearest_tri * 3 + 2];
+		}
+
+		if (hitDistance) {
+			*hitDistance = nearest;
+		}
+
+		return true;
+	}
+
+	// A ray stream walk (each node fetched once for every ray that reaches it) measured no faster than this on
+	// zone sized trees, which stay in cache, so the batch goes ray by ray and wins from the any hit exit.
+	virtual void raycastBatch(RmUint32 count, const RmReal *from, const RmReal *to, unsigned char *hits, RmReal *hitLocations)
+	{
+		const bool any_hit = hitLocations == nullptr;
+		for (RmUint32 i = 0; i < count; i++) {
+			hits[i] = 0;
+
+			RmReal dir[3];
+			RmReal inv[3];
+			RmReal distance;
+			if (!setupRay(&from[i * 3], &to[i * 3], dir, inv, distance)) {
+				continue;
+			}
+
+			RmReal   nearest     = distance;
+			RmUint32 nearest_tri = NoTriangle;
+			traverse(&from[i * 3], dir, inv, any_hit, nearest, nearest_tri);
+			if (nearest_tri == NoTriangle) {
+				continue;
+			}
+
+			hits[i] = 1;
+			if (hitLocations) {
+				hitLocations[i * 3 + 0] = from[i * 3 + 0] + dir[0] * nearest;
+				hitLocations[i * 3 + 1] = from[i * 3 + 1] + dir[1] * nearest;
+				hitLocations[i * 3 + 2] = from[i * 3 + 2] + dir[2] * nearest;
+			}
+		}
+	}
+
+	virtual bool bruteForceRaycast(const RmReal *from, const RmReal *to, RmReal *hitLocation, RmReal *hitNormal, RmReal *hitDistance)
+	{
+		RmReal dir[3];
+		dir[0] = to[0] - from[0];
+		dir[1] = to[1] - from[1];
+		dir[2] = to[2] - from[2];
+		RmReal distance = sqrtf(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+		if (distance < 0.0000000001f) return false;
+		RmReal recipDistance = 1.0f / distance;
+		dir[0] *= recipDistance;
+		dir[1] *= recipDistance;
+		dir[2] *= recipDistance;
+
+		RmReal   nearest     = distance;
+		RmUint32 nearest_tri = NoTriangle;
+		for (auto &p : mPackets) {
+			intersectPacket(p, from, dir, nearest, nearest_tri);
+		}
+
+		if (nearest_tri == NoTriangle) {
+			return false;
+		}
+
+		if (hitLocation) {
+			hitLocation[0] = from[0] + dir[0] * nearest;
+			hitLocation[1] = from[1] + dir[1] * nearest;
+			hitLocation[2] = from[2] + dir[2] * nearest;
+		}
+
+		if (hitNormal) {
+			hitNormal[0] = mNormals[nearest_tri * 3 + 0];
+			hitNormal[1] = mNormals[nearest_tri * 3 + 1];
+			hitNormal[2] = mNormals[nearest_tri * 3 + 2];
+		}
+
+		if (hitDistance) {
+			*hitDistance = nearest;
+		}
+
+		return true;
+	}
+
+	virtual void release(void)
+	{
+		delete this;
+	}
+
+	virtual const RmReal * getBoundMin(void) const // return the minimum bounding box
+	{
+		return mBounds.mMin;
+	}
+
+	virtual const RmReal * getBoundMax(void) const // return the maximum bounding box.
+	{
+		return mBounds.mMax;
+	}
+
+	RmUint32		mTcount;
+	Bounds			mBounds;
+	NodeVector		mNodes;
+	PacketVector	mPackets;
+	RealVector		mNormals;
+
+#ifdef USE_MAP_MMFS
+	MyRaycastBVH(std::vector<char>& rm_buffer, bool& load_success);
+	void serialize(std::vector<char>& rm_buffer);
+#endif /*USE_MAP_MMFS*/
+};
+
+};
+
+using namespace RAYCAST_BVH;
+
+RaycastMesh * createRaycastBVH(RmUint32 vcount, const RmReal *vertices, RmUint32 tcount, const RmUint32 *indices)
+{
+	auto m = new MyRaycastBVH(vcount, vertices, tcount, indices);
+
+	size_t node_size   = m->mNodes.size() * sizeof(Node4);
+	size_t packet_size = m->mPackets.size() * sizeof(TriPacket);
+	size_t normal_size = m->mNormals.size() * sizeof(RmReal);
+
+	LogInfo(
+		"Map Raycast BVH Memory Usage | Nodes [{:.2f}] MB Triangles [{:.2f}] MB Normals [{:.2f}] MB Total [{:.2f}] MB",
+		node_size / (1024.0 * 1024.0),
+		packet_size / (1024.0 * 1024.0),
+		normal_size / (1024.0 * 1024.0),
+		(node_size + packet_size + normal_size) / (1024.0 * 1024.0)
+	);
+
+	return static_cast<RaycastMesh *>(m);
+}
+
+#ifdef USE_MAP_MMFS
+RaycastMesh* loadRaycastBVH(std::vector<char>& rm_buffer, bool& load_success)
+{
+	load_success = false;
+	if (rm_buffer.empty())
+		return nullptr;
+
+	auto m = new MyRaycastBVH(rm_buffer, load_success);
+
+	return static_cast<RaycastMesh*>(m);
+}
+
+void serializeRaycastBVH(RaycastMesh* rm, std::vector<char>& rm_buffer)
+{
+	if (!rm) {
+		rm_buffer.clear();
+		return;
+	}
+
+	static_cast<MyRaycastBVH*>(rm)->serialize(rm_buffer);
+}
+
+MyRaycastBVH::MyRaycastBVH(std::vector<char>& rm_buffer, bool& load_success)
+{
+	load_success = false;
+	mTcount = 0;
+	mBounds.clear();
+
+	const char *buf = rm_buffer.data();
+	const char *end = buf + rm_buffer.size();
+
+	RmUint32 header[4]; // version, tcount, node count, packet count
+	if (end - buf < (ptrdiff_t) (sizeof(header) + sizeof(mBounds))) {
+		return;
+	}
+
+	memcpy(header, buf, sizeof(header));
+	buf += sizeof(header);
+	memcpy(&mBounds, buf, sizeof(mBounds));
+	buf += sizeof(mBounds);
+
+	if (header[0] != SerializeVersion) {
+		return;
+	}
+
+	size_t node_size   = header[2] * sizeof(Node4);
+	size_t packet_size = header[3] * sizeof(TriPacket);
+	size_t normal_size = header[1] * 3 * sizeof(RmReal);
+	if ((size_t) (end - buf) != node_size + packet_size + normal_size) {
+		return;
+	}
+
+	mTcount = header[1];
+	mNodes.resize(header[2]);
+	mPackets.resize(header[3]);
+	mNormals.resize(mTcount * 3);
+
+	memcpy(mNodes.data(), buf, node_size);
+	buf += node_size;
+	memcpy(mPackets.data(), buf, packet_size);
+	buf += packet_size;
+	memcpy(mNormals.data(), buf, normal_size);
+
+	markForKSM();
+	load_success = true;
+}
+
+void MyRaycastBVH::serialize(std::vector<char>& rm_buffer)
+{
+	RmUint32 header[4] = {SerializeVersion, mTcount, (RmUint32) mNodes.size(), (RmUint32) mPackets.size()};
+
+	size_t node_size   = mNodes.size() * sizeof(Node4);
+	size_t packet_size = mPackets.size() * sizeof(TriPacket);
+	size_t normal_size = mNormals.size() * sizeof(RmReal);
+
+	rm_buffer.resize(sizeof(header) + sizeof(mBounds) + node_size + packet_size + normal_size);
+
+	char* buf = rm_buffer.data();
+
+	memcpy(buf, header, sizeof(header));
+	buf += sizeof(header);
+	memcpy(buf, &mBounds, sizeof(mBounds));
+	buf += sizeof(mBounds);
+	memcpy(buf, mNodes.data(), node_size);
+	buf += node_size;
+	memcpy(buf, mPackets.data(), packet_size);
+	buf += packet_size;
+	memcpy(buf, mNormals.data(), normal_size);
+}
+#endif /*USE_MAP_MMFS*/
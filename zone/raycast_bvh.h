@@ -0,0 +1,30 @@
+#ifndef RAYCAST_BVH_H
+
+#define RAYCAST_BVH_H
+
+#include "raycast_mesh.h"
+
+// Alternative RaycastMesh backend.
+//
+// The tree is built with the surface area heuristic (binned, 16 bins per axis) down to leaves of at most four
+// triangles and then collapsed into a 4 wide BVH. Child bounds and leaf triangles are stored four to a node in
+// structure of arrays form, so a single SSE pass tests a ray against four boxes or four triangles at once.
+// Children are visited nearest first and anything starting past the closest hit so far is skipped.
+//
+// raycast() returns the same hit as the AABB tree in raycast_mesh.cpp (nearest hit along the segment, lowest
+// triangle index on exact ties) and keeps no per query state, so it can be called from several threads.
+
+RaycastMesh * createRaycastBVH(RmUint32 vcount,		// The number of vertices in the source triangle mesh
+							   const RmReal *vertices,	// The array of vertex positions in the format x1,y1,z1..x2,y2,z2.. etc.
+							   RmUint32 tcount,		// The number of triangles in the source triangle mesh
+							   const RmUint32 *indices	// The triangle indices in the format of i1,i2,i3 ... i4,i5,i6, ...
+							   );
+
+#ifdef USE_MAP_MMFS
+#include <vector>
+
+RaycastMesh* loadRaycastBVH(std::vector<char>& rm_buffer, bool& load_success);
+void serializeRaycastBVH(RaycastMesh* rm, std::vector<char>& rm_buffer);
+#endif /*USE_MAP_MMFS*/
+
+#endif
@@ -832,6 +832,14 @@ public:
 		return ret;
 	}
 
+	virtual void raycastBatch(RmUint32 count,const RmReal *from,const RmReal *to,unsigned char *hits,RmReal *hitLocations)
+	{
+		for (RmUint32 i=0; i<count; i++)
+		{
+			hits[i] = raycast(&from[i*3],&to[i*3],hitLocations ? &hitLocations[i*3] : NULL,NULL,NULL) ? 1 : 0;
+		}
+	}
+
 	virtual void release(void)
 	{
 		delete this;
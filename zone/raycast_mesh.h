@@ -39,6 +39,11 @@ public:
 	virtual bool raycast(const RmReal *from,const RmReal *to,RmReal *hitLocation,RmReal *hitNormal,RmReal *hitDistance) = 0;
 	virtual bool bruteForceRaycast(const RmReal *from,const RmReal *to,RmReal *hitLocation,RmReal *hitNormal,RmReal *hitDistance) = 0;
 
+	// Casts count segments, from and to hold count points each. hits[i] is set to 1 when segment i hits the mesh.
+	// With hitLocations null only the yes/no answer is wanted and a segment may stop at the first triangle it
+	// meets, otherwise hitLocations gets the same nearest hit point raycast() would return for each segment.
+	virtual void raycastBatch(RmUint32 count,const RmReal *from,const RmReal *to,unsigned char *hits,RmReal *hitLocations) = 0;
+
 	virtual const RmReal * getBoundMin(void) const = 0; // return the minimum bounding box
 	virtual const RmReal * getBoundMax(void) const = 0; // return the maximum bounding box.
 	virtual void release(void) = 0;
@@ -0,0 +1,212 @@
+#ifndef EQEMU_ZONE_SLEEP_WHEEL_H
+#define EQEMU_ZONE_SLEEP_WHEEL_H
+
+#include <algorithm>
+#include <vector>
+
+#include "../common/types.h"
+
+/**
+ * Hierarchical timer wheel of sleeping entities, keyed by entity id. An entity is scheduled with the
+ * time it wants to be woken at and Advance() hands back every entity whose time has come, so nothing
+ * is spent on an entity while it sleeps.
+ *
+ * Three levels of 256, 64 and 64 slots cover about 2.3 hours at Resolution; a wake time further out
+ * than that is parked at the edge of the outer level and re-filed once the wheel gets there.
+ * Entities are woken no earlier than their wake time and at most one Resolution late.
+ *
+ * Schedule and Cancel are O(1), Advance costs one slot visit per Resolution that passed plus the
+ * entities it wakes or moves down a level.
+ */
+class SleepWheel {
+public:
+	static constexpr uint32 Resolution = 8; // milliseconds per inner slot
+
+	explicit SleepWheel(uint64 now = 0) { Reset(now); }
+
+	// drops everything and restarts the wheel at now
+	void Reset(uint64 now)
+	{
+		m_nodes.clear();
+		m_slots.assign(SlotCount, None);
+		m_tick  = now / Resolution;
+		m_count = 0;
+	}
+
+	// schedules the entity to wake at wake, moving it if it was already asleep
+	void Schedule(uint16 id, uint64 wake)
+	{
+		if (id >= m_nodes.size()) {
+			m_nodes.resize(static_cast<size_t>(id) + 1);
+		}
+
+		auto &n = m_nodes[id];
+		if (n.slot != None) {
+			Unlink(id);
+		}
+		else {
+			m_count++;
+		}
+
+		// rounded up, an entity never wakes before its time
+		n.tick = (wake + Resolution - 1) / Resolution;
+		File(id, m_tick + 1);
+	}
+
+	// wakes the entity without it being handed back by Advance, true if it was asleep
+	bool Cancel(uint16 id)
+	{
+		if (!IsScheduled(id)) {
+			return false;
+		}
+
+		Unlink(id);
+		m_count--;
+		return true;
+	}
+
+	inline bool IsScheduled(uint16 id) const { return id < m_nodes.size() && m_nodes[id].slot != None; }
+
+	inline uint64 GetWakeTime(uint16 id) const { return IsScheduled(id) ? m_nodes[id].tick * Resolution : 0; }
+
+	inline size_t Size() const { return m_count; }
+
+	// moves the wheel up to now, appending every entity that is due to woken
+	void Advance(uint64 now, std::vector<uint16> &woken)
+	{
+		const uint64 target = now / Resolution;
+		if (m_count == 0) {
+			m_tick = std::max(m_tick, target);
+			return;
+		}
+
+		while (m_tick < target && m_count > 0) {
+			m_tick++;
+
+			const uint32 inner = static_cast<uint32>(m_tick & InnerMask);
+			if (inner == 0) {
+				const uint32 middle = static_cast<uint32>((m_tick >> InnerBits) & OuterMask);
+				if (middle == 0) {
+					Cascade(InnerSlots + OuterSlots + static_cast<uint32>((m_tick >> (InnerBits + OuterBits)) & OuterMask));
+				}
+
+				Cascade(InnerSlots + middle);
+			}
+
+			uint32 id = m_slots[inner];
+			m_slots[inner] = None;
+			while (id != None) {
+				auto &n = m_nodes[id];
+				uint32 next = n.next;
+				n.slot = None;
+				n.prev = None;
+				n.next = None;
+
+				// only the far future outer slot can hold entities that aren't due yet
+				if (n.tick > m_tick) {
+					File(id, m_tick + 1);
+				}
+				else {
+					m_count--;
+					woken.push_back(static_cast<uint16>(id));
+				}
+
+				id = next;
+			}
+		}
+
+		m_tick = std::max(m_tick, target);
+	}
+
+private:
+	static constexpr uint32 InnerBits  = 8;
+	static constexpr uint32 OuterBits  = 6;
+	static constexpr uint32 InnerSlots = 1u << InnerBits;
+	static constexpr uint32 OuterSlots = 1u << OuterBits;
+	static constexpr uint32 InnerMask  = InnerSlots - 1;
+	static constexpr uint32 OuterMask  = OuterSlots - 1;
+	static constexpr uint32 SlotCount  = InnerSlots + OuterSlots * 2;
+	static constexpr uint64 MaxDelta   = 1ull << (InnerBits + OuterBits * 2);
+	static constexpr uint32 None       = 0xFFFFFFFF;
+
+	struct Node {
+		uint64 tick = 0;
+		uint32 slot = None;
+		uint32 prev = None;
+		uint32 next = None;
+	};
+
+	// picks the slot for the node's tick relative to the current tick and links it there, a tick
+	// before earliest is filed at earliest
+	void File(uint32 id, uint64 earliest)
+	{
+		auto   &n    = m_nodes[id];
+		uint64 tick  = std::max(n.tick, earliest);
+		uint64 delta = tick - m_tick;
+		if (delta >= MaxDelta) {
+			tick  = m_tick + MaxDelta - 1;
+			delta = MaxDelta - 1;
+		}
+
+		uint32 slot;
+		if (delta < InnerSlots) {
+			slot = static_cast<uint32>(tick & InnerMask);
+		}
+		else if (delta < (1ull << (InnerBits + OuterBits))) {
+			slot = InnerSlots + static_cast<uint32>((tick >> InnerBits) & OuterMask);
+		}
+		else {
+			slot = InnerSlots + OuterSlots + static_cast<uint32>((tick >> (InnerBits + OuterBits)) & OuterMask);
+		}
+
+		n.slot = slot;
+		n.prev = None;
+		n.next = m_slots[slot];
+		if (n.next != None) {
+			m_nodes[n.next].prev = id;
+		}
+		m_slots[slot] = id;
+	}
+
+	void Unlink(uint32 id)
+	{
+		auto &n = m_nodes[id];
+		if (n.prev != None) {
+			m_nodes[n.prev].next = n.next;
+		}
+		else {
+			m_slots[n.slot] = n.next;
+		}
+
+		if (n.next != None) {
+			m_nodes[n.next].prev = n.prev;
+		}
+
+		n.slot = None;
+		n.prev = None;
+		n.next = None;
+	}
+
+	// re-files everything in an outer slot now that the wheel has reached it, entities due on the
+	// current tick land in the inner slot that is about to be handed back
+	void Cascade(uint32 slot)
+	{
+		uint32 id = m_slots[slot];
+		m_slots[slot] = None;
+		while (id != None) {
+			uint32 next = m_nodes[id].next;
+			m_nodes[id].slot = None;
+			m_nodes[id].prev = None;
+			m_nodes[id].next = None;
+			File(id, m_tick);
+			id = next;
+		}
+	}
+
+	std::vector<Node>   m_nodes;
+	std::vector<uint32> m_slots;
+	uint64              m_tick;  // last tick Advance has handled
+	size_t              m_count;
+};
+
+#endif
@@ -0,0 +1,235 @@
+#ifndef EQEMU_ZONE_SPATIAL_GRID_H
+#define EQEMU_ZONE_SPATIAL_GRID_H
+
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+#include <glm/vec3.hpp>
+
+#include "../common/types.h"
+
+/**
+ * Uniform 2D grid over the zone's XY plane used to answer "who is near this point" without walking
+ * the entire entity list. Entities are bucketed by the cell containing their position and re-bucketed
+ * incrementally when they move across a cell boundary.
+ *
+ * Entities flagged as unbounded (e.g. NPCs whose aggro range exceeds the close scan distance) are kept
+ * out of the cells entirely and are visited by every range query; callers are expected to apply their own
+ * exact distance test to whatever the grid hands back.
+ *
+ * The grid does not own the entities it tracks, callers must Remove() an entity before it is destroyed.
+ */
+template<typename T>
+class SpatialGrid {
+public:
+	explicit SpatialGrid(float cell_size = 600.0f) { SetCellSize(cell_size); }
+
+	// changing the cell size re-buckets everything currently tracked
+	void SetCellSize(float cell_size)
+	{
+		if (cell_size < 1.0f) {
+			cell_size = 1.0f;
+		}
+
+		if (m_cell_size == cell_size) {
+			return;
+		}
+
+		m_cell_size     = cell_size;
+		m_inv_cell_size = 1.0f / cell_size;
+
+		std::vector<std::pair<T *, Entry>> tracked(m_entries.begin(), m_entries.end());
+
+		Clear();
+		for (auto &e: tracked) {
+			Update(e.first, e.second.position, e.second.unbounded);
+		}
+	}
+
+	inline float GetCellSize() const { return m_cell_size; }
+
+	// inserts the entity if it is not tracked yet, otherwise moves it to the cell for its new position
+	void Update(T *entity, const glm::vec3 &position, bool unbounded = false)
+	{
+		if (!entity) {
+			return;
+		}
+
+		const uint64 key = CellKey(position.x, position.y);
+
+		auto it = m_entries.find(entity);
+		if (it == m_entries.end()) {
+			Entry e{};
+			e.position  = position;
+			e.unbounded = unbounded;
+			e.cell      = key;
+			Insert(entity, e);
+			m_entries.emplace(entity, e);
+			return;
+		}
+
+		Relocate(entity, it->second, position, unbounded);
+	}
+
+	// same as Update() but ignores entities that are not already tracked
+	void Move(T *entity, const glm::vec3 &position, bool unbounded = false)
+	{
+		auto it = m_entries.find(entity);
+		if (it == m_entries.end()) {
+			return;
+		}
+
+		Relocate(entity, it->second, position, unbounded);
+	}
+
+	void Remove(T *entity)
+	{
+		auto it = m_entries.find(entity);
+		if (it == m_entries.end()) {
+			return;
+		}
+
+		Erase(entity, it->second);
+		m_entries.erase(it);
+	}
+
+	inline bool Contains(T *entity) const { return m_entries.find(entity) != m_entries.end(); }
+
+	void Clear()
+	{
+		m_cells.clear();
+		m_unbounded.clear();
+		m_entries.clear();
+	}
+
+	/**
+	 * Invokes fn(T*) for every entity in a cell overlapping the square of half-width range centered on
+	 * position, plus every unbounded entity. This is a broad phase only, no distance test is applied.
+	 */
+	template<typename Fn>
+	void ForEachInRange(const glm::vec3 &position, float range, Fn &&fn) const
+	{
+		const int32 min_x = CellCoord(position.x - range);
+		const int32 max_x = CellCoord(position.x + range);
+		const int32 min_y = CellCoord(position.y - range);
+		const int32 max_y = CellCoord(position.y + range);
+
+		// a query wider than the populated grid is cheaper as a walk over the populated cells
+		const uint64 span = static_cast<uint64>(max_x - min_x + 1) * static_cast<uint64>(max_y - min_y + 1);
+		if (span > m_cells.size()) {
+			for (auto &c: m_cells) {
+				const int32 cx = static_cast<int32>(static_cast<uint32>(c.first >> 32));
+				const int32 cy = static_cast<int32>(static_cast<uint32>(c.first & 0xFFFFFFFF));
+				if (cx < min_x || cx > max_x || cy < min_y || cy > max_y) {
+					continue;
+				}
+
+				for (auto *e: c.second) {
+					fn(e);
+				}
+			}
+		}
+		else {
+			for (int32 x = min_x; x <= max_x; ++x) {
+				for (int32 y = min_y; y <= max_y; ++y) {
+					auto c = m_cells.find(PackCell(x, y));
+					if (c == m_cells.end()) {
+						continue;
+					}
+
+					for (auto *e: c->second) {
+						fn(e);
+					}
+				}
+			}
+		}
+
+		for (auto *e: m_unbounded) {
+			fn(e);
+		}
+	}
+
+	inline size_t Size() const { return m_entries.size(); }
+	inline size_t CellCount() const { return m_cells.size(); }
+	inline size_t UnboundedCount() const { return m_unbounded.size(); }
+
+private:
+	struct Entry {
+		glm::vec3 position;
+		uint64    cell;
+		size_t    index;
+		bool      unbounded;
+	};
+
+	inline int32 CellCoord(float v) const { return static_cast<int32>(std::floor(v * m_inv_cell_size)); }
+
+	static inline uint64 PackCell(int32 x, int32 y)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(x)) << 32) | static_cast<uint64>(static_cast<uint32>(y));
+	}
+
+	inline uint64 CellKey(float x, float y) const { return PackCell(CellCoord(x), CellCoord(y)); }
+
+	void Relocate(T *entity, Entry &e, const glm::vec3 &position, bool unbounded)
+	{
+		const uint64 key = CellKey(position.x, position.y);
+
+		e.position = position;
+
+		// common case, entity moved within its cell
+		if (e.unbounded == unbounded && (unbounded || e.cell == key)) {
+			return;
+		}
+
+		Erase(entity, e);
+		e.unbounded = unbounded;
+		e.cell      = key;
+		Insert(entity, e);
+	}
+
+	void Insert(T *entity, Entry &e)
+	{
+		auto &bucket = e.unbounded ? m_unbounded : m_cells[e.cell];
+		e.index = bucket.size();
+		bucket.push_back(entity);
+	}
+
+	// swap-remove out of the bucket, patching the index of whichever entity took our slot
+	void Erase(T *entity, Entry &e)
+	{
+		std::vector<T *> *bucket = &m_unbounded;
+		if (!e.unbounded) {
+			auto c = m_cells.find(e.cell);
+			if (c == m_cells.end()) {
+				return;
+			}
+
+			bucket = &c->second;
+		}
+
+		if (e.index >= bucket->size() || (*bucket)[e.index] != entity) {
+			return;
+		}
+
+		T *last = bucket->back();
+		(*bucket)[e.index] = last;
+		bucket->pop_back();
+
+		if (last != entity) {
+			m_entries[last].index = e.index;
+		}
+
+		if (!e.unbounded && bucket->empty()) {
+			m_cells.erase(e.cell);
+		}
+	}
+
+	float m_cell_size     = 0.0f;
+	float m_inv_cell_size = 0.0f;
+
+	std::unordered_map<uint64, std::vector<T *>> m_cells;
+	std::vector<T *>                             m_unbounded;
+	std::unordered_map<T *, Entry>               m_entries;
+};
+
+#endif //EQEMU_ZONE_SPATIAL_GRID_H
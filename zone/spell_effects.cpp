@@ -3436,7 +3436,7 @@ bool Mob::SpellEffect(Mob* caster, uint16 spell_id, float partial, int level_ove
 #endif
 	}
 
-	CalcBonuses();
+	CalcBuffBonuses();
 
 	if (SummonedItem) {
 		Client *c=CastToClient();
@@ -3846,10 +3846,17 @@ void Mob::BuffProcess()
 	{
 		if (IsValidSpell(buffs[buffs_i].spellid))
 		{
-			DoBuffTic(buffs[buffs_i], buffs_i, entity_list.GetMob(buffs[buffs_i].casterid));
-			// If the Mob died during DoBuffTic, then the buff we are currently processing will have been removed
-			if(!IsValidSpell(buffs[buffs_i].spellid)) {
-				continue;
+			// most buffs only count down, DoBuffTic and the caster lookup are for the ones with per tic work
+			if (
+				degenerating_effects ||
+				SpellHasBuffTic(buffs[buffs_i].spellid) ||
+				HasBuffTicQuestSub(buffs[buffs_i].spellid)
+			) {
+				DoBuffTic(buffs[buffs_i], buffs_i, entity_list.GetMob(buffs[buffs_i].casterid));
+				// If the Mob died during DoBuffTic, then the buff we are currently processing will have been removed
+				if(!IsValidSpell(buffs[buffs_i].spellid)) {
+					continue;
+				}
 			}
 
 			// DF_Permanent uses -1 DF_Aura uses -4 but we need to check negatives for some spells for some reason?
@@ -3899,29 +3906,32 @@ void Mob::DoBuffTic(const Buffs_Struct &buff, int slot, Mob *caster)
 
 	const SPDat_Spell_Struct &spell = spells[buff.spellid];
 
-	const auto& export_string = fmt::format(
-		"{} {} {} {}",
-		caster ? caster->GetID() : 0,
-		buffs[slot].ticsremaining,
-		caster ? caster->GetLevel() : 0,
-		slot
-	);
+	// only built when a quest is listening
+	auto export_string = [&]() {
+		return fmt::format(
+			"{} {} {} {}",
+			caster ? caster->GetID() : 0,
+			buffs[slot].ticsremaining,
+			caster ? caster->GetLevel() : 0,
+			slot
+		);
+	};
 
 	if (IsClient()) {
 		if (parse->SpellHasQuestSub(buff.spellid, EVENT_SPELL_EFFECT_BUFF_TIC_CLIENT)) {
-			if (parse->EventSpell(EVENT_SPELL_EFFECT_BUFF_TIC_CLIENT, nullptr, CastToClient(), buff.spellid, export_string, 0) != 0) {
+			if (parse->EventSpell(EVENT_SPELL_EFFECT_BUFF_TIC_CLIENT, nullptr, CastToClient(), buff.spellid, export_string(), 0) != 0) {
 				return;
 			}
 		}
 	} else if (IsNPC()) {
 		if (parse->SpellHasQuestSub(buff.spellid, EVENT_SPELL_EFFECT_BUFF_TIC_NPC)) {
-			if (parse->EventSpell(EVENT_SPELL_EFFECT_BUFF_TIC_NPC, this, nullptr, buff.spellid, export_string, 0) != 0) {
+			if (parse->EventSpell(EVENT_SPELL_EFFECT_BUFF_TIC_NPC, this, nullptr, buff.spellid, export_string(), 0) != 0) {
 				return;
 			}
 		}
 	} else if (IsBot()) {
 		if (parse->SpellHasQuestSub(buff.spellid, EVENT_SPELL_EFFECT_BUFF_TIC_BOT)) {
-			if (parse->EventSpell(EVENT_SPELL_EFFECT_BUFF_TIC_BOT, this, nullptr, buff.spellid, export_string, 0) != 0) {
+			if (parse->EventSpell(EVENT_SPELL_EFFECT_BUFF_TIC_BOT, this, nullptr, buff.spellid, export_string(), 0) != 0) {
 				return;
 			}
 		}
@@ -3934,6 +3944,7 @@ void Mob::DoBuffTic(const Buffs_Struct &buff, int slot, Mob *caster)
 		effect = spell.effect_id[i];
 		// I copied the calculation into each case which needed it instead of
 		// doing it every time up here, since most buff effects dont need it
+		// a new case here needs adding to LoadBuffTicSpells as well
 
 		switch (effect) {
 		case SE_CurrentHP: {
@@ -4241,12 +4252,78 @@ void Mob::DoBuffTic(const Buffs_Struct &buff, int slot, Mob *caster)
 	}
 
 	/* Is this the best place for this?
-	 * Ideally we would only recalc spell bonuses
-	 * but we would also have to call all the Calc functions like Max HP
-	 * so lets just call the main CalcBonuses
+	 * Only the spell bonuses changed, CalcBuffBonuses reuses the item and AA
+	 * bonuses and still runs all the Calc functions like Max HP
 	 */
 	if (degenerating_effects)
-		CalcBonuses();
+		CalcBuffBonuses();
+}
+
+bool Mob::HasBuffTicQuestSub(uint16 spell_id)
+{
+	if (IsClient()) {
+		return parse->SpellHasQuestSub(spell_id, EVENT_SPELL_EFFECT_BUFF_TIC_CLIENT);
+	} else if (IsNPC()) {
+		return parse->SpellHasQuestSub(spell_id, EVENT_SPELL_EFFECT_BUFF_TIC_NPC);
+	} else if (IsBot()) {
+		return parse->SpellHasQuestSub(spell_id, EVENT_SPELL_EFFECT_BUFF_TIC_BOT);
+	}
+
+	return false;
+}
+
+// spells with an effect DoBuffTic acts on, indexed by spell id
+static std::vector<bool> buff_tic_spells;
+
+void Mob::LoadBuffTicSpells()
+{
+	buff_tic_spells.assign(std::max(SPDAT_RECORDS, 0), false);
+
+	for (int spell_id = 0; spell_id < SPDAT_RECORDS; spell_id++) {
+		for (int i = 0; i < EFFECT_COUNT; i++) {
+			if (IsBlankSpellEffect(spell_id, i)) {
+				continue;
+			}
+
+			switch (spells[spell_id].effect_id[i]) {
+				case SE_CurrentHP:
+				case SE_HealOverTime:
+				case SE_CurrentEndurance:
+				case SE_BardAEDot:
+				case SE_Hate:
+				case SE_WipeHateList:
+				case SE_Charm:
+				case SE_Root:
+				case SE_Fear:
+				case SE_Invisibility:
+				case SE_InvisVsAnimals:
+				case SE_InvisVsUndead:
+				case SE_ImprovedInvisAnimals:
+				case SE_Invisibility2:
+				case SE_InvisVsUndead2:
+				case SE_InterruptCasting:
+				case SE_CastOnFadeEffect:
+				case SE_CastOnFadeEffectNPC:
+				case SE_CastOnFadeEffectAlways:
+				case SE_LocateCorpse:
+				case SE_DistanceRemoval:
+				case SE_AddHateOverTimePct:
+				case SE_Duration_HP_Pct:
+				case SE_Duration_Mana_Pct:
+				case SE_Duration_Endurance_Pct:
+					buff_tic_spells[spell_id] = true;
+					break;
+				default:
+					break;
+			}
+		}
+	}
+}
+
+bool Mob::SpellHasBuffTic(uint16 spell_id)
+{
+	// anything the table doesn't know about gets the full tic
+	return spell_id >= buff_tic_spells.size() || buff_tic_spells[spell_id];
 }
 
 // removes the buff in the buff slot 'slot'
@@ -4702,7 +4779,7 @@ void Mob::BuffFadeBySlot(int slot, bool iRecalcBonuses)
 	// we will eventually call CalcBonuses() even if we skip it right here, so should correct itself if we still have them
 	degenerating_effects = false;
 	if (iRecalcBonuses)
-		CalcBonuses();
+		CalcBuffBonuses();
 }
 
 int64 Mob::CalcAAFocus(focusType type, const AA::Rank &rank, uint16 spell_id)
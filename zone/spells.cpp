@@ -167,6 +167,8 @@ bool Mob::CastSpell(uint16 spell_id, uint16 target_id, CastingSlot slot,
 		ZeroCastingVars();
 	}
 
+	entity_list.WakeMob(GetID());
+
 	//If spell fails checks here determine if we need to send packet to client to reset spell bar.
 	bool send_spellbar_enable = true;
 	if ((item_slot != -1 && cast_time == 0) || aa_id) {
@@ -3791,7 +3793,7 @@ int Mob::AddBuff(Mob *caster, uint16 spell_id, int duration, int32 level_overrid
 	}
 
 	// recalculate bonuses since we stripped/added buffs
-	CalcBonuses();
+	CalcBuffBonuses();
 
 	return emptyslot;
 }
@@ -3917,6 +3919,8 @@ bool Mob::SpellOnTarget(
 		return false;
 	}
 
+	entity_list.WakeMob(spelltar->GetID());
+
 	if (spelltar->IsClient() && spelltar->CastToClient()->IsHoveringForRespawn()) {
 		return false;
 	}
@@ -4833,7 +4837,7 @@ void Mob::BuffFadeAll()
 	}
 
 	if (recalc_bonus) {
-		CalcBonuses();
+		CalcBuffBonuses();
 	}
 }
 
@@ -4854,7 +4858,7 @@ void Mob::BuffFadeNonPersistDeath()
 	}
 
 	if (recalc_bonus) {
-		CalcBonuses();
+		CalcBuffBonuses();
 	}
 }
 
@@ -4873,7 +4877,7 @@ void Mob::BuffFadeBeneficial() {
 	}
 
 	if (recalc_bonus) {
-		CalcBonuses();
+		CalcBuffBonuses();
 	}
 }
 
@@ -4892,7 +4896,7 @@ void Mob::BuffFadeDetrimental() {
 	}
 
 	if (recalc_bonus) {
-		CalcBonuses();
+		CalcBuffBonuses();
 	}
 }
 
@@ -4917,7 +4921,7 @@ void Mob::BuffFadeDetrimentalByCaster(Mob *caster)
 	}
 
 	if (recalc_bonus) {
-		CalcBonuses();
+		CalcBuffBonuses();
 	}
 }
 
@@ -4937,7 +4941,7 @@ void Mob::BuffFadeBySitModifier()
 	}
 
 	if (recalc_bonus) {
-		CalcBonuses();
+		CalcBuffBonuses();
 	}
 }
 
@@ -4953,7 +4957,7 @@ void Mob::BuffFadeBySpellID(uint16 spell_id)
 	}
 
 	if (recalc_bonus) {
-		CalcBonuses();
+		CalcBuffBonuses();
 	}
 }
 
@@ -4972,7 +4976,7 @@ void Mob::BuffFadeBySpellIDAndCaster(uint16 spell_id, uint16 caster_id)
 	}
 
 	if (recalc_bonus) {
-		CalcBonuses();
+		CalcBuffBonuses();
 	}
 }
 
@@ -4993,7 +4997,7 @@ void Mob::BuffFadeByEffect(int effect_id, int slot_to_skip)
 	}
 
 	if (recalc_bonus) {
-		CalcBonuses();
+		CalcBuffBonuses();
 	}
 }
 
@@ -5010,7 +5014,7 @@ void Mob::BuffFadeSongs() {
 	}
 
 	if (recalc_bonus) {
-		CalcBonuses();
+		CalcBuffBonuses();
 	}
 }
 
@@ -5742,9 +5746,7 @@ void Mob::Spin() {
 		h=GetHeading()+5;
 
 		if (IsCorpse() || (IsClient() && !IsAIControlled())) {
-			m_Position.x = x;
-			m_Position.y = y;
-			m_Position.z = z;
+			SetPosition(x, y, z);
 			mMovementManager->SendCommandToClients(this, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeAny);
 		}
 		else {
@@ -6997,9 +6999,48 @@ void Mob::CalcDestFromHeading(float heading, float distance, float MaxZDiff, flo
 	dZ = FindGroundZ(dX, dY, MaxZDiff);
 }
 
+void Mob::DirectionalSpellOnTargets(uint16 spell_id, int16 resist_adjust, const std::vector<Mob *> &targets)
+{
+	const bool check_los = !spells[spell_id].npc_no_los;
+	const int  max_count = spells[spell_id].aoe_max_targets;
+
+	// line of sight is checked a batch at a time, no bigger than the number of targets still allowed
+	int               maxtarget_count = 0;
+	size_t            next            = 0;
+	std::vector<Mob*> batch;
+	std::vector<bool> can_see;
+	while (next < targets.size()) {
+		size_t batch_size = targets.size() - next;
+		if (max_count) {
+			batch_size = std::min(batch_size, static_cast<size_t>(std::max(max_count - maxtarget_count, 1)));
+		}
+
+		if (check_los) {
+			batch.assign(targets.begin() + next, targets.begin() + next + batch_size);
+			CheckLosFN(batch, can_see);
+		}
+
+		for (size_t i = next; i < next + batch_size; ++i) {
+			if (check_los && !can_see[i - next]) {
+				continue;
+			}
+
+			targets[i]->CalcSpellPowerDistanceMod(spell_id, 0, this);
+			SpellOnTarget(spell_id, targets[i], 0, true, resist_adjust);
+			maxtarget_count++;
+
+			// my SHM breath could hit all 5 dummies I could summon in arena
+			if (max_count && maxtarget_count >= max_count) {
+				return;
+			}
+		}
+
+		next += batch_size;
+	}
+}
+
 void Mob::BeamDirectional(uint16 spell_id, int16 resist_adjust)
 {
-	int maxtarget_count = 0;
 	bool beneficial_targets = false;
 
 	if (IsBeneficialSpell(spell_id) && IsClient())
@@ -7011,6 +7052,8 @@ void Mob::BeamDirectional(uint16 spell_id, int16 resist_adjust)
 					  spells[spell_id].range / 2, spells[spell_id].pcnpc_only_flag, targets_in_range);
 	auto iter = targets_in_range.begin();
 
+	std::vector<Mob *> targets;
+
 	float dX = 0;
 	float dY = 0;
 	float dZ = 0;
@@ -7067,23 +7110,16 @@ void Mob::BeamDirectional(uint16 spell_id, int16 resist_adjust)
 		float d = std::abs((*iter)->GetY() - m * (*iter)->GetX() - b) / sqrt(m * m + 1);
 
 		if (d <= spells[spell_id].aoe_range) {
-			if (CheckLosFN((*iter)) || spells[spell_id].npc_no_los) {
-				(*iter)->CalcSpellPowerDistanceMod(spell_id, 0, this);
-				SpellOnTarget(spell_id, (*iter), 0, true, resist_adjust);
-				maxtarget_count++;
-			}
-
-			// not sure if we need this check, but probably do, need to check if it should be default limited or not
-			if (spells[spell_id].aoe_max_targets && maxtarget_count >= spells[spell_id].aoe_max_targets)
-				return;
+			targets.push_back(*iter);
 		}
 		++iter;
 	}
+
+	DirectionalSpellOnTargets(spell_id, resist_adjust, targets);
 }
 
 void Mob::ConeDirectional(uint16 spell_id, int16 resist_adjust)
 {
-	int maxtarget_count = 0;
 	bool beneficial_targets = false;
 
 	if (IsBeneficialSpell(spell_id) && IsClient())
@@ -7106,6 +7142,8 @@ void Mob::ConeDirectional(uint16 spell_id, int16 resist_adjust)
 					  spells[spell_id].aoe_range / 2, spells[spell_id].pcnpc_only_flag, targets_in_range);
 	auto iter = targets_in_range.begin();
 
+	std::vector<Mob *> targets;
+
 	while (iter != targets_in_range.end()) {
 		if (!(*iter) || (beneficial_targets && ((*iter)->IsNPC() && !(*iter)->IsPetOwnerOfClientBot()))) {
 			++iter;
@@ -7158,28 +7196,18 @@ void Mob::ConeDirectional(uint16 spell_id, int16 resist_adjust)
 		if (angle_start > angle_end) {
 			if ((heading_to_target >= angle_start && heading_to_target <= 360.0f) ||
 				(heading_to_target >= 0.0f && heading_to_target <= angle_end)) {
-				if (CheckLosFN((*iter)) || spells[spell_id].npc_no_los) {
-					(*iter)->CalcSpellPowerDistanceMod(spell_id, 0, this);
-					SpellOnTarget(spell_id, (*iter), 0, true, resist_adjust);
-					maxtarget_count++;
-				}
+				targets.push_back(*iter);
 			}
 		} else {
 			if (heading_to_target >= angle_start && heading_to_target <= angle_end) {
-				if (CheckLosFN((*iter)) || spells[spell_id].npc_no_los) {
-					(*iter)->CalcSpellPowerDistanceMod(spell_id, 0, this);
-					SpellOnTarget(spell_id, (*iter), 0, true, resist_adjust);
-					maxtarget_count++;
-				}
+				targets.push_back(*iter);
 			}
 		}
 
-		// my SHM breath could hit all 5 dummies I could summon in arena
-		if (spells[spell_id].aoe_max_targets && maxtarget_count >= spells[spell_id].aoe_max_targets)
-			return;
-
 		++iter;
 	}
+
+	DirectionalSpellOnTargets(spell_id, resist_adjust, targets);
 }
 
 // duration in seconds
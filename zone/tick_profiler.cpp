@@ -0,0 +1,186 @@
+#include "tick_profiler.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+TickProfiler::TickProfiler()
+{
+	m_ticks_per_ms = std::max<int64>(RDTSC_Timer::ticksPerMS(), 1);
+	Reset();
+}
+
+const char *TickProfiler::PhaseName(Phase phase)
+{
+	switch (phase) {
+		case PhaseOther: return "Other";
+		case PhaseStreams: return "Streams";
+		case PhaseWorldServer: return "World Server";
+		case PhaseGroup: return "Groups";
+		case PhaseDoor: return "Doors";
+		case PhaseObject: return "Objects";
+		case PhaseCorpse: return "Corpses";
+		case PhaseTrap: return "Traps";
+		case PhaseRaid: return "Raids";
+		case PhaseEntity: return "Entity Process";
+		case PhaseMob: return "Mobs";
+		case PhaseBeacon: return "Beacons";
+		case PhaseEncounter: return "Encounters";
+		case PhaseEventScheduler: return "Event Scheduler";
+		case PhaseZone: return "Zone";
+		case PhaseQuest: return "Quest Timers";
+		default: return "Unknown";
+	}
+}
+
+void TickProfiler::Reset()
+{
+	m_windows[0] = Window{};
+	m_windows[1] = Window{};
+	m_current      = 0;
+	m_window_start = std::chrono::steady_clock::now();
+}
+
+void TickProfiler::BeginTick()
+{
+	std::fill(std::begin(m_tick_phase_ticks), std::end(m_tick_phase_ticks), 0);
+	m_tick_start  = RDTSC_Timer::rdtsc();
+	m_phase_start = m_tick_start;
+	m_phase       = PhaseOther;
+}
+
+void TickProfiler::EndTick()
+{
+	int64 now = RDTSC_Timer::rdtsc();
+	m_tick_phase_ticks[m_phase] += now - m_phase_start;
+
+	auto &w = m_windows[m_current];
+
+	uint32 phase_us[PhaseCount];
+	for (int i = 0; i < PhaseCount; ++i) {
+		phase_us[i] = TicksToMicroseconds(m_tick_phase_ticks[i]);
+		if (m_tick_phase_ticks[i] > 0) {
+			Record(w.phases[i], phase_us[i]);
+		}
+	}
+
+	uint32 total_us = TicksToMicroseconds(now - m_tick_start);
+	Record(w.phases[PhaseCount], total_us);
+
+	if (total_us > w.worst.total_us) {
+		w.worst.total_us = total_us;
+		std::copy(std::begin(phase_us), std::end(phase_us), std::begin(w.worst.phase_us));
+		w.worst.when = std::chrono::system_clock::now();
+	}
+
+	if (std::chrono::steady_clock::now() - m_window_start >= std::chrono::seconds(WindowSeconds)) {
+		Rotate();
+	}
+}
+
+void TickProfiler::Rotate()
+{
+	m_current ^= 1;
+	m_windows[m_current] = Window{};
+	m_window_start = std::chrono::steady_clock::now();
+}
+
+uint32 TickProfiler::TicksToMicroseconds(int64 ticks) const
+{
+	if (ticks <= 0) {
+		return 0;
+	}
+
+	return static_cast<uint32>(std::min<int64>(ticks * 1000 / m_ticks_per_ms, UINT32_MAX));
+}
+
+int TickProfiler::BucketFor(uint32 us)
+{
+	if (us < 16) {
+		return static_cast<int>(us);
+	}
+
+	int exponent = 31;
+	while (!(us & (1u << exponent))) {
+		--exponent;
+	}
+
+	int sub = static_cast<int>((us >> (exponent - 3)) & 7);
+	return 16 + (exponent - 4) * 8 + sub;
+}
+
+uint32 TickProfiler::BucketUpperBound(int bucket)
+{
+	if (bucket < 16) {
+		return static_cast<uint32>(bucket);
+	}
+
+	int    exponent = (bucket - 16) / 8 + 4;
+	uint64 sub      = static_cast<uint64>((bucket - 16) % 8);
+	uint64 upper    = (1ull << exponent) + ((sub + 1) << (exponent - 3)) - 1;
+	return static_cast<uint32>(std::min<uint64>(upper, UINT32_MAX));
+}
+
+void TickProfiler::Record(Histogram &h, uint32 us)
+{
+	h.buckets[BucketFor(us)]++;
+	h.count++;
+	h.sum_us += us;
+	h.max_us = std::max(h.max_us, us);
+}
+
+TickProfiler::PhaseSummary TickProfiler::Summarize(int index, const char *name)
+{
+	auto &a = m_windows[0].phases[index];
+	auto &b = m_windows[1].phases[index];
+
+	PhaseSummary s{};
+	s.name    = name;
+	s.samples = a.count + b.count;
+	s.max_us  = std::max(a.max_us, b.max_us);
+	s.avg_us  = s.samples ? static_cast<double>(a.sum_us + b.sum_us) / s.samples : 0.0;
+
+	uint64 p50_rank = (s.samples * 50 + 99) / 100;
+	uint64 p99_rank = (s.samples * 99 + 99) / 100;
+	uint64 seen     = 0;
+	bool   have_p50 = false;
+	for (int i = 0; i < BucketCount && s.samples > 0; ++i) {
+		seen += a.buckets[i] + b.buckets[i];
+		if (!have_p50 && seen >= p50_rank) {
+			s.p50_us = std::min(BucketUpperBound(i), s.max_us);
+			have_p50 = true;
+		}
+
+		if (seen >= p99_rank) {
+			s.p99_us = std::min(BucketUpperBound(i), s.max_us);
+			break;
+		}
+	}
+
+	auto worst = GetWorstTick();
+	s.worst_tick_us = index < PhaseCount ? worst.phase_us[index] : worst.total_us;
+
+	return s;
+}
+
+std::vector<TickProfiler::PhaseSummary> TickProfiler::GetPhaseSummaries()
+{
+	std::vector<PhaseSummary> summaries;
+	summaries.reserve(PhaseCount);
+	for (int i = 0; i < PhaseCount; ++i) {
+		summaries.push_back(Summarize(i, PhaseName(static_cast<Phase>(i))));
+	}
+
+	return summaries;
+}
+
+TickProfiler::PhaseSummary TickProfiler::GetTickSummary()
+{
+	return Summarize(PhaseCount, "Tick");
+}
+
+TickProfiler::WorstTick TickProfiler::GetWorstTick()
+{
+	auto &a = m_windows[0].worst;
+	auto &b = m_windows[1].worst;
+	return a.total_us >= b.total_us ? a : b;
+}
@@ -0,0 +1,119 @@
+#ifndef EQEMU_TICK_PROFILER_H
+#define EQEMU_TICK_PROFILER_H
+
+#include "../common/types.h"
+#include "../common/rdtsc.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+/*
+	Always on wall time accounting for the phases of the zone main loop.
+
+	Each phase is timed with the cycle counter and recorded into a log scale histogram
+	(8 buckets per power of two, so percentiles are within ~12%). Histograms roll over every
+	WindowSeconds and queries cover the current and previous window, the slowest tick seen
+	in that span is kept with its per phase breakdown.
+*/
+class TickProfiler {
+public:
+	enum Phase : uint8 {
+		PhaseOther = 0,
+		PhaseStreams,
+		PhaseWorldServer,
+		PhaseGroup,
+		PhaseDoor,
+		PhaseObject,
+		PhaseCorpse,
+		PhaseTrap,
+		PhaseRaid,
+		PhaseEntity,
+		PhaseMob,
+		PhaseBeacon,
+		PhaseEncounter,
+		PhaseEventScheduler,
+		PhaseZone,
+		PhaseQuest,
+		PhaseCount
+	};
+
+	static constexpr int WindowSeconds = 60;
+
+	struct PhaseSummary {
+		std::string name;
+		uint64      samples;
+		uint32      p50_us;
+		uint32      p99_us;
+		uint32      max_us;
+		double      avg_us;
+		uint32      worst_tick_us;
+	};
+
+	struct WorstTick {
+		uint32 total_us = 0;
+		uint32 phase_us[PhaseCount] = { };
+		std::chrono::system_clock::time_point when;
+	};
+
+	static TickProfiler &Get()
+	{
+		static TickProfiler inst;
+		return inst;
+	}
+
+	static const char *PhaseName(Phase phase);
+
+	void BeginTick();
+	void EndTick();
+
+	// closes the phase in progress and starts timing the next one
+	inline void Enter(Phase phase)
+	{
+		int64 now = RDTSC_Timer::rdtsc();
+		m_tick_phase_ticks[m_phase] += now - m_phase_start;
+		m_phase_start = now;
+		m_phase       = phase;
+	}
+
+	std::vector<PhaseSummary> GetPhaseSummaries();
+	PhaseSummary GetTickSummary();
+	WorstTick GetWorstTick();
+	void Reset();
+
+private:
+	static constexpr int BucketCount = 256;
+
+	struct Histogram {
+		uint32 buckets[BucketCount];
+		uint64 count;
+		uint64 sum_us;
+		uint32 max_us;
+	};
+
+	struct Window {
+		Histogram phases[PhaseCount + 1]; // last entry is the whole tick
+		WorstTick worst;
+	};
+
+	TickProfiler();
+
+	static int BucketFor(uint32 us);
+	static uint32 BucketUpperBound(int bucket);
+	static void Record(Histogram &h, uint32 us);
+	PhaseSummary Summarize(int index, const char *name);
+	void Rotate();
+
+	uint32 TicksToMicroseconds(int64 ticks) const;
+
+	Window m_windows[2];
+	int    m_current = 0;
+	std::chrono::steady_clock::time_point m_window_start;
+
+	int64 m_ticks_per_ms;
+	int64 m_tick_start       = 0;
+	int64 m_phase_start      = 0;
+	Phase m_phase            = PhaseOther;
+	int64 m_tick_phase_ticks[PhaseCount];
+};
+
+#endif //EQEMU_TICK_PROFILER_H
@@ -7,14 +7,9 @@ WaterMapV2::~WaterMapV2() {
 }
 
 WaterRegionType WaterMapV2::ReturnRegionType(const glm::vec3& location) const {
-	size_t sz = regions.size();
-	for(size_t i = 0; i < sz; ++i) {
-		auto const &region = regions[i];
-		if (region.second.ContainsPoint(glm::vec3(location.y, location.x, location.z))) {
-			return region.first;
-		}
-	}
-	return RegionTypeNormal;
+	glm::vec3 p(location.y, location.x, location.z);
+	int index = grid.FindFirst(p, [&](uint32 i) { return regions[i].second.ContainsPoint(p); });
+	return index >= 0 ? regions[index].first : RegionTypeNormal;
 }
 
 bool WaterMapV2::InWater(const glm::vec3& location) const {
@@ -119,5 +114,13 @@ bool WaterMapV2::Load(FILE *fp) {
 			OrientedBoundingBox(glm::vec3(x, y, z), glm::vec3(x_rot, y_rot, z_rot), glm::vec3(x_scale, y_scale, z_scale), glm::vec3(x_extent, y_extent, z_extent))));
 	}
 
+	std::vector<glm::vec3> mins(regions.size());
+	std::vector<glm::vec3> maxs(regions.size());
+	for (size_t i = 0; i < regions.size(); ++i) {
+		regions[i].second.GetAxisAlignedBounds(mins[i], maxs[i]);
+	}
+
+	grid.Build(mins, maxs);
+
 	return true;
 }
@@ -3,6 +3,7 @@
 
 #include "water_map.h"
 #include "oriented_bounding_box.h"
+#include "water_region_grid.h"
 #include <vector>
 #include <utility>
 
@@ -24,6 +25,7 @@ protected:
 	virtual bool Load(FILE *fp);
 
 	std::vector<std::pair<WaterRegionType, OrientedBoundingBox>> regions;
+	WaterRegionGrid grid;
 	friend class WaterMap;
 };
 
@@ -0,0 +1,148 @@
+#ifndef EQEMU_WATER_REGION_GRID_H
+#define EQEMU_WATER_REGION_GRID_H
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <glm/common.hpp>
+#include <glm/vec3.hpp>
+
+/*
+	Uniform x/y grid over the axis aligned bounds of a set of water regions.
+
+	Each cell lists, in region order, the regions whose bounds overlap it. A lookup walks the
+	one cell under the point, checks the bounds and hands survivors to the exact test in order,
+	so the first region found is the same one a front to back scan of every region returns.
+*/
+class WaterRegionGrid {
+public:
+	static constexpr uint32_t MaxCellsPerAxis = 128;
+
+	void Build(const std::vector<glm::vec3> &mins, const std::vector<glm::vec3> &maxs)
+	{
+		m_mins = mins;
+		m_maxs = maxs;
+		m_cell_start.clear();
+		m_cell_regions.clear();
+		m_unbounded = false;
+		m_min       = glm::vec3(FLT_MAX);
+		m_max       = glm::vec3(-FLT_MAX);
+
+		for (size_t i = 0; i < m_mins.size(); ++i) {
+			if (!Finite(m_mins[i]) || !Finite(m_maxs[i])) {
+				// can't place it, test it everywhere
+				m_mins[i]   = glm::vec3(-FLT_MAX);
+				m_maxs[i]   = glm::vec3(FLT_MAX);
+				m_unbounded = true;
+				continue;
+			}
+
+			m_min = glm::min(m_min, m_mins[i]);
+			m_max = glm::max(m_max, m_maxs[i]);
+		}
+
+		if (m_min.x > m_max.x) {
+			m_min = m_max = glm::vec3(0.0f);
+		}
+
+		// about four cells per region
+		auto per_axis = static_cast<uint32_t>(std::ceil(std::sqrt(4.0 * m_mins.size())));
+		m_cells_x = std::clamp<uint32_t>(per_axis, 1, MaxCellsPerAxis);
+		m_cells_y = m_cells_x;
+		m_inv_x   = m_max.x > m_min.x ? m_cells_x / (m_max.x - m_min.x) : 0.0f;
+		m_inv_y   = m_max.y > m_min.y ? m_cells_y / (m_max.y - m_min.y) : 0.0f;
+
+		std::vector<uint32_t> counts(m_cells_x * m_cells_y + 1, 0);
+		auto                  cover = [&](size_t i, auto &&f) {
+			uint32_t x0 = CellX(m_mins[i].x);
+			uint32_t x1 = CellX(m_maxs[i].x);
+			uint32_t y0 = CellY(m_mins[i].y);
+			uint32_t y1 = CellY(m_maxs[i].y);
+			for (uint32_t y = y0; y <= y1; ++y) {
+				for (uint32_t x = x0; x <= x1; ++x) {
+					f(y * m_cells_x + x);
+				}
+			}
+		};
+
+		for (size_t i = 0; i < m_mins.size(); ++i) {
+			cover(i, [&](uint32_t cell) { counts[cell + 1]++; });
+		}
+
+		for (size_t c = 1; c < counts.size(); ++c) {
+			counts[c] += counts[c - 1];
+		}
+
+		m_cell_start = counts;
+		m_cell_regions.resize(counts.back());
+		for (size_t i = 0; i < m_mins.size(); ++i) {
+			cover(i, [&](uint32_t cell) { m_cell_regions[counts[cell]++] = static_cast<uint32_t>(i); });
+		}
+	}
+
+	// index of the first region whose bounds hold p and for which contains(index) is true, or -1
+	template<typename F>
+	int FindFirst(const glm::vec3 &p, F &&contains) const
+	{
+		if (m_cell_start.empty()) {
+			return -1;
+		}
+
+		if (!m_unbounded && !Inside(p, m_min, m_max)) {
+			return -1;
+		}
+
+		uint32_t cell = CellY(p.y) * m_cells_x + CellX(p.x);
+		for (uint32_t k = m_cell_start[cell]; k < m_cell_start[cell + 1]; ++k) {
+			uint32_t i = m_cell_regions[k];
+			if (Inside(p, m_mins[i], m_maxs[i]) && contains(i)) {
+				return static_cast<int>(i);
+			}
+		}
+
+		return -1;
+	}
+
+	size_t CellCount() const { return static_cast<size_t>(m_cells_x) * m_cells_y; }
+	size_t EntryCount() const { return m_cell_regions.size(); }
+
+private:
+	static bool Finite(const glm::vec3 &v)
+	{
+		return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+	}
+
+	static bool Inside(const glm::vec3 &p, const glm::vec3 &min, const glm::vec3 &max)
+	{
+		return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y && p.z >= min.z && p.z <= max.z;
+	}
+
+	static uint32_t Cell(float v, float min, float inv, uint32_t count)
+	{
+		float c = (v - min) * inv;
+		if (!(c > 0.0f)) {
+			return 0;
+		}
+
+		return std::min(static_cast<uint32_t>(std::min(c, static_cast<float>(count))), count - 1);
+	}
+
+	uint32_t CellX(float x) const { return Cell(x, m_min.x, m_inv_x, m_cells_x); }
+	uint32_t CellY(float y) const { return Cell(y, m_min.y, m_inv_y, m_cells_y); }
+
+	std::vector<glm::vec3> m_mins;
+	std::vector<glm::vec3> m_maxs;
+	std::vector<uint32_t>  m_cell_start;
+	std::vector<uint32_t>  m_cell_regions;
+	glm::vec3              m_min       = glm::vec3(0.0f);
+	glm::vec3              m_max       = glm::vec3(0.0f);
+	float                  m_inv_x     = 0.0f;
+	float                  m_inv_y     = 0.0f;
+	uint32_t               m_cells_x   = 1;
+	uint32_t               m_cells_y   = 1;
+	bool                   m_unbounded = false;
+};
+
+#endif //EQEMU_WATER_REGION_GRID_H
@@ -68,6 +68,7 @@ void NPC::AI_SetRoambox(
 	uint32 min_delay
 )
 {
+	entity_list.WakeMob(GetID());
 	m_roambox.distance  = distance;
 	m_roambox.max_x     = max_x;
 	m_roambox.min_x     = min_x;
@@ -139,6 +140,7 @@ void NPC::StopWandering()
 
 void NPC::ResumeWandering()
 {	// causes wandering to continue - overrides waypoint pause timer and PauseWandering()
+	entity_list.WakeMob(GetID());
 	if (!IsNPC())
 		return;
 	if (GetGrid() != 0)
@@ -206,6 +208,7 @@ void NPC::PauseWandering(int pausetime)
 
 void NPC::MoveTo(const glm::vec4 &position, bool saveguardspot)
 {    // makes mob walk to specified location
+	entity_list.WakeMob(GetID());
 	if (!AI_walking_timer) {
 		return;
 	}
@@ -580,6 +583,7 @@ void NPC::SaveGuardSpot(bool ClearGuardSpot) {
 
 void NPC::SaveGuardSpot(const glm::vec4 &pos)
 {
+	entity_list.WakeMob(GetID());
 	m_GuardPoint = pos;
 
 	if (m_GuardPoint.w == 0)
@@ -660,6 +664,7 @@ void Mob::StopNavigation() {
 
 void NPC::AssignWaypoints(int32 grid_id, int start_wp)
 {
+	entity_list.WakeMob(GetID());
 	if (grid_id == 0)
 		return; // grid ID 0 not supported
 
@@ -731,6 +736,7 @@ void Mob::SendTo(float new_x, float new_y, float new_z) {
 	m_Position.x = new_x;
 	m_Position.y = new_y;
 	m_Position.z = new_z;
+	entity_list.UpdateCloseGrid(this);
 	LogAIDetail("Sent To ({}, {}, {})", new_x, new_y, new_z);
 
 	if (flymode == GravityBehavior::Flying)
@@ -765,6 +771,7 @@ void Mob::SendToFixZ(float new_x, float new_y, float new_z) {
 	m_Position.x = new_x;
 	m_Position.y = new_y;
 	m_Position.z = new_z + 0.1;
+	entity_list.UpdateCloseGrid(this);
 
 	if (zone->HasMap() && RuleB(Map, FixPathingZOnSendTo))
 	{
@@ -3389,6 +3389,8 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 		if (!content_db.LoadSpells(hotfix_name, &SPDAT_RECORDS, &spells)) {
 			LogError("Loading spells failed!");
 		}
+
+		Mob::LoadBuffTicSpells();
 		break;
 	}
 	case ServerOP_CZClientMessageString:
@@ -36,6 +36,7 @@
 #include "../common/strings.h"
 #include "../common/eqemu_logsys.h"
 
+#include "character_save_queue.h"
 #include "dynamic_zone.h"
 #include "guild_mgr.h"
 #include "map.h"
@@ -49,6 +50,7 @@
 #include "water_map.h"
 #include "worldserver.h"
 #include "zone.h"
+#include "zone_boot_pipeline.h"
 #include "zone_config.h"
 #include "mob_movement_manager.h"
 #include "npc_scale_manager.h"
@@ -677,10 +679,10 @@ void Zone::LoadNewMerchantData(uint32 merchantid) {
 	merchanttable[merchantid] = merchant_list;
 }
 
-void Zone::LoadMerchants()
+void Zone::LoadMerchants(ZoneDatabase &db)
 {
 	const auto& l = MerchantlistRepository::GetWhere(
-		content_db,
+		db,
 		fmt::format(
 			SQL(
 				`merchantid` IN (
@@ -881,9 +883,14 @@ void Zone::Shutdown(bool quiet)
 	}
 
 	DataBucket::DeleteCachedBuckets(DataBucketLoadType::Zone, zone->GetZoneID(), zone->GetInstanceID());
-	// save and kick all clients
+	// save and kick all clients, the saves are on disk before anyone is sent back to world
 	for (auto c : entity_list.GetClientList()) {
 		c.second->Save();
+	}
+
+	CharacterSaveQueue::Get().Flush();
+
+	for (auto c : entity_list.GetClientList()) {
 		c.second->WorldKick();
 	}
 
@@ -1132,6 +1139,7 @@ Zone::~Zone() {
 	safe_delete(Weather_Timer);
 	safe_delete(zonemap);
 	safe_delete(watermap);
+	MobMovementManager::Get().CancelPathRequests();
 	safe_delete(pathing);
 	safe_delete(Instance_Timer);
 	safe_delete(Instance_Shutdown_Timer);
@@ -1166,80 +1174,194 @@ bool Zone::Init(bool is_static) {
 		return false;
 	}
 
-	zonemap  = Map::LoadMapFile(map_name);
-	watermap = WaterMap::LoadWaterMapfile(map_name);
-	pathing  = IPathfinder::Load(map_name);
-
-	LogInfo("Loading timezone data");
-	zone_time.setEQTimeZone(content_db.GetZoneTimezone(zoneid, GetInstanceVersion()));
-
-	LoadLDoNTraps();
-	LoadLDoNTrapEntries();
+	using Runs = ZoneBootPipeline::Runs;
 
-	LoadDynamicZoneTemplates();
-	DynamicZone::CacheAllFromDatabase();
+	ZoneBootPipeline boot(fmt::format("{} ({})", GetShortName(), GetInstanceID()));
 
-	content_db.LoadGlobalLoot();
-
-	npc_scale_manager->LoadScaleData();
-
-	LoadGrids();
+	// map files come off disk and are first needed once scripts can spawn things
+	boot.Add("map", Runs::Worker, {}, [this](ZoneDatabase &) {
+		zonemap = Map::LoadMapFile(map_name);
+		return true;
+	});
+	boot.Add("water map", Runs::Worker, {}, [this](ZoneDatabase &) {
+		watermap = WaterMap::LoadWaterMapfile(map_name);
+		return true;
+	});
+	boot.Add("navmesh", Runs::Worker, {}, [this](ZoneDatabase &) {
+		pathing = IPathfinder::Load(map_name);
+		return true;
+	});
 
-	if (RuleB(Zone, LevelBasedEXPMods)) {
-		LoadLevelEXPMods();
-	}
+	// content the zone keeps to itself, none of it is read by the zone thread stages before quests
+	boot.Add("ldon traps", Runs::Worker, {}, [this](ZoneDatabase &db) {
+		LoadLDoNTraps(db);
+		return true;
+	});
+	boot.Add("ldon trap entries", Runs::Worker, {"ldon traps"}, [this](ZoneDatabase &db) {
+		LoadLDoNTrapEntries(db);
+		return true;
+	});
+	boot.Add("dynamic zone templates", Runs::Worker, {}, [this](ZoneDatabase &db) {
+		LoadDynamicZoneTemplates(db);
+		return true;
+	});
+	boot.Add("global loot", Runs::Worker, {}, [](ZoneDatabase &db) {
+		db.LoadGlobalLoot();
+		return true;
+	});
+	boot.Add("grids", Runs::Worker, {}, [this](ZoneDatabase &db) {
+		LoadGrids(db);
+		return true;
+	});
 
-	RespawnTimesRepository::ClearExpiredRespawnTimers(database);
+	boot.Add("timezone", Runs::Zone, {}, [this](ZoneDatabase &db) {
+		LogInfo("Loading timezone data");
+		zone_time.setEQTimeZone(db.GetZoneTimezone(zoneid, GetInstanceVersion()));
+		return true;
+	});
+	boot.Add("dynamic zones", Runs::Zone, {}, [](ZoneDatabase &) {
+		DynamicZone::CacheAllFromDatabase();
+		return true;
+	});
+	boot.Add("npc scaling", Runs::Zone, {}, [](ZoneDatabase &) {
+		npc_scale_manager->LoadScaleData();
+		return true;
+	});
+	boot.Add("level exp mods", Runs::Zone, {}, [this](ZoneDatabase &) {
+		if (RuleB(Zone, LevelBasedEXPMods)) {
+			LoadLevelEXPMods();
+		}
 
+		return true;
+	});
+	boot.Add("respawn timers", Runs::Zone, {}, [](ZoneDatabase &) {
+		RespawnTimesRepository::ClearExpiredRespawnTimers(database);
+		return true;
+	});
 	// Loading zone variables so they're available for things like encounter_load
-	if (RuleB(Zone, StateSavingOnShutdown)) {
-		zone->LoadZoneVariablesState();
-	}
+	boot.Add("zone variables", Runs::Zone, {}, [](ZoneDatabase &) {
+		if (RuleB(Zone, StateSavingOnShutdown)) {
+			zone->LoadZoneVariablesState();
+		}
+
+		return true;
+	});
 
 	// make sure that anything that needs to be loaded prior to scripts is loaded before here
 	// this is to ensure that the scripts have access to the data they need
-	parse->ReloadQuests(true);
-
-	spawn_conditions.LoadSpawnConditions(short_name, instanceid);
-
-	content_db.LoadStaticZonePoints(&zone_point_list, short_name, GetInstanceVersion());
-
-	if (!content_db.LoadSpawnGroups(short_name, GetInstanceVersion(), &spawn_group_list)) {
-		LogError("Loading spawn groups failed");
-		return false;
-	}
-
-	content_db.PopulateZoneSpawnList(zoneid, spawn2_list, GetInstanceVersion());
-	SetSaveZoneState(true);
+	boot.Add(
+		"quests",
+		Runs::Zone,
+		{"map", "water map", "navmesh", "ldon trap entries", "dynamic zone templates", "global loot", "grids"},
+		[](ZoneDatabase &) {
+			parse->ReloadQuests(true);
+			return true;
+		}
+	);
 
-	database.LoadCharacterCorpses(zoneid, instanceid);
+	boot.Add("spawn conditions", Runs::Zone, {}, [this](ZoneDatabase &) {
+		spawn_conditions.LoadSpawnConditions(short_name, instanceid);
+		return true;
+	});
+	boot.Add("zone points", Runs::Zone, {}, [this](ZoneDatabase &db) {
+		db.LoadStaticZonePoints(&zone_point_list, short_name, GetInstanceVersion());
+		return true;
+	});
+	boot.Add("spawn groups", Runs::Zone, {}, [this](ZoneDatabase &db) {
+		if (!db.LoadSpawnGroups(short_name, GetInstanceVersion(), &spawn_group_list)) {
+			LogError("Loading spawn groups failed");
+			return false;
+		}
 
-	content_db.LoadTraps(short_name, GetInstanceVersion());
+		return true;
+	});
+	boot.Add("spawns", Runs::Zone, {}, [this](ZoneDatabase &db) {
+		db.PopulateZoneSpawnList(zoneid, spawn2_list, GetInstanceVersion());
+		SetSaveZoneState(true);
+		return true;
+	});
+	// the npcs in the spawn list are created before these load, same as before, nothing they touch is filled yet
+	boot.Add("adventure flavor", Runs::Worker, {"spawns"}, [this](ZoneDatabase &db) {
+		LogInfo("Loading adventure flavor text");
+		LoadAdventureFlavor(db);
+		return true;
+	});
+	boot.Add("blocked spells", Runs::Worker, {"spawns"}, [this](ZoneDatabase &db) {
+		LoadZoneBlockedSpells(db);
+		return true;
+	});
+	boot.Add("veteran rewards", Runs::Worker, {"spawns"}, [this](ZoneDatabase &db) {
+		LoadVeteranRewards(db);
+		return true;
+	});
+	boot.Add("alternate currencies", Runs::Worker, {"spawns"}, [this](ZoneDatabase &db) {
+		LoadAlternateCurrencies(db);
+		return true;
+	});
+	boot.Add("npc emotes", Runs::Worker, {"spawns"}, [this](ZoneDatabase &db) {
+		LoadNPCEmotes(&npc_emote_list, db);
+		return true;
+	});
+	boot.Add("alternate advancement", Runs::Worker, {"spawns"}, [this](ZoneDatabase &db) {
+		LoadAlternateAdvancement(db);
+		return true;
+	});
+	boot.Add("base data", Runs::Worker, {"spawns"}, [this](ZoneDatabase &db) {
+		LoadBaseData(db);
+		return true;
+	});
+	boot.Add("merchants", Runs::Worker, {"spawns"}, [this](ZoneDatabase &db) {
+		LoadMerchants(db);
+		return true;
+	});
 
-	LogInfo("Loading adventure flavor text");
-	LoadAdventureFlavor();
-	LoadGroundSpawns();
-	LoadZoneObjects();
-	LoadZoneDoors();
-	LoadZoneBlockedSpells();
-	LoadVeteranRewards();
-	LoadAlternateCurrencies();
-	LoadNPCEmotes(&npc_emote_list);
-	LoadAlternateAdvancement();
-	LoadBaseData();
-	LoadMerchants();
-	LoadTempMerchantData();
+	boot.Add("corpses", Runs::Zone, {}, [this](ZoneDatabase &) {
+		database.LoadCharacterCorpses(zoneid, instanceid);
+		return true;
+	});
+	boot.Add("traps", Runs::Zone, {}, [this](ZoneDatabase &db) {
+		db.LoadTraps(short_name, GetInstanceVersion());
+		return true;
+	});
+	boot.Add("ground spawns", Runs::Zone, {}, [this](ZoneDatabase &) {
+		LoadGroundSpawns();
+		return true;
+	});
+	boot.Add("objects", Runs::Zone, {}, [this](ZoneDatabase &) {
+		LoadZoneObjects();
+		return true;
+	});
+	boot.Add("doors", Runs::Zone, {}, [this](ZoneDatabase &) {
+		LoadZoneDoors();
+		return true;
+	});
+	boot.Add("temp merchants", Runs::Zone, {"merchants"}, [this](ZoneDatabase &) {
+		LoadTempMerchantData();
+		return true;
+	});
 
 	// Merc data
-	if (RuleB(Mercs, AllowMercs)) {
-		LoadMercenaryTemplates();
-		LoadMercenarySpells();
-	}
+	boot.Add("mercenaries", Runs::Zone, {}, [this](ZoneDatabase &) {
+		if (RuleB(Mercs, AllowMercs)) {
+			LoadMercenaryTemplates();
+			LoadMercenarySpells();
+		}
 
-	petition_list.ClearPetitions();
-	petition_list.ReadDatabase();
+		return true;
+	});
+	boot.Add("petitions", Runs::Zone, {}, [](ZoneDatabase &) {
+		petition_list.ClearPetitions();
+		petition_list.ReadDatabase();
+		return true;
+	});
+	boot.Add("guilds", Runs::Zone, {}, [](ZoneDatabase &) {
+		guild_mgr.LoadGuilds();
+		return true;
+	});
 
-	guild_mgr.LoadGuilds();
+	if (!boot.Run()) {
+		return false;
+	}
 
 	LogInfo("Zone booted successfully zone_id [{}] time_offset [{}]", zoneid, zone_time.getEQTimeZone());
 
@@ -2247,13 +2369,13 @@ bool Zone::HasGraveyard() {
 	return Result;
 }
 
-void Zone::LoadZoneBlockedSpells()
+void Zone::LoadZoneBlockedSpells(ZoneDatabase &db)
 {
 	if (!blocked_spells) {
-		zone_total_blocked_spells = content_db.GetBlockedSpellsCount(GetZoneID());
+		zone_total_blocked_spells = db.GetBlockedSpellsCount(GetZoneID());
 		if (zone_total_blocked_spells > 0) {
 			blocked_spells = new ZoneSpellsBlocked[zone_total_blocked_spells];
-			if (!content_db.LoadBlockedSpells(zone_total_blocked_spells, blocked_spells, GetZoneID())) {
+			if (!db.LoadBlockedSpells(zone_total_blocked_spells, blocked_spells, GetZoneID())) {
 				LogError(
 					"Failed to load blocked spells for {} ({}).",
 					zone_store.GetZoneName(GetZoneID(), true),
@@ -2372,9 +2494,9 @@ void Zone::SetInstanceTimer(uint32 new_duration)
 	}
 }
 
-void Zone::LoadLDoNTraps()
+void Zone::LoadLDoNTraps(ZoneDatabase &db)
 {
-	const auto& l = LdonTrapTemplatesRepository::All(content_db);
+	const auto& l = LdonTrapTemplatesRepository::All(db);
 
 	for (const auto& e : l) {
 		auto t = new LDoNTrapTemplate;
@@ -2389,9 +2511,9 @@ void Zone::LoadLDoNTraps()
 	}
 }
 
-void Zone::LoadLDoNTrapEntries()
+void Zone::LoadLDoNTrapEntries(ZoneDatabase &db)
 {
-	const auto& l = LdonTrapEntriesRepository::All(content_db);
+	const auto& l = LdonTrapEntriesRepository::All(db);
 
 	for (const auto& e : l) {
 		auto t = new LDoNTrapTemplate;
@@ -2416,7 +2538,7 @@ void Zone::LoadLDoNTrapEntries()
 	}
 }
 
-void Zone::LoadVeteranRewards()
+void Zone::LoadVeteranRewards(ZoneDatabase &db)
 {
 	VeteranRewards.clear();
 
@@ -2427,7 +2549,7 @@ void Zone::LoadVeteranRewards()
                             "FROM veteran_reward_templates "
                             "WHERE reward_slot < 8 and claim_id > 0 "
                             "ORDER by claim_id, reward_slot";
-    auto results = content_db.QueryDatabase(query);
+    auto results = db.QueryDatabase(query);
     if (!results.Success()) {
         return;
     }
@@ -2467,11 +2589,11 @@ void Zone::LoadVeteranRewards()
 
 }
 
-void Zone::LoadAlternateCurrencies()
+void Zone::LoadAlternateCurrencies(ZoneDatabase &db)
 {
 	AlternateCurrencies.clear();
 
-	const auto& l = AlternateCurrencyRepository::All(content_db);
+	const auto& l = AlternateCurrencyRepository::All(db);
 
 	if (l.empty()) {
 		return;
@@ -2522,10 +2644,10 @@ void Zone::DeleteQGlobal(std::string name, uint32 npcID, uint32 charID, uint32 z
 	}
 }
 
-void Zone::LoadAdventureFlavor()
+void Zone::LoadAdventureFlavor(ZoneDatabase &db)
 {
 	const std::string query = "SELECT id, text FROM adventure_template_entry_flavor";
-	auto results = content_db.QueryDatabase(query);
+	auto results = db.QueryDatabase(query);
 	if (!results.Success()) {
 		return;
 	}
@@ -2601,7 +2723,7 @@ void Zone::DoAdventureActions()
 
 }
 
-void Zone::LoadNPCEmotes(std::vector<NPC_Emote_Struct*>* v)
+void Zone::LoadNPCEmotes(std::vector<NPC_Emote_Struct*>* v, ZoneDatabase &db)
 {
 	for (auto &e: *v) {
 		safe_delete(e);
@@ -2609,7 +2731,7 @@ void Zone::LoadNPCEmotes(std::vector<NPC_Emote_Struct*>* v)
 
 	v->clear();
 
-	const auto& l = NpcEmotesRepository::All(content_db);
+	const auto& l = NpcEmotesRepository::All(db);
 
 	for (const auto& e : l) {
 		auto n = new NPC_Emote_Struct;
@@ -2723,10 +2845,10 @@ void Zone::SetQuestHotReloadQueued(bool in_quest_hot_reload_queued)
 	quest_hot_reload_queued = in_quest_hot_reload_queued;
 }
 
-void Zone::LoadGrids()
+void Zone::LoadGrids(ZoneDatabase &db)
 {
-	zone_grids        = GridRepository::GetZoneGrids(content_db, GetZoneID());
-	zone_grid_entries = GridEntriesRepository::GetZoneGridEntries(content_db, GetZoneID());
+	zone_grids        = GridRepository::GetZoneGrids(db, GetZoneID());
+	zone_grid_entries = GridEntriesRepository::GetZoneGridEntries(db, GetZoneID());
 
 	LogInfo(
 		"Loaded [{}] grids and [{}] grid_entries",
@@ -2883,10 +3005,10 @@ void Zone::SendDiscordMessage(const std::string& webhook_name, const std::string
 	}
 }
 
-void Zone::LoadDynamicZoneTemplates()
+void Zone::LoadDynamicZoneTemplates(ZoneDatabase &db)
 {
 	dz_template_cache.clear();
-	auto dz_templates = DynamicZoneTemplatesRepository::All(content_db);
+	auto dz_templates = DynamicZoneTemplatesRepository::All(db);
 	for (const auto& dz_template : dz_templates)
 	{
 		dz_template_cache[dz_template.id] = dz_template;
@@ -3304,6 +3426,7 @@ void Zone::ReloadMaps()
 {
 	zonemap  = Map::LoadMapFile(map_name);
 	watermap = WaterMap::LoadWaterMapfile(map_name);
+	MobMovementManager::Get().CancelPathRequests();
 	pathing  = IPathfinder::Load(map_name);
 }
 
@@ -304,23 +304,23 @@ public:
 	void DoAdventureActions();
 	void DoAdventureAssassinationCountIncrease();
 	void DoAdventureCountIncrease();
-	void LoadMerchants();
+	void LoadMerchants(ZoneDatabase &db = content_db);
 	void GetTimeSync();
-	void LoadAdventureFlavor();
-	void LoadAlternateAdvancement();
-	void LoadAlternateCurrencies();
-	void LoadDynamicZoneTemplates();
-	void LoadZoneBlockedSpells();
-	void LoadLDoNTrapEntries();
-	void LoadLDoNTraps();
+	void LoadAdventureFlavor(ZoneDatabase &db = content_db);
+	void LoadAlternateAdvancement(ZoneDatabase &db = content_db);
+	void LoadAlternateCurrencies(ZoneDatabase &db = content_db);
+	void LoadDynamicZoneTemplates(ZoneDatabase &db = content_db);
+	void LoadZoneBlockedSpells(ZoneDatabase &db = content_db);
+	void LoadLDoNTrapEntries(ZoneDatabase &db = content_db);
+	void LoadLDoNTraps(ZoneDatabase &db = content_db);
 	void LoadLevelEXPMods();
-	void LoadGrids();
+	void LoadGrids(ZoneDatabase &db = content_db);
 	void LoadMercenarySpells();
 	void LoadMercenaryTemplates();
 	void LoadNewMerchantData(uint32 merchantid);
-	void LoadNPCEmotes(std::vector<NPC_Emote_Struct*>* v);
+	void LoadNPCEmotes(std::vector<NPC_Emote_Struct*>* v, ZoneDatabase &db = content_db);
 	void LoadTempMerchantData();
-	void LoadVeteranRewards();
+	void LoadVeteranRewards(ZoneDatabase &db = content_db);
 	void LoadZoneDoors();
 	void ReloadStaticData();
 	void RemoveAuth(const char *iCharName, const char *iLSKey);
@@ -464,7 +464,7 @@ public:
 	// Base Data
 	inline void ClearBaseData() { m_base_data.clear(); };
 	BaseDataRepository::BaseData GetBaseData(uint8 level, uint8 class_id);
-	void LoadBaseData();
+	void LoadBaseData(ZoneDatabase &db = content_db);
 	void ReloadBaseData();
 
 	// data buckets
@@ -11,9 +11,9 @@ BaseDataRepository::BaseData Zone::GetBaseData(uint8 level, uint8 class_id)
 	return BaseDataRepository::NewEntity();
 }
 
-void Zone::LoadBaseData()
+void Zone::LoadBaseData(ZoneDatabase &db)
 {
-	const auto& l = BaseDataRepository::All(content_db);
+	const auto& l = BaseDataRepository::All(db);
 
 	m_base_data.reserve(l.size());
 
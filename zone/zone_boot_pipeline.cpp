@@ -0,0 +1,240 @@
+#include "zone_boot_pipeline.h"
+#include "../common/event/task_scheduler.h"
+#include "../common/eqemu_logsys.h"
+#include "../common/rulesys.h"
+#include "../common/timer.h"
+#include "zone_config.h"
+#include "zonedb.h"
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+extern const ZoneConfig *Config;
+
+namespace {
+	// idle boot connections, kept so the next instance boot doesn't pay for the connects again
+	std::mutex                                 boot_connections_lock;
+	std::vector<std::unique_ptr<ZoneDatabase>> boot_connections;
+
+	std::unique_ptr<ZoneDatabase> LeaseConnection()
+	{
+		{
+			std::lock_guard<std::mutex> lock(boot_connections_lock);
+			if (!boot_connections.empty()) {
+				auto db = std::move(boot_connections.back());
+				boot_connections.pop_back();
+				return db;
+			}
+		}
+
+		auto       db      = std::make_unique<ZoneDatabase>();
+		const bool content = !Config->ContentDbHost.empty();
+		const bool connected = db->Connect(
+			content ? Config->ContentDbHost : Config->DatabaseHost,
+			content ? Config->ContentDbUsername : Config->DatabaseUsername,
+			content ? Config->ContentDbPassword : Config->DatabasePassword,
+			content ? Config->ContentDbName : Config->DatabaseDB,
+			content ? Config->ContentDbPort : Config->DatabasePort,
+			"boot"
+		);
+
+		return connected ? std::move(db) : nullptr;
+	}
+
+	void ReturnConnection(std::unique_ptr<ZoneDatabase> db)
+	{
+		std::lock_guard<std::mutex> lock(boot_connections_lock);
+		boot_connections.emplace_back(std::move(db));
+	}
+}
+
+void ZoneBootPipeline::Add(const std::string &name, Runs runs, const std::vector<std::string> &after, Work work)
+{
+	Stage s{};
+	s.name  = name;
+	s.runs  = runs;
+	s.work  = std::move(work);
+	s.state = State::Waiting;
+
+	for (const auto &a: after) {
+		auto iter = std::find_if(
+			m_stages.begin(),
+			m_stages.end(),
+			[&a](const Stage &e) { return e.name == a; }
+		);
+
+		// stages can only wait on stages added before them, which also rules out cycles
+		if (iter == m_stages.end()) {
+			LogError("Boot stage [{}] waits on unknown stage [{}]", name, a);
+			continue;
+		}
+
+		s.after.push_back(std::distance(m_stages.begin(), iter));
+	}
+
+	m_stages.emplace_back(std::move(s));
+}
+
+bool ZoneBootPipeline::Ready(const Stage &s) const
+{
+	for (auto i: s.after) {
+		if (m_stages[i].state != State::Done) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool ZoneBootPipeline::Run()
+{
+	const size_t worker_stages = std::count_if(
+		m_stages.begin(),
+		m_stages.end(),
+		[](const Stage &s) { return s.runs == Runs::Worker; }
+	);
+
+	size_t threads = 0;
+	if (RuleI(Zone, BootThreads) > 0) {
+		threads = std::min<size_t>(RuleI(Zone, BootThreads), worker_stages);
+	}
+
+	BenchTimer                                boot_timer;
+	std::mutex                                lock;
+	std::condition_variable                   changed;
+	std::unique_ptr<EQ::Event::TaskScheduler> workers;
+	if (threads > 0) {
+		workers = std::make_unique<EQ::Event::TaskScheduler>(threads);
+	}
+
+	auto run_stage = [&boot_timer](Stage &s, ZoneDatabase &db) {
+		BenchTimer timer;
+		s.start_ms = boot_timer.elapsed() * 1000.0;
+		bool ok = s.work(db);
+		s.took_ms = timer.elapsed() * 1000.0;
+		return ok;
+	};
+
+	bool   failed  = false;
+	bool   offline = false; // a boot connection failed, the remaining stages run on the zone thread
+	size_t running = 0;
+
+	std::unique_lock<std::mutex> l(lock);
+	for (;;) {
+		if (workers && !offline && !failed) {
+			for (auto &s: m_stages) {
+				if (s.state != State::Waiting || s.runs != Runs::Worker || !Ready(s)) {
+					continue;
+				}
+
+				s.state     = State::Running;
+				s.on_worker = true;
+				running++;
+
+				workers->Enqueue(
+					[&, stage = &s]() {
+						auto db = LeaseConnection();
+						bool ok = db && run_stage(*stage, *db);
+
+						std::lock_guard<std::mutex> guard(lock);
+						if (!db) {
+							LogError("Boot connection failed, stage [{}] runs on the zone thread", stage->name);
+							stage->state     = State::Waiting;
+							stage->on_worker = false;
+							offline          = true;
+						}
+						else {
+							ReturnConnection(std::move(db));
+							stage->state = ok ? State::Done : State::Failed;
+							failed       = failed || !ok;
+						}
+
+						running--;
+						changed.notify_all();
+					}
+				);
+			}
+		}
+
+		// the next stage for the zone thread, in the order stages were added
+		Stage *next = nullptr;
+		for (auto &s: m_stages) {
+			if (s.state == State::Waiting && (s.runs == Runs::Zone || !workers || offline)) {
+				next = &s;
+				break;
+			}
+		}
+
+		if (!failed && next && Ready(*next)) {
+			next->state = State::Running;
+			l.unlock();
+			bool ok = run_stage(*next, content_db);
+			l.lock();
+			next->state = ok ? State::Done : State::Failed;
+			failed      = failed || !ok;
+			continue;
+		}
+
+		if (running == 0) {
+			break;
+		}
+
+		changed.wait(l);
+	}
+	l.unlock();
+
+	workers.reset();
+
+	for (auto &s: m_stages) {
+		if (s.state == State::Failed) {
+			LogError("Zone boot [{}] failed at stage [{}]", m_label, s.name);
+		}
+		else if (s.state != State::Done && !failed) {
+			LogError("Zone boot [{}] stage [{}] never became ready", m_label, s.name);
+			failed = true;
+		}
+	}
+
+	Report(boot_timer.elapsed() * 1000.0, threads);
+
+	return !failed;
+}
+
+void ZoneBootPipeline::Report(double total_ms, size_t threads) const
+{
+	std::vector<const Stage *> ran;
+	double                     stage_ms = 0.0;
+	for (auto &s: m_stages) {
+		if (s.state == State::Done || s.state == State::Failed) {
+			ran.push_back(&s);
+			stage_ms += s.took_ms;
+		}
+	}
+
+	std::sort(ran.begin(), ran.end(), [](const Stage *a, const Stage *b) { return a->start_ms < b->start_ms; });
+
+	for (auto s: ran) {
+		LogInfo(
+			"Boot stage [{}] on [{}] started [{:.1f}ms] took [{:.1f}ms]",
+			s->name,
+			s->on_worker ? "worker" : "zone",
+			s->start_ms,
+			s->took_ms
+		);
+	}
+
+	LogInfo(
+		"Zone boot [{}] took [{:.1f}ms] stages add up to [{:.1f}ms] boot threads [{}]",
+		m_label,
+		total_ms,
+		stage_ms,
+		threads
+	);
+}
+
+void ZoneBootPipeline::CloseConnections()
+{
+	std::lock_guard<std::mutex> lock(boot_connections_lock);
+	boot_connections.clear();
+}
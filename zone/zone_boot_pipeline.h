@@ -0,0 +1,65 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include "../common/types.h"
+
+class ZoneDatabase;
+
+/*
+	The steps of a zone boot and what each one waits on.
+
+	Worker stages are the ones that only read files or content tables into the zone's own
+	containers: map files, grids, merchant lists and the like. They run on boot threads, each
+	with a content database connection of its own, as soon as the stages they name are done.
+	Zone stages run on the zone thread strictly in the order they were added, each after the
+	stages it names, so everything that touches the entity list or scripts keeps its old order.
+	Run returns once every stage is done, nothing is left loading when the zone starts spawning.
+
+	With Zone:BootThreads at 0 every stage runs on the zone thread in the order it was added.
+*/
+class ZoneBootPipeline {
+public:
+	enum class Runs {
+		Zone,
+		Worker
+	};
+
+	// stages get the connection they should read content through
+	typedef std::function<bool(ZoneDatabase &db)> Work;
+
+	explicit ZoneBootPipeline(std::string label) : m_label(std::move(label)) { }
+
+	void Add(const std::string &name, Runs runs, const std::vector<std::string> &after, Work work);
+
+	// false if a stage failed, stages that hadn't started by then are skipped
+	bool Run();
+
+	// drops the boot connections kept between boots
+	static void CloseConnections();
+
+private:
+	enum class State {
+		Waiting,
+		Running,
+		Done,
+		Failed
+	};
+
+	struct Stage {
+		std::string         name;
+		Runs                runs;
+		std::vector<size_t> after;
+		Work                work;
+		State               state;
+		bool                on_worker;
+		double              start_ms;
+		double              took_ms;
+	};
+
+	bool Ready(const Stage &s) const;
+	void Report(double total_ms, size_t threads) const;
+
+	std::string        m_label;
+	std::vector<Stage> m_stages;
+};
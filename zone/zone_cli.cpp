@@ -29,7 +29,15 @@ void ZoneCLI::CommandHandler(int argc, char **argv)
 	auto function_map = EQEmuCommand::function_map;
 
 	// Register commands
+	function_map["benchmark:close-mob-scan"]     = &ZoneCLI::BenchmarkCloseMobScan;
+	function_map["benchmark:databucket-cache"]   = &ZoneCLI::BenchmarkDatabucketCache;
 	function_map["benchmark:databuckets"]        = &ZoneCLI::BenchmarkDatabuckets;
+	function_map["benchmark:hate-list"]          = &ZoneCLI::BenchmarkHateList;
+	function_map["benchmark:mob-movement"]       = &ZoneCLI::BenchmarkMobMovement;
+	function_map["benchmark:mob-process"]        = &ZoneCLI::BenchmarkMobProcess;
+	function_map["benchmark:perl-events"]        = &ZoneCLI::BenchmarkPerlEvents;
+	function_map["benchmark:raycast"]            = &ZoneCLI::BenchmarkRaycast;
+	function_map["benchmark:water-regions"]      = &ZoneCLI::BenchmarkWaterRegions;
 	function_map["sidecar:serve-http"]           = &ZoneCLI::SidecarServeHttp;
 	function_map["tests:databuckets"]            = &ZoneCLI::TestDataBuckets;
 	function_map["tests:npc-handins"]            = &ZoneCLI::TestNpcHandins;
@@ -40,7 +48,15 @@ void ZoneCLI::CommandHandler(int argc, char **argv)
 }
 
 // cli
+#include "cli/benchmark_close_mob_scan.cpp"
+#include "cli/benchmark_databucket_cache.cpp"
 #include "cli/benchmark_databuckets.cpp"
+#include "cli/benchmark_hate_list.cpp"
+#include "cli/benchmark_mob_movement.cpp"
+#include "cli/benchmark_mob_process.cpp"
+#include "cli/benchmark_perl_events.cpp"
+#include "cli/benchmark_raycast.cpp"
+#include "cli/benchmark_water_regions.cpp"
 #include "cli/sidecar_serve_http.cpp"
 
 // tests
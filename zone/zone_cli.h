@@ -7,7 +7,15 @@
 class ZoneCLI {
 public:
 	static void CommandHandler(int argc, char **argv);
+	static void BenchmarkCloseMobScan(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkDatabucketCache(int argc, char **argv, argh::parser &cmd, std::string &description);
 	static void BenchmarkDatabuckets(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkHateList(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkMobMovement(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkMobProcess(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkPerlEvents(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkRaycast(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkWaterRegions(int argc, char **argv, argh::parser &cmd, std::string &description);
 	static void SidecarServeHttp(int argc, char **argv, argh::parser &cmd, std::string &description);
 	static bool RanConsoleCommand(int argc, char **argv);
 	static bool RanSidecarCommand(int argc, char **argv);
@@ -11,6 +11,7 @@
 #include "zone.h"
 #include "zonedb.h"
 #include "aura.h"
+#include "character_save_queue.h"
 #include "../common/repositories/blocked_spells_repository.h"
 #include "../common/repositories/character_tribute_repository.h"
 #include "../common/repositories/character_data_repository.h"
@@ -1051,20 +1052,42 @@ bool ZoneDatabase::SaveCharacterData(
 		return false;
 	}
 
+	return SaveCharacterData(
+		c->CharacterID(),
+		c->AccountID(),
+		pp,
+		m_epp,
+		c->IsEXPEnabled(),
+		c->GetMailKeyFull(),
+		c->GetIllusionBlock()
+	);
+}
+
+bool ZoneDatabase::SaveCharacterData(
+	uint32 character_id,
+	uint32 account_id,
+	PlayerProfile_Struct* pp,
+	ExtendedProfile_Struct* m_epp,
+	bool exp_enabled,
+	const std::string& mail_key,
+	bool illusion_block
+) {
 	/* If this is ever zero - the client hasn't fully loaded and potentially crashed during zone */
-	if (c->AccountID() <= 0) {
+	if (account_id <= 0) {
 		return false;
 	}
 
+	CharacterSaveQueue::Get().Wait(character_id);
+
 	clock_t t = std::clock(); /* Function timer start */
 
-	auto e = CharacterDataRepository::FindOne(database, c->CharacterID());
+	auto e = CharacterDataRepository::FindOne(*this, character_id);
 	if (!e.id) {
 		return false;
 	}
 
-	e.id                      = c->CharacterID();
-	e.account_id              = c->AccountID();
+	e.id                      = character_id;
+	e.account_id              = account_id;
 	e.name                    = pp->name;
 	e.last_name               = pp->last_name;
 	e.gender                  = pp->gender;
@@ -1093,7 +1116,7 @@ bool ZoneDatabase::SaveCharacterData(
 	e.title                   = pp->title;
 	e.suffix                  = pp->suffix;
 	e.exp                     = pp->exp;
-	e.exp_enabled             = c->IsEXPEnabled();
+	e.exp_enabled             = exp_enabled;
 	e.points                  = pp->points;
 	e.mana                    = pp->mana;
 	e.cur_hp                  = pp->cur_hp;
@@ -1158,19 +1181,19 @@ bool ZoneDatabase::SaveCharacterData(
 	e.e_percent_to_aa         = m_epp->perAA;
 	e.e_expended_aa_spent     = m_epp->expended_aa;
 	e.e_last_invsnapshot      = m_epp->last_invsnapshot_time;
-	e.mailkey                 = c->GetMailKeyFull();
-	e.illusion_block          = c->GetIllusionBlock();
+	e.mailkey                 = mail_key;
+	e.illusion_block          = illusion_block;
 
-	const int replaced = CharacterDataRepository::ReplaceOne(database, e);
+	const int replaced = CharacterDataRepository::ReplaceOne(*this, e);
 
 	if (!replaced) {
-		LogError("Failed to save character data for [{}] ID [{}].", c->GetCleanName(), c->CharacterID());
+		LogError("Failed to save character data for [{}] ID [{}].", pp->name, character_id);
 		return false;
 	}
 
 	LogDebug(
 		"ZoneDatabase::SaveCharacterData [{}], done Took [{}] seconds",
-		c->CharacterID(),
+		character_id,
 		((float)(std::clock() - t)) / CLOCKS_PER_SEC
 	);
 	return true;
@@ -1178,6 +1201,8 @@ bool ZoneDatabase::SaveCharacterData(
 
 bool ZoneDatabase::SaveCharacterCurrency(uint32 character_id, PlayerProfile_Struct* pp)
 {
+	CharacterSaveQueue::Get().Wait(character_id);
+
 	ZeroPlayerProfileCurrency(pp);
 
 	auto e = CharacterCurrencyRepository::NewEntity();
@@ -2879,17 +2904,21 @@ void ZoneDatabase::UpdateAltCurrencyValue(uint32 char_id, uint32 currency_id, ui
 
 void ZoneDatabase::SaveBuffs(Client *client)
 {
+	SaveBuffs(client->CharacterID(), client->GetBuffs(), client->GetMaxBuffSlots());
+}
+
+void ZoneDatabase::SaveBuffs(uint32 character_id, const Buffs_Struct *buffs, int max_buff_slots)
+{
+	CharacterSaveQueue::Get().Wait(character_id);
+
 	CharacterBuffsRepository::DeleteWhere(
-		database,
+		*this,
 		fmt::format(
 			"`character_id` = {}",
-			client->CharacterID()
+			character_id
 		)
 	);
 
-	auto      buffs          = client->GetBuffs();
-	const int max_buff_slots = client->GetMaxBuffSlots();
-
 	std::vector<CharacterBuffsRepository::CharacterBuffs> v;
 
 	auto e = CharacterBuffsRepository::NewEntity();
@@ -2911,7 +2940,7 @@ void ZoneDatabase::SaveBuffs(Client *client)
 			continue;
 		}
 
-		e.character_id   = client->CharacterID();
+		e.character_id   = character_id;
 		e.slot_id        = slot_id;
 		e.spell_id       = buffs[slot_id].spellid;
 		e.caster_level   = buffs[slot_id].casterlevel;
@@ -2933,7 +2962,7 @@ void ZoneDatabase::SaveBuffs(Client *client)
 	}
 
 	if (!v.empty()) {
-		CharacterBuffsRepository::ReplaceMany(database, v);
+		CharacterBuffsRepository::ReplaceMany(*this, v);
 	}
 }
 
@@ -4079,12 +4108,19 @@ void ZoneDatabase::UpdateGMStatus(uint32 account_id, int new_status)
 
 void ZoneDatabase::SaveCharacterBinds(Client *c)
 {
+	database.SaveCharacterBinds(c->CharacterID(), &c->GetPP());
+}
+
+void ZoneDatabase::SaveCharacterBinds(uint32 character_id, const PlayerProfile_Struct *pp)
+{
+	CharacterSaveQueue::Get().Wait(character_id);
+
 	std::vector<CharacterBindRepository::CharacterBind> v;
 
 	auto e = CharacterBindRepository::NewEntity();
 
 	uint32 bind_count = 0;
-	for (const auto &b : c->GetPP().binds) {
+	for (const auto &b : pp->binds) {
 		if (b.zone_id) {
 			bind_count++;
 		}
@@ -4094,9 +4130,9 @@ void ZoneDatabase::SaveCharacterBinds(Client *c)
 
 	int slot_id = 0;
 
-	for (const auto &b : c->GetPP().binds) {
+	for (const auto &b : pp->binds) {
 		if (b.zone_id) {
-			e.id          = c->CharacterID();
+			e.id          = character_id;
 			e.zone_id     = b.zone_id;
 			e.instance_id = b.instance_id;
 			e.x           = b.x;
@@ -4112,7 +4148,7 @@ void ZoneDatabase::SaveCharacterBinds(Client *c)
 	}
 
 	if (bind_count > 0) {
-		CharacterBindRepository::ReplaceMany(database, v);
+		CharacterBindRepository::ReplaceMany(*this, v);
 	}
 }
 
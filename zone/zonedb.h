@@ -24,6 +24,7 @@ class Petition;
 class Spawn2;
 class SpawnGroupList;
 class Trap;
+struct Buffs_Struct;
 struct Door;
 struct ExtendedProfile_Struct;
 struct NPCType;
@@ -415,6 +416,7 @@ public:
 	uint32	GetServerFilters(char* name, ServerSideFilters_Struct *ssfs);
 
 	void SaveBuffs(Client *c);
+	void SaveBuffs(uint32 character_id, const Buffs_Struct *buffs, int max_buff_slots);
 	void LoadBuffs(Client *c);
 	void SaveAuras(Client *c);
 	void LoadAuras(Client *c);
@@ -449,6 +451,15 @@ public:
 	bool SaveCharacterBandolier(uint32 character_id, uint8 bandolier_id, uint8 bandolier_slot, uint32 item_id, uint32 icon, const char* bandolier_name);
 	bool SaveCharacterCurrency(uint32 character_id, PlayerProfile_Struct* pp);
 	bool SaveCharacterData(Client* c, PlayerProfile_Struct* pp, ExtendedProfile_Struct* m_epp);
+	bool SaveCharacterData(
+		uint32 character_id,
+		uint32 account_id,
+		PlayerProfile_Struct* pp,
+		ExtendedProfile_Struct* m_epp,
+		bool exp_enabled,
+		const std::string& mail_key,
+		bool illusion_block
+	);
 	bool SaveCharacterDiscipline(uint32 character_id, uint32 slot_id, uint32 disc_id);
 	bool SaveCharacterLanguage(uint32 character_id, uint32 lang_id, uint32 value);
 	bool SaveCharacterLeadershipAbilities(uint32 character_id, PlayerProfile_Struct* pp);
@@ -655,6 +666,7 @@ public:
 	static void LoadCharacterTribute(Client* c);
 
 	static void SaveCharacterBinds(Client *c);
+	void SaveCharacterBinds(uint32 character_id, const PlayerProfile_Struct *pp);
 	static void SaveCharacterTribute(Client* c);
 protected:
 	void ZDBInitVars();
@@ -416,9 +416,7 @@ void Client::SendZoneCancel(ZoneChange_Struct *zc) {
 	// we're using rewind location because it should be where the client relatively was before we rejected the zone request.
 	// it also prevents the client from getting caught up in a zone loop because if we sent them exactly back to where they
 	// originated the request we could end up in a situation where the client is caught in a zone loop.
-	m_Position.x = m_RewindLocation.x;
-	m_Position.y = m_RewindLocation.y;
-	m_Position.z = m_RewindLocation.z;
+	SetPosition(m_RewindLocation.x, m_RewindLocation.y, m_RewindLocation.z);
 	zc2->x       = m_Position.x;
 	zc2->y       = m_Position.y;
 	zc2->z       = m_Position.z;
@@ -524,6 +522,7 @@ void Client::DoZoneSuccess(ZoneChange_Struct *zc, uint16 zone_id, uint32 instanc
 	m_Position.y = dest_y;
 	m_Position.z = dest_z;
 	m_Position.w = dest_h; // Cripp: fix for zone heading
+	entity_list.UpdateCloseGrid(this);
 	m_pp.heading = dest_h;
 	m_pp.zone_id = zone_id;
 	m_pp.zoneInstance = instance_id;
@@ -921,6 +920,8 @@ void Client::ZonePC(uint32 zoneID, uint32 instance_id, float x, float y, float z
 			break;
 	}
 
+	entity_list.UpdateCloseGrid(this);
+
 	if (ReadyToZone)
 	{
 		//if client is looting, we need to send an end loot